@@ -8,6 +8,14 @@
 namespace OwnCAD {
 namespace Export {
 
+/**
+ * @brief Encoding of a written DXF file
+ */
+enum class DXFFormat {
+    Ascii,      ///< Text: one code or value per line
+    Binary      ///< Binary DXF: typed values, exact doubles, smaller and faster to read
+};
+
 /**
  * @brief DXF file writer - converts DXF entities to DXF text format
  *
@@ -17,6 +25,8 @@ namespace Export {
  * - Preserve handles, layers, colors exactly as imported
  * - Use high-precision formatting (15 decimal places) for coordinates
  * - Write clean, readable DXF with proper formatting
+ * - Optionally write binary DXF: the same groups, with codes and values
+ *   stored little-endian by type (see Import::DXFTokenizer::valueType)
  *
  * DXF Structure:
  * - SECTION HEADER: Metadata (version, units, etc.)
@@ -33,6 +43,7 @@ public:
      * @brief Write DXF entities to file
      * @param filePath Output DXF file path
      * @param entities DXF entities to write
+     * @param format Text or binary DXF
      * @return true if successful, false on file write error
      *
      * Writes a complete, valid DXF file with all sections.
@@ -40,23 +51,34 @@ public:
      */
     static bool writeFile(
         const std::string& filePath,
-        const std::vector<Import::DXFEntity>& entities
+        const std::vector<Import::DXFEntity>& entities,
+        DXFFormat format = DXFFormat::Ascii
     );
 
     /**
      * @brief Write DXF entities to stream
      * @param out Output stream
      * @param entities DXF entities to write
+     * @param format Text or binary DXF (binary needs a stream opened in binary mode)
      * @return true if successful, false on stream error
      *
      * For testing and in-memory DXF generation.
      */
     static bool writeStream(
         std::ostream& out,
-        const std::vector<Import::DXFEntity>& entities
+        const std::vector<Import::DXFEntity>& entities,
+        DXFFormat format = DXFFormat::Ascii
     );
 
 private:
+    /**
+     * @brief Stream and the encoding groups are written in
+     */
+    struct GroupOutput {
+        std::ostream& stream;
+        bool binary;
+    };
+
     /**
      * @brief Write DXF HEADER section
      *
@@ -65,7 +87,7 @@ private:
      * - Database version
      * - Minimal required header variables
      */
-    static void writeHeader(std::ostream& out);
+    static void writeHeader(GroupOutput& out);
 
     /**
      * @brief Write DXF TABLES section
@@ -74,19 +96,19 @@ private:
      * - Layer table (extracted from entities)
      * - Line type table (CONTINUOUS, BYLAYER)
      */
-    static void writeTables(std::ostream& out, const std::vector<Import::DXFEntity>& entities);
+    static void writeTables(GroupOutput& out, const std::vector<Import::DXFEntity>& entities);
 
     /**
      * @brief Write DXF ENTITIES section
      *
      * Writes all geometry entities with full metadata.
      */
-    static void writeEntities(std::ostream& out, const std::vector<Import::DXFEntity>& entities);
+    static void writeEntities(GroupOutput& out, const std::vector<Import::DXFEntity>& entities);
 
     /**
      * @brief Write EOF marker
      */
-    static void writeFooter(std::ostream& out);
+    static void writeFooter(GroupOutput& out);
 
     // ========================================================================
     // ENTITY WRITERS
@@ -95,37 +117,37 @@ private:
     /**
      * @brief Write LINE entity
      */
-    static void writeLine(std::ostream& out, const Import::DXFLine& line);
+    static void writeLine(GroupOutput& out, const Import::DXFLine& line);
 
     /**
      * @brief Write ARC entity
      */
-    static void writeArc(std::ostream& out, const Import::DXFArc& arc);
+    static void writeArc(GroupOutput& out, const Import::DXFArc& arc);
 
     /**
      * @brief Write CIRCLE entity
      */
-    static void writeCircle(std::ostream& out, const Import::DXFCircle& circle);
+    static void writeCircle(GroupOutput& out, const Import::DXFCircle& circle);
 
     /**
      * @brief Write LWPOLYLINE entity
      */
-    static void writeLWPolyline(std::ostream& out, const Import::DXFLWPolyline& polyline);
+    static void writeLWPolyline(GroupOutput& out, const Import::DXFLWPolyline& polyline);
 
     /**
      * @brief Write ELLIPSE entity
      */
-    static void writeEllipse(std::ostream& out, const Import::DXFEllipse& ellipse);
+    static void writeEllipse(GroupOutput& out, const Import::DXFEllipse& ellipse);
 
     /**
      * @brief Write POINT entity
      */
-    static void writePoint(std::ostream& out, const Import::DXFPoint& point);
+    static void writePoint(GroupOutput& out, const Import::DXFPoint& point);
 
     /**
      * @brief Write SOLID entity
      */
-    static void writeSolid(std::ostream& out, const Import::DXFSolid& solid);
+    static void writeSolid(GroupOutput& out, const Import::DXFSolid& solid);
 
     // ========================================================================
     // HELPER METHODS
@@ -137,17 +159,22 @@ private:
      * @param code DXF group code
      * @param value String value
      */
-    static void writeGroup(std::ostream& out, int code, const std::string& value);
+    static void writeGroup(GroupOutput& out, int code, const std::string& value);
 
     /**
-     * @brief Write group code + integer value
+     * @brief Write group code + integer value (binary: sized by the code's type)
      */
-    static void writeGroup(std::ostream& out, int code, int value);
+    static void writeGroup(GroupOutput& out, int code, int value);
 
     /**
      * @brief Write group code + double value (high precision)
      */
-    static void writeGroup(std::ostream& out, int code, double value);
+    static void writeGroup(GroupOutput& out, int code, double value);
+
+    /**
+     * @brief Write a binary group code (two bytes, little-endian)
+     */
+    static void writeBinaryCode(GroupOutput& out, int code);
 
     /**
      * @brief Extract unique layer names from entities
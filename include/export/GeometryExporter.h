@@ -57,6 +57,19 @@ public:
         const std::vector<Import::GeometryEntityWithMetadata>& entities
     );
 
+    /**
+     * @brief Convert a batch of entities and append them to an existing result
+     * @param entities Internal geometry with metadata
+     * @param result Result to extend (errors and counters accumulate)
+     *
+     * Lets callers export chunked storage (e.g. document snapshot pages)
+     * without first gathering every entity into one vector.
+     */
+    static void appendToDXF(
+        const std::vector<Import::GeometryEntityWithMetadata>& entities,
+        ExportResult& result
+    );
+
 private:
     /**
      * @brief Export Line2D to DXFLine
@@ -0,0 +1,212 @@
+#pragma once
+
+/**
+ * @file DuplicateIndex.h
+ * @brief Hash-bucketed candidate search for duplicate/overlapping geometry
+ *
+ * GeometryValidator::detectDuplicates used to compare every entity against
+ * every other entity. On nesting sheets with tens of thousands of segments
+ * that is far too slow. The indexes in this file only hand pairs to the
+ * exact GeometryValidator predicates when the pair can possibly satisfy
+ * them, so the reported issues are identical to the pairwise scan.
+ */
+
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include "geometry/GeometryValidator.h"
+#include <vector>
+#include <cstddef>
+
+namespace OwnCAD {
+namespace Geometry {
+
+/**
+ * @brief One confirmed duplicate/overlap relation between two entities
+ *
+ * Indices refer to the caller's entity list. `first` is always the lower
+ * index so that sorting pairs reproduces the (i, j) order of the old
+ * nested-loop scan.
+ */
+struct DuplicatePair {
+    size_t first;            ///< Lower entity index
+    size_t second;           ///< Higher entity index
+    GeometryIssueType type;  ///< DuplicateLine, OverlappingLines, ...
+
+    bool operator<(const DuplicatePair& other) const noexcept {
+        if (first != other.first) return first < other.first;
+        return second < other.second;
+    }
+};
+
+/// Cells swept between two polls of the cancellation token in findPairs()
+constexpr size_t CANCEL_CHECK_CELLS = 64;
+
+/**
+ * @brief Duplicate and collinear-overlap detector for line segments
+ *
+ * Lines are bucketed by a tolerance-quantized canonical key:
+ * - Direction bucket: undirected angle in [0, π), quantized so that any two
+ *   lines satisfying areLinesDuplicate/areLinesOverlapping land in the same
+ *   or in adjacent buckets. The bucket width is derived from the tolerance
+ *   and the 5th-percentile line length (short lines have a looser angular
+ *   bound). Lines shorter than that are not bucketed: a spatial hash of
+ *   their cells pairs them with every line that passes near them.
+ * - Offset cell: perpendicular offset measured in the bucket's reference
+ *   frame, quantized into cells. A line is inserted into every cell its
+ *   tolerance-expanded offset range touches.
+ *
+ * Inside each cell the lines are swept along the bucket direction and only
+ * pairs whose expanded extents overlap are passed to the exact predicates.
+ * Exact duplicates (identical endpoints) always share a cell and are found
+ * by the same sweep.
+ *
+ * Complexity: O(n log n + k) where k is the number of candidate pairs.
+ * findPairs() can spread the sweep over worker threads: small direction
+ * grids go to workers whole, large ones are split on offset-cell borders.
+ *
+ * Usage:
+ * @code
+ *   LineDuplicateIndex index(tolerance);
+ *   for (size_t i = 0; i < lines.size(); ++i) index.insert(i, lines[i]);
+ *   for (const auto& pair : index.findPairs()) { ... }
+ * @endcode
+ *
+ * NOTE: The index stores pointers to the inserted lines. The lines must
+ * outlive the index (it is meant to be built and queried in one pass).
+ */
+class LineDuplicateIndex {
+public:
+    /**
+     * @brief Create an empty index
+     * @param tolerance Comparison tolerance (same as passed to the predicates)
+     */
+    explicit LineDuplicateIndex(double tolerance) noexcept;
+
+    /**
+     * @brief Reserve storage for the expected number of lines
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Add a line to the index
+     * @param entityIndex Index of the line in the caller's entity list
+     * @param line Line geometry (must outlive the index)
+     */
+    void insert(size_t entityIndex, const Line2D& line);
+
+    /**
+     * @brief Number of lines in the index
+     */
+    size_t size() const noexcept { return entries_.size(); }
+
+    /**
+     * @brief Find all duplicate and overlapping line pairs
+     * @param threadCount Worker threads (0 = hardware concurrency)
+     * @return Pairs sorted by (first, second); each pair reported once
+     *
+     * For every pair the result equals the pairwise scan:
+     * DuplicateLine if areLinesDuplicate(lower, higher), otherwise
+     * OverlappingLines if areLinesOverlapping(lower, higher).
+     * The result does not depend on threadCount.
+     *
+     * A set cancellation token is polled every CANCEL_CHECK_CELLS offset
+     * cells; once it is cancelled the sweep stops and the pairs are
+     * incomplete (callers discard them).
+     */
+    std::vector<DuplicatePair> findPairs(size_t threadCount = 1,
+                                         const CancellationToken* cancellation = nullptr) const;
+
+private:
+    struct Entry {
+        size_t entityIndex;
+        const Line2D* line;
+        double angle;   ///< Undirected direction in [0, π)
+        double length;
+    };
+
+    /**
+     * @brief Append every pair that includes a line shorter than shortLength
+     * @param shortEntries Entries shorter than shortLength
+     * @param meanLength Mean length of all entries (bounds the cells walked)
+     */
+    void findShortLinePairs(const std::vector<size_t>& shortEntries,
+                            double shortLength, double meanLength,
+                            size_t threads, const CancellationToken* cancellation,
+                            std::vector<DuplicatePair>& out) const;
+
+    double tolerance_;
+    std::vector<Entry> entries_;
+};
+
+/**
+ * @brief Duplicate and coincidence detector for circular arcs
+ *
+ * Arcs are hashed by quantized center (x, y) and radius, with a cell size
+ * equal to the tolerance. Any two arcs on the "same circle" (center and
+ * radius within tolerance) therefore share a cell or sit in neighbouring
+ * cells, so each cell is only combined with its 26 neighbours.
+ *
+ * Within each cell neighbourhood the arcs' angular ranges are swept on the
+ * unrolled circle. Only arcs whose (slightly padded) ranges intersect are
+ * passed to areArcsDuplicate/areArcsCoincident.
+ *
+ * Complexity: O(n log n + k) where k is the number of candidate pairs.
+ *
+ * NOTE: Like LineDuplicateIndex, the index stores pointers to the inserted
+ * arcs. The arcs must outlive the index.
+ */
+class ArcDuplicateIndex {
+public:
+    /**
+     * @brief Create an empty index
+     * @param tolerance Comparison tolerance (same as passed to the predicates)
+     */
+    explicit ArcDuplicateIndex(double tolerance) noexcept;
+
+    /**
+     * @brief Reserve storage for the expected number of arcs
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Add an arc to the index
+     * @param entityIndex Index of the arc in the caller's entity list
+     * @param arc Arc geometry (must outlive the index)
+     */
+    void insert(size_t entityIndex, const Arc2D& arc);
+
+    /**
+     * @brief Number of arcs in the index
+     */
+    size_t size() const noexcept { return entries_.size(); }
+
+    /**
+     * @brief Find all duplicate and coincident arc pairs
+     * @param threadCount Worker threads (0 = hardware concurrency)
+     * @return Pairs sorted by (first, second); each pair reported once
+     *
+     * For every pair the result equals the pairwise scan:
+     * DuplicateArc if areArcsDuplicate(lower, higher), otherwise
+     * CoincidentArcs if areArcsCoincident(lower, higher).
+     * The result does not depend on threadCount.
+     *
+     * Cancellation is polled every CANCEL_CHECK_CELLS cell neighbourhoods,
+     * as in LineDuplicateIndex::findPairs().
+     */
+    std::vector<DuplicatePair> findPairs(size_t threadCount = 1,
+                                         const CancellationToken* cancellation = nullptr) const;
+
+private:
+    struct Entry {
+        size_t entityIndex;
+        const Arc2D* arc;
+        double rangeStart;   ///< CCW start of the covered range, [0, 2π)
+        double rangeLength;  ///< CCW length of the covered range, [0, 2π)
+    };
+
+    double tolerance_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace Geometry
+} // namespace OwnCAD
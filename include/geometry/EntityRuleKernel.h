@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * @file EntityRuleKernel.h
+ * @brief Per-entity rules as one pass over flat coordinate arrays
+ *
+ * Checking entities one variant at a time builds a ValidationResult per
+ * entity. The kernel in this file copies the geometry into parallel
+ * arrays a batch at a time and evaluates every per-entity rule in a
+ * branch-free loop over each batch; only flagged entities produce a record.
+ */
+
+#include "geometry/GeometryValidator.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OwnCAD {
+namespace Geometry {
+
+class ContourTopology;
+
+/**
+ * @brief Lines and arcs as parallel arrays (structure of arrays)
+ *
+ * Lines store their endpoints in (x0, y0) and (x1, y1). Arcs store their
+ * center in both, with radius, direction and the normalized angles as
+ * Arc2D keeps them; the kernel derives the sweep itself. Loading is plain
+ * copying, so all arithmetic happens in the kernel loop.
+ *
+ * Joint columns are filled by setJoints(): for each entity in a contour,
+ * the entities before and after it, the unit tangents where the
+ * traversal enters and leaves it and the points where it does so.
+ * Entities without a predecessor or successor point at themselves.
+ * Joint columns may be set without the geometry columns, for the
+ * kernel run that loads geometry straight from the entities.
+ */
+struct EntityColumns {
+    std::vector<uint8_t> arc;          ///< 1 for arcs, 0 for lines
+    std::vector<uint8_t> ccw;          ///< Arc direction
+    std::vector<double> x0;
+    std::vector<double> y0;
+    std::vector<double> x1;
+    std::vector<double> y1;
+    std::vector<double> radius;
+    std::vector<double> startAngle;    ///< Arc2D::startAngle()
+    std::vector<double> endAngle;      ///< Arc2D::endAngle()
+
+    std::vector<uint32_t> previous;   ///< Entity before this one in its contour (joint columns)
+    std::vector<uint32_t> next;       ///< Entity after this one in its contour
+    std::vector<double> entryX;       ///< Unit tangent at the traversal start
+    std::vector<double> entryY;
+    std::vector<double> exitX;        ///< Unit tangent at the traversal end
+    std::vector<double> exitY;
+    std::vector<double> entryPointX;  ///< Traversal start (joint with previous)
+    std::vector<double> entryPointY;
+    std::vector<double> exitPointX;   ///< Traversal end (joint with next)
+    std::vector<double> exitPointY;
+
+    /**
+     * @brief Columns of a whole entity list
+     */
+    static EntityColumns build(const SegmentView& entities);
+
+    /**
+     * @brief Size the geometry columns for count entities
+     */
+    void resize(size_t count);
+
+    /**
+     * @brief Copy entities [begin, end) into rows of the same index
+     *
+     * Rows are independent: disjoint ranges may be loaded concurrently.
+     */
+    void load(const SegmentView& entities, size_t begin, size_t end);
+
+    /**
+     * @brief Fill the joint columns from a topology of the same entities
+     *
+     * Sized by the entity list; the geometry columns are not needed.
+     */
+    void setJoints(const ContourTopology& contours,
+                   const SegmentView& entities);
+
+    size_t size() const noexcept { return arc.size(); }
+    bool hasJoints() const noexcept { return !next.empty(); }
+};
+
+/**
+ * @brief One issue found by the kernel
+ *
+ * 24 bytes; turned into a GeometryIssue only for the reported result.
+ */
+struct EntityIssueRecord {
+    uint32_t entity;           ///< Entity index
+    uint32_t related;          ///< Other entity at a sharp corner (entity otherwise)
+    double value;              ///< Edge length (ShortEdge) or corner angle in radians (SharpCorner)
+    GeometryIssueType type;
+    bool arc;                  ///< Entity is an arc (selects the description)
+    bool atEntry;              ///< Sharp corner is at the traversal start (else at its end)
+};
+
+/**
+ * @brief Single-pass per-entity rule evaluation over EntityColumns
+ *
+ * Each entity is checked for, in report order:
+ * - ZeroLengthLine / ZeroRadiusArc: length or radius below the tolerance
+ * - InvalidArcAngle: sweep below the tolerance or not finite
+ * - NumericalInstability: length, radius or sweep within 10 × tolerance
+ * - InvalidCoordinates: NaN or infinity in the stored coordinates
+ * - ShortEdge: line or arc length below rules.minEdgeLength
+ * - SharpCorner: corner between two contour segments narrower than
+ *   rules.minCornerAngle (needs joint columns). Each joint is reported
+ *   once, on the lower of its two entities, with the other as related
+ *   entity; the traversal start is checked before the end.
+ *
+ * The first four match validateLine() / validateArc() exactly. ShortEdge
+ * is skipped for entities that are already degenerate; each rule with a
+ * limit of 0 is disabled.
+ *
+ * The loop computes a flag byte per entity with no branches or calls the
+ * compiler cannot vectorize; a second scan over the flags emits records.
+ * Validation uses the entity-list run(), which fills one batch-sized
+ * buffer at a time and scans it while it is in cache, so no document-sized
+ * geometry columns are built.
+ *
+ * THREAD SAFETY: Immutable; run() may be called concurrently on disjoint
+ * or overlapping ranges.
+ */
+class EntityRuleKernel {
+public:
+    /// Entities per flag buffer
+    static constexpr size_t BATCH_SIZE = 256;
+
+    /**
+     * @brief Arc2D::sweepAngle() from the angles an Arc2D stores
+     *
+     * Stored angles are already normalized, so this skips the fmod of
+     * GeometryMath::sweepAngle and returns the identical value.
+     */
+    static double sweepOf(double startAngle, double endAngle, bool counterClockwise) noexcept;
+
+    /**
+     * @brief Create a kernel
+     * @param tolerance Tolerance for the structural checks
+     * @param rules Limits for the short-edge and sharp-corner rules
+     */
+    EntityRuleKernel(double tolerance, const ManufacturingRules& rules) noexcept;
+
+    /**
+     * @brief Check entities [begin, end), appending records in entity order
+     */
+    void run(const EntityColumns& columns, size_t begin, size_t end,
+             std::vector<EntityIssueRecord>& records) const;
+
+    /**
+     * @brief Check entities [begin, end) loaded batch by batch from the list
+     * @param entities Entities to check
+     * @param joints Joint columns for the sharp-corner rule (may be empty)
+     * @param begin First entity
+     * @param end One past the last entity
+     * @param records Appended in entity order; identical to the columns run
+     */
+    void run(const SegmentView& entities, const EntityColumns& joints,
+             size_t begin, size_t end, std::vector<EntityIssueRecord>& records) const;
+
+    /**
+     * @brief Issue for a record, with the rule limit and corner location
+     * @param record Record from run()
+     * @param columns Columns the record was found in (only the joint columns are read)
+     */
+    GeometryIssue toIssue(const EntityIssueRecord& record, const EntityColumns& columns) const noexcept;
+
+private:
+    struct Rows;
+
+    /**
+     * @brief Flag and record one batch of at most BATCH_SIZE entities
+     * @param rows Geometry of the batch, row 0 being entity first
+     */
+    void scan(const Rows& rows, size_t first, size_t count, const EntityColumns& joints,
+              std::vector<EntityIssueRecord>& records) const;
+
+    double tolerance_;
+    double minEdgeLength_;
+    double minCornerAngle_;
+    double cornerCosine_;    ///< Joints with a tangent dot product below this are sharp
+
+    // Line limits on squared length: x < zeroSquared_ exactly when
+    // sqrt(x) < tolerance, so the loop needs no square root
+    double zeroSquared_;
+    double stableSquared_;   ///< Smallest squared length with sqrt above 10 × tolerance
+    double edgeSquared_;     ///< Squared length limit for minEdgeLength
+};
+
+} // namespace Geometry
+} // namespace OwnCAD
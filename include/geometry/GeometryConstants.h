@@ -48,6 +48,32 @@ constexpr double MIN_ARC_RADIUS = GEOMETRY_EPSILON;
  */
 constexpr double MIN_ARC_SWEEP = GEOMETRY_EPSILON;
 
+/**
+ * @brief Tolerance for joining segment endpoints into contours
+ *
+ * Endpoints closer than this are treated as one vertex when chaining
+ * contours. Larger than GEOMETRY_EPSILON because DXF writers round
+ * coordinates, so consecutive polyline segments rarely meet exactly.
+ */
+constexpr double ENDPOINT_SNAP_TOLERANCE = 1e-6;
+
+/**
+ * @brief Minimum area of a closed contour that can be a hole
+ *
+ * Smaller closed contours are degenerate (e.g. a line drawn twice); the
+ * duplicate checks report those instead.
+ */
+constexpr double MIN_CONTOUR_AREA = GEOMETRY_EPSILON;
+
+/**
+ * @brief Typical minimum cuttable hole diameter (mm)
+ *
+ * Suggested to the user when enabling the hole size rule. The rule itself
+ * is off by default: DXF files carry no reliable units, so a millimetre
+ * limit would flag every hole of an inch or unitless drawing.
+ */
+constexpr double TYPICAL_MIN_HOLE_DIAMETER = 3.0;
+
 /**
  * @brief Mathematical constant PI
  *
@@ -247,6 +247,43 @@ Point2D closestPointOnArc(const Point2D& point, const Arc2D& arc) noexcept;
  */
 Point2D closestPointOnEllipse(const Point2D& point, const Ellipse2D& ellipse) noexcept;
 
+// ============================================================================
+// CLOSEST POINTS BETWEEN ENTITIES
+// ============================================================================
+
+/**
+ * @brief Closest pair of points between two entities
+ */
+struct ClosestPoints {
+    Point2D first;     ///< Point on the first entity
+    Point2D second;    ///< Point on the second entity
+    double distance;   ///< Distance between them (0 if the entities meet)
+};
+
+/**
+ * @brief Minimum distance between two line segments
+ * @return Closest points (an intersection point twice if the segments cross)
+ */
+ClosestPoints closestPoints(const Line2D& line1, const Line2D& line2) noexcept;
+
+/**
+ * @brief Minimum distance between a line segment and an arc
+ * @return Closest points; first is on the line
+ *
+ * Exact: besides the endpoints, the only interior candidate is the point
+ * of the segment nearest the arc center, measured radially.
+ */
+ClosestPoints closestPoints(const Line2D& line, const Arc2D& arc) noexcept;
+
+/**
+ * @brief Minimum distance between two arcs
+ * @return Closest points; first is on arc1
+ *
+ * Exact: besides the endpoints, interior minima lie on the line through
+ * both centers.
+ */
+ClosestPoints closestPoints(const Arc2D& arc1, const Arc2D& arc2) noexcept;
+
 // ============================================================================
 // TRANSLATION (for transformation tools)
 // ============================================================================
@@ -2,13 +2,23 @@
 
 #include "Line2D.h"
 #include "Arc2D.h"
+#include "GeometryConstants.h"
+#include "SegmentView.h"
 #include <vector>
 #include <variant>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
 
 namespace OwnCAD {
 namespace Geometry {
 
+class ContourTopology;
+
 /**
  * @brief Types of geometry issues that can be detected
  */
@@ -25,80 +35,245 @@ enum class GeometryIssueType {
     DuplicateLine,           ///< Two lines with identical endpoints
     OverlappingLines,        ///< Two collinear lines sharing a portion
     DuplicateArc,            ///< Two arcs identical in all parameters
-    CoincidentArcs           ///< Arcs with same center/radius and angular overlap
+    CoincidentArcs,          ///< Arcs with same center/radius and angular overlap
+
+    // Intersection issues (pairwise)
+    SelfIntersection,        ///< Two segments cross or touch away from a shared endpoint
+
+    // Contour issues (closed contours of several segments)
+    HoleTooSmall,            ///< Hole narrower than the smallest cuttable diameter
+    FeaturesTooClose,        ///< Two features closer than the minimum spacing (pairwise)
+
+    // Manufacturing warnings (individual entities)
+    ShortEdge,               ///< Segment shorter than the minimum edge length
+    SharpCorner              ///< Joint to the next contour segment narrower than the minimum angle
 };
 
+/// Number of GeometryIssueType values
+constexpr size_t ISSUE_TYPE_COUNT = static_cast<size_t>(GeometryIssueType::SharpCorner) + 1;
+
 /**
  * @brief Details about a single geometry issue
+ *
+ * A compact, trivially copyable record: indices and the numbers the
+ * description is formatted from. Text is produced on demand by
+ * describe(); handles and contour members are looked up in the
+ * ValidationResult that holds the issue (handleOf(), contourOf()).
  */
 struct GeometryIssue {
     GeometryIssueType type;
+    bool arc;                        ///< Entity is an arc (entity issues; selects the description)
+    uint32_t contourBegin;           ///< First member in ValidationResult::contourMembers (contour issues)
+    uint32_t contourSize;            ///< Number of contour members (0 for other issues)
     size_t entityIndex;              ///< Index in the entity list (if applicable)
-    std::string description;         ///< Human-readable description
-    std::string entityHandle;        ///< Entity handle/ID (if available)
     size_t relatedEntityIndex;       ///< Index of related entity (for pairwise issues)
-    std::string relatedEntityHandle; ///< Handle of related entity (for pairwise issues)
+    double value;                    ///< Measured quantity: length, angle (radians), diameter or distance
+    double limit;                    ///< Rule limit the value fell below
+    std::optional<Point2D> location; ///< Where the issue is (intersection point), if known
+    std::optional<Point2D> relatedLocation;   ///< Matching point on the related entity (spacing issues)
 
     GeometryIssue()
-        : type(GeometryIssueType::ZeroLengthLine)
-        , entityIndex(0)
-        , relatedEntityIndex(0)
+        : GeometryIssue(GeometryIssueType::ZeroLengthLine, 0, 0)
     {}
 
-    GeometryIssue(GeometryIssueType t, size_t idx, const std::string& desc)
-        : type(t)
-        , entityIndex(idx)
-        , description(desc)
-        , relatedEntityIndex(0)
-    {}
-
-    GeometryIssue(GeometryIssueType t, size_t idx, const std::string& desc,
-                  const std::string& handle)
-        : type(t)
-        , entityIndex(idx)
-        , description(desc)
-        , entityHandle(handle)
-        , relatedEntityIndex(0)
+    GeometryIssue(GeometryIssueType t, size_t idx)
+        : GeometryIssue(t, idx, 0)
     {}
 
-    GeometryIssue(GeometryIssueType t, size_t idx1, size_t idx2,
-                  const std::string& desc,
-                  const std::string& handle1, const std::string& handle2)
+    GeometryIssue(GeometryIssueType t, size_t idx1, size_t idx2)
         : type(t)
+        , arc(false)
+        , contourBegin(0)
+        , contourSize(0)
         , entityIndex(idx1)
-        , description(desc)
-        , entityHandle(handle1)
         , relatedEntityIndex(idx2)
-        , relatedEntityHandle(handle2)
+        , value(0.0)
+        , limit(0.0)
     {}
 };
 
 /**
  * @brief Result of geometry validation
+ *
+ * Issues are kept in report order with a per-type index beside them.
+ * They are only changed through add(), append() and editIssues(), so the
+ * index cannot go stale: add() extends it, editIssues() drops it until
+ * the next indexIssues() (queries scan meanwhile). Results returned by
+ * the validator are indexed.
  */
 struct ValidationResult {
     bool isValid;                       ///< true if all geometry is valid
-    std::vector<GeometryIssue> issues;  ///< List of detected issues
+    bool cancelled = false;             ///< Run was cancelled; issues are partial
+    std::vector<std::string> truncatedRules;  ///< Rules stopped by their time budget
+
+    std::vector<size_t> contourMembers; ///< Entities of all contour issues, each run ascending
+
+    /// Entity handles by index (shared with the caller; may be empty or shorter)
+    HandleTable handles;
+
+    /**
+     * @brief Check if every rule ran to completion
+     */
+    bool isComplete() const noexcept { return !cancelled && truncatedRules.empty(); }
+
+    /**
+     * @brief Detected issues, in report order
+     */
+    const std::vector<GeometryIssue>& issues() const noexcept { return issues_; }
 
     /**
      * @brief Check if validation passed (no issues)
      */
-    bool passed() const noexcept { return issues.empty(); }
+    bool passed() const noexcept { return issues_.empty(); }
 
     /**
      * @brief Get count of issues
      */
-    size_t issueCount() const noexcept { return issues.size(); }
+    size_t issueCount() const noexcept { return issues_.size(); }
+
+    /**
+     * @brief Add an issue at the end (the type index stays current)
+     */
+    void add(const GeometryIssue& issue);
+
+    /**
+     * @brief Reserve storage for issues about to be added
+     */
+    void reserveIssues(size_t count) { issues_.reserve(count); }
 
     /**
-     * @brief Check if specific issue type exists
+     * @brief Mutable access to the issues; drops the type index
+     *
+     * Queries scan until indexIssues() is called again.
+     */
+    std::vector<GeometryIssue>& editIssues() noexcept;
+
+    /**
+     * @brief Check if specific issue type exists (O(1) when indexed)
      */
     bool hasIssueType(GeometryIssueType type) const noexcept;
 
     /**
-     * @brief Get all issues of a specific type
+     * @brief Get all issues of a specific type (O(k) when indexed)
      */
     std::vector<GeometryIssue> getIssuesOfType(GeometryIssueType type) const;
+
+    /**
+     * @brief Positions in issues() of every issue of a type, ascending
+     */
+    std::vector<size_t> issuePositionsOfType(GeometryIssueType type) const;
+
+    /**
+     * @brief Handle of an entity, or an empty string if none is known
+     */
+    const std::string& handleOf(size_t entityIndex) const noexcept;
+
+    /**
+     * @brief Entities of a contour issue, ascending (empty for other issues)
+     */
+    std::vector<size_t> contourOf(const GeometryIssue& issue) const;
+
+    /**
+     * @brief Store the members of a contour issue in contourMembers
+     * @param entities Entities of the contour, ascending
+     */
+    void setContour(GeometryIssue& issue, const std::vector<size_t>& entities);
+
+    /**
+     * @brief Append the issues of another rule's result (same entity list)
+     *
+     * Takes over validity, cancellation and truncated rules the way the
+     * validator merges its rules, and the handle table if this has none.
+     */
+    void append(ValidationResult&& other);
+
+    /**
+     * @brief Rebuild the per-type index from the issues
+     */
+    void indexIssues();
+
+private:
+    std::vector<GeometryIssue> issues_;             ///< Detected issues
+    std::vector<std::vector<uint32_t>> typeIndex_;  ///< Positions of each type's issues (empty = not indexed)
+
+    bool isIndexed() const noexcept { return !typeIndex_.empty(); }
+};
+
+/**
+ * @brief Cooperative cancellation flag for a validation run
+ *
+ * Copies share one flag: the caller keeps a copy and hands another to
+ * the validating thread. The validator polls it between entities.
+ */
+class CancellationToken {
+public:
+    CancellationToken() : flag_(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() noexcept { flag_->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const noexcept { return flag_->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag_;
+};
+
+/**
+ * @brief Progress of a validation run, reported per rule
+ */
+struct ValidationProgress {
+    const char* rule;   ///< Rule being checked (static string)
+    size_t processed;   ///< Entities processed by this rule so far
+    size_t total;       ///< Entities this rule processes
+};
+
+/**
+ * @brief Manufacturing limits checked by the validator
+ *
+ * Lengths are in drawing units (mm), angles in radians. A minimum of 0
+ * disables its rule; every rule starts disabled until the user sets its
+ * limit (see TYPICAL_MIN_HOLE_DIAMETER).
+ */
+struct ManufacturingRules {
+    double minHoleDiameter = 0.0;    ///< Smallest hole the process can cut
+    double kerfWidth = 0.0;          ///< Width of material removed by the cut
+    double minFeatureSpacing = 0.0;  ///< Closest features may be (0 = 2 × kerfWidth)
+    double minEdgeLength = 0.0;      ///< Shortest segment the machine follows cleanly
+    double minCornerAngle = 0.0;     ///< Narrowest corner cut without a special strategy
+
+    /**
+     * @brief Spacing checked by the proximity rule (0 = disabled)
+     */
+    double featureSpacing() const noexcept {
+        return minFeatureSpacing > 0.0 ? minFeatureSpacing : 2.0 * kerfWidth;
+    }
+};
+
+/**
+ * @brief Cancellation, progress, time budget and threading for a validation run
+ *
+ * The validator checks the token, reports progress and measures the rule
+ * budget every progressInterval entities, so the overhead is negligible.
+ *
+ * Complete results are identical for every threadCount: per-entity issues
+ * are merged in entity order, duplicate and intersection pairs in
+ * (first, second) order.
+ */
+struct ValidationControl {
+    CancellationToken cancellation;
+
+    /// Called on a validating thread, never concurrently; must be cheap and must not throw
+    std::function<void(const ValidationProgress&)> progress;
+
+    size_t progressInterval = 4096;            ///< Entities between checks
+    std::chrono::milliseconds ruleBudget{0};   ///< Per-rule time limit (0 = unlimited)
+    size_t threadCount = 0;                    ///< Worker threads (0 = hardware concurrency)
+    ManufacturingRules rules;                  ///< Limits for the manufacturing rules
+
+    /// Topology of the validated entities for the sharp-corner rule (built when needed if null)
+    std::shared_ptr<const ContourTopology> contours;
+
+    /// Per-entity issues of exactly these entities, found while importing them;
+    /// the entity checks are skipped when set (see Import::ImportPipeline)
+    std::shared_ptr<const std::vector<GeometryIssue>> entityIssues;
 };
 
 /**
@@ -136,12 +311,12 @@ public:
 
     /**
      * @brief Validate collection of entities
-     * @param entities Vector of lines and arcs
+     * @param entities Lines and arcs
      * @param tolerance Tolerance for validation
      * @return Validation result with all detected issues
      */
     static ValidationResult validateEntities(
-        const std::vector<std::variant<Line2D, Arc2D>>& entities,
+        const SegmentView& entities,
         double tolerance
     ) noexcept;
 
@@ -250,38 +425,256 @@ public:
     static bool areArcsCoincident(const Arc2D& arc1, const Arc2D& arc2,
                                   double tolerance) noexcept;
 
+    /**
+     * @brief Validate one line or arc (validateLine / validateArc)
+     */
+    static ValidationResult validateEntity(SegmentRef entity,
+                                           double tolerance) noexcept;
+
+    /**
+     * @brief Validate one line or arc, including the edge-length rule
+     * @param entity Entity to check
+     * @param tolerance Tolerance for validation
+     * @param rules Manufacturing limits (rules.minEdgeLength)
+     *
+     * Same issues validateEntitiesWithHandles reports for the entity,
+     * except SharpCorner, which depends on its neighbours.
+     */
+    static ValidationResult validateEntity(SegmentRef entity,
+                                           double tolerance,
+                                           const ManufacturingRules& rules) noexcept;
+
+    /**
+     * @brief Classify a pair the way detectDuplicates does
+     * @param lower Entity that comes first in the collection
+     * @param higher Entity that comes later in the collection
+     * @param tolerance Comparison tolerance
+     * @return DuplicateLine/OverlappingLines/DuplicateArc/CoincidentArcs, or nullopt
+     *
+     * Used to re-check single pairs (incremental validation). Line-arc
+     * pairs are never duplicates.
+     */
+    static std::optional<GeometryIssueType> comparePair(
+        SegmentRef lower,
+        SegmentRef higher,
+        double tolerance) noexcept;
+
+    /**
+     * @brief Find where two entities intersect, ignoring shared endpoints
+     * @param lower Entity that comes first in the collection
+     * @param higher Entity that comes later in the collection
+     * @param tolerance Comparison tolerance
+     * @return First intersection point not at a shared endpoint, or nullopt
+     *
+     * Uses the GeometryMath kernels (segmentSegmentIntersection,
+     * intersectLineArc, intersectArcArc). A point within
+     * max(tolerance, ENDPOINT_SNAP_TOLERANCE) of an endpoint of both
+     * entities is a contour joint, not an intersection. A T-junction (the
+     * end of one segment on the interior of another) is reported.
+     * Collinear lines and concentric arcs have no intersection point; they
+     * are left to the duplicate and overlap checks.
+     */
+    static std::optional<Point2D> findIntersection(
+        SegmentRef lower,
+        SegmentRef higher,
+        double tolerance) noexcept;
+
+    /**
+     * @brief Description of a SelfIntersection issue at a point
+     */
+    static std::string intersectionDescription(const Point2D& point);
+
+    /**
+     * @brief Check if an issue type relates two entities
+     */
+    static bool isPairIssue(GeometryIssueType type) noexcept;
+
+    /**
+     * @brief Check if an issue type concerns a whole contour
+     *
+     * Contour issues list the contour's entities in the result's
+     * contourMembers (see ValidationResult::contourOf()); entityIndex is
+     * the lowest of them.
+     */
+    static bool isContourIssue(GeometryIssueType type) noexcept;
+
+    /**
+     * @brief Check if an issue type makes the geometry invalid
+     *
+     * NumericalInstability, FeaturesTooClose, ShortEdge and SharpCorner
+     * are warnings; every other issue type fails validation.
+     */
+    static bool isBlockingIssue(GeometryIssueType type) noexcept;
+
+    /**
+     * @brief Description used for pairwise issues of a type
+     */
+    static const char* pairDescription(GeometryIssueType type) noexcept;
+
     /**
      * @brief Validate entities with handle information for detailed reporting
-     * @param entities Vector of geometry entities
-     * @param handles Vector of entity handles (parallel to entities)
+     * @param entities Lines and arcs (a vector or a snapshot's pages)
+     * @param handles Entity handles by index (shared with the result, not copied)
      * @param tolerance Tolerance for validation
-     * @return Validation result with entity handles populated
+     * @return Validation result with its handle table set
+     *
+     * This method performs individual validation, pairwise
+     * duplicate/overlap detection and self-intersection detection. Issues
+     * hold entity indices; ValidationResult::handleOf() maps them to
+     * handles.
      *
-     * This method performs both individual validation and pairwise
-     * duplicate/overlap detection, populating handles in issues.
+     * Individual checks run through EntityRuleKernel (see
+     * EntityRuleKernel.h) over columns of the entities, in parallel blocks.
      */
     static ValidationResult validateEntitiesWithHandles(
-        const std::vector<std::variant<Line2D, Arc2D>>& entities,
-        const std::vector<std::string>& handles,
+        const SegmentView& entities,
+        const HandleTable& handles,
         double tolerance
     ) noexcept;
 
+    /**
+     * @brief Validate entities with cancellation, progress and rule budgets
+     * @param entities Lines and arcs (a vector or a snapshot's pages)
+     * @param handles Entity handles by index (shared with the result, not copied)
+     * @param tolerance Tolerance for validation
+     * @param control Cancellation token, progress callback and time budget
+     * @return Validation result; check cancelled/truncatedRules for partial results
+     *
+     * A cancelled run stops at the next check and skips the remaining
+     * rules. A rule over its budget stops early; later rules still run.
+     *
+     * control.rules.minEdgeLength and minCornerAngle add ShortEdge and
+     * SharpCorner warnings to the entity checks; the corner rule uses
+     * control.contours, or builds a topology if that is null.
+     */
+    static ValidationResult validateEntitiesWithHandles(
+        const SegmentView& entities,
+        const HandleTable& handles,
+        double tolerance,
+        const ValidationControl& control
+    ) noexcept;
+
     /**
      * @brief Detect all duplicate and overlapping geometry in a collection
-     * @param entities Vector of geometry entities
-     * @param handles Vector of entity handles (parallel to entities)
+     * @param entities Lines and arcs (a vector or a snapshot's pages)
+     * @param handles Entity handles by index (shared with the result, not copied)
      * @param tolerance Tolerance for detection
      * @return ValidationResult containing only duplicate/overlap issues
      *
      * This is a focused method for duplicate detection only.
      * Does not check individual entity validity.
+     *
+     * Candidates come from LineDuplicateIndex and ArcDuplicateIndex (see
+     * DuplicateIndex.h), so large documents avoid the O(n²) scan. Issues are reported in
+     * (entityIndex1, entityIndex2) order, identical to a pairwise scan.
+     */
+    static ValidationResult detectDuplicates(
+        const SegmentView& entities,
+        const HandleTable& handles,
+        double tolerance
+    ) noexcept;
+
+    /**
+     * @brief Detect duplicates with cancellation, progress and a time budget
+     * @param control Cancellation token, progress callback and time budget
+     *
+     * Progress covers indexing the entities; the pair search polls the
+     * cancellation token every CANCEL_CHECK_CELLS cells (DuplicateIndex.h).
      */
     static ValidationResult detectDuplicates(
-        const std::vector<std::variant<Line2D, Arc2D>>& entities,
-        const std::vector<std::string>& handles,
+        const SegmentView& entities,
+        const HandleTable& handles,
+        double tolerance,
+        const ValidationControl& control
+    ) noexcept;
+
+    /**
+     * @brief Detect segments that cross or touch each other
+     * @param entities Lines and arcs (a vector or a snapshot's pages)
+     * @param handles Entity handles by index (shared with the result, not copied)
+     * @param tolerance Tolerance for detection
+     * @return ValidationResult containing only SelfIntersection issues
+     *
+     * Candidates come from IntersectionSweep (see IntersectionSweep.h);
+     * each intersecting pair is reported once, at the point returned by
+     * findIntersection(), in (entityIndex1, entityIndex2) order.
+     */
+    static ValidationResult detectSelfIntersections(
+        const SegmentView& entities,
+        const HandleTable& handles,
         double tolerance
     ) noexcept;
 
+    /**
+     * @brief Detect self-intersections with cancellation, progress and a time budget
+     * @param control Cancellation token, progress callback and time budget
+     *
+     * Progress covers adding the entities to the sweep; the sweep itself
+     * is checked for cancellation before and after it runs.
+     */
+    static ValidationResult detectSelfIntersections(
+        const SegmentView& entities,
+        const HandleTable& handles,
+        double tolerance,
+        const ValidationControl& control
+    ) noexcept;
+
+    /**
+     * @brief Find holes too small to cut
+     * @param entities Lines and arcs (a vector or a snapshot's pages)
+     * @param handles Entity handles by index (shared with the result, not copied)
+     * @param contours Topology built from the same entities
+     * @param control Cancellation, progress, budget, threads and the minimum diameter
+     * @return ValidationResult containing only HoleTooSmall issues
+     *
+     * Every hole (closed contour at odd nesting depth with nonzero area) is
+     * measured with HoleMeasure. A hole fails when its inscribed-circle
+     * diameter is below rules.minHoleDiameter + rules.kerfWidth. Holes are
+     * measured in parallel; issues are sorted by entityIndex (the lowest
+     * entity of the contour) and carry the circle's center as location.
+     * Disabled when rules.minHoleDiameter is 0.
+     */
+    static ValidationResult checkHoleSizes(
+        const SegmentView& entities,
+        const HandleTable& handles,
+        const ContourTopology& contours,
+        const ValidationControl& control
+    ) noexcept;
+
+    /**
+     * @brief Find features closer than the minimum spacing
+     * @param entities Lines and arcs (a vector or a snapshot's pages)
+     * @param handles Entity handles by index (shared with the result, not copied)
+     * @param contours Topology built from the same entities
+     * @param control Cancellation, progress, budget, threads and the spacing
+     * @return ValidationResult containing only FeaturesTooClose warnings
+     *
+     * A feature is a contour. Candidates come from ProximitySweep (see
+     * ProximitySweep.h); segments joined at a shared endpoint and segments
+     * that touch are skipped. Two segments of one contour count only as a
+     * narrow neck, where the outline between their close points is longer
+     * than π/2 × spacing; segments a few short segments apart along a
+     * fillet, chamfer or tessellated arc are not. Each pair of features closer than
+     * rules.featureSpacing() (or a single contour with a narrow neck) is
+     * reported once, at its closest pair of segments: entityIndex and
+     * relatedEntityIndex are those segments, location and relatedLocation
+     * the closest points. Issues are in (entityIndex, relatedEntityIndex)
+     * order. Disabled when the spacing is 0.
+     */
+    static ValidationResult checkFeatureSpacing(
+        const SegmentView& entities,
+        const HandleTable& handles,
+        const ContourTopology& contours,
+        const ValidationControl& control
+    ) noexcept;
+
+    // Rule names reported in ValidationProgress and truncatedRules
+    static constexpr const char* RULE_ENTITY_CHECKS = "Entity checks";
+    static constexpr const char* RULE_DUPLICATES = "Duplicate detection";
+    static constexpr const char* RULE_SELF_INTERSECTIONS = "Self-intersection detection";
+    static constexpr const char* RULE_HOLE_SIZE = "Hole size";
+    static constexpr const char* RULE_FEATURE_SPACING = "Feature spacing";
+
 private:
     /**
      * @brief Check if lines are collinear (all endpoints on same infinite line)
@@ -323,5 +716,13 @@ private:
  */
 std::string toString(GeometryIssueType type);
 
+/**
+ * @brief Human-readable description of an issue
+ *
+ * Formatted from the issue's type and numbers when it is shown; results
+ * store no text.
+ */
+std::string describe(const GeometryIssue& issue);
+
 } // namespace Geometry
 } // namespace OwnCAD
@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file IntersectionSweep.h
+ * @brief Sweep over x-extents for self-intersection candidates
+ *
+ * Running the GeometryMath intersection kernels on every pair of segments
+ * is O(n²). The sweep in this file only hands a pair to
+ * GeometryValidator::findIntersection when the bounding boxes of the two
+ * segments overlap, so the reported intersections are identical to the
+ * pairwise scan.
+ */
+
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include "geometry/Point2D.h"
+#include "geometry/GeometryValidator.h"
+#include "geometry/SegmentView.h"
+#include <cstddef>
+#include <vector>
+
+namespace OwnCAD {
+namespace Geometry {
+
+/**
+ * @brief One intersection between two entities
+ *
+ * Indices refer to the caller's entity list; `first` is always the lower
+ * index. Sorting hits gives the (i, j) order of a nested-loop scan.
+ */
+struct IntersectionHit {
+    size_t first;    ///< Lower entity index
+    size_t second;   ///< Higher entity index
+    Point2D point;   ///< Intersection point reported for the pair
+
+    bool operator<(const IntersectionHit& other) const noexcept {
+        if (first != other.first) return first < other.first;
+        return second < other.second;
+    }
+};
+
+/**
+ * @brief Sorted-interval sweep detecting crossing lines and arcs
+ *
+ * Entities are sorted by the left edge of their bounding box. Walking
+ * that order, each entity is compared with the entities that start
+ * before its right edge and overlap it in y; only those pairs reach the
+ * exact kernels (segmentSegmentIntersection, intersectLineArc,
+ * intersectArcArc). Intersections at an endpoint shared by both segments
+ * (contour joints) are not reported; see GeometryValidator::findIntersection.
+ *
+ * Complexity: O(n log n + c + k) where c is the number of pairs that
+ * overlap in x. On nested sheets c stays close to k except for the few
+ * sheet-length edges. findIntersections() splits the sorted order into
+ * chunks that are swept on worker threads.
+ *
+ * Usage:
+ * @code
+ *   IntersectionSweep sweep(tolerance);
+ *   for (size_t i = 0; i < entities.size(); ++i) sweep.insert(i, entities[i]);
+ *   for (const auto& hit : sweep.findIntersections()) { ... }
+ * @endcode
+ *
+ * NOTE: The sweep stores references to the inserted entities. They must
+ * outlive the sweep (it is meant to be built and queried in one pass).
+ */
+class IntersectionSweep {
+public:
+    /**
+     * @brief Create an empty sweep
+     * @param tolerance Comparison tolerance (same as passed to findIntersection)
+     */
+    explicit IntersectionSweep(double tolerance) noexcept;
+
+    /**
+     * @brief Reserve storage for the expected number of entities
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Add a line or arc to the sweep
+     * @param entityIndex Index of the entity in the caller's entity list
+     * @param entity Geometry (must outlive the sweep)
+     *
+     * Entities with invalid coordinates are ignored.
+     */
+    void insert(size_t entityIndex, SegmentRef entity);
+
+    /**
+     * @brief Number of entities in the sweep
+     */
+    size_t size() const noexcept { return entries_.size(); }
+
+    /**
+     * @brief Find all intersecting pairs
+     * @param threadCount Worker threads (0 = hardware concurrency)
+     * @return Hits sorted by (first, second); each pair reported once
+     *
+     * For every pair the result equals
+     * GeometryValidator::findIntersection(lower, higher, tolerance).
+     * The result does not depend on threadCount.
+     *
+     * A set cancellation token is polled every 64 swept
+     * entries; once it is cancelled the sweep stops and the hits are
+     * incomplete (callers discard them).
+     */
+    std::vector<IntersectionHit> findIntersections(size_t threadCount = 1,
+                                                   const CancellationToken* cancellation = nullptr) const;
+
+private:
+    struct Entry {
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+        size_t entityIndex;
+        SegmentRef entity;
+    };
+
+    double tolerance_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace OwnCAD {
+namespace Geometry {
+
+/**
+ * @brief Runs independent chunks of work on a short-lived worker pool
+ *
+ * Used by the validator to spread per-entity checks and duplicate sweeps
+ * across cores. Chunks are handed out dynamically (atomic counter), so
+ * uneven chunks still balance. The calling thread works as well, so a
+ * thread count of 1 runs everything inline without creating threads.
+ *
+ * Determinism is the caller's job: write each chunk's output into its own
+ * slot (indexed by chunk) and merge the slots in chunk order afterwards.
+ *
+ * Usage:
+ * @code
+ *   std::vector<std::vector<Issue>> perChunk(chunkCount);
+ *   ParallelExecutor::forEachChunk(chunkCount, threads,
+ *       [&](size_t chunk, size_t worker) { perChunk[chunk] = check(chunk); });
+ *   // concatenate perChunk in order
+ * @endcode
+ */
+class ParallelExecutor {
+public:
+    /**
+     * @brief Task for one chunk
+     * @param chunk Chunk index in [0, chunkCount)
+     * @param worker Worker index in [0, threadCount) for per-worker scratch buffers
+     */
+    using ChunkTask = std::function<void(size_t chunk, size_t worker)>;
+
+    /**
+     * @brief Resolve a requested thread count
+     * @param requested Requested threads (0 = hardware concurrency)
+     * @return Thread count, at least 1
+     */
+    static size_t resolveThreadCount(size_t requested) noexcept;
+
+    /**
+     * @brief Run task for every chunk, on at most threadCount threads
+     * @param chunkCount Number of chunks
+     * @param threadCount Thread count (0 = hardware concurrency); capped at chunkCount
+     * @param task Task to run (must not throw)
+     * @return Number of threads actually used
+     *
+     * Returns when every chunk has run. If worker threads cannot be
+     * created, the remaining work runs on the threads that exist.
+     */
+    static size_t forEachChunk(size_t chunkCount, size_t threadCount, const ChunkTask& task) noexcept;
+};
+
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file ProximitySweep.h
+ * @brief Sweep over expanded x-extents for segments closer than a spacing
+ *
+ * Measuring the distance between every pair of segments is O(n²). The
+ * sweep in this file widens each bounding box by the spacing and only
+ * measures pairs whose widened boxes overlap; any pair closer than the
+ * spacing is among them.
+ */
+
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include "geometry/Point2D.h"
+#include "geometry/GeometryValidator.h"
+#include "geometry/SegmentView.h"
+#include <cstddef>
+#include <vector>
+
+namespace OwnCAD {
+namespace Geometry {
+
+/**
+ * @brief Two entities closer than the spacing
+ *
+ * Indices refer to the caller's entity list; `first` is always the lower
+ * index. Sorting hits gives the (i, j) order of a nested-loop scan.
+ */
+struct ProximityHit {
+    size_t first;          ///< Lower entity index
+    size_t second;         ///< Higher entity index
+    Point2D firstPoint;    ///< Closest point on the first entity
+    Point2D secondPoint;   ///< Closest point on the second entity
+    double distance;       ///< Minimum distance between the entities
+
+    bool operator<(const ProximityHit& other) const noexcept {
+        if (first != other.first) return first < other.first;
+        return second < other.second;
+    }
+};
+
+/**
+ * @brief Sorted-interval sweep finding lines and arcs closer than a spacing
+ *
+ * Works like IntersectionSweep with boxes widened by the spacing: entities
+ * are sorted by the left edge of the widened box, and each is measured
+ * against the entities that start before its right edge and overlap it
+ * in y, using the exact GeometryMath::closestPoints kernels.
+ *
+ * Two kinds of pairs are not reported:
+ * - Adjacent segments: an endpoint of one snaps to an endpoint of the
+ *   other (within ENDPOINT_SNAP_TOLERANCE). They meet at a joint by design.
+ * - Touching segments (distance within the tolerance): those cross or
+ *   overlap and are reported by the intersection and duplicate checks.
+ *
+ * NOTE: The sweep stores references to the inserted entities. They must
+ * outlive the sweep (it is meant to be built and queried in one pass).
+ */
+class ProximitySweep {
+public:
+    /**
+     * @brief Create an empty sweep
+     * @param spacing Pairs closer than this are reported
+     * @param tolerance Pairs within this distance touch and are skipped
+     */
+    ProximitySweep(double spacing, double tolerance) noexcept;
+
+    /**
+     * @brief Reserve storage for the expected number of entities
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Add a line or arc to the sweep
+     * @param entityIndex Index of the entity in the caller's entity list
+     * @param entity Geometry (must outlive the sweep)
+     *
+     * Entities with invalid coordinates are ignored.
+     */
+    void insert(size_t entityIndex, SegmentRef entity);
+
+    /**
+     * @brief Number of entities in the sweep
+     */
+    size_t size() const noexcept { return entries_.size(); }
+
+    /**
+     * @brief Find all pairs closer than the spacing
+     * @param threadCount Worker threads (0 = hardware concurrency)
+     * @return Hits sorted by (first, second); each pair reported once
+     *
+     * The result does not depend on threadCount.
+     *
+     * A set cancellation token is polled every 64 swept
+     * entries; once it is cancelled the sweep stops and the hits are
+     * incomplete (callers discard them).
+     */
+    std::vector<ProximityHit> findClosePairs(size_t threadCount = 1,
+                                             const CancellationToken* cancellation = nullptr) const;
+
+private:
+    struct Entry {
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+        size_t entityIndex;
+        SegmentRef entity;
+    };
+
+    double spacing_;
+    double tolerance_;
+    std::vector<Entry> entries_;
+};
+
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,239 @@
+#pragma once
+
+/**
+ * @file SegmentView.h
+ * @brief Read-only views of the lines and arcs a validation run checks
+ *
+ * The validator and its kernels index entities through a SegmentView
+ * rather than a std::vector, so a document is checked straight from its
+ * own storage (the pages of a DocumentSnapshot). A ValidationResult looks
+ * handles up through a HandleTable, which can read them from the same
+ * storage. Neither copies geometry or handles.
+ */
+
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace OwnCAD {
+namespace Geometry {
+
+/**
+ * @brief Reference to one line or arc stored elsewhere
+ *
+ * Converts implicitly from a line, an arc or a variant holding one, so a
+ * function taking a SegmentRef accepts the caller's own types. It only
+ * points at the geometry, which must outlive it.
+ */
+class SegmentRef {
+public:
+    SegmentRef() noexcept = default;
+    SegmentRef(const Line2D& line) noexcept : line_(&line) {}
+    SegmentRef(const Arc2D& arc) noexcept : arc_(&arc) {}
+
+    /**
+     * @brief Line or arc held by a variant (empty for any other alternative)
+     */
+    template <typename... Types>
+    SegmentRef(const std::variant<Types...>& entity) noexcept
+        : line_(std::get_if<Line2D>(&entity)), arc_(std::get_if<Arc2D>(&entity)) {}
+
+    const Line2D* line() const noexcept { return line_; }
+    const Arc2D* arc() const noexcept { return arc_; }
+    bool empty() const noexcept { return !line_ && !arc_; }
+
+    /**
+     * @brief Call f with the referenced Line2D or Arc2D (must not be empty)
+     */
+    template <typename F>
+    decltype(auto) visit(F&& f) const {
+        if (line_) {
+            return f(*line_);
+        }
+        return f(*arc_);
+    }
+
+private:
+    const Line2D* line_ = nullptr;
+    const Arc2D* arc_ = nullptr;
+};
+
+/**
+ * @brief Random-access view of lines and arcs, indexed as validation reports them
+ *
+ * A view points either into a vector of segments (converted implicitly,
+ * so every validator entry point still accepts a std::vector) or into
+ * chunks of larger records, such as the pages of a DocumentSnapshot, of
+ * which only some are lines and arcs. Index i is the i-th line or arc in
+ * chunk order.
+ *
+ * A view built from chunks keeps their storage alive through its owner;
+ * a view of a vector does not, and the vector must outlive it. Copies
+ * share the storage (O(1)).
+ *
+ * Access is O(1) into a vector and O(log chunks) into chunks; forEach()
+ * walks a range chunk by chunk.
+ */
+class SegmentView {
+public:
+    using Segment = std::variant<Line2D, Arc2D>;
+
+    /// Reads the line or arc of one stored record
+    using ReadSegment = SegmentRef (*)(const void* record) noexcept;
+
+    /// Reads the handle of one stored record
+    using ReadHandle = const std::string& (*)(const void* record) noexcept;
+
+    /**
+     * @brief Records stored in one contiguous array
+     */
+    struct Chunk {
+        const void* records = nullptr;       ///< First record
+        size_t stride = 0;                   ///< Bytes from one record to the next
+        size_t start = 0;                    ///< View index of the chunk's first segment
+        size_t count = 0;                    ///< Lines and arcs in the chunk
+        const uint32_t* offsets = nullptr;   ///< Record of each of them (null = records [0, count))
+    };
+
+    /**
+     * @brief Empty view
+     */
+    SegmentView() noexcept = default;
+
+    /**
+     * @brief View of a vector of segments (not copied; must outlive the view)
+     */
+    SegmentView(const std::vector<Segment>& segments) noexcept;
+
+    /**
+     * @brief View of chunks of records
+     * @param chunks Chunks in order, starts ascending from 0; stored by owner
+     * @param chunkCount Number of chunks
+     * @param readSegment Reads a record's line or arc
+     * @param readHandle Reads a record's handle (null if records have none)
+     * @param owner Keeps the chunks and their records alive
+     */
+    SegmentView(const Chunk* chunks, size_t chunkCount, ReadSegment readSegment,
+                ReadHandle readHandle, std::shared_ptr<const void> owner) noexcept;
+
+    /**
+     * @brief Number of lines and arcs
+     */
+    size_t size() const noexcept { return size_; }
+
+    /**
+     * @brief Check if the view has no lines or arcs
+     */
+    bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Line or arc at an index (index < size())
+     */
+    SegmentRef operator[](size_t index) const noexcept;
+
+    /**
+     * @brief Check if the records carry handles
+     */
+    bool hasHandles() const noexcept { return readHandle_ != nullptr; }
+
+    /**
+     * @brief Handle of the record at an index (index < size(), hasHandles())
+     */
+    const std::string& handle(size_t index) const noexcept;
+
+    /**
+     * @brief Storage the view keeps alive (null for a view of a vector)
+     */
+    const std::shared_ptr<const void>& owner() const noexcept { return owner_; }
+
+    /**
+     * @brief Call f(index, SegmentRef) for every index in [begin, end), in order
+     */
+    template <typename F>
+    void forEach(size_t begin, size_t end, F&& f) const {
+        end = end < size_ ? end : size_;
+        size_t chunk = begin < end ? chunkIndexOf(begin) : 0;
+        for (size_t index = begin; index < end; ++chunk) {
+            const Chunk& run = chunkAt(chunk);
+            const size_t stop = run.start + run.count < end ? run.start + run.count : end;
+            for (; index < stop; ++index) {
+                f(index, readSegment_(recordOf(run, index - run.start)));
+            }
+        }
+    }
+
+private:
+    const Chunk& chunkAt(size_t chunk) const noexcept { return chunks_ ? chunks_[chunk] : single_; }
+    size_t chunkIndexOf(size_t index) const noexcept;
+
+    static const void* recordOf(const Chunk& chunk, size_t position) noexcept {
+        const size_t record = chunk.offsets ? chunk.offsets[position] : position;
+        return static_cast<const unsigned char*>(chunk.records) + record * chunk.stride;
+    }
+
+    const Chunk* chunks_ = nullptr;   // Null: the one chunk is single_ (a vector)
+    size_t chunkCount_ = 0;
+    Chunk single_;
+    size_t size_ = 0;
+    ReadSegment readSegment_ = nullptr;
+    ReadHandle readHandle_ = nullptr;
+    std::shared_ptr<const void> owner_;
+};
+
+/**
+ * @brief Handles of validated entities by index, shared instead of copied
+ *
+ * Holds its own list, or reads the handles through a SegmentView that
+ * owns its storage (a snapshot's pages). Copies share the storage. An
+ * index past the end has no handle (empty string).
+ */
+class HandleTable {
+public:
+    /**
+     * @brief Empty table
+     */
+    HandleTable() = default;
+
+    /**
+     * @brief Table owning a list of handles
+     */
+    HandleTable(std::vector<std::string> handles);
+
+    /**
+     * @brief Table reading the handles of a view's records
+     * @param entities View with handles and an owner (otherwise the table is empty)
+     */
+    explicit HandleTable(SegmentView entities);
+
+    /**
+     * @brief Number of handles
+     */
+    size_t size() const noexcept;
+
+    /**
+     * @brief Check if the table has no handles
+     */
+    bool empty() const noexcept { return size() == 0; }
+
+    /**
+     * @brief Handle at an index, or an empty string if none is known
+     */
+    const std::string& operator[](size_t index) const noexcept;
+
+    /**
+     * @brief Check if two tables read the same storage
+     */
+    bool sharesStorage(const HandleTable& other) const noexcept;
+
+private:
+    std::shared_ptr<const std::vector<std::string>> list_;
+    SegmentView view_;
+};
+
+} // namespace Geometry
+} // namespace OwnCAD
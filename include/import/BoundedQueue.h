@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace OwnCAD {
+namespace Import {
+
+/**
+ * @brief Blocking FIFO queue with a fixed capacity
+ *
+ * Connects the stages of the import pipeline. A producer blocks while the
+ * queue is full, so a fast stage cannot run ahead of a slow one and pile
+ * up batches in memory. close() ends the stream: producers stop, and
+ * consumers drain what is left and then receive nullopt.
+ *
+ * THREAD SAFETY: Any number of producers and consumers.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : capacity_(capacity > 0 ? capacity : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Append an item, waiting for room
+     * @return false if the queue was closed (the item is dropped)
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Take the oldest item, waiting for one
+     * @return nullopt once the queue is closed and empty
+     */
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        return item;
+    }
+
+    /**
+     * @brief End the stream and wake every waiting thread
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+} // namespace Import
+} // namespace OwnCAD
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "DXFEntity.h"
+#include "DXFTokenizer.h"
 #include <string>
-#include <fstream>
+#include <string_view>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace OwnCAD {
 namespace Import {
@@ -27,6 +30,18 @@ namespace Import {
  * - Group value (string on even line)
  * - Entities in ENTITIES section between "ENDSEC" markers
  *
+ * Binary DXF files are recognized by their sentinel and read by the same
+ * tokenizer (see DXFTokenizer), with numbers decoded from their bytes
+ * instead of parsed from text. Both encodings of a drawing give the same
+ * entities, errors and line numbers.
+ *
+ * Large ENTITIES sections are parsed in parallel: a pre-scan records where
+ * each entity starts, the section is cut into byte ranges at those
+ * boundaries, and the ranges are parsed on worker threads. Per-range
+ * results are merged in file order, so the output (entities, errors, line
+ * numbers) is identical to a single-threaded parse. Sections the pre-scan
+ * cannot read cleanly are parsed on one thread.
+ *
  * Example DXF:
  * ```
  * 0
@@ -45,19 +60,54 @@ namespace Import {
  */
 class DXFParser {
 public:
+    /**
+     * @brief Smallest ENTITIES byte range handed to one worker
+     *
+     * Sections shorter than two ranges are parsed on the calling thread.
+     */
+    static constexpr size_t MIN_CHUNK_BYTES = 256 * 1024;
+
     /**
      * @brief Parse DXF file from path
      * @param filePath Absolute path to DXF file
+     * @param threadCount Threads for the ENTITIES section (0 = hardware concurrency)
      * @return Parse result with entities or errors
      */
-    static DXFParseResult parseFile(const std::string& filePath);
+    static DXFParseResult parseFile(const std::string& filePath, size_t threadCount = 0);
 
     /**
      * @brief Parse DXF content from string
      * @param content DXF file content
+     * @param threadCount Threads for the ENTITIES section (0 = hardware concurrency)
      * @return Parse result with entities or errors
      */
-    static DXFParseResult parseString(const std::string& content);
+    static DXFParseResult parseString(const std::string& content, size_t threadCount = 0);
+
+    /**
+     * @brief Receives parsed entities, in file order
+     */
+    using EntityBatchCallback = std::function<void(std::vector<DXFEntity>&& batch)>;
+
+    /**
+     * @brief Parse DXF file, handing entities over in batches as they are read
+     * @param filePath Absolute path to DXF file
+     * @param onBatch Called on the calling thread with up to batchSize entities at a time
+     * @param batchSize Entities per batch (at least 1)
+     * @return Parse result with errors and counts; its entity list is empty
+     *
+     * The ENTITIES section is read on the calling thread, so later stages
+     * can work on earlier batches while parsing continues.
+     */
+    static DXFParseResult parseFile(const std::string& filePath,
+                                    const EntityBatchCallback& onBatch,
+                                    size_t batchSize);
+
+    /**
+     * @brief Parse DXF content from string, handing entities over in batches
+     */
+    static DXFParseResult parseString(const std::string& content,
+                                      const EntityBatchCallback& onBatch,
+                                      size_t batchSize);
 
 private:
     /**
@@ -65,11 +115,11 @@ private:
      */
     struct GroupPair {
         int code;
-        std::string value;
+        DXFValue value;   // View into the tokenized text
         bool valid;
 
         GroupPair() : code(0), valid(false) {}
-        GroupPair(int c, const std::string& v) : code(c), value(v), valid(true) {}
+        GroupPair(int c, const DXFValue& v) : code(c), value(v), valid(true) {}
     };
 
     /**
@@ -81,90 +131,140 @@ private:
         bool inEntitiesSection;
         DXFParseResult result;
         GroupPair lookahead;  // Lookahead group for entity parsing
+        const EntityBatchCallback* onBatch;  // Streams result.entities when set
+        size_t batchSize;
 
         ParserState()
             : lineNumber(0)
-            , inEntitiesSection(false) {}
+            , inEntitiesSection(false)
+            , onBatch(nullptr)
+            , batchSize(0) {}
     };
 
     /**
-     * @brief Parse DXF from input stream
+     * @brief Entity start found by the pre-scan
      */
-    static DXFParseResult parse(std::istream& input);
+    struct EntityStart {
+        size_t position;     // Byte offset of the entity's "0" group
+        size_t lineNumber;   // Lines before that offset
+    };
+
+    /**
+     * @brief Parse the whole DXF text
+     * @param onBatch Receives the entities in batches if not null
+     */
+    static DXFParseResult parse(std::string_view text, size_t threadCount,
+                                const EntityBatchCallback* onBatch = nullptr,
+                                size_t batchSize = 0);
+
+    /**
+     * @brief Parse the rest of an ENTITIES section on worker threads
+     * @return false if the section was left to the sequential loop
+     *
+     * On success the entities are in state.result and the tokenizer is
+     * positioned at the group that ends the section.
+     */
+    static bool parseEntitiesParallel(
+        std::string_view text,
+        DXFTokenizer& tokenizer,
+        ParserState& state,
+        size_t threadCount
+    );
+
+    /**
+     * @brief Find entity starts up to the group that ends the section
+     * @param sectionEnd Receives the byte offset and line of that group
+     * @return false if the section has no end marker or a malformed group
+     */
+    static bool scanEntities(
+        DXFTokenizer& tokenizer,
+        std::vector<EntityStart>& starts,
+        EntityStart& sectionEnd
+    );
+
+    /**
+     * @brief Parse every entity up to the end of the tokenizer's text
+     */
+    static void parseEntityRange(DXFTokenizer& tokenizer, ParserState& state);
+
+    /**
+     * @brief Parse one entity and count it in state.result
+     */
+    static void addEntity(DXFTokenizer& tokenizer, std::string_view entityType, ParserState& state);
+
+    /**
+     * @brief Hand state.result.entities to the batch callback
+     */
+    static void flushEntities(ParserState& state);
 
     /**
      * @brief Read group code and value pair
      */
-    static bool readGroup(std::istream& input, int& code, std::string& value, size_t& lineNumber);
+    static bool readGroup(DXFTokenizer& tokenizer, int& code, DXFValue& value, size_t& lineNumber);
 
     /**
      * @brief Parse single entity starting at current position
      */
     static std::optional<DXFEntity> parseEntity(
-        std::istream& input,
-        const std::string& entityType,
+        DXFTokenizer& tokenizer,
+        std::string_view entityType,
         ParserState& state
     );
 
     /**
      * @brief Parse LINE entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseLine(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseLine(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse ARC entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseArc(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseArc(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse CIRCLE entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseCircle(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseCircle(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse LWPOLYLINE entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseLWPolyline(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseLWPolyline(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse ELLIPSE entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseEllipse(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseEllipse(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse SPLINE entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseSpline(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseSpline(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse POINT entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parsePoint(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parsePoint(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Parse SOLID entity (uses lookahead from state)
      */
-    static std::optional<DXFEntity> parseSolid(std::istream& input, ParserState& state);
+    static std::optional<DXFEntity> parseSolid(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
      * @brief Skip unsupported entity
      */
-    static void skipEntity(std::istream& input, ParserState& state);
-
-    /**
-     * @brief Safe string to double conversion
-     */
-    static bool stringToDouble(const std::string& str, double& result);
+    static void skipEntity(DXFTokenizer& tokenizer, ParserState& state);
 
     /**
-     * @brief Safe string to int conversion
+     * @brief Safe value to double conversion (text is parsed, binary numbers are taken as read)
      */
-    static bool stringToInt(const std::string& str, int& result);
+    static bool stringToDouble(const DXFValue& value, double& result);
 
     /**
-     * @brief Trim whitespace from string
+     * @brief Safe value to int conversion
      */
-    static std::string trim(const std::string& str);
+    static bool stringToInt(const DXFValue& value, int& result);
 
     /**
      * @brief Validate numeric value is finite
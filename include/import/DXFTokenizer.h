@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace OwnCAD {
+namespace Import {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Maps the file with mmap (POSIX) or MapViewOfFile (Windows) so the
+ * tokenizer reads the page cache directly, without copying through a
+ * stream buffer. Empty files map to an empty view. Move-only; the
+ * mapping is released with the object.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Map a file
+     * @param filePath Path to the file
+     * @return The mapping, or nullopt if the file cannot be opened or mapped
+     */
+    static std::optional<MappedFile> open(const std::string& filePath);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    std::string_view data() const noexcept { return std::string_view(data_, size_); }
+    size_t size() const noexcept { return size_; }
+
+private:
+    MappedFile() = default;
+    void release() noexcept;
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    void* mapping_ = nullptr;   // HANDLE of the file mapping object
+#endif
+};
+
+/**
+ * @brief Storage type of a group value in binary DXF, by group code
+ */
+enum class DXFValueType : uint8_t {
+    String,     ///< Zero-terminated text
+    Double,     ///< 8-byte IEEE double
+    Int16,
+    Int32,
+    Int64,
+    Bool,       ///< One byte
+    Binary,     ///< Length byte followed by that many bytes
+    Unknown     ///< Code with no defined type
+};
+
+/**
+ * @brief Value of one group
+ *
+ * Text DXF values and binary DXF strings are views into the tokenized
+ * buffer. Binary DXF numbers arrive decoded, with an empty text.
+ */
+struct DXFValue {
+    enum class Kind : uint8_t { Text, Real, Integer };
+
+    std::string_view text;      ///< Trimmed text (Kind::Text)
+    double real = 0.0;          ///< Decoded double (Kind::Real)
+    int64_t integer = 0;        ///< Decoded integer or bool (Kind::Integer)
+    Kind kind = Kind::Text;
+
+    DXFValue() = default;
+    DXFValue(std::string_view value) noexcept : text(value) {}
+
+    operator std::string_view() const noexcept { return text; }
+    bool operator==(std::string_view other) const noexcept { return kind == Kind::Text && text == other; }
+    bool operator!=(std::string_view other) const noexcept { return !(*this == other); }
+
+    /**
+     * @brief Get the value as a double (text is parsed, integers widen)
+     */
+    bool toDouble(double& result) const noexcept;
+
+    /**
+     * @brief Get the value as an int (text is parsed; doubles and out-of-range integers fail)
+     */
+    bool toInt(int& result) const noexcept;
+};
+
+/**
+ * @brief Splits DXF text into (group code, value) pairs without copying
+ *
+ * Values are views into the buffer passed in, trimmed of surrounding
+ * whitespace; they stay valid as long as the buffer does. Lines may end
+ * in LF or CRLF, and a UTF-8 byte order mark at the start is skipped.
+ * Group codes and numbers are parsed with std::from_chars: no
+ * allocation, no exceptions and no dependence on the C locale.
+ *
+ * A buffer starting with BINARY_SENTINEL is read as binary DXF: little-
+ * endian group codes (two bytes; one byte in R12 files) followed by values
+ * stored as valueType() gives for the code. Numbers are decoded straight
+ * from their bytes. Line numbers count two per group, as in the same
+ * drawing written as text.
+ *
+ * THREAD SAFETY: One tokenizer per thread; the buffer may be shared.
+ */
+class DXFTokenizer {
+public:
+    /// First bytes of a binary DXF file
+    static constexpr std::string_view BINARY_SENTINEL{"AutoCAD Binary DXF\r\n\x1a", 22};
+
+    explicit DXFTokenizer(std::string_view text) noexcept;
+
+    /**
+     * @brief Read the next group
+     * @param code Group code
+     * @param value Trimmed value (view into the buffer) or decoded number
+     * @return false at the end of the text or if the group is malformed
+     */
+    bool next(int& code, DXFValue& value) noexcept;
+
+    /**
+     * @brief Whether the buffer is binary DXF
+     */
+    bool isBinary() const noexcept { return binary_; }
+
+    /**
+     * @brief Lines consumed so far (1-based number of the last line read)
+     */
+    size_t lineNumber() const noexcept { return lineNumber_; }
+
+    /**
+     * @brief Byte offset of the next unread line (binary: group)
+     */
+    size_t position() const noexcept { return position_; }
+
+    /**
+     * @brief Continue reading from another line of the same text
+     * @param position Byte offset of a line start (from position())
+     * @param lineNumber Lines before that offset (from lineNumber())
+     */
+    void seek(size_t position, size_t lineNumber) noexcept {
+        position_ = position;
+        lineNumber_ = lineNumber;
+    }
+
+    /**
+     * @brief Parse a whole value as a double (leading '+' allowed)
+     */
+    static bool parseDouble(std::string_view text, double& result) noexcept;
+
+    /**
+     * @brief Parse a whole value as an int (leading '+' allowed)
+     */
+    static bool parseInt(std::string_view text, int& result) noexcept;
+
+    /**
+     * @brief Strip leading and trailing whitespace
+     */
+    static std::string_view trim(std::string_view text) noexcept;
+
+    /**
+     * @brief Storage type of a group code's value in binary DXF
+     */
+    static DXFValueType valueType(int code) noexcept;
+
+private:
+    bool nextLine(std::string_view& line) noexcept;
+    bool nextBinary(int& code, DXFValue& value) noexcept;
+
+    std::string_view text_;
+    size_t position_ = 0;
+    size_t lineNumber_ = 0;
+    bool binary_ = false;
+    bool shortCodes_ = false;   // R12 binary: one-byte group codes
+};
+
+} // namespace Import
+} // namespace OwnCAD
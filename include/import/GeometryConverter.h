@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DXFEntity.h"
+#include "import/ImportDiagnostics.h"
 #include "geometry/Line2D.h"
 #include "geometry/Arc2D.h"
 #include "geometry/Ellipse2D.h"
@@ -60,7 +61,8 @@ struct ConversionResult {
  * - DXF Z-coordinates are ignored (2D projection)
  * - DXF angles (degrees) converted to radians
  * - DXF circles converted to full arcs (0° to 360°)
- * - Invalid geometry is rejected and logged (not silently fixed)
+ * - Invalid geometry is rejected and logged (not silently fixed); every
+ *   outcome is reported to an optional ImportDiagnostics sink
  * - Layer and handle metadata preserved for traceability
  *
  * Validation during conversion:
@@ -77,9 +79,13 @@ public:
     /**
      * @brief Convert DXF entities to internal geometry model
      * @param dxfEntities DXF entities from parser
+     * @param diagnostics Receives per-entity outcome counts and, if it
+     *        asks for them, messages (null = none); may be shared by
+     *        concurrent conversions
      * @return Conversion result with validated geometry or errors
      */
-    static ConversionResult convert(const std::vector<DXFEntity>& dxfEntities);
+    static ConversionResult convert(const std::vector<DXFEntity>& dxfEntities,
+                                    ImportDiagnostics* diagnostics = nullptr);
 
     /**
      * @brief Convert single DXF LINE to Line2D
@@ -161,6 +167,11 @@ private:
      */
     static bool validateCoordinates(double x, double y);
 
+    /**
+     * @brief Summarize polyline segments for a diagnostic ("3 segments (2 lines, 1 arcs)")
+     */
+    static std::string describeSegments(const std::vector<GeometryEntity>& segments);
+
     /**
      * @brief Create error message with context
      */
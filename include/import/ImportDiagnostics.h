@@ -0,0 +1,152 @@
+#pragma once
+
+#include "import/DXFEntity.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OwnCAD {
+namespace Import {
+
+/**
+ * @brief Importance of an import diagnostic
+ */
+enum class DiagnosticSeverity : uint8_t {
+    Debug,      ///< Entity details (type, coordinates, segment counts)
+    Info,       ///< Entity accepted
+    Warning,    ///< Entity accepted with a caveat
+    Error       ///< Entity rejected
+};
+
+/**
+ * @brief Get the lowercase name of a severity ("debug", "info", ...)
+ */
+const char* toString(DiagnosticSeverity severity) noexcept;
+
+/**
+ * @brief One stored diagnostic
+ */
+struct DiagnosticMessage {
+    DiagnosticSeverity severity;
+    DXFEntityType category;     ///< Entity type the message is about
+    size_t lineNumber;          ///< Line of the entity in the DXF file
+    std::string text;
+};
+
+/**
+ * @brief Settings for an ImportDiagnostics sink
+ *
+ * The defaults keep counters only: no message text is formatted, stored
+ * or written.
+ */
+struct DiagnosticOptions {
+    DiagnosticSeverity level = DiagnosticSeverity::Info;   ///< Least severe message kept
+    size_t maxMessages = 0;        ///< Messages stored in memory; the rest are dropped
+    std::string jsonLinesPath;     ///< Also write every kept message here (empty = no file)
+};
+
+/**
+ * @brief Collects what happened while converting DXF entities
+ *
+ * Replaces per-entity console output, which dominated the import of large
+ * files. Every outcome is counted per entity type and severity. Message
+ * text is only built when wants() is true for its severity, that is when
+ * messages are stored or written to a JSON-lines file, so the default sink
+ * costs nothing per entity.
+ *
+ * Each JSON line is an object with "severity", "category", "line" and
+ * "message" fields.
+ *
+ * THREAD SAFETY: Converter threads may report and merge concurrently.
+ * Messages from different batches interleave; their line numbers place
+ * them in the file.
+ */
+class ImportDiagnostics {
+public:
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(DXFEntityType::Unknown) + 1;
+    static constexpr size_t SEVERITY_COUNT = static_cast<size_t>(DiagnosticSeverity::Error) + 1;
+
+    /**
+     * @brief Counts per entity type and severity, kept locally by a converter
+     */
+    struct Counters {
+        std::array<std::array<size_t, SEVERITY_COUNT>, CATEGORY_COUNT> counts{};
+
+        void add(DXFEntityType category, DiagnosticSeverity severity) noexcept {
+            counts[static_cast<size_t>(category)][static_cast<size_t>(severity)]++;
+        }
+    };
+
+    ImportDiagnostics();
+
+    /**
+     * @brief Create a sink; opens options.jsonLinesPath, if set, for writing
+     */
+    explicit ImportDiagnostics(const DiagnosticOptions& options);
+
+    ImportDiagnostics(const ImportDiagnostics&) = delete;
+    ImportDiagnostics& operator=(const ImportDiagnostics&) = delete;
+
+    /**
+     * @brief Whether a message of this severity would be kept
+     *
+     * Check before formatting message text.
+     */
+    bool wants(DiagnosticSeverity severity) const noexcept {
+        return keepsMessages_ && severity >= options_.level;
+    }
+
+    /**
+     * @brief Keep a message (counted separately, through merge())
+     */
+    void report(DiagnosticSeverity severity, DXFEntityType category,
+                size_t lineNumber, std::string text);
+
+    /**
+     * @brief Add a converter's counts to the totals
+     */
+    void merge(const Counters& counters);
+
+    /**
+     * @brief Number of outcomes for an entity type and severity
+     */
+    size_t count(DXFEntityType category, DiagnosticSeverity severity) const;
+
+    /**
+     * @brief Number of outcomes of a severity over all entity types
+     */
+    size_t total(DiagnosticSeverity severity) const;
+
+    /**
+     * @brief Stored messages, at most options.maxMessages
+     */
+    std::vector<DiagnosticMessage> messages() const;
+
+    /**
+     * @brief Kept messages that did not fit in memory
+     */
+    size_t droppedMessages() const;
+
+    /**
+     * @brief Whether the JSON-lines file is open and healthy
+     */
+    bool fileOk() const;
+
+    const DiagnosticOptions& options() const noexcept { return options_; }
+
+private:
+    const DiagnosticOptions options_;
+    mutable std::mutex mutex_;
+    Counters totals_;
+    std::vector<DiagnosticMessage> messages_;
+    size_t dropped_ = 0;
+    std::ofstream file_;
+    bool keepsMessages_;
+};
+
+} // namespace Import
+} // namespace OwnCAD
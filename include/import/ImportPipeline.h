@@ -0,0 +1,106 @@
+#pragma once
+
+#include "import/DXFParser.h"
+#include "import/GeometryConverter.h"
+#include "geometry/GeometryConstants.h"
+#include "geometry/GeometryValidator.h"
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OwnCAD {
+namespace Import {
+
+/**
+ * @brief Settings for a streaming import
+ */
+struct ImportOptions {
+    size_t batchSize = 1024;       ///< DXF entities per batch
+    size_t queueDepth = 4;         ///< Batches buffered between two stages
+    size_t threadCount = 0;        ///< Converter threads (0 = hardware concurrency)
+
+    /// Run the per-entity rules on the converted lines and arcs
+    /// (skipped while rules.minCornerAngle is set: corners need every contour)
+    bool checkEntities = false;
+    double tolerance = Geometry::GEOMETRY_EPSILON;
+    Geometry::ManufacturingRules rules;
+
+    /// Receives the converters' per-entity outcomes (null = not collected)
+    ImportDiagnostics* diagnostics = nullptr;
+};
+
+/**
+ * @brief Outcome of a streaming import
+ *
+ * The entities themselves went to the batch callback; both results carry
+ * the errors, warnings and counts only.
+ */
+struct ImportResult {
+    DXFParseResult parse;
+    ConversionResult conversion;
+
+    /// Per-entity issues of the imported lines and arcs, indexed as the
+    /// validator indexes them (null unless checked); see
+    /// Geometry::ValidationControl::entityIssues
+    std::shared_ptr<const std::vector<Geometry::GeometryIssue>> entityIssues;
+
+    size_t batches = 0;             ///< Batches that went through every stage
+    size_t peakBatchesInFlight = 0; ///< Most batches between parser and callback at once
+};
+
+/**
+ * @brief Parse → convert → check import with overlapping stages
+ *
+ * Reading a file in one go holds the whole DXFParseResult, then the whole
+ * ConversionResult, then the document's copy. The pipeline instead passes
+ * batches through three stages connected by BoundedQueues:
+ *
+ * 1. Parse: DXFParser reads the file on its own thread and emits batches.
+ * 2. Convert: worker threads run GeometryConverter on batches as they come.
+ * 3. Check: the calling thread puts batches back in file order, runs the
+ *    per-entity rules (EntityRuleKernel) on them and hands the entities to
+ *    the callback, which stores them.
+ *
+ * Converted batches run at most queueDepth ahead of the next one in file
+ * order, so only a few batches exist between the parser and the callback:
+ * memory holds roughly one copy of the geometry, and wall time approaches
+ * that of the slowest stage. Output, errors and counts are the same as
+ * DXFParser::parseFile followed by GeometryConverter::convert. If threads
+ * cannot be started, the stages run one batch at a time on the calling
+ * thread.
+ */
+class ImportPipeline {
+public:
+    /**
+     * @brief Receives converted entities in file order, on the calling thread
+     */
+    using EntityCallback = std::function<void(std::vector<GeometryEntityWithMetadata>&& batch)>;
+
+    /**
+     * @brief Import a DXF file
+     * @param filePath Path to DXF file
+     * @param options Batch size, queue depth, threads and entity rules
+     * @param onEntities Stores each converted batch
+     */
+    static ImportResult importFile(const std::string& filePath,
+                                   const ImportOptions& options,
+                                   const EntityCallback& onEntities);
+
+    /**
+     * @brief Import DXF content from a string
+     */
+    static ImportResult importString(const std::string& content,
+                                     const ImportOptions& options,
+                                     const EntityCallback& onEntities);
+
+private:
+    using ParseFunction = std::function<DXFParseResult(const DXFParser::EntityBatchCallback&, size_t)>;
+
+    static ImportResult run(const ParseFunction& parse,
+                            const ImportOptions& options,
+                            const EntityCallback& onEntities);
+};
+
+} // namespace Import
+} // namespace OwnCAD
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OwnCAD {
+namespace Model {
+
+/**
+ * @brief 128-bit digest of document content
+ */
+struct ContentHash {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    /**
+     * @brief 32 lowercase hex digits, high word first
+     */
+    std::string toHex() const;
+
+    bool operator==(const ContentHash& other) const noexcept {
+        return high == other.high && low == other.low;
+    }
+    bool operator!=(const ContentHash& other) const noexcept { return !(*this == other); }
+};
+
+/**
+ * @brief Streaming 128-bit hash over words, doubles and strings
+ *
+ * MurmurHash3 x64_128 block and finalization steps, fed with 64-bit words
+ * instead of raw memory. Doubles are hashed by bit pattern (with -0.0
+ * folded into 0.0) and strings by length and bytes packed in a fixed
+ * order, so a digest is the same on every platform and across sessions.
+ * Not cryptographic: it identifies content, it does not authenticate it.
+ */
+class ContentHasher {
+public:
+    explicit ContentHasher(uint64_t seed = 0) noexcept;
+
+    void addWord(uint64_t word) noexcept;
+    void addDouble(double value) noexcept;
+    void addString(const std::string& text) noexcept;
+    void addBytes(const char* data, size_t size) noexcept;
+
+    /**
+     * @brief Digest of everything added so far (the hasher stays usable)
+     */
+    ContentHash finish() const noexcept;
+
+private:
+    void mixBlock(uint64_t k1, uint64_t k2) noexcept;
+
+    uint64_t h1_;
+    uint64_t h2_;
+    uint64_t pending_ = 0;       // First word of an incomplete block
+    bool hasPending_ = false;
+    uint64_t wordCount_ = 0;
+};
+
+} // namespace Model
+} // namespace OwnCAD
@@ -1,18 +1,29 @@
 #pragma once
 
 #include "import/GeometryConverter.h"
+#include "export/DXFWriter.h"
 #include "geometry/GeometryValidator.h"
+#include "model/SpatialIndex.h"
+#include "model/DocumentSnapshot.h"
+#include "model/IncrementalValidation.h"
+#include "model/ContentHash.h"
 #include <vector>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <optional>
 #include <memory>
 #include <future>
 #include <atomic>
 #include <functional>
 #include <mutex>
+#include <cstdint>
 
 namespace OwnCAD {
 namespace Model {
 
+class ValidationCache;
+
 /**
  * @brief Statistics about loaded document
  */
@@ -37,6 +48,55 @@ struct DocumentStatistics {
     size_t totalEntities() const { return dxfEntitiesImported; }
 };
 
+/**
+ * @brief Stable reference to an entity storage slot
+ *
+ * Generational slot-map key: the generation changes whenever a slot is
+ * recycled, so a stale id never resolves to a different entity.
+ */
+struct EntityId {
+    uint32_t slot = 0;
+    uint32_t generation = 0;  // 0 = invalid
+
+    bool isValid() const noexcept { return generation != 0; }
+
+    bool operator==(const EntityId& other) const noexcept {
+        return slot == other.slot && generation == other.generation;
+    }
+};
+
+/**
+ * @brief Document order keys handed out between two renumberings
+ *
+ * Renumbering re-spaces every order key. If removal records still hold keys
+ * of the current epoch, it closes the epoch with the keys as they were, so
+ * a saved key can be carried into the next epoch.
+ */
+struct OrderEpoch {
+    std::vector<uint64_t> keys;         // Keys in document order when closed
+    std::shared_ptr<OrderEpoch> next;   // Set when closed
+};
+
+/**
+ * @brief Entity removed from the document, with what undo needs to put it back
+ */
+struct RemovedEntity {
+    Import::GeometryEntityWithMetadata entity;
+    EntityId id;                 // Slot the entity occupied (tombstoned on removal)
+    uint64_t documentOrder = 0;  // Position key in document order
+    std::shared_ptr<const OrderEpoch> orderEpoch;  // Epoch documentOrder belongs to
+};
+
+/**
+ * @brief Per-item outcome of a batch mutation
+ */
+struct BatchResult {
+    std::vector<bool> succeeded;  // Parallel to the input items
+    size_t successCount = 0;
+
+    bool allSucceeded() const noexcept { return successCount == succeeded.size(); }
+};
+
 /**
  * @brief Document model - holds all geometry and validation state
  *
@@ -50,7 +110,23 @@ struct DocumentStatistics {
  * - Single source of truth for all geometry
  * - Validation is always up-to-date
  * - Immutable after import (edits create new geometry)
- * - Thread-safe read access
+ * - Main thread only: other threads read a DocumentSnapshot
+ *
+ * Storage:
+ * Entities live in a generational slot map. Document (draw/export) order
+ * is kept separately as a list of slots sorted by an order key, so removal
+ * and undo-restore are O(1) instead of shifting every later entity.
+ * Removed entities leave a tombstone in the order list; restoring one
+ * revives it in place. Tombstones are compacted once they outnumber live
+ * entities, after which restores fall back to the saved order key.
+ *
+ * The records themselves live only in pages: page k holds the live
+ * entities of order-list positions [k * PAGE_SIZE, (k+1) * PAGE_SIZE), and
+ * a slot keeps its offset within the page. Readers get the entities as a
+ * DocumentSnapshot sharing these pages. An edit writes to its page in
+ * place, copying the page first if a snapshot still holds it; removals and
+ * restores rebuild the pages they touched once, at the end of the call.
+ * Snapshots are cheap to copy and safe to read from other threads.
  */
 class DocumentModel {
 public:
@@ -60,9 +136,22 @@ public:
     /**
      * @brief Load DXF file and validate geometry
      * @param filePath Path to DXF file
+     * @param validate false to skip the synchronous validation pass
+     *        (caller validates in the background, e.g. via ValidationScheduler)
      * @return true if loaded successfully (may have validation warnings)
+     *
+     * With a validation cache set, a result stored for the same content
+     * is applied instead of validating (isValidationFromCache() is then
+     * true). It is not an incremental baseline, so the next scheduled run
+     * is a full validation that confirms it.
+     *
+     * The file is read through Import::ImportPipeline: parsing,
+     * conversion and the per-entity rules overlap, and converted batches
+     * go straight into storage. The per-entity issues are kept for the
+     * first full validation of the unedited document, which then skips
+     * its entity checks.
      */
-    bool loadDXFFile(const std::string& filePath);
+    bool loadDXFFile(const std::string& filePath, bool validate = true);
 
     /**
      * @brief Clear all geometry
@@ -72,14 +161,36 @@ public:
     /**
      * @brief Check if document has geometry loaded
      */
-    bool isEmpty() const noexcept { return entities_.empty(); }
+    bool isEmpty() const noexcept { return liveCount_ == 0; }
 
     /**
-     * @brief Get all entities
+     * @brief Get all entities in document order
+     *
+     * Same as snapshot(); kept for existing callers.
      */
-    const std::vector<Import::GeometryEntityWithMetadata>& entities() const noexcept {
-        return entities_;
-    }
+    DocumentSnapshot entities() const { return snapshot(); }
+
+    /**
+     * @brief Contours of the current document (cached per version)
+     *
+     * Same as snapshot().contours(): rebuilt only after the document changed.
+     */
+    std::shared_ptr<const Geometry::ContourTopology> contours() const { return snapshot().contours(); }
+
+    /**
+     * @brief Immutable snapshot of all entities in document order (Main Thread Only)
+     *
+     * Shares the document's pages, so it costs one pointer per page and is
+     * O(1) when nothing changed since the last call. Not thread-safe: it
+     * caches the snapshot it returns. The returned snapshot may be handed
+     * to other threads and stays valid while the document is edited.
+     */
+    DocumentSnapshot snapshot() const;
+
+    /**
+     * @brief Document version, incremented by every change to the entities
+     */
+    uint64_t version() const noexcept { return version_; }
 
     /**
      * @brief Get validation result
@@ -116,6 +227,16 @@ public:
         return importWarnings_;
     }
 
+    /**
+     * @brief Get per-entity conversion outcomes of the last load
+     *
+     * Counts per entity type and severity; messages only as asked for by
+     * setImportDiagnosticOptions().
+     */
+    const Import::ImportDiagnostics& importDiagnostics() const noexcept {
+        return *importDiagnostics_;
+    }
+
     /**
      * @brief Check if document is valid (no critical errors)
      */
@@ -128,6 +249,37 @@ public:
      */
     std::vector<std::string> getLayers() const;
 
+    // =========================================================================
+    // SPATIAL QUERIES
+    // =========================================================================
+
+    /**
+     * @brief Spatial index of entity bounding boxes
+     *
+     * Kept up to date by every add/update/remove/restore, so window,
+     * radius and nearest-k queries never scan the entity list. Entry keys
+     * are entity slots (EntityId::slot).
+     */
+    const SpatialIndex& spatialIndex() const noexcept {
+        return spatialIndex_;
+    }
+
+    /**
+     * @brief Positions in entities() of the entities whose bounding box touches a window
+     * @return Ascending positions, one per entity hit (segments of a
+     *         polyline are reported separately)
+     *
+     * O(hits log hits); main thread only, like snapshot().
+     */
+    std::vector<size_t> queryWindowIndices(const Geometry::BoundingBox& window) const;
+
+    /**
+     * @brief Bounding box of all entities (invalid box if empty)
+     */
+    Geometry::BoundingBox bounds() const noexcept {
+        return spatialIndex_.bounds();
+    }
+
     // =========================================================================
     // ENTITY CREATION (for drawing tools)
     // =========================================================================
@@ -162,17 +314,35 @@ public:
      * @brief Find entity by handle
      * @param handle Entity handle string
      * @return Pointer to entity, nullptr if not found
+     *
+     * O(1) via the handle index. If several entities share the handle
+     * (decomposed polylines), the first one in document order is returned.
+     * The pointer refers to page storage and is valid until the next edit;
+     * modify geometry through updateEntity() so the spatial index and
+     * snapshots stay in sync.
      */
-    Import::GeometryEntityWithMetadata* findEntityByHandle(const std::string& handle);
     const Import::GeometryEntityWithMetadata* findEntityByHandle(const std::string& handle) const;
 
     /**
      * @brief Get index of entity by handle
      * @param handle Entity handle string
-     * @return Index in entities_ vector, or std::nullopt if not found
+     * @return Index in entities(), or std::nullopt if not found
      */
     std::optional<size_t> findEntityIndexByHandle(const std::string& handle) const;
 
+    /**
+     * @brief Get stable slot id of entity by handle
+     * @param handle Entity handle string
+     * @return Id of the first entity with this handle, or std::nullopt
+     */
+    std::optional<EntityId> findEntityId(const std::string& handle) const;
+
+    /**
+     * @brief Resolve a stable id
+     * @return Entity, or nullptr if removed or the id is stale
+     */
+    const Import::GeometryEntityWithMetadata* findEntity(EntityId id) const;
+
     /**
      * @brief Update entity geometry (preserves metadata)
      * @param handle Entity handle
@@ -188,6 +358,27 @@ public:
      */
     bool removeEntity(const std::string& handle);
 
+    /**
+     * @brief Remove entity and return it with its place in document order
+     * @param handle Entity handle
+     * @return Removed entity for restoreEntity(const RemovedEntity&),
+     *         std::nullopt if not found
+     *
+     * O(1): the entity's slot becomes a tombstone in the order list.
+     */
+    std::optional<RemovedEntity> extractEntity(const std::string& handle);
+
+    /**
+     * @brief Put back an entity returned by extractEntity (for undo support)
+     * @param removed Entity, slot id and document order saved at removal
+     * @return true if restored, false if the entity is already present
+     *
+     * Revives the tombstone in place when it still exists (O(1)); otherwise
+     * re-inserts at the saved order key. Either way the original document
+     * order is restored, independent of the order in which entities come back.
+     */
+    bool restoreEntity(const RemovedEntity& removed);
+
     /**
      * @brief Restore a previously removed entity (for undo support)
      * @param entity Complete entity with metadata (handle, layer, color, etc.)
@@ -204,6 +395,9 @@ public:
      * @param entity Complete entity with metadata
      * @param index Original index in the entities vector
      * @return true if restored successfully
+     *
+     * Needs a current snapshot to resolve the index; prefer
+     * extractEntity/restoreEntity(const RemovedEntity&) for undo.
      */
     bool restoreEntityAtIndex(const Import::GeometryEntityWithMetadata& entity, size_t index);
 
@@ -223,14 +417,216 @@ public:
      */
     std::string addPoint(const Geometry::Point2D& point, const std::string& layer = "0");
 
+    // =========================================================================
+    // BATCH MUTATION
+    // =========================================================================
+    //
+    // One pass over the input: storage and lookup tables are reserved once,
+    // and statistics are applied once.
+    // Items are processed independently; failures do not stop the batch.
+
+    /**
+     * @brief Add many entities to the document
+     * @param entities Geometry to add (same validity rules as addLine/addArc/...)
+     * @param layer Target layer for all entities
+     * @return Generated handles, parallel to entities; empty for rejected items
+     */
+    std::vector<std::string> addEntities(const std::vector<Import::GeometryEntity>& entities,
+                                         const std::string& layer = "0");
+
+    /**
+     * @brief Add many entities, each on its own layer
+     * @param entities Geometry to add
+     * @param layers Target layer per entity (parallel to entities)
+     * @return Generated handles, parallel to entities; empty for rejected items
+     */
+    std::vector<std::string> addEntities(const std::vector<Import::GeometryEntity>& entities,
+                                         const std::vector<std::string>& layers);
+
+    /**
+     * @brief Remove every entity carrying each handle
+     * @param handles Handles to remove (decomposed polylines remove all segments)
+     * @param removed Optional output: removed entities, for restoreEntities()
+     * @return Per-handle status; false if no entity had the handle
+     */
+    BatchResult removeEntities(const std::vector<std::string>& handles,
+                               std::vector<RemovedEntity>* removed = nullptr);
+
+    /**
+     * @brief Put back entities returned by removeEntities/extractEntity
+     * @param removed Entities with their saved document order
+     * @return Per-item status; false if the entity is already present
+     */
+    BatchResult restoreEntities(const std::vector<RemovedEntity>& removed);
+
+    /**
+     * @brief Replace the geometry of many entities (preserves metadata)
+     * @param handles Entities to update (first entity per handle, as updateEntity)
+     * @param geometries New geometry, parallel to handles
+     * @return Per-handle status; false if handle not found or no geometry given
+     */
+    BatchResult updateEntities(const std::vector<std::string>& handles,
+                               const std::vector<Import::GeometryEntity>& geometries);
+
     /**
      * @brief Run validation asynchronously (non-blocking)
      *
      * Spawns a background task to validate all entities.
      * When complete, updates validationResult and calls the completion callback.
+     * Does nothing while a run is in progress; edit-driven validation should
+     * go through ValidationScheduler, which coalesces requests instead.
      */
     void runValidationAsync();
 
+    /**
+     * @brief Validate the entities of a snapshot
+     * @param entities Snapshot to validate
+     * @param control Cancellation token, progress callback and rule budget
+     * @return Validation result (not applied to any document)
+     *
+     * Touches only the snapshot, so it may run on any thread.
+     */
+    static Geometry::ValidationResult validateSnapshot(
+        const DocumentSnapshot& entities,
+        const Geometry::ValidationControl& control = Geometry::ValidationControl());
+
+    /**
+     * @brief Entities of a region check, copied out of the document
+     *
+     * Produced on the main thread by prepareRegion() and safe to validate
+     * on any thread with validatePreparedRegion() while the document keeps
+     * changing.
+     */
+    struct PreparedRegion {
+        DocumentSnapshot entities;            ///< Requested entities with neighbours, document order
+        std::vector<bool> requested;          ///< Whether each entity's issues are reported
+        Geometry::ValidationControl control;  ///< Control with the document's rules
+    };
+
+    /**
+     * @brief Validate the entities in a window, e.g. the viewport (Main Thread Only)
+     * @param region World-space window (Viewport::visibleBounds())
+     * @param control Cancellation, progress, budget and threads
+     * @return Result for the region; validationResult() is not changed
+     *
+     * Entities whose bounding box touches the window are checked as
+     * described for the handle overload. Neighbours are searched around
+     * the window and every checked entity, so partners of an entity that
+     * crosses the window edge are found.
+     */
+    Geometry::ValidationResult validateRegion(
+        const Geometry::BoundingBox& region,
+        const Geometry::ValidationControl& control = Geometry::ValidationControl()) const;
+
+    /**
+     * @brief Validate a set of entities, e.g. the selection (Main Thread Only)
+     * @param handles Entities to check (unknown handles are ignored)
+     * @param control Cancellation, progress, budget and threads
+     * @return Result for the entities; validationResult() is not changed
+     *
+     * The entities and their neighbours within a halo (the endpoint snap
+     * tolerance or the feature spacing, whichever is larger) are found
+     * through the spatial index and validated on their own with the full
+     * rule set and the document's manufacturing rules. Only issues
+     * involving a requested entity are kept: neighbours count for
+     * duplicates, intersections, corners and spacing but are not reported
+     * on their own. Issue indices refer to the checked entities in
+     * document order; resolve them with ValidationResult::handleOf().
+     * Every contour a requested entity lies on is checked whole, together
+     * with the contours enclosing it, so hole size and spacing see the
+     * same contours as a full run.
+     */
+    Geometry::ValidationResult validateRegion(
+        const std::vector<std::string>& handles,
+        const Geometry::ValidationControl& control = Geometry::ValidationControl()) const;
+
+    /**
+     * @brief Gather the entities validateRegion() checks in a window (Main Thread Only)
+     *
+     * Cost follows the entities found around the window, not the
+     * document. Validate the result with validatePreparedRegion(), e.g.
+     * on a worker thread so the UI stays responsive.
+     */
+    PreparedRegion prepareRegion(
+        const Geometry::BoundingBox& region,
+        const Geometry::ValidationControl& control = Geometry::ValidationControl()) const;
+
+    /**
+     * @brief Gather the entities validateRegion() checks for some handles (Main Thread Only)
+     */
+    PreparedRegion prepareRegion(
+        const std::vector<std::string>& handles,
+        const Geometry::ValidationControl& control = Geometry::ValidationControl()) const;
+
+    /**
+     * @brief Validate a prepared region (Thread-Safe: touches no document state)
+     * @return Issues involving a requested entity, as validateRegion() reports them
+     */
+    static Geometry::ValidationResult validatePreparedRegion(const PreparedRegion& region);
+
+    /**
+     * @brief Prepare control for a new validation run (Main Thread Only)
+     * @return Fresh cancellation token with the progress callback, rule budget,
+     *         thread count and manufacturing rules
+     *
+     * The token becomes the one cancelValidation() cancels, so a cancelled
+     * run never affects a run started later.
+     */
+    Geometry::ValidationControl beginValidation();
+
+    /**
+     * @brief Cancel the validation run started last (Main Thread Only)
+     *
+     * Cooperative: the worker stops at its next check and returns a result
+     * marked cancelled, which finalizeValidation() ignores.
+     */
+    void cancelValidation();
+
+    /**
+     * @brief Set callback for validation progress
+     * @param callback Function to call (NOTE: called from background thread)
+     */
+    void setValidationProgressCallback(std::function<void(const Geometry::ValidationProgress&)> callback);
+
+    /**
+     * @brief Set the time budget per validation rule (0 = unlimited)
+     */
+    void setValidationRuleBudget(std::chrono::milliseconds budget) { validationRuleBudget_ = budget; }
+
+    /**
+     * @brief Set validation worker threads (0 = hardware concurrency)
+     *
+     * Results do not depend on the thread count.
+     */
+    void setValidationThreadCount(size_t threads) { validationThreadCount_ = threads; }
+
+    /**
+     * @brief Get configured validation worker threads (0 = hardware concurrency)
+     */
+    size_t validationThreadCount() const { return validationThreadCount_; }
+
+    /**
+     * @brief Set the manufacturing limits checked by the validator
+     *
+     * Takes effect on the next full validation; the incremental baseline
+     * is dropped because its issues used the old limits.
+     */
+    void setManufacturingRules(const Geometry::ManufacturingRules& rules);
+
+    /**
+     * @brief Keep import diagnostic messages in memory or a JSON-lines file
+     *
+     * Takes effect on the next load. The default keeps counts only.
+     */
+    void setImportDiagnosticOptions(const Import::DiagnosticOptions& options) {
+        importDiagnosticOptions_ = options;
+    }
+
+    /**
+     * @brief Get the manufacturing limits checked by the validator
+     */
+    const Geometry::ManufacturingRules& manufacturingRules() const { return manufacturingRules_; }
+
     /**
      * @brief Set callback to be notified when validation completes
      * @param callback Function to call (NOTE: may be called from background thread)
@@ -239,15 +635,70 @@ public:
 
     /**
      * @brief Apply validation result and update statistics (Main Thread Only)
-     * @param result Result computed by async validator
+     * @param result Result computed by async validator (ignored if cancelled)
      */
     void finalizeValidation(const Geometry::ValidationResult& result);
 
+    /**
+     * @brief Apply a result and adopt it as baseline for incremental validation
+     * @param result Result computed by async validator (ignored if cancelled)
+     * @param snapshotVersion Version of the snapshot it was computed on
+     *
+     * The baseline is only taken if the result is complete and the document
+     * is still at snapshotVersion.
+     */
+    void finalizeValidation(const Geometry::ValidationResult& result, uint64_t snapshotVersion);
+
+    /**
+     * @brief Patch the validation result for entities changed since the last run
+     * @return false if a full validation is needed instead (Main Thread Only)
+     *
+     * Every add, remove, restore and update marks its entity dirty. This
+     * re-checks only the dirty entities, pairs them with their spatial
+     * neighbours and patches the previous result, which must come from a
+     * complete run of this document (runValidation() or the versioned
+     * finalizeValidation()). The patched result has the same issues, in
+     * the same order, as a full validation.
+     *
+     * Falls back (returns false) without a baseline, when more than an
+     * eighth of the document changed and a full run is cheaper, when an
+     * edit touched a closed contour while the hole-size rule is enabled,
+     * and always while the feature-spacing rule is enabled.
+     */
+    bool validateIncremental();
+
     /**
      * @brief Check if validation is currently running
      */
     bool isValidating() const;
 
+    // =========================================================================
+    // VALIDATION CACHE
+    // =========================================================================
+
+    /**
+     * @brief Set the cache of results for previously loaded content (nullptr = none)
+     *
+     * Complete results of an unedited loaded document are stored by
+     * loadDXFFile() and the versioned finalizeValidation(); loadDXFFile()
+     * looks them up.
+     */
+    void setValidationCache(std::shared_ptr<ValidationCache> cache) { validationCache_ = std::move(cache); }
+
+    /**
+     * @brief Hash of everything a validation result depends on
+     *
+     * Covers every entity in document order (handle, type and exact
+     * geometry), the imported entity count, the manufacturing rules and
+     * the validation tolerances. Layers and colors are not included.
+     */
+    ContentHash contentHash() const;
+
+    /**
+     * @brief Current result came from the cache and no validation run has replaced it
+     */
+    bool isValidationFromCache() const noexcept { return validationFromCache_; }
+
     // =========================================================================
     // DXF EXPORT
     // =========================================================================
@@ -255,12 +706,14 @@ public:
     /**
      * @brief Export document to DXF file
      * @param filePath Output DXF file path
+     * @param format Text or binary DXF (binary keeps coordinates exact)
      * @return true if successful, false on error
      *
      * Exports all entities with preserved metadata (handles, layers, colors).
      * Uses GeometryExporter and DXFWriter for conversion.
      */
-    bool exportDXFFile(const std::string& filePath) const;
+    bool exportDXFFile(const std::string& filePath,
+                       Export::DXFFormat format = Export::DXFFormat::Ascii) const;
 
     /**
      * @brief Get export errors from last export operation
@@ -288,24 +741,254 @@ private:
     void calculateStatistics();
 
     /**
-     * @brief Convert entities to variant for validation
+     * @brief Recount issue statistics from validationResult_ (entity counts kept)
+     */
+    void countIssues();
+
+    /**
+     * @brief Apply the cached result for the loaded content, if there is one
+     */
+    bool adoptCachedValidation();
+
+    /**
+     * @brief Store the current result if it is complete and the loaded document unedited
+     */
+    void storeCachedValidation();
+
+    /**
+     * @brief Adopt a complete result of the current document for incremental validation
+     */
+    void setValidationBaseline(const Geometry::ValidationResult& result);
+
+    /**
+     * @brief Check that no edit since the baseline touched a closed contour
+     *
+     * The dirty entities' old and new endpoints are followed through the
+     * spatial index to every entity joined to them. The contour issues of
+     * the baseline still hold if none of those was in a closed contour and
+     * together they close none (contours without area do not count).
+     */
+    bool editsKeepContours() const;
+
+    /**
+     * @brief Gather requested slots with their neighbours in some windows
+     * @param requested Live slots whose issues are reported
+     * @param windows Spatial-index windows that hold the neighbours
+     */
+    PreparedRegion prepareSlots(const std::vector<uint32_t>& requested,
+                                const std::vector<Geometry::BoundingBox>& windows,
+                                const Geometry::ValidationControl& control) const;
+
+    /**
+     * @brief Validated entities joined to the seeds through shared endpoints
+     *
+     * Walks the spatial index from endpoint to endpoint, so the cost
+     * follows the chains found, not the document.
+     */
+    std::unordered_set<uint32_t> joinedSlots(const std::vector<uint32_t>& seeds) const;
+
+    // =========================================================================
+    // SLOT STORAGE
+    // =========================================================================
+
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+    static constexpr uint64_t ORDER_STEP = uint64_t(1) << 20;  // Gap for mid-order inserts
+    static constexpr size_t TOMBSTONE_COMPACT_MIN = 1024;
+    static constexpr size_t PAGE_SIZE = 1024;  // Order-list positions per snapshot page
+    static constexpr size_t INCREMENTAL_MIN_DIRTY = 64;  // Dirty entities always patched incrementally
+    static constexpr size_t CONTOUR_COMPONENT_LIMIT = 4096;  // Joined entities checked before a full run
+
+    using PageStorage = std::shared_ptr<DocumentSnapshot::Page>;
+
+    struct EntitySlot {
+        uint64_t order = 0;          // Document order key
+        uint32_t generation = 0;     // 0 while on the free list
+        bool live = false;           // false = free or tombstone
+        size_t orderPosition = 0;    // Position in orderedSlots_
+        uint32_t pageOffset = 0;     // Record index in page orderPosition / PAGE_SIZE (live slots)
+    };
+
+    /**
+     * @brief Replace all storage (after import)
+     */
+    void assignEntities(std::vector<Import::GeometryEntityWithMetadata> entities);
+
+    /**
+     * @brief Empty the storage before entities are appended
+     */
+    void resetSlots();
+
+    /**
+     * @brief Append entities in document order (import batches)
+     */
+    void appendSlots(std::vector<Import::GeometryEntityWithMetadata>&& entities);
+
+    /**
+     * @brief Index the appended entities and publish them
+     */
+    void finishSlots();
+
+    /**
+     * @brief Store a new entity at an order key and index it
+     */
+    uint32_t insertSlot(const Import::GeometryEntityWithMetadata& entity, uint64_t order);
+
+    /**
+     * @brief Append an entity in document order (for add* methods)
+     */
+    void appendEntity(const Import::GeometryEntityWithMetadata& entity);
+
+    /**
+     * @brief First live slot with handle in document order, or NO_SLOT
+     */
+    uint32_t findSlot(const std::string& handle) const;
+
+    /**
+     * @brief Record of a live slot
+     */
+    const Import::GeometryEntityWithMetadata& recordOf(const EntitySlot& entry) const {
+        return (*pages_[entry.orderPosition / PAGE_SIZE])[entry.pageOffset];
+    }
+
+    /**
+     * @brief Record of a live slot, for an edit (copies its page if a snapshot holds it)
+     */
+    Import::GeometryEntityWithMetadata& editRecord(uint32_t slot);
+
+    /**
+     * @brief Register a live slot in the handle and spatial indexes
+     */
+    void attachSlot(uint32_t slot, const Import::GeometryEntityWithMetadata& record);
+
+    /**
+     * @brief Unindex a live slot and turn it into a tombstone
+     * @param unindexHandle false if the caller already dropped it from slotsByHandle_
+     * @return The entity, with its id and order key
+     */
+    RemovedEntity detachSlot(uint32_t slot, bool unindexHandle = true);
+
+    /**
+     * @brief Revive a tombstone or re-insert at the saved order key
+     * @return false if the entity is already present
+     */
+    bool reattach(const RemovedEntity& removed);
+
+    /**
+     * @brief Shared implementation of the addEntities overloads
+     * @param layers First layer; advanced by layerStride per entity (0 = shared)
+     */
+    std::vector<std::string> appendEntities(const std::vector<Import::GeometryEntity>& entities,
+                                            const std::string* layers, size_t layerStride);
+
+    /**
+     * @brief Entity counts by type, applied to statistics_ in one step
+     */
+    struct EntityCounts {
+        size_t lines = 0;
+        size_t arcs = 0;
+        size_t total = 0;
+
+        void add(const Import::GeometryEntity& entity) noexcept;
+    };
+
+    /**
+     * @brief Update statistics for entities entering or leaving the document
+     */
+    void applyCounts(const EntityCounts& counts, bool added);
+
+    /**
+     * @brief Update statistics for one entity entering or leaving the document
+     */
+    void countEntity(const Import::GeometryEntity& entity, bool added);
+
+    /**
+     * @brief Recycle tombstoned slots once they outnumber live entities
+     */
+    void compactTombstones();
+
+    /**
+     * @brief Re-space order keys (when a mid-order insert finds no gap)
+     *
+     * Closes the order epoch first if removal records may still hold its keys.
+     */
+    void renumberOrder();
+
+    /**
+     * @brief Order key of a removal record, carried through later renumberings
+     */
+    uint64_t currentOrderKey(const RemovedEntity& removed) const;
+
+    /**
+     * @brief Sort the order list if an out-of-order insert left it unsorted
+     */
+    void ensureOrder();
+
+    /**
+     * @brief Record a change to the entities (new version, cached snapshot dropped)
+     */
+    void touch();
+
+    /**
+     * @brief Page for writing, copied first if a snapshot shares it
+     */
+    DocumentSnapshot::Page& writablePage(size_t pageIndex);
+
+    /**
+     * @brief Forget the scanned layout of a page about to be written in place
+     */
+    void dropPageLayout(size_t pageIndex);
+
+    /**
+     * @brief Gather page records again after removals, revivals or moved positions
+     * @param all true if order-list positions moved (orderPosition still holds
+     *        each slot's old position); false to rebuild stalePages_ only
+     */
+    void rebuildPages(bool all);
+
+    /**
+     * @brief Sort and rebuild whatever a mutation left pending (end of each public mutator)
+     */
+    void settlePages();
+
+    /**
+     * @brief Live slot at a position in entities() (needs a current snapshot)
      */
-    std::vector<std::variant<Geometry::Line2D, Geometry::Arc2D>>
-        getEntityVariants() const;
+    uint32_t slotAtIndex(size_t index) const;
 
     /**
-     * @brief Extract entity handles (parallel to getEntityVariants)
+     * @brief Re-index all entities (after bulk replacement of storage)
      */
-    std::vector<std::string> getEntityHandles() const;
+    void rebuildSpatialIndex();
 
     // Data members
-    std::vector<Import::GeometryEntityWithMetadata> entities_;
+    std::vector<EntitySlot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::vector<uint32_t> orderedSlots_;  // Document order, may contain tombstones
+    bool orderSorted_ = true;             // false after out-of-order insert
+    size_t liveCount_ = 0;
+    size_t tombstoneCount_ = 0;
+    uint64_t nextOrder_ = ORDER_STEP;
+    std::shared_ptr<OrderEpoch> orderEpoch_ = std::make_shared<OrderEpoch>();
+    uint32_t nextGeneration_ = 1;
+    std::unordered_multimap<std::string, uint32_t> slotsByHandle_;  // Live slots only
+
+    // Record pages: pages_[k] covers orderedSlots_[k * PAGE_SIZE, (k+1) * PAGE_SIZE)
+    uint64_t version_ = 0;
+    std::vector<PageStorage> pages_;
+    std::vector<size_t> stalePages_;  // Pages with removed or revived records
+    std::unordered_map<uint32_t, Import::GeometryEntityWithMetadata> revivedRecords_;  // Until their page is rebuilt
+    mutable std::optional<DocumentSnapshot> snapshot_;  // Cache of snapshot(); dropped by touch()
+    mutable std::vector<DocumentSnapshot::PageLayoutPtr> pageLayouts_;  // Of the last snapshot's pages
+
+    SpatialIndex spatialIndex_;
     Geometry::ValidationResult validationResult_;
     mutable std::mutex validationMutex_; // Protect validationResult_ access
     DocumentStatistics statistics_;
     std::string filePath_;
     std::vector<std::string> importErrors_;
     std::vector<std::string> importWarnings_;
+    Import::DiagnosticOptions importDiagnosticOptions_;
+    std::unique_ptr<Import::ImportDiagnostics> importDiagnostics_ = std::make_unique<Import::ImportDiagnostics>();
     mutable std::vector<std::string> exportErrors_;
 
     // Handle generation
@@ -315,6 +998,18 @@ private:
     std::future<void> validationFuture_;
     std::atomic<bool> isValidating_{false};
     std::function<void(const Geometry::ValidationResult&)> validationCallback_;
+    std::function<void(const Geometry::ValidationProgress&)> validationProgressCallback_;
+    Geometry::CancellationToken validationToken_;  // Token of the run started last
+    std::chrono::milliseconds validationRuleBudget_{0};
+    size_t validationThreadCount_ = 0;
+    Geometry::ManufacturingRules manufacturingRules_;
+    IncrementalValidation incremental_;  // Slot-keyed issues and dirty set
+    std::shared_ptr<ValidationCache> validationCache_;
+    uint64_t loadedVersion_ = UINT64_MAX;  // Version right after the last load
+    bool validationFromCache_ = false;
+
+    // Per-entity issues found while importing; valid at loadedVersion_
+    std::shared_ptr<const std::vector<Geometry::GeometryIssue>> importedEntityIssues_;
 };
 
 } // namespace Model
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "import/GeometryConverter.h"
+#include "geometry/ContourTopology.h"
+#include "geometry/SegmentView.h"
+#include <vector>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <utility>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+
+namespace OwnCAD {
+namespace Model {
+
+/**
+ * @brief Immutable, versioned view of the document entities
+ *
+ * Entities are stored in fixed-capacity pages shared between snapshots.
+ * The pages are the document's own storage: DocumentModel edits a page in
+ * place while no snapshot holds it and copies it first otherwise, so a
+ * new snapshot shares every page the edits did not touch.
+ *
+ * Design decisions:
+ * - Copying a snapshot is O(1) (one shared pointer), so it can be handed
+ *   to a worker thread, the exporter or the canvas without copying geometry
+ * - A snapshot never changes after construction: it stays valid and
+ *   consistent while the live document keeps being edited
+ * - Safe for concurrent reads from any number of threads
+ * - Indexing is O(log pages); iteration walks pages directly
+ *
+ * Pages may be empty (all of their entities removed); they are skipped
+ * by iteration and indexing.
+ */
+class DocumentSnapshot {
+public:
+    using Page = std::vector<Import::GeometryEntityWithMetadata>;
+    using PagePtr = std::shared_ptr<const Page>;
+
+    static constexpr size_t NO_SEGMENT = SIZE_MAX;
+
+    /**
+     * @brief Which records of one page are lines and arcs
+     *
+     * Layouts are immutable and shared: a snapshot taken after an edit
+     * reuses the layouts of the pages it shares with the last one, so
+     * only replaced pages are scanned (see the constructor taking known
+     * layouts).
+     */
+    struct PageLayout {
+        std::weak_ptr<const Page> page;   ///< Page described (weak: never keeps it alive)
+        uint32_t segmentCount = 0;        ///< Lines and arcs in the page
+        std::vector<uint32_t> offsets;    ///< Their offsets in the page (empty if every record is one)
+    };
+    using PageLayoutPtr = std::shared_ptr<const PageLayout>;
+
+    /**
+     * @brief Forward iterator over all entities in document order
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Import::GeometryEntityWithMetadata;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const { return (*pages_[page_])[offset_]; }
+        pointer operator->() const { return &(*pages_[page_])[offset_]; }
+
+        const_iterator& operator++() {
+            ++offset_;
+            skipEmpty();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept {
+            return pages_ == other.pages_ && page_ == other.page_ && offset_ == other.offset_;
+        }
+
+        bool operator!=(const const_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        friend class DocumentSnapshot;
+
+        const_iterator(const PagePtr* pages, size_t pageCount, size_t page)
+            : pages_(pages), pageCount_(pageCount), page_(page) {
+            skipEmpty();
+        }
+
+        void skipEmpty() {
+            while (page_ < pageCount_ && offset_ >= pages_[page_]->size()) {
+                ++page_;
+                offset_ = 0;
+            }
+        }
+
+        const PagePtr* pages_ = nullptr;
+        size_t pageCount_ = 0;
+        size_t page_ = 0;
+        size_t offset_ = 0;
+    };
+
+    /**
+     * @brief Empty snapshot (version 0)
+     */
+    DocumentSnapshot();
+
+    /**
+     * @brief Assemble a snapshot from shared pages
+     * @param version Document version the pages were taken at
+     * @param pages Pages in document order (null pages are treated as empty)
+     */
+    DocumentSnapshot(uint64_t version, std::vector<PagePtr> pages);
+
+    /**
+     * @brief Assemble a snapshot, reusing the layouts of unchanged pages
+     * @param version Document version the pages were taken at
+     * @param pages Pages in document order (null pages are treated as empty)
+     * @param known Layouts by page index, e.g. pageLayouts() of the last
+     *        snapshot; used where they still describe the same page object
+     *
+     * The caller must drop the layout of a page it edits in place.
+     */
+    DocumentSnapshot(uint64_t version, std::vector<PagePtr> pages,
+                     const std::vector<PageLayoutPtr>& known);
+
+    /**
+     * @brief Wrap a plain entity list (copies it once into pages)
+     * @param entities Entities in document order
+     * @param version Version to report
+     */
+    static DocumentSnapshot fromEntities(const std::vector<Import::GeometryEntityWithMetadata>& entities,
+                                         uint64_t version = 0);
+
+    /**
+     * @brief Document version this snapshot was taken at
+     */
+    uint64_t version() const noexcept { return data_->version; }
+
+    /**
+     * @brief Number of entities
+     */
+    size_t size() const noexcept { return data_->size; }
+
+    /**
+     * @brief Check if snapshot has no entities
+     */
+    bool empty() const noexcept { return data_->size == 0; }
+
+    /**
+     * @brief Entity at a position in document order (O(log pages))
+     */
+    const Import::GeometryEntityWithMetadata& operator[](size_t index) const;
+
+    const_iterator begin() const noexcept {
+        return const_iterator(data_->pages.data(), data_->pages.size(), 0);
+    }
+
+    const_iterator end() const noexcept {
+        return const_iterator(data_->pages.data(), data_->pages.size(), data_->pages.size());
+    }
+
+    // =========================================================================
+    // PAGES
+    // =========================================================================
+
+    /**
+     * @brief Number of pages (including empty ones)
+     */
+    size_t pageCount() const noexcept { return data_->pages.size(); }
+
+    /**
+     * @brief Entities of one page
+     */
+    const Page& page(size_t index) const noexcept { return *data_->pages[index]; }
+
+    /**
+     * @brief Position of a page's first entity in document order
+     */
+    size_t pageStart(size_t index) const noexcept { return data_->pageStarts[index]; }
+
+    /**
+     * @brief Check if a page is shared with another snapshot (same storage)
+     */
+    bool sharesPage(const DocumentSnapshot& other, size_t index) const noexcept;
+
+    /**
+     * @brief Find the page holding a position in document order
+     * @return (page index, offset within page); index must be < size()
+     */
+    std::pair<size_t, size_t> locate(size_t index) const;
+
+    /**
+     * @brief Layouts of the pages, by page index
+     */
+    const std::vector<PageLayoutPtr>& pageLayouts() const noexcept { return data_->layouts; }
+
+    /**
+     * @brief Copy all entities into one vector
+     */
+    std::vector<Import::GeometryEntityWithMetadata> toVector() const;
+
+    // =========================================================================
+    // DERIVED DATA
+    // =========================================================================
+
+    /**
+     * @brief Lines and arcs in document order, as validation indexes them (O(1))
+     *
+     * The view reads the pages in place and keeps them alive; nothing is
+     * copied. Validation, the contour topology and the result's handle
+     * table all index entities through it. Safe to use from any thread.
+     */
+    Geometry::SegmentView segments() const noexcept;
+
+    /**
+     * @brief Handles of segments(), read from the pages (O(1))
+     */
+    Geometry::HandleTable segmentHandles() const;
+
+    /**
+     * @brief Index in segments() of the entity at a position in document order
+     * @param index Position, < size()
+     * @return NO_SEGMENT if the entity is not a line or arc
+     *
+     * O(log pages + log page size), so a caller that knows entity positions
+     * can name them as validation issues do without walking the document.
+     */
+    size_t segmentIndexOf(size_t index) const;
+
+    /**
+     * @brief Contours of the snapshot's lines and arcs (built once, then cached)
+     *
+     * Entity indices are those of segments(), as validation issues use.
+     * The topology is built on first use and shared by every copy of this
+     * snapshot, so all rules checking one document version share a single
+     * build. Safe to call from any thread.
+     */
+    std::shared_ptr<const Geometry::ContourTopology> contours() const;
+
+private:
+    struct Data {
+        uint64_t version = 0;
+        size_t size = 0;
+        std::vector<PagePtr> pages;
+        std::vector<size_t> pageStarts;  // Prefix sums of page sizes
+        std::vector<PageLayoutPtr> layouts;
+        std::vector<size_t> segmentStarts;  // Prefix sums of page segment counts
+        std::vector<Geometry::SegmentView::Chunk> chunks;  // Pages holding lines or arcs
+
+        // Built on demand; the snapshot itself stays immutable
+        mutable std::once_flag contoursOnce;
+        mutable std::shared_ptr<const Geometry::ContourTopology> contours;
+    };
+
+    std::shared_ptr<const Data> data_;
+};
+
+} // namespace Model
+} // namespace OwnCAD
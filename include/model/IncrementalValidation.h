@@ -0,0 +1,167 @@
+#pragma once
+
+#include "geometry/GeometryValidator.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace OwnCAD {
+namespace Model {
+
+/**
+ * @brief Validation result keyed by storage slot, so edits can be patched in
+ *
+ * A ValidationResult identifies entities by position in the validated
+ * entity list, and positions shift on every insert or removal. This class
+ * keeps the same issues keyed by DocumentModel slot instead: entity-check
+ * issues per slot, and pairwise relations (duplicates, overlaps,
+ * intersections) between slots. After an edit only the dirty slots are re-checked; assemble()
+ * then rebuilds a result with the same issues, in the same order, as a
+ * full validation of the edited document.
+ *
+ * Contour issues (HoleTooSmall) are carried over unchanged. They stay
+ * valid as long as no edit touches a closed contour; DocumentModel checks
+ * that with the loop slots and the previous endpoints of dirty slots, and
+ * falls back to a full validation otherwise.
+ *
+ * DocumentModel owns one instance. It marks slots dirty on every mutation
+ * and performs the re-checks, since it owns the geometry and the spatial
+ * index used to find neighbours.
+ *
+ * THREAD SAFETY: Not thread-safe. Used from the document's thread only.
+ */
+class IncrementalValidation {
+public:
+    static constexpr size_t NO_INDEX = SIZE_MAX;
+
+    /**
+     * @brief Drop the baseline; the next validation must be a full one
+     */
+    void clear();
+
+    /**
+     * @brief Check if a baseline exists to patch
+     */
+    bool hasBaseline() const noexcept { return hasBaseline_; }
+
+    /**
+     * @brief Adopt a full validation result as baseline
+     * @param result Complete result of the current document
+     * @param slotOfIndex Slot of each validated entity, by entity index
+     * @return false (and no baseline) if the result is partial or does not match
+     */
+    bool setBaseline(const Geometry::ValidationResult& result,
+                     const std::vector<uint32_t>& slotOfIndex);
+
+    /**
+     * @brief Record that a slot changed (added, removed, revived or updated)
+     *
+     * @param slot Changed slot
+     * @param previousEndpoints Endpoints before the change (none if it did not exist)
+     *
+     * Ignored without a baseline. Only the endpoints of the first change
+     * since the last patch are kept: those are the ones the baseline saw.
+     */
+    void markDirty(uint32_t slot, const std::vector<Geometry::Point2D>& previousEndpoints = {});
+
+    /**
+     * @brief Check if a slot changed since the result was last patched
+     */
+    bool isDirty(uint32_t slot) const { return dirty_.count(slot) > 0; }
+
+    /**
+     * @brief Slots changed since the result was last patched (ascending)
+     */
+    std::vector<uint32_t> dirtySlots() const;
+
+    /**
+     * @brief Number of changed slots
+     */
+    size_t dirtyCount() const noexcept { return dirty_.size(); }
+
+    /**
+     * @brief Endpoints the dirty slots had in the baseline
+     */
+    std::vector<Geometry::Point2D> previousEndpoints() const;
+
+    /**
+     * @brief Mark every change as patched
+     */
+    void clearDirty();
+
+    /**
+     * @brief Record which slots belong to closed contours in the baseline
+     */
+    void setLoopSlots(const std::vector<uint32_t>& loopSlots);
+
+    /**
+     * @brief Check if a slot belongs to a closed contour in the baseline
+     */
+    bool isLoopSlot(uint32_t slot) const { return loopSlots_.count(slot) > 0; }
+
+    /**
+     * @brief Drop every issue of a slot (entity checks and relations)
+     */
+    void forget(uint32_t slot);
+
+    /**
+     * @brief Store the entity-check issues of a slot
+     *
+     * The index is filled in by assemble().
+     */
+    void setEntityIssues(uint32_t slot, std::vector<Geometry::GeometryIssue> issues);
+
+    /**
+     * @brief Record a pairwise relation
+     * @param lower Slot of the entity that comes first in document order
+     * @param higher Slot of the entity that comes later
+     * @param type DuplicateLine, OverlappingLines, DuplicateArc, CoincidentArcs
+     *             or SelfIntersection
+     * @param location Intersection point (SelfIntersection only)
+     */
+    void addRelation(uint32_t lower, uint32_t higher, Geometry::GeometryIssueType type,
+                     const std::optional<Geometry::Point2D>& location = std::nullopt);
+
+    /**
+     * @brief Build the result in full-validation order
+     * @param indexOf Entity index of a slot (NO_INDEX if not validated); asked
+     *        only for slots that have issues, so the cost follows the issues
+     * @param handles Handles by entity index, shared with the result
+     *
+     * Entity-check issues come first by entity index, then duplicate and
+     * overlap pairs, then intersections, each by (entityIndex,
+     * relatedEntityIndex), as GeometryValidator reports them. Contour
+     * issues follow by their lowest entity index.
+     */
+    Geometry::ValidationResult assemble(const std::function<size_t(uint32_t)>& indexOf,
+                                        Geometry::HandleTable handles) const;
+
+private:
+    struct Relation {
+        uint32_t other;
+        Geometry::GeometryIssueType type;
+        bool lower;  ///< true if the owning slot is the lower entity of the pair
+        std::optional<Geometry::Point2D> location;
+    };
+
+    struct ContourIssue {
+        Geometry::GeometryIssue issue;
+        std::vector<uint32_t> members;  ///< Slots of the contour's entities
+    };
+
+    bool hasBaseline_ = false;
+    std::unordered_set<uint32_t> dirty_;
+    std::unordered_map<uint32_t, std::vector<Geometry::Point2D>> previousEndpoints_;
+    std::unordered_set<uint32_t> loopSlots_;
+    std::vector<ContourIssue> contourIssues_;
+    std::unordered_map<uint32_t, std::vector<Geometry::GeometryIssue>> entityIssues_;
+    std::unordered_map<uint32_t, std::vector<Relation>> relations_;  // Both directions
+};
+
+} // namespace Model
+} // namespace OwnCAD
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "geometry/BoundingBox.h"
+#include "geometry/Point2D.h"
+#include "import/GeometryConverter.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace OwnCAD {
+namespace Model {
+
+/**
+ * @brief Incrementally maintained spatial index of entity bounding boxes
+ *
+ * Uniform hashed grid of (handle, bounding box) entries. Each entry is
+ * registered in every grid cell its box touches; entries spanning too many
+ * cells (sheet borders, huge arcs) are kept in a separate "oversized" list
+ * that every query checks directly.
+ *
+ * Design decisions:
+ * - Incremental: insert/update/remove touch only the affected cells
+ * - Adaptive cell size: re-bucketed when the entity count grows 4x, so
+ *   the amortized insertion cost stays O(1)
+ * - Bounds of the gridded entries are kept in a min/max tree over entry
+ *   slots (O(log n) per edit); bounds() merges in the oversized entries,
+ *   which every query already scans
+ * - queryNearest() walks rings of cells clamped to the occupied extent,
+ *   and stops once the next ring is farther than the k-th hit
+ * - Queries are const and keep no scratch state (safe for concurrent reads)
+ *
+ * The index only knows bounding boxes. Callers that need exact geometry
+ * (hit testing, snapping) use it to find candidates and then measure.
+ *
+ * NOTE: Handles are not unique per entity - decomposed polylines keep the
+ * source handle on every segment. The index therefore allows several
+ * entries per handle; handle queries report each handle once. Callers that
+ * own a unique id per entity (DocumentModel's slots) pass it as the entry
+ * key and use the key queries, which report exactly the entries hit.
+ */
+class SpatialIndex {
+public:
+    /**
+     * @brief Caller's id of an entry (DocumentModel passes the entity slot)
+     *
+     * Keys index a table, so they should be small and dense.
+     */
+    using Key = uint32_t;
+
+    /// Key of entries inserted without one
+    static constexpr Key NO_KEY = std::numeric_limits<Key>::max();
+
+    SpatialIndex();
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+
+    /**
+     * @brief Add an entity bounding box
+     * @param handle Entity handle
+     * @param box Entity bounding box
+     * @param key Unique id of the entry for the key queries (optional)
+     * @return false if box invalid or key already indexed
+     */
+    bool insert(const std::string& handle, const Geometry::BoundingBox& box, Key key = NO_KEY);
+
+    /**
+     * @brief Replace the bounding box of an indexed entity
+     * @param handle Entity handle
+     * @param oldBox Current bounding box (selects the entry if handle is shared)
+     * @param newBox New bounding box
+     * @return false if handle not indexed or newBox invalid
+     */
+    bool update(const std::string& handle,
+                const Geometry::BoundingBox& oldBox,
+                const Geometry::BoundingBox& newBox);
+
+    /**
+     * @brief Replace the bounding box of the entry inserted with a key
+     * @return false if key not indexed or newBox invalid
+     */
+    bool update(Key key, const Geometry::BoundingBox& newBox);
+
+    /**
+     * @brief Remove an entity from the index
+     * @param handle Entity handle
+     * @param box Current bounding box (selects the entry if handle is shared)
+     * @return false if handle not indexed
+     */
+    bool remove(const std::string& handle, const Geometry::BoundingBox& box);
+
+    /**
+     * @brief Remove the entry inserted with a key
+     * @return false if key not indexed
+     */
+    bool remove(Key key);
+
+    /**
+     * @brief Check if a handle is indexed
+     */
+    bool contains(const std::string& handle) const;
+
+    /**
+     * @brief Number of indexed entities
+     */
+    size_t size() const noexcept { return slotByHandle_.size(); }
+
+    /**
+     * @brief Check if index is empty
+     */
+    bool empty() const noexcept { return slotByHandle_.empty(); }
+
+    /**
+     * @brief Union of all indexed bounding boxes
+     * @return Document bounds, or invalid box if empty
+     */
+    Geometry::BoundingBox bounds() const noexcept;
+
+    /**
+     * @brief Current grid cell size (world units)
+     */
+    double cellSize() const noexcept { return cellSize_; }
+
+    // =========================================================================
+    // QUERIES
+    // =========================================================================
+
+    /**
+     * @brief Find entities whose bounding box touches or crosses a window
+     * @param window Query window
+     * @return Unique handles, sorted
+     */
+    std::vector<std::string> queryWindow(const Geometry::BoundingBox& window) const;
+
+    /**
+     * @brief Keys of the entries whose bounding box touches or crosses a window
+     * @param window Query window
+     * @return Keys, sorted; entries inserted without a key are skipped
+     *
+     * Unlike queryWindow() this reports only the entries hit, not every
+     * entity sharing their handle.
+     */
+    std::vector<Key> queryWindowKeys(const Geometry::BoundingBox& window) const;
+
+    /**
+     * @brief Find entities whose bounding box lies completely inside a window
+     * @param window Query window
+     * @return Unique handles, sorted
+     *
+     * A shared handle is reported if any of its entities is inside.
+     */
+    std::vector<std::string> queryContained(const Geometry::BoundingBox& window) const;
+
+    /**
+     * @brief Find entities whose bounding box is within a radius of a point
+     * @param center Query point
+     * @param radius Search radius (world units)
+     * @return Unique handles, sorted
+     */
+    std::vector<std::string> queryRadius(const Geometry::Point2D& center, double radius) const;
+
+    /**
+     * @brief Find the k entities whose bounding boxes are nearest to a point
+     * @param point Query point
+     * @param count Maximum number of results
+     * @return Unique handles sorted by bounding box distance (ties by handle)
+     */
+    std::vector<std::string> queryNearest(const Geometry::Point2D& point, size_t count) const;
+
+    /**
+     * @brief Bounding box of any document entity
+     *
+     * Points get a zero-size box at their location.
+     */
+    static Geometry::BoundingBox boundsOf(const Import::GeometryEntity& entity) noexcept;
+
+private:
+    struct CellKey {
+        int64_t x;
+        int64_t y;
+
+        bool operator==(const CellKey& other) const noexcept {
+            return x == other.x && y == other.y;
+        }
+    };
+
+    struct CellKeyHash {
+        size_t operator()(const CellKey& key) const noexcept;
+    };
+
+    struct Entry {
+        std::string handle;
+        Key key = NO_KEY;
+        Geometry::BoundingBox box;
+        int64_t cellMinX = 0;
+        int64_t cellMinY = 0;
+        int64_t cellMaxX = 0;
+        int64_t cellMaxY = 0;
+        bool oversized = false;
+        bool live = false;
+    };
+
+    int64_t cellCoord(double value) const noexcept;
+    size_t findSlot(const std::string& handle, const Geometry::BoundingBox& box) const;
+    size_t findSlot(Key key) const noexcept;
+    bool updateSlot(size_t slot, const Geometry::BoundingBox& newBox);
+    bool removeSlot(size_t slot);
+    void placeEntry(size_t slot);
+    void unplaceEntry(size_t slot);
+    Geometry::BoundingBox gridBounds() const noexcept;
+    Geometry::BoundingBox gridBox(size_t slot) const noexcept;
+    void setBoundsLeaf(size_t slot);
+    void buildBoundsTree(size_t leaves);
+    void rebuild();
+
+    template <typename Visitor>
+    void forEachInWindow(const Geometry::BoundingBox& window, Visitor&& visit) const;
+
+    std::vector<Entry> entries_;
+    std::vector<size_t> freeSlots_;
+    std::unordered_multimap<std::string, size_t> slotByHandle_;
+    std::vector<size_t> slotByKey_;  // Entry slot per key; SIZE_MAX if none
+    std::unordered_map<CellKey, std::vector<size_t>, CellKeyHash> cells_;
+    std::vector<size_t> oversized_;
+
+    // Min/max tree over gridded entry slots (leaf i at boundsTree_[boundsLeaves_ + i]);
+    // oversized and free slots hold an invalid box
+    std::vector<Geometry::BoundingBox> boundsTree_;
+    size_t boundsLeaves_;
+
+    double cellSize_;
+    size_t rebuildThreshold_;
+};
+
+} // namespace Model
+} // namespace OwnCAD
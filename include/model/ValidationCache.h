@@ -0,0 +1,93 @@
+#pragma once
+
+#include "model/ContentHash.h"
+#include "model/DocumentModel.h"
+#include "geometry/GeometryValidator.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace OwnCAD {
+namespace Model {
+
+/**
+ * @brief Validation result and statistics restored from the cache
+ */
+struct CachedValidation {
+    Geometry::ValidationResult result;  ///< Without a handle table; the caller attaches its own
+    DocumentStatistics statistics;
+};
+
+/**
+ * @brief On-disk cache of validation results keyed by document content
+ *
+ * Each entry is one file, named after the ContentHash of the document it
+ * was computed for (see DocumentModel::contentHash()), holding the
+ * complete ValidationResult and DocumentStatistics. Handles are not
+ * stored: they are part of the hash, so the document being loaded already
+ * has them in the same order.
+ *
+ * The directory is kept under a size cap. Reading an entry refreshes its
+ * modification time; storing one evicts the least recently used entries
+ * until the total fits again.
+ *
+ * Files are written in native byte order and end with a digest of their
+ * payload. Entries from another platform, an older format, or that were
+ * cut short fail the checks and are treated as misses.
+ *
+ * THREAD SAFETY: Not thread-safe. Use from one thread (the UI thread).
+ */
+class ValidationCache {
+public:
+    static constexpr uint64_t DEFAULT_MAX_BYTES = uint64_t(256) << 20;
+    static constexpr const char* FILE_EXTENSION = ".ovc";
+
+    /**
+     * @brief Cache in a directory (created on first store)
+     * @param directory Directory holding the entries
+     * @param maxBytes Total entry size kept after each store
+     */
+    explicit ValidationCache(std::string directory, uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+    /**
+     * @brief Entry for a document, if present and intact
+     * @param key Content hash of the document
+     * @param entityCount Entities in the document (sanity check)
+     */
+    std::optional<CachedValidation> find(const ContentHash& key, size_t entityCount);
+
+    /**
+     * @brief Store the result of a complete validation
+     * @return false if the result is incomplete or the entry could not be written
+     */
+    bool store(const ContentHash& key, const Geometry::ValidationResult& result,
+               const DocumentStatistics& statistics, size_t entityCount);
+
+    /**
+     * @brief Remove every entry
+     */
+    void clear();
+
+    /**
+     * @brief Total size of all entries in bytes
+     */
+    uint64_t totalBytes() const;
+
+    const std::string& directory() const noexcept { return directory_; }
+    uint64_t maxBytes() const noexcept { return maxBytes_; }
+
+private:
+    std::string pathOf(const ContentHash& key) const;
+
+    /**
+     * @brief Delete least recently used entries until the total fits
+     * @param keep Entry that is never deleted (the one just stored)
+     */
+    void evict(const std::string& keep);
+
+    std::string directory_;
+    uint64_t maxBytes_;
+};
+
+} // namespace Model
+} // namespace OwnCAD
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "geometry/GeometryValidator.h"
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <future>
+#include <cstdint>
+
+namespace OwnCAD {
+namespace Model {
+
+class DocumentModel;
+
+/**
+ * @brief Coalesces validation requests and delivers the newest result.
+ *
+ * Edits call requestValidation(). Requests are debounced: a burst of
+ * edits (dragging, repeated undo) restarts a single-shot timer, so the
+ * whole burst costs one validation run.
+ *
+ * Every request bumps a generation counter. A run remembers the
+ * generation and document version it started from; when it finishes, the
+ * result is applied only if neither has moved on. A request arriving while
+ * a run is in flight cancels it (DocumentModel::cancelValidation), and a
+ * fresh run is started for the newest state, so a request is never lost
+ * and the UI never shows a stale result.
+ *
+ * When the document holds a baseline from an earlier complete run and
+ * only a few entities changed since, the run is patched synchronously
+ * (DocumentModel::validateIncremental) instead of starting a worker.
+ *
+ * INVARIANTS:
+ * - At most one worker runs at a time (requests while running are queued)
+ * - Results are applied (DocumentModel::finalizeValidation) on the
+ *   scheduler's thread via a queued call, never on the worker thread
+ * - validationFinished() is emitted only for results matching the
+ *   current document
+ *
+ * THREAD SAFETY: Not thread-safe. All calls must be from UI thread.
+ *
+ * USAGE:
+ * @code
+ *   ValidationScheduler scheduler(document);
+ *   connect(history, &CommandHistory::historyChanged,
+ *           &scheduler, &ValidationScheduler::requestValidation);
+ *   connect(&scheduler, &ValidationScheduler::validationFinished,
+ *           this, &MainWindow::updateValidationStatus);
+ * @endcode
+ */
+class ValidationScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_DEBOUNCE_MS = 150;
+
+    /**
+     * @brief Create a scheduler for a document.
+     * @param document Document to validate (must outlive the scheduler)
+     * @param parent Qt parent
+     */
+    explicit ValidationScheduler(DocumentModel* document, QObject* parent = nullptr);
+
+    /**
+     * @brief Waits for an in-flight run; its result is discarded.
+     */
+    ~ValidationScheduler() override;
+
+    /**
+     * @brief Validate after the debounce interval (restarts on every call).
+     */
+    void requestValidation();
+
+    /**
+     * @brief Validate now, skipping the debounce interval.
+     */
+    void validateNow();
+
+    /**
+     * @brief Drop pending requests and cancel the in-flight run.
+     *
+     * Use before replacing the document (open/new) or when the user stops
+     * a long check. Emits validationCancelled() if anything was dropped.
+     */
+    void cancel();
+
+    /**
+     * @brief Set the debounce interval.
+     * @param milliseconds Quiet time required before a run starts (0 = next event loop pass)
+     */
+    void setDebounceInterval(int milliseconds);
+
+    /**
+     * @brief Get the debounce interval in milliseconds.
+     */
+    int debounceInterval() const { return m_debounceTimer.interval(); }
+
+    /**
+     * @brief Check if a worker is running.
+     */
+    bool isRunning() const { return m_running; }
+
+    /**
+     * @brief Check if a run is waiting (debounce timer or queued behind a worker).
+     */
+    bool isPending() const { return m_debounceTimer.isActive() || m_rerunPending; }
+
+    /**
+     * @brief Current request generation.
+     */
+    uint64_t generation() const { return m_generation; }
+
+    /**
+     * @brief Number of validation runs started (for diagnostics and tests).
+     */
+    uint64_t runsStarted() const { return m_runsStarted; }
+
+signals:
+    /**
+     * @brief Emitted when a worker starts.
+     * @param generation Request generation the run validates
+     */
+    void validationStarted(quint64 generation);
+
+    /**
+     * @brief Emitted after a current result was applied to the document.
+     * @param generation Request generation of the result
+     *
+     * Read the result from DocumentModel::validationResult().
+     */
+    void validationFinished(quint64 generation);
+
+    /**
+     * @brief Progress of the current run (throttled by the validator).
+     * @param rule Rule being checked
+     * @param processed Entities processed by the rule
+     * @param total Entities the rule processes
+     */
+    void validationProgress(const QString& rule, quint64 processed, quint64 total);
+
+    /**
+     * @brief Emitted when a run or pending request was cancelled.
+     *
+     * Not emitted for runs superseded by a newer request.
+     */
+    void validationCancelled();
+
+private:
+    /**
+     * @brief Start a worker for the current document state.
+     */
+    void startRun();
+
+    /**
+     * @brief Apply or discard a finished run (UI thread).
+     */
+    void onRunFinished(uint64_t generation, uint64_t version,
+                       const Geometry::ValidationResult& result);
+
+    DocumentModel* m_document;
+    QTimer m_debounceTimer;
+    std::future<void> m_worker;
+    Geometry::CancellationToken m_runToken;  // Token of the worker started last
+    uint64_t m_generation = 0;
+    uint64_t m_runsStarted = 0;
+    bool m_running = false;
+    bool m_rerunPending = false;
+};
+
+} // namespace Model
+} // namespace OwnCAD
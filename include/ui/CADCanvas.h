@@ -8,13 +8,16 @@
 #include "geometry/Arc2D.h"
 #include "geometry/BoundingBox.h"
 #include "import/GeometryConverter.h"
+#include "model/DocumentSnapshot.h"
 #include "ui/GridSettingsDialog.h"
 #include "ui/SelectionManager.h"
 #include "ui/ToolManager.h"
+#include "ui/IssueOverlay.h"
 #include <vector>
 #include <optional>
 #include <memory>
 #include <set>
+#include <unordered_set>
 
 namespace OwnCAD {
 namespace UI {
@@ -49,6 +52,9 @@ public:
     void reset();
     void setViewportSize(int width, int height);
 
+    // World-space window currently on screen
+    Geometry::BoundingBox visibleBounds() const;
+
 private:
     double panX_;       // Pan offset X (screen space)
     double panY_;       // Pan offset Y (screen space)
@@ -171,6 +177,7 @@ public:
 
     // Entity management
     void setEntities(const std::vector<Import::GeometryEntityWithMetadata>& entities);
+    void setSnapshot(const Model::DocumentSnapshot& snapshot);  // O(1), shares document pages
     void clear();
 
     // Grid settings
@@ -199,7 +206,8 @@ public:
     void clearSelection();
 
     // Validation issue highlighting
-    void setProblematicEntities(const std::set<std::string>& handles);
+    void setProblematicEntities(std::unordered_set<std::string> handles);
+    void setIssueMarkers(std::vector<IssueMarker> markers);  // Clustered overlay
 
 signals:
     void viewportChanged(double zoom, double panX, double panY);
@@ -229,12 +237,14 @@ private:
     void renderSnapIndicator(QPainter& painter);
     void renderSelectionBoundingBox(QPainter& painter);
     void renderGripPoints(QPainter& painter);
+    void renderIssueOverlay(QPainter& painter);
 
     // Data members
-    std::vector<Import::GeometryEntityWithMetadata> entities_;
+    Model::DocumentSnapshot entities_;
     Viewport viewport_;
     SnapManager snapManager_;
     std::unique_ptr<ToolManager> toolManager_;
+    Model::DocumentModel* documentModel_ = nullptr;
 
     // UI state
     GridSettings gridSettings_;
@@ -248,7 +258,8 @@ private:
     SelectionManager selectionManager_;
 
     // Validation issue tracking
-    std::set<std::string> problematicEntityHandles_;  // Entities with validation issues
+    std::unordered_set<std::string> problematicEntityHandles_;  // Entities with validation issues
+    IssueOverlay issueOverlay_;  // Issue locations clustered per zoom bucket
 
     // Box selection state
     BoxSelectMode boxSelectMode_;
@@ -258,6 +269,11 @@ private:
     // Hit testing
     std::string hitTest(const Geometry::Point2D& point);
 
+    // Spatial lookup through the document's index (linear fallback)
+    bool usesDocumentIndex() const;
+    std::vector<size_t> candidateEntities(const Geometry::BoundingBox& window) const;
+    std::optional<Geometry::Point2D> snapAt(const Geometry::Point2D& worldPos);
+
     // Box selection helpers
     void renderSelectionBox(QPainter& painter);
     std::vector<std::string> getEntitiesInBox(const Geometry::BoundingBox& selectionBox, BoxSelectMode mode);
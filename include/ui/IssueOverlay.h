@@ -0,0 +1,105 @@
+#pragma once
+
+#include "geometry/GeometryValidator.h"
+#include "geometry/Point2D.h"
+#include "model/DocumentSnapshot.h"
+#include <cstdint>
+#include <vector>
+
+namespace OwnCAD {
+namespace UI {
+
+/**
+ * @brief How an issue affects export
+ */
+enum class IssueSeverity : uint8_t {
+    Warning,  // Manufacturing warning; export allowed
+    Error     // Blocking issue
+};
+
+/**
+ * @brief One validation issue placed in world space
+ */
+struct IssueMarker {
+    Geometry::Point2D location;
+    IssueSeverity severity = IssueSeverity::Error;
+};
+
+/**
+ * @brief Issues sharing one cell of the cluster grid
+ */
+struct IssueCluster {
+    Geometry::Point2D center;  // Mean of the member locations
+    size_t count = 0;
+    size_t errors = 0;         // Members with IssueSeverity::Error
+
+    IssueSeverity severity() const noexcept {
+        return errors > 0 ? IssueSeverity::Error : IssueSeverity::Warning;
+    }
+    bool isSingle() const noexcept { return count == 1; }
+};
+
+/**
+ * @brief Validation issues aggregated for display at the current zoom
+ *
+ * Issue locations are binned into a world-aligned grid whose cells are
+ * CELL_PIXELS to twice that on screen. The cell size only changes when
+ * the zoom level crosses a power of two (a zoom bucket), so panning and
+ * zooming within a bucket reuse the clusters. They are rebuilt only when
+ * the markers or the bucket change. Zooming in halves the cells per
+ * bucket until each issue has a cell of its own.
+ *
+ * Plain data, no Qt: CADCanvas draws the clusters.
+ */
+class IssueOverlay {
+public:
+    static constexpr double CELL_PIXELS = 48.0;  // Smallest cell edge on screen
+
+    /**
+     * @brief Markers for the issues of a validation result
+     * @param result Result of validating entities
+     * @param entities Snapshot the result was computed on
+     *
+     * Uses the issue location where the validator recorded one, and the
+     * center of the entity's bounding box otherwise.
+     */
+    static std::vector<IssueMarker> markersFor(const Geometry::ValidationResult& result,
+                                               const Model::DocumentSnapshot& entities);
+
+    /**
+     * @brief Zoom bucket of a zoom level (floor of log2)
+     */
+    static int zoomBucket(double zoomLevel) noexcept;
+
+    /**
+     * @brief Replace the markers (clusters are rebuilt on next use)
+     */
+    void setMarkers(std::vector<IssueMarker> markers);
+
+    void clear();
+
+    /**
+     * @brief Clusters for a zoom level, rebuilt only for a new bucket or markers
+     */
+    const std::vector<IssueCluster>& clusters(double zoomLevel);
+
+    size_t markerCount() const noexcept { return markers_.size(); }
+    bool isEmpty() const noexcept { return markers_.empty(); }
+
+    /**
+     * @brief Times the cluster grid was built (for tests and profiling)
+     */
+    size_t rebuildCount() const noexcept { return rebuildCount_; }
+
+private:
+    void rebuild(int bucket);
+
+    std::vector<IssueMarker> markers_;
+    std::vector<IssueCluster> clusters_;
+    int bucket_ = 0;
+    bool clustersValid_ = false;
+    size_t rebuildCount_ = 0;
+};
+
+} // namespace UI
+} // namespace OwnCAD
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "geometry/GeometryValidator.h"
+#include <QDialog>
+#include <QDoubleSpinBox>
+
+namespace OwnCAD {
+namespace UI {
+
+/**
+ * @brief Dialog for the manufacturing limits checked by the validator
+ *
+ * Every limit shows "Off" at 0, which disables its rule. All limits start
+ * off because DXF files carry no reliable units; the hole size and edge
+ * length rules are only meaningful once the user confirms the drawing is
+ * in millimetres.
+ */
+class ManufacturingRulesDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit ManufacturingRulesDialog(const Geometry::ManufacturingRules& current,
+                                      QWidget* parent = nullptr);
+    ~ManufacturingRulesDialog() override = default;
+
+    /**
+     * @brief Get the configured limits
+     * @return Limits from user input (corner angle in radians)
+     */
+    Geometry::ManufacturingRules rules() const;
+
+private:
+    void setupUI(const Geometry::ManufacturingRules& current);
+    QDoubleSpinBox* addLimit(const QString& suffix, double maximum, double value);
+
+    QDoubleSpinBox* minHoleDiameterSpinBox_ = nullptr;
+    QDoubleSpinBox* kerfWidthSpinBox_ = nullptr;
+    QDoubleSpinBox* minFeatureSpacingSpinBox_ = nullptr;
+    QDoubleSpinBox* minEdgeLengthSpinBox_ = nullptr;
+    QDoubleSpinBox* minCornerAngleSpinBox_ = nullptr;
+};
+
+} // namespace UI
+} // namespace OwnCAD
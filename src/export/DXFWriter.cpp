@@ -1,30 +1,53 @@
 #include "export/DXFWriter.h"
+#include "import/DXFTokenizer.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <set>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace OwnCAD {
 namespace Export {
 
 using namespace OwnCAD::Import;
 
+namespace {
+
+/**
+ * @brief Write the low bytes of a value, least significant first
+ */
+void writeLittleEndian(std::ostream& out, uint64_t value, size_t bytes) {
+    char buffer[8];
+    for (size_t i = 0; i < bytes; ++i) {
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    out.write(buffer, static_cast<std::streamsize>(bytes));
+}
+
+} // namespace
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
 
 bool DXFWriter::writeFile(
     const std::string& filePath,
-    const std::vector<DXFEntity>& entities
+    const std::vector<DXFEntity>& entities,
+    DXFFormat format
 ) {
-    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    std::ios::openmode mode = std::ios::out | std::ios::trunc;
+    if (format == DXFFormat::Binary) {
+        mode |= std::ios::binary;
+    }
+    std::ofstream file(filePath, mode);
 
     if (!file.is_open()) {
         return false;
     }
 
-    bool success = writeStream(file, entities);
+    bool success = writeStream(file, entities, format);
     file.close();
 
     return success;
@@ -32,17 +55,24 @@ bool DXFWriter::writeFile(
 
 bool DXFWriter::writeStream(
     std::ostream& out,
-    const std::vector<DXFEntity>& entities
+    const std::vector<DXFEntity>& entities,
+    DXFFormat format
 ) {
     if (!out.good()) {
         return false;
     }
 
+    GroupOutput output{out, format == DXFFormat::Binary};
+    if (output.binary) {
+        out.write(DXFTokenizer::BINARY_SENTINEL.data(),
+                  static_cast<std::streamsize>(DXFTokenizer::BINARY_SENTINEL.size()));
+    }
+
     // Write DXF sections in order
-    writeHeader(out);
-    writeTables(out, entities);
-    writeEntities(out, entities);
-    writeFooter(out);
+    writeHeader(output);
+    writeTables(output, entities);
+    writeEntities(output, entities);
+    writeFooter(output);
 
     return out.good();
 }
@@ -51,7 +81,7 @@ bool DXFWriter::writeStream(
 // SECTION WRITERS
 // ============================================================================
 
-void DXFWriter::writeHeader(std::ostream& out) {
+void DXFWriter::writeHeader(GroupOutput& out) {
     writeGroup(out, 0, "SECTION");
     writeGroup(out, 2, "HEADER");
 
@@ -70,7 +100,7 @@ void DXFWriter::writeHeader(std::ostream& out) {
     writeGroup(out, 0, "ENDSEC");
 }
 
-void DXFWriter::writeTables(std::ostream& out, const std::vector<DXFEntity>& entities) {
+void DXFWriter::writeTables(GroupOutput& out, const std::vector<DXFEntity>& entities) {
     writeGroup(out, 0, "SECTION");
     writeGroup(out, 2, "TABLES");
 
@@ -123,7 +153,7 @@ void DXFWriter::writeTables(std::ostream& out, const std::vector<DXFEntity>& ent
     writeGroup(out, 0, "ENDSEC");
 }
 
-void DXFWriter::writeEntities(std::ostream& out, const std::vector<DXFEntity>& entities) {
+void DXFWriter::writeEntities(GroupOutput& out, const std::vector<DXFEntity>& entities) {
     writeGroup(out, 0, "SECTION");
     writeGroup(out, 2, "ENTITIES");
 
@@ -167,7 +197,7 @@ void DXFWriter::writeEntities(std::ostream& out, const std::vector<DXFEntity>& e
     writeGroup(out, 0, "ENDSEC");
 }
 
-void DXFWriter::writeFooter(std::ostream& out) {
+void DXFWriter::writeFooter(GroupOutput& out) {
     writeGroup(out, 0, "EOF");
 }
 
@@ -175,7 +205,7 @@ void DXFWriter::writeFooter(std::ostream& out) {
 // ENTITY WRITERS
 // ============================================================================
 
-void DXFWriter::writeLine(std::ostream& out, const DXFLine& line) {
+void DXFWriter::writeLine(GroupOutput& out, const DXFLine& line) {
     writeGroup(out, 0, "LINE");
 
     // Handle (entity ID)
@@ -200,7 +230,7 @@ void DXFWriter::writeLine(std::ostream& out, const DXFLine& line) {
     writeGroup(out, 31, line.endZ);
 }
 
-void DXFWriter::writeArc(std::ostream& out, const DXFArc& arc) {
+void DXFWriter::writeArc(GroupOutput& out, const DXFArc& arc) {
     writeGroup(out, 0, "ARC");
 
     // Handle
@@ -227,7 +257,7 @@ void DXFWriter::writeArc(std::ostream& out, const DXFArc& arc) {
     writeGroup(out, 51, arc.endAngle);
 }
 
-void DXFWriter::writeCircle(std::ostream& out, const DXFCircle& circle) {
+void DXFWriter::writeCircle(GroupOutput& out, const DXFCircle& circle) {
     writeGroup(out, 0, "CIRCLE");
 
     // Handle
@@ -250,7 +280,7 @@ void DXFWriter::writeCircle(std::ostream& out, const DXFCircle& circle) {
     writeGroup(out, 40, circle.radius);
 }
 
-void DXFWriter::writeLWPolyline(std::ostream& out, const DXFLWPolyline& polyline) {
+void DXFWriter::writeLWPolyline(GroupOutput& out, const DXFLWPolyline& polyline) {
     writeGroup(out, 0, "LWPOLYLINE");
 
     // Handle
@@ -282,7 +312,7 @@ void DXFWriter::writeLWPolyline(std::ostream& out, const DXFLWPolyline& polyline
     }
 }
 
-void DXFWriter::writeEllipse(std::ostream& out, const DXFEllipse& ellipse) {
+void DXFWriter::writeEllipse(GroupOutput& out, const DXFEllipse& ellipse) {
     writeGroup(out, 0, "ELLIPSE");
 
     // Handle
@@ -314,7 +344,7 @@ void DXFWriter::writeEllipse(std::ostream& out, const DXFEllipse& ellipse) {
     writeGroup(out, 42, ellipse.endParameter);
 }
 
-void DXFWriter::writePoint(std::ostream& out, const DXFPoint& point) {
+void DXFWriter::writePoint(GroupOutput& out, const DXFPoint& point) {
     writeGroup(out, 0, "POINT");
 
     // Handle
@@ -334,7 +364,7 @@ void DXFWriter::writePoint(std::ostream& out, const DXFPoint& point) {
     writeGroup(out, 30, point.z);
 }
 
-void DXFWriter::writeSolid(std::ostream& out, const DXFSolid& solid) {
+void DXFWriter::writeSolid(GroupOutput& out, const DXFSolid& solid) {
     writeGroup(out, 0, "SOLID");
 
     // Handle
@@ -375,22 +405,62 @@ void DXFWriter::writeSolid(std::ostream& out, const DXFSolid& solid) {
 // HELPER METHODS
 // ============================================================================
 
-void DXFWriter::writeGroup(std::ostream& out, int code, const std::string& value) {
-    out << std::setw(3) << std::setfill(' ') << code << "\n";
-    out << value << "\n";
+void DXFWriter::writeGroup(GroupOutput& out, int code, const std::string& value) {
+    if (out.binary) {
+        writeBinaryCode(out, code);
+        out.stream.write(value.c_str(), static_cast<std::streamsize>(value.size() + 1));  // With terminator
+        return;
+    }
+    out.stream << std::setw(3) << std::setfill(' ') << code << "\n";
+    out.stream << value << "\n";
 }
 
-void DXFWriter::writeGroup(std::ostream& out, int code, int value) {
-    out << std::setw(3) << std::setfill(' ') << code << "\n";
-    out << std::setw(6) << std::setfill(' ') << value << "\n";
+void DXFWriter::writeGroup(GroupOutput& out, int code, int value) {
+    if (out.binary) {
+        switch (DXFTokenizer::valueType(code)) {
+            case DXFValueType::Double:
+                writeGroup(out, code, static_cast<double>(value));
+                return;
+            case DXFValueType::Bool:
+                writeBinaryCode(out, code);
+                writeLittleEndian(out.stream, static_cast<uint64_t>(value != 0), 1);
+                return;
+            case DXFValueType::Int32:
+                writeBinaryCode(out, code);
+                writeLittleEndian(out.stream, static_cast<uint32_t>(value), 4);
+                return;
+            case DXFValueType::Int64:
+                writeBinaryCode(out, code);
+                writeLittleEndian(out.stream, static_cast<uint64_t>(static_cast<int64_t>(value)), 8);
+                return;
+            default:
+                writeBinaryCode(out, code);
+                writeLittleEndian(out.stream, static_cast<uint16_t>(value), 2);
+                return;
+        }
+    }
+    out.stream << std::setw(3) << std::setfill(' ') << code << "\n";
+    out.stream << std::setw(6) << std::setfill(' ') << value << "\n";
 }
 
-void DXFWriter::writeGroup(std::ostream& out, int code, double value) {
-    out << std::setw(3) << std::setfill(' ') << code << "\n";
+void DXFWriter::writeGroup(GroupOutput& out, int code, double value) {
+    if (out.binary) {
+        // Exact: the double's own bytes
+        uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeBinaryCode(out, code);
+        writeLittleEndian(out.stream, bits, 8);
+        return;
+    }
+    out.stream << std::setw(3) << std::setfill(' ') << code << "\n";
 
     // High precision: 15 decimal places (matches double precision)
     // Use fixed notation to avoid scientific notation for small values
-    out << std::fixed << std::setprecision(15) << value << "\n";
+    out.stream << std::fixed << std::setprecision(15) << value << "\n";
+}
+
+void DXFWriter::writeBinaryCode(GroupOutput& out, int code) {
+    writeLittleEndian(out.stream, static_cast<uint16_t>(code), 2);
 }
 
 std::vector<std::string> DXFWriter::extractLayers(const std::vector<DXFEntity>& entities) {
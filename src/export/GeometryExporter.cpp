@@ -16,6 +16,15 @@ ExportResult GeometryExporter::exportToDXF(
     const std::vector<GeometryEntityWithMetadata>& entities
 ) {
     ExportResult result;
+    appendToDXF(entities, result);
+    return result;
+}
+
+void GeometryExporter::appendToDXF(
+    const std::vector<GeometryEntityWithMetadata>& entities,
+    ExportResult& result
+) {
+    result.entities.reserve(result.entities.size() + entities.size());
 
     for (const auto& entityWithMeta : entities) {
         DXFEntity dxfEntity;
@@ -103,7 +112,6 @@ ExportResult GeometryExporter::exportToDXF(
     }
 
     result.success = result.errors.empty();
-    return result;
 }
 
 // ============================================================================
@@ -62,6 +62,13 @@ BoundingBox BoundingBox::fromLine(const Line2D& line) noexcept {
 }
 
 BoundingBox BoundingBox::fromArc(const Arc2D& arc) noexcept {
+    // Full circle: start and end angle coincide, so the crossing tests below
+    // would see an empty range
+    if (arc.isFullCircle()) {
+        return BoundingBox(arc.center().x() - arc.radius(), arc.center().y() - arc.radius(),
+                           arc.center().x() + arc.radius(), arc.center().y() + arc.radius());
+    }
+
     // Start with endpoints
     std::vector<Point2D> points;
     points.push_back(arc.startPoint());
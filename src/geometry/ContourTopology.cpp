@@ -0,0 +1,527 @@
+#include "geometry/ContourTopology.h"
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+// Closed contours per parallel nesting chunk
+constexpr size_t NESTING_CHUNK_SIZE = 256;
+
+// Maximum angle per chord when flattening arcs for point-in-polygon tests
+constexpr double FLATTEN_STEP = PI / 32.0;
+
+// Contours covering more nesting-grid cells than this are tested by every probe
+constexpr size_t MAX_CELLS_PER_CONTOUR = 16;
+
+// Cell coordinates are clamped so far-away points cannot overflow
+constexpr double MAX_CELL_COORD = 4.0e18;
+
+/**
+ * @brief Disjoint-set forest over endpoint indices
+ *
+ * The smaller index always becomes the root, so node numbering does not
+ * depend on the order unions happen in.
+ */
+class UnionFind {
+public:
+    explicit UnionFind(size_t count) : parent_(count) {
+        std::iota(parent_.begin(), parent_.end(), uint32_t(0));
+    }
+
+    uint32_t find(uint32_t x) {
+        while (parent_[x] != x) {
+            parent_[x] = parent_[parent_[x]];  // Path halving
+            x = parent_[x];
+        }
+        return x;
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a < b) {
+            parent_[b] = a;
+        } else if (b < a) {
+            parent_[a] = b;
+        }
+    }
+
+private:
+    std::vector<uint32_t> parent_;
+};
+
+struct CellKey {
+    int64_t x;
+    int64_t y;
+
+    bool operator==(const CellKey& other) const noexcept {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct CellKeyHash {
+    size_t operator()(const CellKey& key) const noexcept {
+        const uint64_t h = static_cast<uint64_t>(key.x) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (static_cast<uint64_t>(key.y) + 0x7F4A7C159E3779B9ULL + (h << 6) + (h >> 2)));
+    }
+};
+
+int64_t cellCoord(double value, double cellSize) noexcept {
+    const double cell = std::floor(value / cellSize);
+    return static_cast<int64_t>(std::clamp(cell, -MAX_CELL_COORD, MAX_CELL_COORD));
+}
+
+Point2D startOf(SegmentRef entity) noexcept {
+    if (const auto* line = entity.line()) {
+        return line->start();
+    }
+    return entity.arc()->startPoint();
+}
+
+Point2D endOf(SegmentRef entity) noexcept {
+    if (const auto* line = entity.line()) {
+        return line->end();
+    }
+    return entity.arc()->endPoint();
+}
+
+BoundingBox boundsOf(SegmentRef entity) noexcept {
+    if (const auto* line = entity.line()) {
+        return line->boundingBox();
+    }
+    return entity.arc()->boundingBox();
+}
+
+/**
+ * @brief Check if a segment whose ends snapped together still forms a loop
+ *
+ * Full (or nearly full) circles do; short lines and tiny arcs are
+ * degenerate and left out of the graph.
+ */
+bool isLoop(SegmentRef entity) noexcept {
+    const auto* arc = entity.arc();
+    return arc && arc->sweepAngle() > PI;
+}
+
+double cross(const Point2D& a, const Point2D& b) noexcept {
+    return a.x() * b.y() - a.y() * b.x();
+}
+
+/**
+ * @brief Signed area of a closed contour (shoelace with circular segments)
+ *
+ * Coordinates are taken relative to the first vertex to limit cancellation
+ * on sheets far from the origin.
+ */
+double signedAreaOf(const Contour& contour,
+                    const SegmentView& entities) noexcept {
+    const SegmentRef first = entities[contour.segments.front().entity];
+    const Point2D origin = contour.segments.front().reversed ? endOf(first) : startOf(first);
+
+    double twiceArea = 0.0;
+    for (const auto& segment : contour.segments) {
+        const SegmentRef entity = entities[segment.entity];
+        Point2D from = segment.reversed ? endOf(entity) : startOf(entity);
+        Point2D to = segment.reversed ? startOf(entity) : endOf(entity);
+        from = Point2D(from.x() - origin.x(), from.y() - origin.y());
+        to = Point2D(to.x() - origin.x(), to.y() - origin.y());
+        twiceArea += cross(from, to);
+
+        if (const auto* arc = entity.arc()) {
+            // Circular segment between chord and arc, signed by travel direction
+            double theta = arc->sweepAngle();
+            if (arc->isCounterClockwise() == segment.reversed) {
+                theta = -theta;
+            }
+            twiceArea += arc->radius() * arc->radius() * (theta - std::sin(theta));
+        }
+    }
+    return twiceArea * 0.5;
+}
+
+/**
+ * @brief Append a segment as polygon vertices (its end point excluded)
+ */
+void flatten(SegmentRef entity, bool reversed,
+             std::vector<Point2D>& polygon) {
+    if (const auto* line = entity.line()) {
+        polygon.push_back(reversed ? line->end() : line->start());
+        return;
+    }
+
+    const Arc2D& arc = *entity.arc();
+    const size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(arc.sweepAngle() / FLATTEN_STEP)));
+    for (size_t i = 0; i < steps; ++i) {
+        const double t = static_cast<double>(i) / static_cast<double>(steps);
+        polygon.push_back(arc.pointAt(reversed ? 1.0 - t : t));
+    }
+}
+
+/**
+ * @brief A point on a contour's first segment, away from its vertices
+ */
+Point2D probeOf(const Contour& contour, const SegmentView& entities) {
+    const SegmentRef entity = entities[contour.segments.front().entity];
+    if (const auto* line = entity.line()) {
+        return line->pointAt(0.5);
+    }
+    return entity.arc()->pointAt(0.5);
+}
+
+} // namespace
+
+// ============================================================================
+// CONTOUR
+// ============================================================================
+
+double Contour::area() const noexcept {
+    return std::abs(signedArea);
+}
+
+// ============================================================================
+// BUILD
+// ============================================================================
+
+ContourTopology ContourTopology::build(const SegmentView& entities,
+                                       double tolerance, size_t threadCount) {
+    ContourTopology topology;
+    topology.tolerance_ = tolerance;
+    topology.contourOfEntity_.assign(entities.size(), NONE);
+    topology.positionOfEntity_.assign(entities.size(), NONE);
+
+    // ------------------------------------------------------------------
+    // Usable segments and their endpoints (2k = start, 2k + 1 = end)
+    // ------------------------------------------------------------------
+    std::vector<size_t> segmentEntity;
+    std::vector<Point2D> endpoints;
+    segmentEntity.reserve(entities.size());
+    endpoints.reserve(entities.size() * 2);
+
+    entities.forEach(0, entities.size(), [&](size_t i, SegmentRef entity) {
+        const Point2D start = startOf(entity);
+        const Point2D end = endOf(entity);
+        if (!start.isValid() || !end.isValid()) {
+            return;
+        }
+        segmentEntity.push_back(i);
+        endpoints.push_back(start);
+        endpoints.push_back(end);
+    });
+
+    // ------------------------------------------------------------------
+    // Snap endpoints: union every pair within tolerance (3x3 cell search)
+    // ------------------------------------------------------------------
+    const double cellSize = std::max(tolerance, GEOMETRY_EPSILON);
+    const double toleranceSquared = tolerance * tolerance;
+    const uint32_t NO_POINT = UINT32_MAX;
+
+    UnionFind sets(endpoints.size());
+    std::unordered_map<CellKey, uint32_t, CellKeyHash> cellHeads;
+    std::vector<uint32_t> nextInCell(endpoints.size(), NO_POINT);
+    cellHeads.reserve(endpoints.size());
+
+    for (uint32_t i = 0; i < endpoints.size(); ++i) {
+        const Point2D& point = endpoints[i];
+        const int64_t cx = cellCoord(point.x(), cellSize);
+        const int64_t cy = cellCoord(point.y(), cellSize);
+
+        for (int64_t dx = -1; dx <= 1; ++dx) {
+            for (int64_t dy = -1; dy <= 1; ++dy) {
+                auto it = cellHeads.find({cx + dx, cy + dy});
+                if (it == cellHeads.end()) {
+                    continue;
+                }
+                for (uint32_t j = it->second; j != NO_POINT; j = nextInCell[j]) {
+                    const double ex = endpoints[j].x() - point.x();
+                    const double ey = endpoints[j].y() - point.y();
+                    if (ex * ex + ey * ey <= toleranceSquared) {
+                        sets.unite(i, j);
+                    }
+                }
+            }
+        }
+
+        auto [head, inserted] = cellHeads.try_emplace({cx, cy}, i);
+        if (!inserted) {
+            nextInCell[i] = head->second;
+            head->second = i;
+        }
+    }
+
+    // Number nodes by first endpoint; position = mean of snapped endpoints
+    std::vector<uint32_t> nodeOfPoint(endpoints.size());
+    {
+        std::vector<uint32_t> nodeOfRoot(endpoints.size(), NO_POINT);
+        std::vector<size_t> members;
+        for (uint32_t i = 0; i < endpoints.size(); ++i) {
+            const uint32_t root = sets.find(i);
+            if (nodeOfRoot[root] == NO_POINT) {
+                nodeOfRoot[root] = static_cast<uint32_t>(topology.nodes_.size());
+                topology.nodes_.emplace_back(0.0, 0.0);
+                members.push_back(0);
+            }
+            const uint32_t node = nodeOfRoot[root];
+            nodeOfPoint[i] = node;
+            const Point2D& sum = topology.nodes_[node];
+            topology.nodes_[node] = Point2D(sum.x() + endpoints[i].x(), sum.y() + endpoints[i].y());
+            members[node]++;
+        }
+        for (size_t node = 0; node < topology.nodes_.size(); ++node) {
+            const double count = static_cast<double>(members[node]);
+            topology.nodes_[node] = Point2D(topology.nodes_[node].x() / count,
+                                            topology.nodes_[node].y() / count);
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Endpoint graph: incidence 2k / 2k + 1 = segment k at its start / end
+    // ------------------------------------------------------------------
+    const size_t segmentCount = segmentEntity.size();
+    const size_t nodeCount = topology.nodes_.size();
+    std::vector<bool> inGraph(segmentCount, true);
+    topology.nodeDegrees_.assign(nodeCount, 0);
+
+    for (size_t k = 0; k < segmentCount; ++k) {
+        const uint32_t a = nodeOfPoint[2 * k];
+        const uint32_t b = nodeOfPoint[2 * k + 1];
+        if (a == b && !isLoop(entities[segmentEntity[k]])) {
+            inGraph[k] = false;  // Degenerate: shorter than the snapping tolerance
+            continue;
+        }
+        topology.nodeDegrees_[a]++;
+        topology.nodeDegrees_[b]++;
+    }
+
+    std::vector<size_t> incidenceStart(nodeCount + 1, 0);
+    for (size_t node = 0; node < nodeCount; ++node) {
+        incidenceStart[node + 1] = incidenceStart[node] + topology.nodeDegrees_[node];
+    }
+    std::vector<size_t> incidences(incidenceStart[nodeCount]);
+    {
+        std::vector<size_t> fill(incidenceStart.begin(), incidenceStart.end() - 1);
+        for (size_t k = 0; k < segmentCount; ++k) {
+            if (inGraph[k]) {
+                incidences[fill[nodeOfPoint[2 * k]]++] = 2 * k;
+                incidences[fill[nodeOfPoint[2 * k + 1]]++] = 2 * k + 1;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Chain segments through degree-2 nodes
+    // ------------------------------------------------------------------
+    std::vector<bool> used(segmentCount, false);
+
+    auto walk = [&](uint32_t startNode, size_t incidence) {
+        Contour contour;
+        contour.startNode = startNode;
+
+        uint32_t node = startNode;
+        for (;;) {
+            const size_t k = incidence / 2;
+            const bool forward = incidence % 2 == 0;
+            used[k] = true;
+            contour.segments.push_back({segmentEntity[k], !forward});
+            contour.bounds = contour.bounds.merge(boundsOf(entities[segmentEntity[k]]));
+
+            const size_t arrival = incidence ^ 1;  // Far end of the segment
+            node = nodeOfPoint[arrival];
+            if (node == startNode || topology.nodeDegrees_[node] != 2) {
+                break;
+            }
+
+            // Leave through the node's other incidence
+            const size_t first = incidences[incidenceStart[node]];
+            const size_t next = first != arrival ? first : incidences[incidenceStart[node] + 1];
+            if (used[next / 2]) {
+                break;
+            }
+            incidence = next;
+        }
+
+        contour.endNode = node;
+        contour.closed = node == startNode;
+        const size_t index = topology.contours_.size();
+        for (size_t position = 0; position < contour.segments.size(); ++position) {
+            topology.contourOfEntity_[contour.segments[position].entity] = index;
+            topology.positionOfEntity_[contour.segments[position].entity] = position;
+        }
+        topology.contours_.push_back(std::move(contour));
+    };
+
+    // Chains start at free ends and branches...
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        if (topology.nodeDegrees_[node] == 2) {
+            continue;
+        }
+        for (size_t i = incidenceStart[node]; i < incidenceStart[node + 1]; ++i) {
+            if (!used[incidences[i] / 2]) {
+                walk(node, incidences[i]);
+            }
+        }
+    }
+    // ...whatever is left are cycles through degree-2 nodes only
+    for (size_t k = 0; k < segmentCount; ++k) {
+        if (inGraph[k] && !used[k]) {
+            walk(nodeOfPoint[2 * k], 2 * k);
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Nesting of closed contours
+    // ------------------------------------------------------------------
+    std::vector<size_t> closed;
+    for (size_t c = 0; c < topology.contours_.size(); ++c) {
+        Contour& contour = topology.contours_[c];
+        if (contour.closed) {
+            contour.signedArea = signedAreaOf(contour, entities);
+            closed.push_back(c);
+        }
+    }
+    topology.closedCount_ = closed.size();
+    if (closed.empty()) {
+        return topology;
+    }
+
+    // Rank by area, largest first: only a larger contour can enclose another
+    std::sort(closed.begin(), closed.end(), [&topology](size_t a, size_t b) {
+        const double areaA = topology.contours_[a].area();
+        const double areaB = topology.contours_[b].area();
+        return areaA != areaB ? areaA > areaB : a < b;
+    });
+
+    std::vector<std::vector<Point2D>> polygons(closed.size());
+    BoundingBox extent;
+    for (size_t rank = 0; rank < closed.size(); ++rank) {
+        const Contour& contour = topology.contours_[closed[rank]];
+        polygons[rank] = outline(contour, entities);
+        extent = extent.merge(contour.bounds);
+    }
+
+    // Coarse grid of contour bounds; each cell lists contours by rank
+    const size_t gridSize = std::clamp<size_t>(
+        static_cast<size_t>(std::sqrt(static_cast<double>(closed.size()))), 1, 1024);
+    const double cellWidth = std::max(extent.width() / static_cast<double>(gridSize), GEOMETRY_EPSILON);
+    const double cellHeight = std::max(extent.height() / static_cast<double>(gridSize), GEOMETRY_EPSILON);
+    auto column = [&](double x) {
+        return std::min(gridSize - 1, static_cast<size_t>(std::max(0.0, (x - extent.minX()) / cellWidth)));
+    };
+    auto row = [&](double y) {
+        return std::min(gridSize - 1, static_cast<size_t>(std::max(0.0, (y - extent.minY()) / cellHeight)));
+    };
+
+    std::vector<std::vector<size_t>> cells(gridSize * gridSize);
+    std::vector<size_t> large;  // Ranks of contours covering many cells
+    for (size_t rank = 0; rank < closed.size(); ++rank) {
+        const BoundingBox& bounds = topology.contours_[closed[rank]].bounds;
+        const size_t x0 = column(bounds.minX());
+        const size_t x1 = column(bounds.maxX());
+        const size_t y0 = row(bounds.minY());
+        const size_t y1 = row(bounds.maxY());
+        if ((x1 - x0 + 1) * (y1 - y0 + 1) > MAX_CELLS_PER_CONTOUR) {
+            large.push_back(rank);
+            continue;
+        }
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) {
+                cells[y * gridSize + x].push_back(rank);
+            }
+        }
+    }
+
+    // Parent = smallest larger contour containing a probe point. Candidates
+    // are tried from the highest rank down, so the first hit is innermost.
+    std::vector<size_t> parentRank(closed.size(), NONE);
+    const size_t chunkCount = (closed.size() + NESTING_CHUNK_SIZE - 1) / NESTING_CHUNK_SIZE;
+    ParallelExecutor::forEachChunk(chunkCount, threadCount, [&](size_t chunk, size_t) {
+        const size_t begin = chunk * NESTING_CHUNK_SIZE;
+        const size_t end = std::min(begin + NESTING_CHUNK_SIZE, closed.size());
+        for (size_t rank = begin; rank < end; ++rank) {
+            const Point2D probe = probeOf(topology.contours_[closed[rank]], entities);
+            const auto& cell = cells[row(probe.y()) * gridSize + column(probe.x())];
+
+            auto a = std::lower_bound(cell.begin(), cell.end(), rank);
+            auto b = std::lower_bound(large.begin(), large.end(), rank);
+            while (a != cell.begin() || b != large.begin()) {
+                size_t candidate;
+                if (b == large.begin() || (a != cell.begin() && *(a - 1) > *(b - 1))) {
+                    candidate = *--a;
+                } else {
+                    candidate = *--b;
+                }
+                const BoundingBox& bounds = topology.contours_[closed[candidate]].bounds;
+                if (bounds.contains(probe) && containsPoint(polygons[candidate], probe)) {
+                    parentRank[rank] = candidate;
+                    break;
+                }
+            }
+        }
+    });
+
+    // Depths follow rank order, since parents always rank before children
+    for (size_t rank = 0; rank < closed.size(); ++rank) {
+        Contour& contour = topology.contours_[closed[rank]];
+        if (parentRank[rank] == NONE) {
+            topology.roots_.push_back(closed[rank]);
+            continue;
+        }
+        Contour& parent = topology.contours_[closed[parentRank[rank]]];
+        contour.parent = closed[parentRank[rank]];
+        contour.depth = parent.depth + 1;
+        parent.children.push_back(closed[rank]);
+    }
+
+    std::sort(topology.roots_.begin(), topology.roots_.end());
+    for (size_t c : closed) {
+        auto& children = topology.contours_[c].children;
+        std::sort(children.begin(), children.end());
+    }
+    return topology;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+std::vector<Point2D> ContourTopology::outline(const Contour& contour,
+                                              const SegmentView& entities) {
+    std::vector<Point2D> polygon;
+    polygon.reserve(contour.segments.size());
+    for (const auto& segment : contour.segments) {
+        flatten(entities[segment.entity], segment.reversed, polygon);
+    }
+    return polygon;
+}
+
+bool ContourTopology::containsPoint(const std::vector<Point2D>& polygon, const Point2D& point) noexcept {
+    bool inside = false;
+    const size_t count = polygon.size();
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        const Point2D& a = polygon[i];
+        const Point2D& b = polygon[j];
+        if ((a.y() > point.y()) != (b.y() > point.y())) {
+            const double x = a.x() + (point.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+            if (point.x() < x) {
+                inside = !inside;
+            }
+        }
+    }
+    return inside;
+}
+
+size_t ContourTopology::contourOf(size_t entity) const noexcept {
+    return entity < contourOfEntity_.size() ? contourOfEntity_[entity] : NONE;
+}
+
+size_t ContourTopology::positionOf(size_t entity) const noexcept {
+    return entity < positionOfEntity_.size() ? positionOfEntity_[entity] : NONE;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
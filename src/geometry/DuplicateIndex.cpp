@@ -0,0 +1,754 @@
+#include "geometry/DuplicateIndex.h"
+#include "geometry/GeometryConstants.h"
+#include "geometry/GeometryMath.h"
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+// Upper bound on the number of offset cells a single line may span.
+// The cell height grows until the thickest line fits, which keeps the
+// insertion cost linear even for very long sheet-edge lines.
+constexpr double MAX_CELLS_PER_LINE = 4096.0;
+
+// With fewer direction buckets than this, adjacent buckets wrap onto
+// each other and bucketing no longer prunes anything.
+constexpr size_t MIN_DIRECTION_BUCKETS = 3;
+
+// Keeps bucket ids representable when tolerance/length ratios are extreme.
+constexpr double MAX_DIRECTION_BUCKETS = 1.0e15;
+
+// Smallest unit of work handed to a worker; below this threads cost more
+// than they save.
+constexpr size_t PARALLEL_MIN_CHUNK = 2048;
+
+// Direction buckets are sized for the line at this length percentile
+// (1/20 = 5th); shorter lines go through the short-line pass instead.
+constexpr size_t SHORT_LINE_PERCENTILE_DIVISOR = 20;
+
+// The short-line grid is at least mean length / this, which caps the cells
+// a long line walks at about this many per mean length.
+constexpr double SHORT_GRID_CELLS_PER_MEAN = 4.0;
+
+int64_t cellOf(double value, double cellSize) noexcept {
+    constexpr double LIMIT = 4.0e18;
+    const double cell = std::floor(value / cellSize);
+    return static_cast<int64_t>(std::clamp(cell, -LIMIT, LIMIT));
+}
+
+/**
+ * @brief Polls a cancellation token every CANCEL_CHECK_CELLS calls
+ *
+ * One per loop (and per worker), so polling needs no synchronisation
+ * beyond the token's own atomic flag.
+ */
+class CancelPoll {
+public:
+    explicit CancelPoll(const CancellationToken* token) noexcept : token_(token) {}
+
+    /**
+     * @brief Count one cell; true once the token is seen cancelled
+     *
+     * The first call polls, so a worker never starts on a cancelled run.
+     */
+    bool stop() noexcept {
+        if (token_ && cells_++ % CANCEL_CHECK_CELLS == 0) {
+            stopped_ = token_->isCancelled();
+        }
+        return stopped_;
+    }
+
+private:
+    const CancellationToken* token_;
+    size_t cells_ = 0;
+    bool stopped_ = false;
+};
+
+/**
+ * @brief Quantized (x, y) cell of the short-line grid
+ */
+struct PlaneCellKey {
+    int64_t x;
+    int64_t y;
+
+    bool operator==(const PlaneCellKey& other) const noexcept {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct PlaneCellKeyHash {
+    size_t operator()(const PlaneCellKey& key) const noexcept {
+        const uint64_t h = static_cast<uint64_t>(key.x) * 73856093ULL ^
+                           static_cast<uint64_t>(key.y) * 19349663ULL;
+        return static_cast<size_t>(h);
+    }
+};
+
+/**
+ * @brief Line extents in the reference frame of one direction bucket
+ */
+struct SweepItem {
+    size_t entry;
+    bool guest;      ///< Belongs to the next bucket (only paired with homes)
+    double oLo, oHi; ///< Offset extent (perpendicular to the frame)
+    double uLo, uHi; ///< Extent along the frame direction
+};
+
+struct CellRef {
+    int64_t cell;
+    double uLo;
+    size_t item;
+};
+
+// Minimum angular tolerance used by areArcsDuplicate/areArcsCoincident
+constexpr double MIN_ANGLE_TOLERANCE = 1e-12;
+
+// Extra angular padding that absorbs rounding when ranges are unrolled
+constexpr double ANGLE_PAD_EPSILON = 1e-9;
+
+/**
+ * @brief Quantized (center x, center y, radius) cell of an arc
+ */
+struct ArcCellKey {
+    int64_t x;
+    int64_t y;
+    int64_t r;
+
+    bool operator==(const ArcCellKey& other) const noexcept {
+        return x == other.x && y == other.y && r == other.r;
+    }
+};
+
+struct ArcCellKeyHash {
+    size_t operator()(const ArcCellKey& key) const noexcept {
+        const uint64_t h = static_cast<uint64_t>(key.x) * 73856093ULL ^
+                           static_cast<uint64_t>(key.y) * 19349663ULL ^
+                           static_cast<uint64_t>(key.r) * 83492791ULL;
+        return static_cast<size_t>(h);
+    }
+};
+
+// The 13 neighbours that follow a cell in lexicographic order. Visiting only
+// these (plus the cell itself) combines every pair of adjacent cells once.
+constexpr std::array<std::array<int64_t, 3>, 13> FORWARD_NEIGHBOURS = {{
+    {{0, 0, 1}},
+    {{0, 1, -1}}, {{0, 1, 0}}, {{0, 1, 1}},
+    {{1, -1, -1}}, {{1, -1, 0}}, {{1, -1, 1}},
+    {{1, 0, -1}}, {{1, 0, 0}}, {{1, 0, 1}},
+    {{1, 1, -1}}, {{1, 1, 0}}, {{1, 1, 1}}
+}};
+
+/**
+ * @brief Padded angular range of an arc on the unrolled circle
+ */
+struct AngularItem {
+    double lo;
+    double hi;
+    size_t entry;
+    bool guest;  ///< Belongs to a neighbour cell (only paired with homes)
+};
+
+} // namespace
+
+// ============================================================================
+// LINE DUPLICATE INDEX
+// ============================================================================
+
+LineDuplicateIndex::LineDuplicateIndex(double tolerance) noexcept
+    : tolerance_(tolerance) {
+}
+
+void LineDuplicateIndex::reserve(size_t count) {
+    entries_.reserve(count);
+}
+
+void LineDuplicateIndex::insert(size_t entityIndex, const Line2D& line) {
+    const double dx = line.end().x() - line.start().x();
+    const double dy = line.end().y() - line.start().y();
+
+    // Fold direction into [0, π) - duplicates may be reversed
+    double angle = std::atan2(dy, dx);
+    if (angle < 0.0) angle += PI;
+    if (angle >= PI) angle -= PI;
+
+    entries_.push_back({entityIndex, &line, angle, line.length()});
+}
+
+std::vector<DuplicatePair> LineDuplicateIndex::findPairs(size_t threadCount,
+                                                        const CancellationToken* cancellation) const {
+    std::vector<DuplicatePair> pairs;
+
+    const size_t n = entries_.size();
+    // Both predicates compare with strict '<' against tolerance, so a
+    // non-positive tolerance can never match anything.
+    if (n < 2 || !(tolerance_ > 0.0)) {
+        return pairs;
+    }
+
+    // ------------------------------------------------------------------
+    // Direction bucket width
+    // ------------------------------------------------------------------
+    // For any accepted pair, both endpoints of one line lie within tol
+    // (overlap) or within √2·tol (duplicate) of the other line's axis.
+    // The undirected angle between them is therefore below
+    // asin(2√2·tol / len) <= 2π·tol / len for the shorter one. Sizing the
+    // buckets for the shortest line would let a single stray sliver
+    // collapse the whole index into one bucket, so they are sized for the
+    // 5th-percentile length instead and lines shorter than that are
+    // paired by findShortLinePairs().
+    double maxLength = 0.0;
+    double totalLength = 0.0;
+    std::vector<double> lengths;
+    lengths.reserve(n);
+    for (const auto& entry : entries_) {
+        maxLength = std::max(maxLength, entry.length);
+        totalLength += entry.length;
+        lengths.push_back(entry.length);
+    }
+
+    const size_t p5 = n / SHORT_LINE_PERCENTILE_DIVISOR;
+    std::nth_element(lengths.begin(), lengths.begin() + p5, lengths.end());
+    const double shortLength = lengths[p5];
+
+    double width = PI;
+    if (shortLength > 0.0) {
+        width = std::min(PI, 2.0 * PI * tolerance_ / shortLength);
+    }
+    size_t bucketCount = 1;
+    if (width > 0.0) {
+        bucketCount = static_cast<size_t>(std::min(PI / width, MAX_DIRECTION_BUCKETS));
+    }
+    if (bucketCount < MIN_DIRECTION_BUCKETS) {
+        bucketCount = 1;
+    }
+    width = PI / static_cast<double>(bucketCount);
+
+    // ------------------------------------------------------------------
+    // Offset cell height
+    // ------------------------------------------------------------------
+    // A line deviates at most `width` from its grid frame, so its offset
+    // extent is length * sin(width). Size cells for the 90th percentile
+    // line so typical lines touch one or two cells.
+    const double spread = (bucketCount == 1) ? 1.0 : std::min(1.0, width);
+    const size_t p90 = (n * 9) / 10;
+    std::nth_element(lengths.begin(), lengths.begin() + p90, lengths.end());
+    const double cellHeight = std::max({
+        8.0 * tolerance_,
+        spread * lengths[p90],
+        spread * maxLength / MAX_CELLS_PER_LINE
+    });
+
+    // ------------------------------------------------------------------
+    // Lines below the percentile: every pair they are part of
+    // ------------------------------------------------------------------
+    const size_t threads = std::min(ParallelExecutor::resolveThreadCount(threadCount),
+                                    (n + PARALLEL_MIN_CHUNK - 1) / PARALLEL_MIN_CHUNK);
+
+    std::vector<size_t> shortEntries;
+    for (size_t e = 0; e < n; ++e) {
+        if (entries_[e].length < shortLength) {
+            shortEntries.push_back(e);
+        }
+    }
+    if (!shortEntries.empty()) {
+        findShortLinePairs(shortEntries, shortLength, totalLength / static_cast<double>(n),
+                           threads, cancellation, pairs);
+        if (cancellation && cancellation->isCancelled()) {
+            return pairs;
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Group the remaining entries by direction bucket
+    // ------------------------------------------------------------------
+    std::vector<std::pair<size_t, size_t>> byBucket;  // (bucket, entry)
+    byBucket.reserve(n - shortEntries.size());
+    for (size_t e = 0; e < n; ++e) {
+        if (entries_[e].length < shortLength) {
+            continue;
+        }
+        const size_t bucket = std::min(
+            bucketCount - 1,
+            static_cast<size_t>(entries_[e].angle / width));
+        byBucket.emplace_back(bucket, e);
+    }
+    std::sort(byBucket.begin(), byBucket.end());
+
+    auto bucketRange = [&byBucket](size_t bucket) {
+        auto lo = std::lower_bound(byBucket.begin(), byBucket.end(),
+                                   std::make_pair(bucket, size_t(0)));
+        auto hi = std::lower_bound(lo, byBucket.end(),
+                                   std::make_pair(bucket + 1, size_t(0)));
+        return std::make_pair(lo, hi);
+    };
+
+    // ------------------------------------------------------------------
+    // One grid per direction bucket: its own lines ("homes") plus the
+    // lines of the next bucket ("guests"), so near-parallel lines that
+    // straddle a bucket boundary are still compared. Guest-guest pairs
+    // are skipped; they are homes of the next grid.
+    // ------------------------------------------------------------------
+    struct Scratch {
+        std::vector<SweepItem> items;
+        std::vector<CellRef> refs;
+    };
+
+    auto buildGrid = [&](size_t bucket, size_t homeBegin, size_t homeEnd, Scratch& scratch) {
+        // Frame on the boundary between this bucket and the next one
+        const double frameAngle = (bucketCount == 1)
+            ? 0.0 : static_cast<double>(bucket + 1) * width;
+        const double ux = std::cos(frameAngle);
+        const double uy = std::sin(frameAngle);
+
+        auto& items = scratch.items;
+        items.clear();
+        auto addItem = [&](size_t entry, bool guest) {
+            const Line2D& line = *entries_[entry].line;
+            const double o1 = -uy * line.start().x() + ux * line.start().y();
+            const double o2 = -uy * line.end().x() + ux * line.end().y();
+            const double u1 = ux * line.start().x() + uy * line.start().y();
+            const double u2 = ux * line.end().x() + uy * line.end().y();
+            items.push_back({
+                entry, guest,
+                std::min(o1, o2) - tolerance_, std::max(o1, o2) + tolerance_,
+                std::min(u1, u2) - tolerance_, std::max(u1, u2) + tolerance_
+            });
+        };
+
+        for (size_t h = homeBegin; h < homeEnd; ++h) {
+            addItem(byBucket[h].second, false);
+        }
+        if (bucketCount >= MIN_DIRECTION_BUCKETS) {
+            auto guests = bucketRange((bucket + 1) % bucketCount);
+            for (auto g = guests.first; g != guests.second; ++g) {
+                addItem(g->second, true);
+            }
+        }
+
+        auto& refs = scratch.refs;
+        refs.clear();
+        for (size_t k = 0; k < items.size(); ++k) {
+            const int64_t first = cellOf(items[k].oLo, cellHeight);
+            const int64_t last = cellOf(items[k].oHi, cellHeight);
+            for (int64_t cell = first; cell <= last; ++cell) {
+                refs.push_back({cell, items[k].uLo, k});
+            }
+        }
+        std::sort(refs.begin(), refs.end(), [](const CellRef& a, const CellRef& b) {
+            if (a.cell != b.cell) return a.cell < b.cell;
+            return a.uLo < b.uLo;
+        });
+    };
+
+    // Sweep refs[runStart, runEnd) - one offset cell - along the frame direction
+    auto sweepCell = [&](const Scratch& scratch, size_t runStart, size_t runEnd,
+                         std::vector<DuplicatePair>& out) {
+        const auto& items = scratch.items;
+        const auto& refs = scratch.refs;
+        const int64_t cell = refs[runStart].cell;
+
+        for (size_t k = runStart; k < runEnd; ++k) {
+            const SweepItem& a = items[refs[k].item];
+            for (size_t m = k + 1; m < runEnd && refs[m].uLo <= a.uHi; ++m) {
+                const SweepItem& b = items[refs[m].item];
+                if (a.guest && b.guest) {
+                    continue;
+                }
+
+                // Offset ranges must overlap; report the pair only in the
+                // cell holding the start of that overlap (both lines are
+                // guaranteed to be registered there).
+                const double overlapLo = std::max(a.oLo, b.oLo);
+                if (overlapLo > std::min(a.oHi, b.oHi) ||
+                    cellOf(overlapLo, cellHeight) != cell) {
+                    continue;
+                }
+
+                const Entry& ea = entries_[a.entry];
+                const Entry& eb = entries_[b.entry];
+                const Entry& lower = (ea.entityIndex < eb.entityIndex) ? ea : eb;
+                const Entry& higher = (ea.entityIndex < eb.entityIndex) ? eb : ea;
+
+                if (GeometryValidator::areLinesDuplicate(*lower.line, *higher.line, tolerance_)) {
+                    out.push_back({lower.entityIndex, higher.entityIndex,
+                                   GeometryIssueType::DuplicateLine});
+                } else if (GeometryValidator::areLinesOverlapping(*lower.line, *higher.line, tolerance_)) {
+                    out.push_back({lower.entityIndex, higher.entityIndex,
+                                   GeometryIssueType::OverlappingLines});
+                }
+            }
+        }
+    };
+
+    auto sweepGrid = [&](const Scratch& scratch, std::vector<DuplicatePair>& out, CancelPoll& poll) {
+        const auto& refs = scratch.refs;
+        size_t runStart = 0;
+        while (runStart < refs.size() && !poll.stop()) {
+            size_t runEnd = runStart;
+            while (runEnd < refs.size() && refs[runEnd].cell == refs[runStart].cell) ++runEnd;
+            sweepCell(scratch, runStart, runEnd, out);
+            runStart = runEnd;
+        }
+    };
+
+    // Home ranges [begin, end) of byBucket, one per non-empty bucket
+    std::vector<std::pair<size_t, size_t>> grids;
+    for (size_t begin = 0; begin < byBucket.size();) {
+        size_t end = begin;
+        while (end < byBucket.size() && byBucket[end].first == byBucket[begin].first) ++end;
+        grids.emplace_back(begin, end);
+        begin = end;
+    }
+
+    if (threads <= 1) {
+        Scratch scratch;
+        CancelPoll poll(cancellation);
+        for (const auto& grid : grids) {
+            if (poll.stop()) {
+                break;
+            }
+            buildGrid(byBucket[grid.first].first, grid.first, grid.second, scratch);
+            sweepGrid(scratch, pairs, poll);
+        }
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+
+    // ------------------------------------------------------------------
+    // Parallel: CAD drawings concentrate most lines in a few directions
+    // (0° and 90°), so large grids split their offset cells across the
+    // workers while the many small grids are spread over workers whole.
+    // Every cell run is swept exactly once either way, so the sorted
+    // output equals the serial one.
+    // ------------------------------------------------------------------
+    const size_t largeGrid = std::max<size_t>(PARALLEL_MIN_CHUNK, n / threads);
+    std::vector<std::vector<DuplicatePair>> chunkPairs;
+    std::vector<size_t> smallGrids;
+    Scratch shared;
+
+    for (size_t g = 0; g < grids.size(); ++g) {
+        if (cancellation && cancellation->isCancelled()) {
+            return pairs;
+        }
+        if (grids[g].second - grids[g].first < largeGrid) {
+            smallGrids.push_back(g);
+            continue;
+        }
+        buildGrid(byBucket[grids[g].first].first, grids[g].first, grids[g].second, shared);
+
+        // Chunk boundaries fall on cell-run boundaries
+        std::vector<size_t> cuts{0};
+        const size_t target = std::max<size_t>(PARALLEL_MIN_CHUNK, shared.refs.size() / (threads * 4));
+        for (size_t r = 0; r < shared.refs.size();) {
+            size_t end = std::min(r + target, shared.refs.size());
+            while (end < shared.refs.size() && shared.refs[end].cell == shared.refs[end - 1].cell) ++end;
+            cuts.push_back(end);
+            r = end;
+        }
+
+        const size_t base = chunkPairs.size();
+        chunkPairs.resize(base + cuts.size() - 1);
+        ParallelExecutor::forEachChunk(cuts.size() - 1, threads, [&](size_t chunk, size_t) {
+            auto& out = chunkPairs[base + chunk];
+            CancelPoll poll(cancellation);
+            size_t runStart = cuts[chunk];
+            while (runStart < cuts[chunk + 1] && !poll.stop()) {
+                size_t runEnd = runStart;
+                while (runEnd < cuts[chunk + 1] && shared.refs[runEnd].cell == shared.refs[runStart].cell) ++runEnd;
+                sweepCell(shared, runStart, runEnd, out);
+                runStart = runEnd;
+            }
+        });
+    }
+
+    if (!smallGrids.empty()) {
+        std::vector<Scratch> scratch(threads);
+        const size_t base = chunkPairs.size();
+        chunkPairs.resize(base + smallGrids.size());
+        ParallelExecutor::forEachChunk(smallGrids.size(), threads, [&](size_t chunk, size_t worker) {
+            const auto& grid = grids[smallGrids[chunk]];
+            CancelPoll poll(cancellation);
+            buildGrid(byBucket[grid.first].first, grid.first, grid.second, scratch[worker]);
+            sweepGrid(scratch[worker], chunkPairs[base + chunk], poll);
+        });
+    }
+
+    for (const auto& chunk : chunkPairs) {
+        pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+void LineDuplicateIndex::findShortLinePairs(const std::vector<size_t>& shortEntries,
+                                            double shortLength, double meanLength,
+                                            size_t threads, const CancellationToken* cancellation,
+                                            std::vector<DuplicatePair>& out) const {
+    // Every accepted pair comes within tol (2·tol per axis for duplicates)
+    // of each other: some point of one line projects inside the other and
+    // lies within tol of its axis. Short lines are hashed by the grid cells
+    // their bounding box touches; a cell is at least shortLength wide, so
+    // that is at most four cells. Every line then walks the cells within
+    // 2·tol of itself and tests the short lines found there.
+    const double cellSize = std::max({shortLength, 8.0 * tolerance_,
+                                      meanLength / SHORT_GRID_CELLS_PER_MEAN});
+
+    std::unordered_map<PlaneCellKey, std::vector<size_t>, PlaneCellKeyHash> cells;
+    cells.reserve(shortEntries.size() * 2);
+    for (size_t e : shortEntries) {
+        const Line2D& line = *entries_[e].line;
+        const int64_t x0 = cellOf(std::min(line.start().x(), line.end().x()), cellSize);
+        const int64_t x1 = cellOf(std::max(line.start().x(), line.end().x()), cellSize);
+        const int64_t y0 = cellOf(std::min(line.start().y(), line.end().y()), cellSize);
+        const int64_t y1 = cellOf(std::max(line.start().y(), line.end().y()), cellSize);
+        for (int64_t x = x0; x <= x1; ++x) {
+            for (int64_t y = y0; y <= y1; ++y) {
+                cells[{x, y}].push_back(e);
+            }
+        }
+    }
+
+    // Pairs of line `e` with the short lines near it. Short-short pairs are
+    // tested from their lower entry only.
+    auto pairsOf = [&](size_t e, std::vector<size_t>& candidates, std::vector<DuplicatePair>& found) {
+        const Entry& entry = entries_[e];
+        const Point2D& start = entry.line->start();
+        const Point2D& end = entry.line->end();
+
+        // Samples at most cellSize apart: every point of the line is within
+        // cellSize/2 of one, so the boxes below cover its 2·tol neighbourhood
+        const size_t steps = std::max<size_t>(1, static_cast<size_t>(std::ceil(entry.length / cellSize)));
+        const double reach = cellSize / 2.0 + 2.0 * tolerance_;
+
+        candidates.clear();
+        for (size_t k = 0; k <= steps; ++k) {
+            const double t = static_cast<double>(k) / static_cast<double>(steps);
+            const double px = start.x() + t * (end.x() - start.x());
+            const double py = start.y() + t * (end.y() - start.y());
+            for (int64_t x = cellOf(px - reach, cellSize); x <= cellOf(px + reach, cellSize); ++x) {
+                for (int64_t y = cellOf(py - reach, cellSize); y <= cellOf(py + reach, cellSize); ++y) {
+                    auto cell = cells.find({x, y});
+                    if (cell != cells.end()) {
+                        candidates.insert(candidates.end(), cell->second.begin(), cell->second.end());
+                    }
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        const bool isShort = entry.length < shortLength;
+        for (size_t s : candidates) {
+            if (s == e || (isShort && s < e)) {
+                continue;
+            }
+            const Entry& other = entries_[s];
+            const Entry& lower = (entry.entityIndex < other.entityIndex) ? entry : other;
+            const Entry& higher = (entry.entityIndex < other.entityIndex) ? other : entry;
+
+            if (GeometryValidator::areLinesDuplicate(*lower.line, *higher.line, tolerance_)) {
+                found.push_back({lower.entityIndex, higher.entityIndex,
+                                 GeometryIssueType::DuplicateLine});
+            } else if (GeometryValidator::areLinesOverlapping(*lower.line, *higher.line, tolerance_)) {
+                found.push_back({lower.entityIndex, higher.entityIndex,
+                                 GeometryIssueType::OverlappingLines});
+            }
+        }
+    };
+
+    const size_t n = entries_.size();
+    if (threads <= 1) {
+        std::vector<size_t> candidates;
+        CancelPoll poll(cancellation);
+        for (size_t e = 0; e < n && !poll.stop(); ++e) {
+            pairsOf(e, candidates, out);
+        }
+        return;
+    }
+
+    const size_t chunkCount = (n + PARALLEL_MIN_CHUNK - 1) / PARALLEL_MIN_CHUNK;
+    std::vector<std::vector<size_t>> candidates(threads);
+    std::vector<std::vector<DuplicatePair>> chunkPairs(chunkCount);
+    ParallelExecutor::forEachChunk(chunkCount, threads, [&](size_t chunk, size_t worker) {
+        const size_t end = std::min((chunk + 1) * PARALLEL_MIN_CHUNK, n);
+        CancelPoll poll(cancellation);
+        for (size_t e = chunk * PARALLEL_MIN_CHUNK; e < end && !poll.stop(); ++e) {
+            pairsOf(e, candidates[worker], chunkPairs[chunk]);
+        }
+    });
+    for (const auto& chunk : chunkPairs) {
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    }
+}
+
+// ============================================================================
+// ARC DUPLICATE INDEX
+// ============================================================================
+
+ArcDuplicateIndex::ArcDuplicateIndex(double tolerance) noexcept
+    : tolerance_(tolerance) {
+}
+
+void ArcDuplicateIndex::reserve(size_t count) {
+    entries_.reserve(count);
+}
+
+void ArcDuplicateIndex::insert(size_t entityIndex, const Arc2D& arc) {
+    const double start = GeometryMath::normalizeAngle(arc.startAngle());
+    const double end = GeometryMath::normalizeAngle(arc.endAngle());
+
+    // Same closed range that isAngleBetween() tests: CCW from start to end,
+    // or CCW from end to start for clockwise arcs.
+    const double lo = arc.isCounterClockwise() ? start : end;
+    const double hi = arc.isCounterClockwise() ? end : start;
+    double length = hi - lo;
+    if (length < 0.0) length += TWO_PI;
+
+    entries_.push_back({entityIndex, &arc, lo, length});
+}
+
+std::vector<DuplicatePair> ArcDuplicateIndex::findPairs(size_t threadCount,
+                                                       const CancellationToken* cancellation) const {
+    std::vector<DuplicatePair> pairs;
+
+    const size_t n = entries_.size();
+    // Center and radius comparisons are strict '<' against tolerance
+    if (n < 2 || !(tolerance_ > 0.0)) {
+        return pairs;
+    }
+
+    // ------------------------------------------------------------------
+    // Hash arcs by quantized center and radius
+    // ------------------------------------------------------------------
+    std::unordered_map<ArcCellKey, std::vector<size_t>, ArcCellKeyHash> cells;
+    cells.reserve(n);
+    for (size_t e = 0; e < n; ++e) {
+        const Arc2D& arc = *entries_[e].arc;
+        const ArcCellKey key{
+            cellOf(arc.center().x(), tolerance_),
+            cellOf(arc.center().y(), tolerance_),
+            cellOf(arc.radius(), tolerance_)
+        };
+        cells[key].push_back(e);
+    }
+
+    auto addArc = [this](std::vector<AngularItem>& items, size_t entry, bool guest) {
+        const Entry& arcEntry = entries_[entry];
+        // Duplicate angles may differ by up to tolerance/radius
+        const double pad = std::max(tolerance_ / arcEntry.arc->radius(), MIN_ANGLE_TOLERANCE)
+                         + ANGLE_PAD_EPSILON;
+        const double lo = arcEntry.rangeStart - pad;
+        const double hi = arcEntry.rangeStart + arcEntry.rangeLength + pad;
+
+        // Copies one turn either side so ranges meeting across 0/2π are seen
+        for (double shift : {-TWO_PI, 0.0, TWO_PI}) {
+            items.push_back({lo + shift, hi + shift, entry, guest});
+        }
+    };
+
+    // ------------------------------------------------------------------
+    // Angular sweep per cell neighbourhood. Neighbourhoods are independent
+    // (each cell owns the pairs it finds with its forward neighbours), so
+    // they are spread over the workers.
+    // ------------------------------------------------------------------
+    std::vector<const std::pair<const ArcCellKey, std::vector<size_t>>*> cellList;
+    cellList.reserve(cells.size());
+    for (const auto& cell : cells) {
+        cellList.push_back(&cell);
+    }
+
+    auto sweepNeighbourhood = [&](const ArcCellKey& key, const std::vector<size_t>& home,
+                                  std::vector<AngularItem>& items,
+                                  std::vector<DuplicatePair>& out) {
+        items.clear();
+        for (size_t entry : home) {
+            addArc(items, entry, false);
+        }
+        for (const auto& offset : FORWARD_NEIGHBOURS) {
+            const ArcCellKey neighbourKey{key.x + offset[0], key.y + offset[1], key.r + offset[2]};
+            auto neighbour = cells.find(neighbourKey);
+            if (neighbour == cells.end()) {
+                continue;
+            }
+            for (size_t entry : neighbour->second) {
+                addArc(items, entry, true);
+            }
+        }
+
+        std::sort(items.begin(), items.end(), [](const AngularItem& a, const AngularItem& b) {
+            return a.lo < b.lo;
+        });
+
+        for (size_t k = 0; k < items.size(); ++k) {
+            const AngularItem& a = items[k];
+            for (size_t m = k + 1; m < items.size() && items[m].lo <= a.hi; ++m) {
+                const AngularItem& b = items[m];
+                if (a.entry == b.entry || (a.guest && b.guest)) {
+                    continue;
+                }
+
+                const Entry& ea = entries_[a.entry];
+                const Entry& eb = entries_[b.entry];
+                const Entry& lower = (ea.entityIndex < eb.entityIndex) ? ea : eb;
+                const Entry& higher = (ea.entityIndex < eb.entityIndex) ? eb : ea;
+
+                if (GeometryValidator::areArcsDuplicate(*lower.arc, *higher.arc, tolerance_)) {
+                    out.push_back({lower.entityIndex, higher.entityIndex,
+                                   GeometryIssueType::DuplicateArc});
+                } else if (GeometryValidator::areArcsCoincident(*lower.arc, *higher.arc, tolerance_)) {
+                    out.push_back({lower.entityIndex, higher.entityIndex,
+                                   GeometryIssueType::CoincidentArcs});
+                }
+            }
+        }
+    };
+
+    const size_t threads = std::min(ParallelExecutor::resolveThreadCount(threadCount),
+                                    (n + PARALLEL_MIN_CHUNK - 1) / PARALLEL_MIN_CHUNK);
+    if (threads <= 1) {
+        std::vector<AngularItem> items;
+        CancelPoll poll(cancellation);
+        for (const auto* cell : cellList) {
+            if (poll.stop()) {
+                break;
+            }
+            sweepNeighbourhood(cell->first, cell->second, items, pairs);
+        }
+    } else {
+        const size_t chunkCount = std::min(cellList.size(), threads * 8);
+        std::vector<std::vector<AngularItem>> items(threads);
+        std::vector<std::vector<DuplicatePair>> chunkPairs(chunkCount);
+        ParallelExecutor::forEachChunk(chunkCount, threads, [&](size_t chunk, size_t worker) {
+            const size_t begin = cellList.size() * chunk / chunkCount;
+            const size_t end = cellList.size() * (chunk + 1) / chunkCount;
+            CancelPoll poll(cancellation);
+            for (size_t c = begin; c < end && !poll.stop(); ++c) {
+                sweepNeighbourhood(cellList[c]->first, cellList[c]->second,
+                                   items[worker], chunkPairs[chunk]);
+            }
+        });
+        for (const auto& chunk : chunkPairs) {
+            pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+        }
+    }
+
+    // Shifted copies may report the same pair more than once
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end(),
+                            [](const DuplicatePair& a, const DuplicatePair& b) {
+                                return a.first == b.first && a.second == b.second;
+                            }),
+                pairs.end());
+    return pairs;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,408 @@
+#include "geometry/EntityRuleKernel.h"
+#include "geometry/ContourTopology.h"
+#include "geometry/GeometryConstants.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+// Flag bits, one per rule, in report order
+constexpr uint8_t FLAG_ZERO = 1 << 0;
+constexpr uint8_t FLAG_ANGLE = 1 << 1;
+constexpr uint8_t FLAG_UNSTABLE = 1 << 2;
+constexpr uint8_t FLAG_INVALID = 1 << 3;
+constexpr uint8_t FLAG_SHORT = 1 << 4;
+constexpr uint8_t FLAG_SHARP_ENTRY = 1 << 5;
+constexpr uint8_t FLAG_SHARP_EXIT = 1 << 6;
+
+/**
+ * @brief Smallest x >= 0 with sqrt(x) >= limit
+ *
+ * sqrt is correctly rounded and monotonic, so sqrt(x) < limit exactly
+ * when x is below this value.
+ */
+double squaredLimit(double limit) noexcept {
+    if (!(limit > 0.0)) {
+        return 0.0;
+    }
+    const double infinity = std::numeric_limits<double>::infinity();
+    double squared = limit * limit;
+    while (std::sqrt(squared) < limit) {
+        squared = std::nextafter(squared, infinity);
+    }
+    while (squared > 0.0 && std::sqrt(std::nextafter(squared, 0.0)) >= limit) {
+        squared = std::nextafter(squared, 0.0);
+    }
+    return squared;
+}
+
+/**
+ * @brief Unit tangent of an arc at an angle, in its direction of travel
+ */
+Point2D arcTangent(const Arc2D& arc, double angle) noexcept {
+    const double sign = arc.isCounterClockwise() ? 1.0 : -1.0;
+    return Point2D(-std::sin(angle) * sign, std::cos(angle) * sign);
+}
+
+/**
+ * @brief Copy one entity into row i of a set of columns
+ *
+ * Columns is EntityColumns or a batch buffer with the same member names.
+ */
+template <typename Columns>
+void loadRow(SegmentRef entity, Columns& columns, size_t i) noexcept {
+    if (const auto* line = entity.line()) {
+        columns.arc[i] = 0;
+        columns.ccw[i] = 0;
+        columns.x0[i] = line->start().x();
+        columns.y0[i] = line->start().y();
+        columns.x1[i] = line->end().x();
+        columns.y1[i] = line->end().y();
+        columns.radius[i] = 0.0;
+        columns.startAngle[i] = 0.0;
+        columns.endAngle[i] = 0.0;
+    } else {
+        const Arc2D& curve = *entity.arc();
+        columns.arc[i] = 1;
+        columns.ccw[i] = curve.isCounterClockwise() ? 1 : 0;
+        columns.x0[i] = columns.x1[i] = curve.center().x();
+        columns.y0[i] = columns.y1[i] = curve.center().y();
+        columns.radius[i] = curve.radius();
+        columns.startAngle[i] = curve.startAngle();
+        columns.endAngle[i] = curve.endAngle();
+    }
+}
+
+/**
+ * @brief Geometry columns for one batch, filled straight from the entities
+ */
+struct BatchBuffer {
+    uint8_t arc[EntityRuleKernel::BATCH_SIZE];
+    uint8_t ccw[EntityRuleKernel::BATCH_SIZE];
+    double x0[EntityRuleKernel::BATCH_SIZE];
+    double y0[EntityRuleKernel::BATCH_SIZE];
+    double x1[EntityRuleKernel::BATCH_SIZE];
+    double y1[EntityRuleKernel::BATCH_SIZE];
+    double radius[EntityRuleKernel::BATCH_SIZE];
+    double startAngle[EntityRuleKernel::BATCH_SIZE];
+    double endAngle[EntityRuleKernel::BATCH_SIZE];
+};
+
+} // namespace
+
+/**
+ * @brief Geometry of one batch, row 0 being its first entity
+ */
+struct EntityRuleKernel::Rows {
+    const uint8_t* arc;
+    const uint8_t* ccw;
+    const double* x0;
+    const double* y0;
+    const double* x1;
+    const double* y1;
+    const double* radius;
+    const double* startAngle;
+    const double* endAngle;
+
+    template <typename Columns>
+    static Rows at(const Columns& columns, size_t first) noexcept {
+        return Rows{&columns.arc[first], &columns.ccw[first], &columns.x0[first], &columns.y0[first],
+                    &columns.x1[first], &columns.y1[first], &columns.radius[first],
+                    &columns.startAngle[first], &columns.endAngle[first]};
+    }
+};
+
+// ============================================================================
+// COLUMNS
+// ============================================================================
+
+EntityColumns EntityColumns::build(const SegmentView& entities) {
+    EntityColumns columns;
+    columns.resize(entities.size());
+    columns.load(entities, 0, entities.size());
+    return columns;
+}
+
+void EntityColumns::resize(size_t count) {
+    arc.resize(count);
+    ccw.resize(count);
+    x0.resize(count);
+    y0.resize(count);
+    x1.resize(count);
+    y1.resize(count);
+    radius.resize(count);
+    startAngle.resize(count);
+    endAngle.resize(count);
+}
+
+void EntityColumns::load(const SegmentView& entities,
+                         size_t begin, size_t end) {
+    entities.forEach(begin, end, [this](size_t i, SegmentRef entity) { loadRow(entity, *this, i); });
+}
+
+void EntityColumns::setJoints(const ContourTopology& contours,
+                              const SegmentView& entities) {
+    const size_t n = entities.size();
+    previous.resize(n);
+    next.resize(n);
+    std::iota(previous.begin(), previous.end(), uint32_t(0));
+    std::iota(next.begin(), next.end(), uint32_t(0));
+    entryX.assign(n, 0.0);
+    entryY.assign(n, 0.0);
+    exitX.assign(n, 0.0);
+    exitY.assign(n, 0.0);
+    entryPointX.assign(n, 0.0);
+    entryPointY.assign(n, 0.0);
+    exitPointX.assign(n, 0.0);
+    exitPointY.assign(n, 0.0);
+
+    for (const Contour& contour : contours.contours()) {
+        const size_t count = contour.segments.size();
+        for (size_t k = 0; k < count; ++k) {
+            const ContourSegment& segment = contour.segments[k];
+            const size_t e = segment.entity;
+            if (e >= n) {
+                continue;
+            }
+
+            // Tangents and end point in the entity's own direction
+            Point2D startTangent, endTangent, endPoint, startPoint;
+            if (const auto* line = entities[e].line()) {
+                const double length = line->length();
+                startTangent = endTangent = Point2D((line->end().x() - line->start().x()) / length,
+                                                    (line->end().y() - line->start().y()) / length);
+                startPoint = line->start();
+                endPoint = line->end();
+            } else {
+                const Arc2D& curve = *entities[e].arc();
+                startTangent = arcTangent(curve, curve.startAngle());
+                endTangent = arcTangent(curve, curve.endAngle());
+                startPoint = curve.startPoint();
+                endPoint = curve.endPoint();
+            }
+
+            const Point2D& entryPoint = segment.reversed ? endPoint : startPoint;
+            const Point2D& exitPoint = segment.reversed ? startPoint : endPoint;
+            const double sign = segment.reversed ? -1.0 : 1.0;
+            const Point2D& entry = segment.reversed ? endTangent : startTangent;
+            const Point2D& exit = segment.reversed ? startTangent : endTangent;
+            entryX[e] = sign * entry.x();
+            entryY[e] = sign * entry.y();
+            exitX[e] = sign * exit.x();
+            exitY[e] = sign * exit.y();
+            entryPointX[e] = entryPoint.x();
+            entryPointY[e] = entryPoint.y();
+            exitPointX[e] = exitPoint.x();
+            exitPointY[e] = exitPoint.y();
+
+            if (k + 1 < count || contour.closed) {
+                const size_t following = contour.segments[(k + 1) % count].entity;
+                if (following < n) {
+                    next[e] = static_cast<uint32_t>(following);
+                    previous[following] = static_cast<uint32_t>(e);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// KERNEL
+// ============================================================================
+
+EntityRuleKernel::EntityRuleKernel(double tolerance, const ManufacturingRules& rules) noexcept
+    : tolerance_(tolerance)
+    , minEdgeLength_(rules.minEdgeLength)
+    , minCornerAngle_(rules.minCornerAngle)
+    , cornerCosine_(-std::cos(rules.minCornerAngle))
+    , zeroSquared_(squaredLimit(tolerance))
+    , stableSquared_(squaredLimit(std::nextafter(tolerance * 10.0, std::numeric_limits<double>::infinity())))
+    , edgeSquared_(squaredLimit(rules.minEdgeLength))
+{}
+
+double EntityRuleKernel::sweepOf(double startAngle, double endAngle, bool counterClockwise) noexcept {
+    // Arc2D normalizes with fmod, which leaves [0, 2π) unchanged; only a
+    // stored 2π (rounded up from just below 0) reduces further. Selections
+    // are written as arithmetic so the kernel loop stays branch-free.
+    startAngle -= TWO_PI * (startAngle >= TWO_PI);
+    endAngle -= TWO_PI * (endAngle >= TWO_PI);
+    const double raw = (endAngle - startAngle) * static_cast<double>(2 * int(counterClockwise) - 1);
+    const double sweep = raw + TWO_PI * (raw < 0.0);
+    const bool fullCircle = (sweep < GEOMETRY_EPSILON) & (std::abs(startAngle - endAngle) < GEOMETRY_EPSILON);
+    return fullCircle ? TWO_PI : sweep;
+}
+
+void EntityRuleKernel::run(const EntityColumns& columns, size_t begin, size_t end,
+                           std::vector<EntityIssueRecord>& records) const {
+    end = std::min(end, columns.size());
+    for (size_t batch = begin; batch < end; batch += BATCH_SIZE) {
+        scan(Rows::at(columns, batch), batch, std::min(BATCH_SIZE, end - batch), columns, records);
+    }
+}
+
+void EntityRuleKernel::run(const SegmentView& entities,
+                           const EntityColumns& joints, size_t begin, size_t end,
+                           std::vector<EntityIssueRecord>& records) const {
+    // Each batch is copied while its entities are in cache and scanned
+    // before the next one overwrites it: no document-sized columns
+    end = std::min(end, entities.size());
+    BatchBuffer buffer;
+    for (size_t batch = begin; batch < end; batch += BATCH_SIZE) {
+        const size_t count = std::min(BATCH_SIZE, end - batch);
+        entities.forEach(batch, batch + count, [&buffer, batch](size_t i, SegmentRef entity) {
+            loadRow(entity, buffer, i - batch);
+        });
+        scan(Rows::at(buffer, 0), batch, count, joints, records);
+    }
+}
+
+void EntityRuleKernel::scan(const Rows& rows, size_t first, size_t count, const EntityColumns& joints,
+                            std::vector<EntityIssueRecord>& records) const {
+    const bool corners = minCornerAngle_ > 0.0 && joints.hasJoints() && first + count <= joints.next.size();
+    const double tolerance = tolerance_;
+    const double stable = tolerance_ * 10.0;
+    const double minEdge = minEdgeLength_;
+    const double zeroSquared = zeroSquared_;
+    const double stableSquared = stableSquared_;
+    const double edgeSquared = edgeSquared_;
+    const double cornerCosine = cornerCosine_;
+
+    const uint8_t* arc = rows.arc;
+    const uint8_t* ccw = rows.ccw;
+    const double* x0 = rows.x0;
+    const double* y0 = rows.y0;
+    const double* x1 = rows.x1;
+    const double* y1 = rows.y1;
+    const double* radius = rows.radius;
+    const double* startAngle = rows.startAngle;
+    const double* endAngle = rows.endAngle;
+
+    // Pass 1: a flag byte per entity. Both the line and the arc form of
+    // each test are computed and masked, and comparisons are combined
+    // with bitwise operators, so the body has no branches.
+    uint8_t flags[BATCH_SIZE];
+    for (size_t k = 0; k < count; ++k) {
+        const int isArc = arc[k];
+        const int isLine = 1 - isArc;
+        const double dx = x1[k] - x0[k];
+        const double dy = y1[k] - y0[k];
+        const double squared = dx * dx + dy * dy;
+        const double r = radius[k];
+        const double s = sweepOf(startAngle[k], endAngle[k], ccw[k] != 0);
+
+        const int zero = (isArc & (r < tolerance)) | (isLine & (squared < zeroSquared));
+        const int badAngle = isArc & !((s >= tolerance) & (s - s == 0.0));
+        const int unstable = (isArc & !((r > stable) & (s > stable))) |
+                             (isLine & !(squared >= stableSquared));
+        // x - x is NaN for NaN and infinity, 0 otherwise
+        const int invalid = !((x0[k] - x0[k] == 0.0) & (y0[k] - y0[k] == 0.0) &
+                              (x1[k] - x1[k] == 0.0) & (y1[k] - y1[k] == 0.0));
+        const int shortEdge = ((isArc & (r * std::abs(s) < minEdge)) | (isLine & (squared < edgeSquared))) &
+                              !zero & !badAngle;
+
+        flags[k] = static_cast<uint8_t>(zero * FLAG_ZERO | badAngle * FLAG_ANGLE |
+                                        unstable * FLAG_UNSTABLE | invalid * FLAG_INVALID |
+                                        shortEdge * FLAG_SHORT);
+    }
+
+    if (corners) {
+        // Each joint belongs to its lower entity; one without a
+        // neighbour points at itself and fails the comparison
+        const uint32_t* previous = joints.previous.data();
+        const uint32_t* next = joints.next.data();
+        const double* entryX = joints.entryX.data();
+        const double* entryY = joints.entryY.data();
+        const double* exitX = joints.exitX.data();
+        const double* exitY = joints.exitY.data();
+        for (size_t k = 0; k < count; ++k) {
+            const size_t i = first + k;
+            const uint32_t before = previous[i];
+            const uint32_t after = next[i];
+            const double entryDot = exitX[before] * entryX[i] + exitY[before] * entryY[i];
+            const double exitDot = exitX[i] * entryX[after] + exitY[i] * entryY[after];
+            const bool sharpEntry = (i < before) & (entryDot < cornerCosine);
+            const bool sharpExit = (i < after) & (exitDot < cornerCosine);
+            flags[k] |= static_cast<uint8_t>((sharpEntry ? FLAG_SHARP_ENTRY : 0) |
+                                             (sharpExit ? FLAG_SHARP_EXIT : 0));
+        }
+    }
+
+    // Pass 2: records for flagged entities, in rule order
+    for (size_t k = 0; k < count; ++k) {
+        if (flags[k] == 0) {
+            continue;
+        }
+        const size_t i = first + k;
+        const bool isArc = arc[k] != 0;
+        EntityIssueRecord record{static_cast<uint32_t>(i), static_cast<uint32_t>(i), 0.0,
+                                 GeometryIssueType::ZeroLengthLine, isArc, false};
+        auto emit = [&records, &record](GeometryIssueType type, double value = 0.0) {
+            record.type = type;
+            record.value = value;
+            records.push_back(record);
+        };
+
+        if (flags[k] & FLAG_ZERO) {
+            emit(isArc ? GeometryIssueType::ZeroRadiusArc : GeometryIssueType::ZeroLengthLine);
+        }
+        if (flags[k] & FLAG_ANGLE) {
+            emit(GeometryIssueType::InvalidArcAngle);
+        }
+        if (flags[k] & FLAG_UNSTABLE) {
+            emit(GeometryIssueType::NumericalInstability);
+        }
+        if (flags[k] & FLAG_INVALID) {
+            emit(GeometryIssueType::InvalidCoordinates);
+        }
+        if (flags[k] & FLAG_SHORT) {
+            const double dx = x1[k] - x0[k];
+            const double dy = y1[k] - y0[k];
+            emit(GeometryIssueType::ShortEdge,
+                 isArc ? radius[k] * std::abs(sweepOf(startAngle[k], endAngle[k], ccw[k] != 0))
+                       : std::sqrt(dx * dx + dy * dy));
+        }
+        auto corner = [&joints](uint32_t from, uint32_t to) {
+            const double dot = joints.exitX[from] * joints.entryX[to] +
+                               joints.exitY[from] * joints.entryY[to];
+            return PI - std::acos(std::clamp(dot, -1.0, 1.0));
+        };
+        if (flags[k] & FLAG_SHARP_ENTRY) {
+            record.related = joints.previous[i];
+            record.atEntry = true;
+            emit(GeometryIssueType::SharpCorner, corner(record.related, record.entity));
+        }
+        if (flags[k] & FLAG_SHARP_EXIT) {
+            record.related = joints.next[i];
+            record.atEntry = false;
+            emit(GeometryIssueType::SharpCorner, corner(record.entity, record.related));
+        }
+    }
+}
+
+GeometryIssue EntityRuleKernel::toIssue(const EntityIssueRecord& record,
+                                        const EntityColumns& columns) const noexcept {
+    GeometryIssue issue(record.type, record.entity);
+    issue.arc = record.arc;
+    issue.value = record.value;
+
+    if (record.type == GeometryIssueType::ShortEdge) {
+        issue.limit = minEdgeLength_;
+    } else if (record.type == GeometryIssueType::SharpCorner) {
+        issue.limit = minCornerAngle_;
+        issue.relatedEntityIndex = record.related;
+        if (record.entity < columns.exitPointX.size()) {
+            issue.location = record.atEntry
+                ? Point2D(columns.entryPointX[record.entity], columns.entryPointY[record.entity])
+                : Point2D(columns.exitPointX[record.entity], columns.exitPointY[record.entity]);
+        }
+    }
+    return issue;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
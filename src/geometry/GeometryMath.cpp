@@ -363,8 +363,10 @@ Point2D closestPointOnSegment(const Point2D& point, const Line2D& line) noexcept
 Point2D closestPointOnArc(const Point2D& point, const Arc2D& arc) noexcept {
     const double angle = angleBetweenPoints(arc.center(), point);
 
-    if (isAngleBetween(angle, arc.startAngle(), arc.endAngle(),
-                       arc.isCounterClockwise())) {
+    // A full circle's start and end angles normalize to the same value,
+    // which isAngleBetween reads as an empty sweep
+    if (arc.isFullCircle() ||
+        isAngleBetween(angle, arc.startAngle(), arc.endAngle(), arc.isCounterClockwise())) {
         return arc.pointAtAngle(angle);
     }
 
@@ -406,6 +408,100 @@ double distancePointToEllipse(const Point2D& point, const Ellipse2D& ellipse) no
     return distance(point, closest);
 }
 
+// ============================================================================
+// CLOSEST POINTS BETWEEN ENTITIES
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Keep the closer of the current best and a candidate pair
+ */
+void keepCloser(ClosestPoints& best, const Point2D& first, const Point2D& second) noexcept {
+    const double d = distance(first, second);
+    if (d < best.distance) {
+        best = ClosestPoints{first, second, d};
+    }
+}
+
+/**
+ * @brief Check if a direction from the arc center falls within its sweep
+ */
+bool arcCoversAngle(const Arc2D& arc, double angle) noexcept {
+    return arc.isFullCircle() ||
+           isAngleBetween(angle, arc.startAngle(), arc.endAngle(), arc.isCounterClockwise());
+}
+
+} // namespace
+
+ClosestPoints closestPoints(const Line2D& line1, const Line2D& line2) noexcept {
+    if (const auto hit = segmentSegmentIntersection(line1, line2)) {
+        return ClosestPoints{*hit, *hit, 0.0};
+    }
+
+    // Non-crossing segments: the minimum involves an endpoint of one of them
+    ClosestPoints best{line1.start(), line2.start(), distance(line1.start(), line2.start())};
+    keepCloser(best, line1.start(), closestPointOnSegment(line1.start(), line2));
+    keepCloser(best, line1.end(), closestPointOnSegment(line1.end(), line2));
+    keepCloser(best, closestPointOnSegment(line2.start(), line1), line2.start());
+    keepCloser(best, closestPointOnSegment(line2.end(), line1), line2.end());
+    return best;
+}
+
+ClosestPoints closestPoints(const Line2D& line, const Arc2D& arc) noexcept {
+    const std::vector<Point2D> hits = intersectLineArc(line, arc);
+    if (!hits.empty()) {
+        return ClosestPoints{hits.front(), hits.front(), 0.0};
+    }
+
+    ClosestPoints best{line.start(), closestPointOnArc(line.start(), arc), 0.0};
+    best.distance = distance(best.first, best.second);
+    keepCloser(best, line.end(), closestPointOnArc(line.end(), arc));
+    keepCloser(best, closestPointOnSegment(arc.startPoint(), line), arc.startPoint());
+    keepCloser(best, closestPointOnSegment(arc.endPoint(), line), arc.endPoint());
+
+    // Segment outside the circle: nearest where it passes closest to the center
+    const Point2D nearCenter = closestPointOnSegment(arc.center(), line);
+    if (distance(nearCenter, arc.center()) > GEOMETRY_EPSILON) {
+        const double angle = angleBetweenPoints(arc.center(), nearCenter);
+        if (arcCoversAngle(arc, angle)) {
+            keepCloser(best, nearCenter, arc.pointAtAngle(angle));
+        }
+    }
+    return best;
+}
+
+ClosestPoints closestPoints(const Arc2D& arc1, const Arc2D& arc2) noexcept {
+    const std::vector<Point2D> hits = intersectArcArc(arc1, arc2);
+    if (!hits.empty()) {
+        return ClosestPoints{hits.front(), hits.front(), 0.0};
+    }
+
+    ClosestPoints best{arc1.startPoint(), closestPointOnArc(arc1.startPoint(), arc2), 0.0};
+    best.distance = distance(best.first, best.second);
+    keepCloser(best, arc1.endPoint(), closestPointOnArc(arc1.endPoint(), arc2));
+    keepCloser(best, closestPointOnArc(arc2.startPoint(), arc1), arc2.startPoint());
+    keepCloser(best, closestPointOnArc(arc2.endPoint(), arc1), arc2.endPoint());
+
+    // Interior pairs: both points on the line of centers, facing either way
+    // (concentric arcs are covered by the endpoint candidates)
+    if (distance(arc1.center(), arc2.center()) > GEOMETRY_EPSILON) {
+        const double toSecond = angleBetweenPoints(arc1.center(), arc2.center());
+        const double toFirst = normalizeAngle(toSecond + PI);
+        for (double angle1 : {toSecond, toFirst}) {
+            if (!arcCoversAngle(arc1, angle1)) {
+                continue;
+            }
+            for (double angle2 : {toSecond, toFirst}) {
+                if (arcCoversAngle(arc2, angle2)) {
+                    keepCloser(best, arc1.pointAtAngle(angle1), arc2.pointAtAngle(angle2));
+                }
+            }
+        }
+    }
+    return best;
+}
+
 // ============================================================================
 // TRANSLATION
 // ============================================================================
@@ -1,8 +1,18 @@
 #include "geometry/GeometryValidator.h"
+#include "geometry/ContourTopology.h"
+#include "geometry/DuplicateIndex.h"
+#include "geometry/EntityRuleKernel.h"
 #include "geometry/GeometryConstants.h"
 #include "geometry/GeometryMath.h"
+#include "geometry/HoleMeasure.h"
+#include "geometry/IntersectionSweep.h"
+#include "geometry/ParallelExecutor.h"
+#include "geometry/ProximitySweep.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <map>
+#include <mutex>
 
 namespace OwnCAD {
 namespace Geometry {
@@ -12,7 +22,10 @@ namespace Geometry {
 // ============================================================================
 
 bool ValidationResult::hasIssueType(GeometryIssueType type) const noexcept {
-    for (const auto& issue : issues) {
+    if (isIndexed()) {
+        return !typeIndex_[static_cast<size_t>(type)].empty();
+    }
+    for (const auto& issue : issues_) {
         if (issue.type == type) {
             return true;
         }
@@ -22,14 +35,88 @@ bool ValidationResult::hasIssueType(GeometryIssueType type) const noexcept {
 
 std::vector<GeometryIssue> ValidationResult::getIssuesOfType(GeometryIssueType type) const {
     std::vector<GeometryIssue> result;
-    for (const auto& issue : issues) {
-        if (issue.type == type) {
-            result.push_back(issue);
-        }
+    for (size_t position : issuePositionsOfType(type)) {
+        result.push_back(issues_[position]);
     }
     return result;
 }
 
+std::vector<size_t> ValidationResult::issuePositionsOfType(GeometryIssueType type) const {
+    if (isIndexed()) {
+        const auto& positions = typeIndex_[static_cast<size_t>(type)];
+        return std::vector<size_t>(positions.begin(), positions.end());
+    }
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < issues_.size(); ++i) {
+        if (issues_[i].type == type) {
+            positions.push_back(i);
+        }
+    }
+    return positions;
+}
+
+const std::string& ValidationResult::handleOf(size_t entityIndex) const noexcept {
+    return handles[entityIndex];
+}
+
+std::vector<size_t> ValidationResult::contourOf(const GeometryIssue& issue) const {
+    const size_t end = std::min<size_t>(size_t(issue.contourBegin) + issue.contourSize,
+                                        contourMembers.size());
+    if (issue.contourBegin >= end) {
+        return {};
+    }
+    return std::vector<size_t>(contourMembers.begin() + issue.contourBegin,
+                               contourMembers.begin() + end);
+}
+
+void ValidationResult::setContour(GeometryIssue& issue, const std::vector<size_t>& entities) {
+    issue.contourBegin = static_cast<uint32_t>(contourMembers.size());
+    issue.contourSize = static_cast<uint32_t>(entities.size());
+    contourMembers.insert(contourMembers.end(), entities.begin(), entities.end());
+}
+
+void ValidationResult::append(ValidationResult&& other) {
+    if (!other.isValid) {
+        isValid = false;
+    }
+    const uint32_t offset = static_cast<uint32_t>(contourMembers.size());
+    issues_.reserve(issues_.size() + other.issues_.size());
+    for (GeometryIssue issue : other.issues_) {
+        if (issue.contourSize > 0) {
+            issue.contourBegin += offset;
+        }
+        issues_.push_back(issue);
+    }
+    contourMembers.insert(contourMembers.end(), other.contourMembers.begin(), other.contourMembers.end());
+    cancelled = other.cancelled;
+    truncatedRules.insert(truncatedRules.end(),
+                          std::make_move_iterator(other.truncatedRules.begin()),
+                          std::make_move_iterator(other.truncatedRules.end()));
+    if (handles.empty()) {
+        handles = std::move(other.handles);
+    }
+    indexIssues();
+}
+
+void ValidationResult::add(const GeometryIssue& issue) {
+    if (isIndexed()) {
+        typeIndex_[static_cast<size_t>(issue.type)].push_back(static_cast<uint32_t>(issues_.size()));
+    }
+    issues_.push_back(issue);
+}
+
+std::vector<GeometryIssue>& ValidationResult::editIssues() noexcept {
+    typeIndex_.clear();
+    return issues_;
+}
+
+void ValidationResult::indexIssues() {
+    typeIndex_.assign(ISSUE_TYPE_COUNT, {});
+    for (size_t i = 0; i < issues_.size(); ++i) {
+        typeIndex_[static_cast<size_t>(issues_[i].type)].push_back(static_cast<uint32_t>(i));
+    }
+}
+
 // ============================================================================
 // VALIDATION METHODS
 // ============================================================================
@@ -41,30 +128,18 @@ ValidationResult GeometryValidator::validateLine(const Line2D& line, double tole
     // Check zero-length
     if (isZeroLength(line, tolerance)) {
         result.isValid = false;
-        result.issues.push_back({
-            GeometryIssueType::ZeroLengthLine,
-            0,
-            "Line has zero or near-zero length"
-        });
+        result.add(GeometryIssue(GeometryIssueType::ZeroLengthLine, 0));
     }
 
     // Check numerical stability
     if (!isNumericallyStable(line, tolerance)) {
-        result.issues.push_back({
-            GeometryIssueType::NumericalInstability,
-            0,
-            "Line length is close to tolerance boundary (numerically unstable)"
-        });
+        result.add(GeometryIssue(GeometryIssueType::NumericalInstability, 0));
     }
 
     // Check for invalid coordinates
     if (!line.start().isValid() || !line.end().isValid()) {
         result.isValid = false;
-        result.issues.push_back({
-            GeometryIssueType::InvalidCoordinates,
-            0,
-            "Line contains invalid coordinates (NaN or infinity)"
-        });
+        result.add(GeometryIssue(GeometryIssueType::InvalidCoordinates, 0));
     }
 
     return result;
@@ -73,58 +148,47 @@ ValidationResult GeometryValidator::validateLine(const Line2D& line, double tole
 ValidationResult GeometryValidator::validateArc(const Arc2D& arc, double tolerance) noexcept {
     ValidationResult result;
     result.isValid = true;
+    auto reportArc = [&result](GeometryIssueType type) {
+        GeometryIssue issue(type, 0);
+        issue.arc = true;
+        result.add(issue);
+    };
 
     // Check zero-radius
     if (isZeroRadius(arc, tolerance)) {
         result.isValid = false;
-        result.issues.push_back({
-            GeometryIssueType::ZeroRadiusArc,
-            0,
-            "Arc has zero or near-zero radius"
-        });
+        reportArc(GeometryIssueType::ZeroRadiusArc);
     }
 
     // Check valid angles
     if (!hasValidAngles(arc, tolerance)) {
         result.isValid = false;
-        result.issues.push_back({
-            GeometryIssueType::InvalidArcAngle,
-            0,
-            "Arc has invalid or degenerate angle configuration"
-        });
+        reportArc(GeometryIssueType::InvalidArcAngle);
     }
 
     // Check numerical stability
     if (!isNumericallyStable(arc, tolerance)) {
-        result.issues.push_back({
-            GeometryIssueType::NumericalInstability,
-            0,
-            "Arc parameters are close to tolerance boundary (numerically unstable)"
-        });
+        reportArc(GeometryIssueType::NumericalInstability);
     }
 
     // Check for invalid coordinates
     if (!arc.center().isValid()) {
         result.isValid = false;
-        result.issues.push_back({
-            GeometryIssueType::InvalidCoordinates,
-            0,
-            "Arc contains invalid center coordinates (NaN or infinity)"
-        });
+        reportArc(GeometryIssueType::InvalidCoordinates);
     }
 
     return result;
 }
 
 ValidationResult GeometryValidator::validateEntities(
-    const std::vector<std::variant<Line2D, Arc2D>>& entities,
+    const SegmentView& entities,
     double tolerance
 ) noexcept {
     ValidationResult result;
     result.isValid = true;
 
     for (size_t i = 0; i < entities.size(); ++i) {
-        std::visit([&](auto&& entity) {
+        entities[i].visit([&](auto&& entity) {
             using T = std::decay_t<decltype(entity)>;
             ValidationResult entityResult;
 
@@ -139,13 +203,14 @@ ValidationResult GeometryValidator::validateEntities(
             }
 
             // Add entity-specific issues with index
-            for (auto issue : entityResult.issues) {
+            for (auto issue : entityResult.issues()) {
                 issue.entityIndex = i;
-                result.issues.push_back(issue);
+                result.add(issue);
             }
-        }, entities[i]);
+        });
     }
 
+    result.indexIssues();
     return result;
 }
 
@@ -205,11 +270,69 @@ std::string toString(GeometryIssueType type) {
             return "Duplicate arc";
         case GeometryIssueType::CoincidentArcs:
             return "Coincident arcs";
+        case GeometryIssueType::SelfIntersection:
+            return "Self-intersection";
+        case GeometryIssueType::HoleTooSmall:
+            return "Hole too small";
+        case GeometryIssueType::FeaturesTooClose:
+            return "Features too close";
+        case GeometryIssueType::ShortEdge:
+            return "Short edge";
+        case GeometryIssueType::SharpCorner:
+            return "Sharp corner";
         default:
             return "Unknown issue";
     }
 }
 
+std::string describe(const GeometryIssue& issue) {
+    char buffer[128];
+    switch (issue.type) {
+        case GeometryIssueType::ZeroLengthLine:
+            return "Line has zero or near-zero length";
+        case GeometryIssueType::ZeroRadiusArc:
+            return "Arc has zero or near-zero radius";
+        case GeometryIssueType::InvalidArcAngle:
+            return "Arc has invalid or degenerate angle configuration";
+        case GeometryIssueType::NumericalInstability:
+            return issue.arc ? "Arc parameters are close to tolerance boundary (numerically unstable)"
+                             : "Line length is close to tolerance boundary (numerically unstable)";
+        case GeometryIssueType::InvalidCoordinates:
+            return issue.arc ? "Arc contains invalid center coordinates (NaN or infinity)"
+                             : "Line contains invalid coordinates (NaN or infinity)";
+        case GeometryIssueType::DuplicateLine:
+        case GeometryIssueType::OverlappingLines:
+        case GeometryIssueType::DuplicateArc:
+        case GeometryIssueType::CoincidentArcs:
+            return GeometryValidator::pairDescription(issue.type);
+        case GeometryIssueType::SelfIntersection:
+            return issue.location ? GeometryValidator::intersectionDescription(*issue.location)
+                                  : GeometryValidator::pairDescription(issue.type);
+        case GeometryIssueType::HoleTooSmall:
+            std::snprintf(buffer, sizeof(buffer),
+                          "Hole diameter (%.3f mm) is below minimum cuttable size (%.3f mm)",
+                          issue.value, issue.limit);
+            return buffer;
+        case GeometryIssueType::FeaturesTooClose:
+            std::snprintf(buffer, sizeof(buffer),
+                          "Minimum distance between features is %.3f mm (recommended minimum: %.3f mm)",
+                          issue.value, issue.limit);
+            return buffer;
+        case GeometryIssueType::ShortEdge:
+            std::snprintf(buffer, sizeof(buffer),
+                          "Edge length (%.3f mm) is below minimum edge length (%.3f mm)",
+                          issue.value, issue.limit);
+            return buffer;
+        case GeometryIssueType::SharpCorner:
+            std::snprintf(buffer, sizeof(buffer),
+                          "Corner angle (%.1f degrees) is below minimum (%.1f degrees)",
+                          issue.value * 180.0 / PI, issue.limit * 180.0 / PI);
+            return buffer;
+        default:
+            return toString(issue.type);
+    }
+}
+
 // ============================================================================
 // DUPLICATE AND OVERLAP DETECTION - LINES
 // ============================================================================
@@ -389,14 +512,427 @@ bool GeometryValidator::areArcsCoincident(const Arc2D& arc1, const Arc2D& arc2,
     );
 }
 
+// ============================================================================
+// SINGLE ENTITY AND PAIR CHECKS
+// ============================================================================
+
+ValidationResult GeometryValidator::validateEntity(SegmentRef entity,
+                                                   double tolerance) noexcept {
+    return entity.visit([tolerance](auto&& geometry) {
+        using T = std::decay_t<decltype(geometry)>;
+        if constexpr (std::is_same_v<T, Line2D>) {
+            return validateLine(geometry, tolerance);
+        } else {
+            return validateArc(geometry, tolerance);
+        }
+    });
+}
+
+ValidationResult GeometryValidator::validateEntity(SegmentRef entity,
+                                                   double tolerance,
+                                                   const ManufacturingRules& rules) noexcept {
+    ValidationResult result;
+    result.isValid = true;
+
+    const EntityColumns noJoints;
+    const EntityRuleKernel kernel(tolerance, rules);
+    std::vector<EntityIssueRecord> records;
+    const std::vector<SegmentView::Segment> single{
+        entity.visit([](const auto& geometry) { return SegmentView::Segment(geometry); })};
+    kernel.run(single, noJoints, 0, 1, records);
+
+    for (const auto& record : records) {
+        GeometryIssue issue = kernel.toIssue(record, noJoints);
+        issue.entityIndex = 0;
+        if (isBlockingIssue(issue.type)) {
+            result.isValid = false;
+        }
+        result.add(issue);
+    }
+    return result;
+}
+
+std::optional<GeometryIssueType> GeometryValidator::comparePair(
+    SegmentRef lower,
+    SegmentRef higher,
+    double tolerance) noexcept {
+    if (const auto* line1 = lower.line()) {
+        const auto* line2 = higher.line();
+        if (!line2) {
+            return std::nullopt;
+        }
+        if (areLinesDuplicate(*line1, *line2, tolerance)) {
+            return GeometryIssueType::DuplicateLine;
+        }
+        if (areLinesOverlapping(*line1, *line2, tolerance)) {
+            return GeometryIssueType::OverlappingLines;
+        }
+        return std::nullopt;
+    }
+
+    const auto* arc1 = lower.arc();
+    const auto* arc2 = higher.arc();
+    if (!arc1 || !arc2) {
+        return std::nullopt;
+    }
+    if (areArcsDuplicate(*arc1, *arc2, tolerance)) {
+        return GeometryIssueType::DuplicateArc;
+    }
+    if (areArcsCoincident(*arc1, *arc2, tolerance)) {
+        return GeometryIssueType::CoincidentArcs;
+    }
+    return std::nullopt;
+}
+
+std::optional<Point2D> GeometryValidator::findIntersection(
+    SegmentRef lower,
+    SegmentRef higher,
+    double tolerance) noexcept {
+    std::vector<Point2D> points;
+    const auto* line1 = lower.line();
+    const auto* line2 = higher.line();
+    const auto* arc1 = lower.arc();
+    const auto* arc2 = higher.arc();
+
+    if (line1 && line2) {
+        if (auto point = GeometryMath::segmentSegmentIntersection(*line1, *line2)) {
+            points.push_back(*point);
+        }
+    } else if (line1 && arc2) {
+        points = GeometryMath::intersectLineArc(*line1, *arc2);
+    } else if (arc1 && line2) {
+        points = GeometryMath::intersectLineArc(*line2, *arc1);
+    } else if (arc1 && arc2) {
+        points = GeometryMath::intersectArcArc(*arc1, *arc2);
+    }
+
+    // Contour joints: the point is an endpoint of both entities
+    const double joint = std::max(tolerance, ENDPOINT_SNAP_TOLERANCE);
+    auto isEndpoint = [joint](const Point2D& point, SegmentRef entity) {
+        return entity.visit([&point, joint](auto&& geometry) {
+            using T = std::decay_t<decltype(geometry)>;
+            if constexpr (std::is_same_v<T, Line2D>) {
+                return point.isEqual(geometry.start(), joint) || point.isEqual(geometry.end(), joint);
+            } else {
+                return point.isEqual(geometry.startPoint(), joint) || point.isEqual(geometry.endPoint(), joint);
+            }
+        });
+    };
+
+    for (const auto& point : points) {
+        if (!(isEndpoint(point, lower) && isEndpoint(point, higher))) {
+            return point;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string GeometryValidator::intersectionDescription(const Point2D& point) {
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "Segments intersect at (%.6f, %.6f)",
+                  point.x(), point.y());
+    return buffer;
+}
+
+bool GeometryValidator::isPairIssue(GeometryIssueType type) noexcept {
+    switch (type) {
+        case GeometryIssueType::DuplicateLine:
+        case GeometryIssueType::OverlappingLines:
+        case GeometryIssueType::DuplicateArc:
+        case GeometryIssueType::CoincidentArcs:
+        case GeometryIssueType::SelfIntersection:
+        case GeometryIssueType::FeaturesTooClose:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool GeometryValidator::isContourIssue(GeometryIssueType type) noexcept {
+    return type == GeometryIssueType::HoleTooSmall;
+}
+
+bool GeometryValidator::isBlockingIssue(GeometryIssueType type) noexcept {
+    return type != GeometryIssueType::NumericalInstability &&
+           type != GeometryIssueType::FeaturesTooClose &&
+           type != GeometryIssueType::ShortEdge &&
+           type != GeometryIssueType::SharpCorner;
+}
+
+const char* GeometryValidator::pairDescription(GeometryIssueType type) noexcept {
+    switch (type) {
+        case GeometryIssueType::DuplicateLine:
+            return "Duplicate line detected (identical endpoints)";
+        case GeometryIssueType::OverlappingLines:
+            return "Overlapping lines detected (collinear with shared portion)";
+        case GeometryIssueType::DuplicateArc:
+            return "Duplicate arc detected (identical parameters)";
+        case GeometryIssueType::CoincidentArcs:
+            return "Coincident arcs detected (same circle with angular overlap)";
+        case GeometryIssueType::SelfIntersection:
+            return "Segments intersect";
+        case GeometryIssueType::FeaturesTooClose:
+            return "Features may be too close";
+        default:
+            return "Duplicate geometry detected";
+    }
+}
+
 // ============================================================================
 // COLLECTION VALIDATION WITH HANDLES
 // ============================================================================
 
+namespace {
+
+// Entities per block of parallel per-entity checks
+constexpr size_t ENTITY_BLOCK_SIZE = 1024;
+
+// Holes per block of parallel hole measurements
+constexpr size_t HOLE_BLOCK_SIZE = 256;
+
+/**
+ * @brief Progress, cancellation and budget bookkeeping for one rule
+ *
+ * proceed() is called once per entity but only does work every
+ * progressInterval entities. Parallel loops call checkpoint() once per
+ * block instead; it is safe to call from several workers.
+ */
+class RuleMonitor {
+public:
+    RuleMonitor(const ValidationControl& control, const char* rule, size_t total,
+                ValidationResult& result)
+        : control_(control)
+        , rule_(rule)
+        , total_(total)
+        , interval_(std::max<size_t>(control.progressInterval, 1))
+        , nextCheck_(0)
+        , reported_(0)
+        , anyReported_(false)
+        , stopped_(false)
+        , start_(std::chrono::steady_clock::now())
+        , result_(result)
+    {}
+
+    /**
+     * @brief Check in before processing an entity
+     * @return false if the rule must stop (cancelled or over budget)
+     */
+    bool proceed(size_t processed) {
+        if (processed < nextCheck_) {
+            return true;
+        }
+        nextCheck_ = processed + interval_;
+        return checkpoint(processed);
+    }
+
+    /**
+     * @brief Unthrottled check (thread-safe)
+     * @param processed Entities completed so far
+     * @return false if the rule must stop (cancelled or over budget)
+     */
+    bool checkpoint(size_t processed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_) {
+            return false;
+        }
+        if (control_.cancellation.isCancelled()) {
+            result_.cancelled = true;
+            stopped_ = true;
+            return false;
+        }
+        if (control_.ruleBudget.count() > 0 &&
+            std::chrono::steady_clock::now() - start_ > control_.ruleBudget) {
+            result_.truncatedRules.push_back(rule_);
+            stopped_ = true;
+            return false;
+        }
+        // Workers finish blocks out of order; keep reports monotonic and
+        // at most one per interval
+        if (!anyReported_ || processed >= reported_ + interval_) {
+            anyReported_ = true;
+            reported_ = processed;
+            report(processed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Check for cancellation outside the per-entity loop
+     */
+    bool cancelled() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (control_.cancellation.isCancelled()) {
+            result_.cancelled = true;
+        }
+        return result_.cancelled;
+    }
+
+    void finish() {
+        if (!result_.cancelled) {
+            report(total_);
+        }
+    }
+
+private:
+    void report(size_t processed) const {
+        if (control_.progress) {
+            control_.progress(ValidationProgress{rule_, processed, total_});
+        }
+    }
+
+    const ValidationControl& control_;
+    const char* rule_;
+    size_t total_;
+    size_t interval_;
+    size_t nextCheck_;
+    size_t reported_;
+    bool anyReported_;
+    bool stopped_;
+    std::chrono::steady_clock::time_point start_;
+    ValidationResult& result_;
+    std::mutex mutex_;
+};
+
+/**
+ * @brief Length of a line or arc
+ */
+double segmentLength(SegmentRef entity) noexcept {
+    return entity.visit([](auto&& geometry) { return geometry.length(); });
+}
+
+/**
+ * @brief Point at parameter t in [0, 1] of a line or arc
+ */
+Point2D segmentPointAt(SegmentRef entity, double t) noexcept {
+    return entity.visit([t](auto&& geometry) { return geometry.pointAt(t); });
+}
+
+/**
+ * @brief Point of a line or arc closest to a point
+ */
+Point2D closestPointOn(SegmentRef entity, const Point2D& point) noexcept {
+    if (const auto* line = entity.line()) {
+        return GeometryMath::closestPointOnSegment(point, *line);
+    }
+    return GeometryMath::closestPointOnArc(point, *entity.arc());
+}
+
+/**
+ * @brief Distance along a line or arc from one of its ends to a point on it
+ * @param fromStart Measure from the start point (otherwise from the end point)
+ */
+double lengthAlong(SegmentRef entity, const Point2D& point, bool fromStart) noexcept {
+    if (const auto* line = entity.line()) {
+        return GeometryMath::distance(fromStart ? line->start() : line->end(), point);
+    }
+    const Arc2D& arc = *entity.arc();
+    const double angle = std::atan2(point.y() - arc.center().y(), point.x() - arc.center().x());
+    const double turn = arc.isCounterClockwise() ? angle - arc.startAngle() : arc.startAngle() - angle;
+    const double fromStartLength = arc.radius() * std::min(GeometryMath::normalizeAngle(turn), arc.sweepAngle());
+    return fromStart ? fromStartLength : arc.length() - fromStartLength;
+}
+
+/**
+ * @brief Check if two close segments of one contour form a narrow neck
+ *
+ * Points closer than the spacing belong to a neck only when the contour
+ * between them is longer than a half circle across the spacing
+ * (π/2 × spacing). Corners, fillets and tessellated arcs never curl that
+ * much, so their segments are one feature even when the segments between
+ * them are shorter than the spacing.
+ *
+ * The segments between the pair are summed the shorter way round
+ * (stopping past the limit). If that is not enough, the closest points
+ * and the far end and midpoint of each segment, paired with the nearest
+ * point of the other segment, are checked.
+ */
+bool isNarrowNeck(const ProximityHit& hit, const Contour& contour, const ContourTopology& topology,
+                  const SegmentView& entities, double spacing) noexcept {
+    const double limit = HALF_PI * spacing;
+    const size_t count = contour.segments.size();
+    const size_t lo = std::min(topology.positionOf(hit.first), topology.positionOf(hit.second));
+    const size_t hi = std::max(topology.positionOf(hit.first), topology.positionOf(hit.second));
+
+    // Length of the segments strictly between two positions, walking forward
+    auto between = [&](size_t from, size_t to) {
+        double length = 0.0;
+        for (size_t p = (from + 1) % count; p != to && length <= limit; p = (p + 1) % count) {
+            length += segmentLength(entities[contour.segments[p].entity]);
+        }
+        return length;
+    };
+
+    // The path leaves `before` through its traversal end and enters `after`
+    // through its traversal start
+    size_t before = lo;
+    size_t after = hi;
+    double path = between(lo, hi);
+    if (contour.closed) {
+        const double around = between(hi, lo);
+        if (around < path) {
+            path = around;
+            std::swap(before, after);
+        }
+    }
+    if (path > limit) {
+        return true;
+    }
+
+    const size_t firstEntity = contour.segments[before].entity;
+    const SegmentRef first = entities[firstEntity];
+    const SegmentRef second = entities[contour.segments[after].entity];
+    const bool firstFromStart = contour.segments[before].reversed;
+    const bool secondFromStart = !contour.segments[after].reversed;
+
+    // p on first, q on second
+    auto isNeck = [&](const Point2D& p, const Point2D& q) {
+        return GeometryMath::distance(p, q) < spacing &&
+               lengthAlong(first, p, firstFromStart) + path + lengthAlong(second, q, secondFromStart) > limit;
+    };
+
+    const bool hitFirst = hit.first == firstEntity;
+    if (isNeck(hitFirst ? hit.firstPoint : hit.secondPoint, hitFirst ? hit.secondPoint : hit.firstPoint)) {
+        return true;
+    }
+    for (const double t : {firstFromStart ? 1.0 : 0.0, 0.5}) {
+        const Point2D p = segmentPointAt(first, t);
+        if (isNeck(p, closestPointOn(second, p))) {
+            return true;
+        }
+    }
+    for (const double t : {secondFromStart ? 1.0 : 0.0, 0.5}) {
+        const Point2D q = segmentPointAt(second, t);
+        if (isNeck(closestPointOn(first, q), q)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Attach the handle table to a rule's result if it reported anything
+ */
+void attachHandles(ValidationResult& result, const HandleTable& handles) {
+    if (!result.issues().empty() && result.handles.empty()) {
+        result.handles = handles;
+    }
+}
+
+} // namespace
+
 ValidationResult GeometryValidator::detectDuplicates(
-    const std::vector<std::variant<Line2D, Arc2D>>& entities,
-    const std::vector<std::string>& handles,
+    const SegmentView& entities,
+    const HandleTable& handles,
     double tolerance
+) noexcept {
+    return detectDuplicates(entities, handles, tolerance, ValidationControl());
+}
+
+ValidationResult GeometryValidator::detectDuplicates(
+    const SegmentView& entities,
+    const HandleTable& handles,
+    double tolerance,
+    const ValidationControl& control
 ) noexcept {
     ValidationResult result;
     result.isValid = true;
@@ -406,123 +942,372 @@ ValidationResult GeometryValidator::detectDuplicates(
         return result;  // Need at least 2 entities for duplicates
     }
 
-    // Ensure handles vector matches entities (or use empty strings)
-    auto getHandle = [&handles, n](size_t idx) -> std::string {
-        if (idx < handles.size()) {
-            return handles[idx];
+    RuleMonitor monitor(control, RULE_DUPLICATES, n, result);
+
+    // Lines and arcs each go through their own index. Line-arc pairs are
+    // never duplicates.
+    LineDuplicateIndex lineIndex(tolerance);
+    ArcDuplicateIndex arcIndex(tolerance);
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!monitor.proceed(i)) {
+            break;  // Over budget: pairs among the entities indexed so far
         }
-        return "";
-    };
+        const SegmentRef entity = entities[i];
+        if (const auto* line = entity.line()) {
+            lineIndex.insert(i, *line);
+        } else {
+            arcIndex.insert(i, *entity.arc());
+        }
+    }
+
+    if (monitor.cancelled()) {
+        return result;
+    }
+    std::vector<DuplicatePair> pairs = lineIndex.findPairs(control.threadCount, &control.cancellation);
+    if (monitor.cancelled()) {
+        return result;
+    }
+    std::vector<DuplicatePair> arcPairs = arcIndex.findPairs(control.threadCount, &control.cancellation);
+    if (monitor.cancelled()) {
+        return result;   // Pairs from a stopped sweep are incomplete
+    }
+    pairs.insert(pairs.end(), arcPairs.begin(), arcPairs.end());
+
+    // Report in (i, j) order, same as a nested pairwise scan
+    std::sort(pairs.begin(), pairs.end());
+
+    for (const auto& pair : pairs) {
+        result.isValid = false;
+        result.add(GeometryIssue(pair.type, pair.first, pair.second));
+    }
+
+    attachHandles(result, handles);
+    result.indexIssues();
+    monitor.finish();
+    return result;
+}
+
+ValidationResult GeometryValidator::detectSelfIntersections(
+    const SegmentView& entities,
+    const HandleTable& handles,
+    double tolerance
+) noexcept {
+    return detectSelfIntersections(entities, handles, tolerance, ValidationControl());
+}
+
+ValidationResult GeometryValidator::detectSelfIntersections(
+    const SegmentView& entities,
+    const HandleTable& handles,
+    double tolerance,
+    const ValidationControl& control
+) noexcept {
+    ValidationResult result;
+    result.isValid = true;
+
+    const size_t n = entities.size();
+    if (n < 2) {
+        return result;
+    }
 
-    // Pairwise comparison O(n²) - acceptable for typical CAD document sizes
+    RuleMonitor monitor(control, RULE_SELF_INTERSECTIONS, n, result);
+
+    IntersectionSweep sweep(tolerance);
+    sweep.reserve(n);
     for (size_t i = 0; i < n; ++i) {
-        for (size_t j = i + 1; j < n; ++j) {
-            // Check Line-Line pairs
-            if (std::holds_alternative<Line2D>(entities[i]) &&
-                std::holds_alternative<Line2D>(entities[j])) {
-
-                const auto& line1 = std::get<Line2D>(entities[i]);
-                const auto& line2 = std::get<Line2D>(entities[j]);
-
-                if (areLinesDuplicate(line1, line2, tolerance)) {
-                    result.isValid = false;
-                    result.issues.emplace_back(
-                        GeometryIssueType::DuplicateLine,
-                        i, j,
-                        "Duplicate line detected (identical endpoints)",
-                        getHandle(i), getHandle(j)
-                    );
-                } else if (areLinesOverlapping(line1, line2, tolerance)) {
-                    result.isValid = false;
-                    result.issues.emplace_back(
-                        GeometryIssueType::OverlappingLines,
-                        i, j,
-                        "Overlapping lines detected (collinear with shared portion)",
-                        getHandle(i), getHandle(j)
-                    );
-                }
+        if (!monitor.proceed(i)) {
+            break;  // Over budget: intersections among the entities added so far
+        }
+        sweep.insert(i, entities[i]);
+    }
+
+    if (monitor.cancelled()) {
+        return result;
+    }
+    const std::vector<IntersectionHit> hits = sweep.findIntersections(control.threadCount, &control.cancellation);
+    if (monitor.cancelled()) {
+        return result;
+    }
+
+    for (const auto& hit : hits) {
+        result.isValid = false;
+        GeometryIssue issue(GeometryIssueType::SelfIntersection, hit.first, hit.second);
+        issue.location = hit.point;
+        result.add(issue);
+    }
+
+    attachHandles(result, handles);
+    result.indexIssues();
+    monitor.finish();
+    return result;
+}
+
+ValidationResult GeometryValidator::checkHoleSizes(
+    const SegmentView& entities,
+    const HandleTable& handles,
+    const ContourTopology& contours,
+    const ValidationControl& control
+) noexcept {
+    ValidationResult result;
+    result.isValid = true;
+
+    const double minimum = control.rules.minHoleDiameter + control.rules.kerfWidth;
+    if (control.rules.minHoleDiameter <= 0.0) {
+        return result;
+    }
+
+    std::vector<size_t> holes;
+    for (size_t c = 0; c < contours.contours().size(); ++c) {
+        const Contour& contour = contours.contours()[c];
+        if (contour.isHole() && contour.area() > MIN_CONTOUR_AREA) {
+            holes.push_back(c);
+        }
+    }
+    if (holes.empty()) {
+        return result;
+    }
+
+    RuleMonitor monitor(control, RULE_HOLE_SIZE, holes.size(), result);
+    const size_t blockCount = (holes.size() + HOLE_BLOCK_SIZE - 1) / HOLE_BLOCK_SIZE;
+    // Issues with their contour members, added to the result's pool in report order
+    using HoleIssue = std::pair<GeometryIssue, std::vector<size_t>>;
+    std::vector<std::vector<HoleIssue>> blockIssues(blockCount);
+    std::atomic<size_t> completed{0};
+
+    ParallelExecutor::forEachChunk(blockCount, control.threadCount, [&](size_t block, size_t) {
+        if (!monitor.checkpoint(completed.load(std::memory_order_relaxed))) {
+            return;
+        }
+        const size_t begin = block * HOLE_BLOCK_SIZE;
+        const size_t end = std::min(begin + HOLE_BLOCK_SIZE, holes.size());
+        for (size_t h = begin; h < end; ++h) {
+            const Contour& contour = contours.contours()[holes[h]];
+            const HoleMeasurement hole = HoleMeasure::measure(contour, entities);
+            if (hole.diameter >= minimum) {
+                continue;
             }
 
-            // Check Arc-Arc pairs
-            if (std::holds_alternative<Arc2D>(entities[i]) &&
-                std::holds_alternative<Arc2D>(entities[j])) {
-
-                const auto& arc1 = std::get<Arc2D>(entities[i]);
-                const auto& arc2 = std::get<Arc2D>(entities[j]);
-
-                if (areArcsDuplicate(arc1, arc2, tolerance)) {
-                    result.isValid = false;
-                    result.issues.emplace_back(
-                        GeometryIssueType::DuplicateArc,
-                        i, j,
-                        "Duplicate arc detected (identical parameters)",
-                        getHandle(i), getHandle(j)
-                    );
-                } else if (areArcsCoincident(arc1, arc2, tolerance)) {
-                    result.isValid = false;
-                    result.issues.emplace_back(
-                        GeometryIssueType::CoincidentArcs,
-                        i, j,
-                        "Coincident arcs detected (same circle with angular overlap)",
-                        getHandle(i), getHandle(j)
-                    );
-                }
+            std::vector<size_t> members;
+            members.reserve(contour.segments.size());
+            for (const auto& segment : contour.segments) {
+                members.push_back(segment.entity);
             }
+            std::sort(members.begin(), members.end());
+
+            GeometryIssue issue(GeometryIssueType::HoleTooSmall, members.front());
+            issue.value = hole.diameter;
+            issue.limit = minimum;
+            issue.location = hole.center;
+            blockIssues[block].emplace_back(issue, std::move(members));
+        }
+        completed.fetch_add(end - begin, std::memory_order_relaxed);
+    });
+
+    std::vector<HoleIssue> found;
+    for (auto& issues : blockIssues) {
+        found.insert(found.end(), std::make_move_iterator(issues.begin()),
+                     std::make_move_iterator(issues.end()));
+    }
+    // Contour order is not entity order; report by lowest entity like the other rules
+    std::stable_sort(found.begin(), found.end(), [](const HoleIssue& a, const HoleIssue& b) {
+        return a.first.entityIndex < b.first.entityIndex;
+    });
+    for (auto& [issue, members] : found) {
+        result.setContour(issue, members);
+        result.add(issue);
+    }
+    attachHandles(result, handles);
+    result.indexIssues();
+    result.isValid = result.issues().empty();
+
+    if (monitor.cancelled()) {
+        return result;
+    }
+    monitor.finish();
+    return result;
+}
+
+ValidationResult GeometryValidator::checkFeatureSpacing(
+    const SegmentView& entities,
+    const HandleTable& handles,
+    const ContourTopology& contours,
+    const ValidationControl& control
+) noexcept {
+    ValidationResult result;
+    result.isValid = true;  // Warnings only
+
+    const double spacing = control.rules.featureSpacing();
+    const size_t n = entities.size();
+    if (spacing <= 0.0 || n < 2) {
+        return result;
+    }
+
+    RuleMonitor monitor(control, RULE_FEATURE_SPACING, n, result);
+
+    // Entities outside any contour (degenerate) are left to the entity checks
+    ProximitySweep sweep(spacing, GEOMETRY_EPSILON);
+    sweep.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        if (!monitor.proceed(i)) {
+            break;  // Over budget: pairs among the entities added so far
+        }
+        if (contours.contourOf(i) != ContourTopology::NONE) {
+            sweep.insert(i, entities[i]);
+        }
+    }
+
+    if (monitor.cancelled()) {
+        return result;
+    }
+    const std::vector<ProximityHit> hits = sweep.findClosePairs(control.threadCount, &control.cancellation);
+    if (monitor.cancelled()) {
+        return result;
+    }
+
+    // Closest segment pair per feature pair; hits are in (first, second)
+    // order, so ties keep the lowest pair
+    std::map<std::pair<size_t, size_t>, const ProximityHit*> closest;
+    for (const auto& hit : hits) {
+        const size_t a = contours.contourOf(hit.first);
+        const size_t b = contours.contourOf(hit.second);
+        if (a == b && !isNarrowNeck(hit, contours.contours()[a], contours, entities, spacing)) {
+            continue;   // Neighbours along one outline
+        }
+        const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+        auto it = closest.find(key);
+        if (it == closest.end()) {
+            closest.emplace(key, &hit);
+        } else if (hit.distance < it->second->distance) {
+            it->second = &hit;
         }
     }
 
+    std::vector<const ProximityHit*> reported;
+    reported.reserve(closest.size());
+    for (const auto& [features, hit] : closest) {
+        reported.push_back(hit);
+    }
+    std::sort(reported.begin(), reported.end(),
+              [](const ProximityHit* a, const ProximityHit* b) { return *a < *b; });
+
+    for (const ProximityHit* hit : reported) {
+        GeometryIssue issue(GeometryIssueType::FeaturesTooClose, hit->first, hit->second);
+        issue.value = hit->distance;
+        issue.limit = spacing;
+        issue.location = hit->firstPoint;
+        issue.relatedLocation = hit->secondPoint;
+        result.add(issue);
+    }
+
+    attachHandles(result, handles);
+    result.indexIssues();
+    monitor.finish();
     return result;
 }
 
 ValidationResult GeometryValidator::validateEntitiesWithHandles(
-    const std::vector<std::variant<Line2D, Arc2D>>& entities,
-    const std::vector<std::string>& handles,
+    const SegmentView& entities,
+    const HandleTable& handles,
     double tolerance
+) noexcept {
+    return validateEntitiesWithHandles(entities, handles, tolerance, ValidationControl());
+}
+
+ValidationResult GeometryValidator::validateEntitiesWithHandles(
+    const SegmentView& entities,
+    const HandleTable& handles,
+    double tolerance,
+    const ValidationControl& control
 ) noexcept {
     ValidationResult result;
     result.isValid = true;
 
-    auto getHandle = [&handles](size_t idx) -> std::string {
-        if (idx < handles.size()) {
-            return handles[idx];
-        }
-        return "";
-    };
+    // Every rule shares the caller's handle table
+    result.handles = handles;
 
-    // Step 1: Validate individual entities
-    for (size_t i = 0; i < entities.size(); ++i) {
-        std::visit([&](auto&& entity) {
-            using T = std::decay_t<decltype(entity)>;
-            ValidationResult entityResult;
-
-            if constexpr (std::is_same_v<T, Line2D>) {
-                entityResult = validateLine(entity, tolerance);
-            } else if constexpr (std::is_same_v<T, Arc2D>) {
-                entityResult = validateArc(entity, tolerance);
+    // Step 1: Validate individual entities. An import pipeline may have
+    // checked them already while the file was read; otherwise the kernel
+    // runs over each block, loading the geometry as it goes.
+    if (control.entityIssues) {
+        result.editIssues() = *control.entityIssues;
+        for (const auto& issue : result.issues()) {
+            if (isBlockingIssue(issue.type)) {
+                result.isValid = false;
+            }
+        }
+        result.indexIssues();
+    } else {
+        const size_t n = entities.size();
+        EntityColumns joints;
+        std::shared_ptr<const ContourTopology> contours = control.contours;
+        if (control.rules.minCornerAngle > 0.0 && n > 0) {
+            if (!contours) {
+                contours = std::make_shared<const ContourTopology>(
+                    ContourTopology::build(entities, ENDPOINT_SNAP_TOLERANCE, control.threadCount));
+            }
+            joints.setJoints(*contours, entities);
+        }
+        const EntityRuleKernel kernel(tolerance, control.rules);
+
+        RuleMonitor monitor(control, RULE_ENTITY_CHECKS, n, result);
+        const size_t blockCount = (n + ENTITY_BLOCK_SIZE - 1) / ENTITY_BLOCK_SIZE;
+        const size_t threads = std::min(ParallelExecutor::resolveThreadCount(control.threadCount), blockCount);
+        std::vector<EntityIssueRecord> records;
+
+        if (threads <= 1) {
+            // Check in as often as the progress interval asks for
+            const size_t step = std::min(ENTITY_BLOCK_SIZE, std::max<size_t>(control.progressInterval, 1));
+            for (size_t begin = 0; begin < n; begin += step) {
+                if (!monitor.proceed(begin)) {
+                    break;
+                }
+                kernel.run(entities, joints, begin, std::min(begin + step, n), records);
+            }
+        } else {
+            // Blocks run in any order; merging them by block index keeps the
+            // issue order of the serial loop
+            std::vector<std::vector<EntityIssueRecord>> blockRecords(blockCount);
+            std::atomic<size_t> completed{0};
+
+            ParallelExecutor::forEachChunk(blockCount, threads, [&](size_t block, size_t) {
+                if (!monitor.checkpoint(completed.load(std::memory_order_relaxed))) {
+                    return;
+                }
+                const size_t begin = block * ENTITY_BLOCK_SIZE;
+                const size_t end = std::min(begin + ENTITY_BLOCK_SIZE, n);
+                kernel.run(entities, joints, begin, end, blockRecords[block]);
+                completed.fetch_add(end - begin, std::memory_order_relaxed);
+            });
+
+            for (const auto& block : blockRecords) {
+                records.insert(records.end(), block.begin(), block.end());
             }
+        }
 
-            if (!entityResult.isValid) {
+        result.reserveIssues(records.size());
+        for (const auto& record : records) {
+            if (isBlockingIssue(record.type)) {
                 result.isValid = false;
             }
+            result.add(kernel.toIssue(record, joints));
+        }
+        result.indexIssues();
 
-            // Add entity-specific issues with index and handle
-            for (auto issue : entityResult.issues) {
-                issue.entityIndex = i;
-                issue.entityHandle = getHandle(i);
-                result.issues.push_back(issue);
-            }
-        }, entities[i]);
+        if (monitor.cancelled()) {
+            return result;
+        }
+        monitor.finish();
     }
 
     // Step 2: Detect duplicates and overlaps
-    ValidationResult duplicateResult = detectDuplicates(entities, handles, tolerance);
-    if (!duplicateResult.isValid) {
-        result.isValid = false;
-    }
-    for (const auto& issue : duplicateResult.issues) {
-        result.issues.push_back(issue);
+    result.append(detectDuplicates(entities, handles, tolerance, control));
+    if (result.cancelled) {
+        return result;
     }
 
+    // Step 3: Detect self-intersections
+    result.append(detectSelfIntersections(entities, handles, tolerance, control));
+
     return result;
 }
 
@@ -0,0 +1,254 @@
+#include "geometry/HoleMeasure.h"
+#include "geometry/GeometryConstants.h"
+#include "geometry/GeometryMath.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <queue>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+// Solver stops refining once no cell can beat the best circle by more than
+// this fraction of the contour's smaller bounding-box side
+constexpr double SOLVER_PRECISION = 1e-3;
+
+// Angle tolerance (radians) for right angles and half circles in the fast paths
+constexpr double SHAPE_ANGLE_TOLERANCE = 1e-6;
+
+const double SQRT2 = std::sqrt(2.0);
+
+/**
+ * @brief Distance from a point to the nearest segment of a contour
+ */
+double distanceToOutline(const Point2D& point, const Contour& contour,
+                         const SegmentView& entities) noexcept {
+    double nearest = std::numeric_limits<double>::max();
+    for (const auto& segment : contour.segments) {
+        const SegmentRef entity = entities[segment.entity];
+        const double distance = entity.line()
+            ? GeometryMath::distancePointToSegment(point, *entity.line())
+            : GeometryMath::distancePointToArc(point, *entity.arc());
+        nearest = std::min(nearest, distance);
+    }
+    return nearest;
+}
+
+/**
+ * @brief Arcs of one circle (a full circle, or a circle split into arcs)
+ */
+std::optional<HoleMeasurement> asCircle(const Contour& contour,
+                                        const SegmentView& entities) {
+    const auto* first = entities[contour.segments.front().entity].arc();
+    if (!first) {
+        return std::nullopt;
+    }
+    for (const auto& segment : contour.segments) {
+        const auto* arc = entities[segment.entity].arc();
+        if (!arc || !arc->center().isEqual(first->center(), ENDPOINT_SNAP_TOLERANCE) ||
+            std::abs(arc->radius() - first->radius()) > ENDPOINT_SNAP_TOLERANCE) {
+            return std::nullopt;
+        }
+    }
+    return HoleMeasurement{HoleShape::Circle, 2.0 * first->radius(), first->center()};
+}
+
+/**
+ * @brief Two parallel lines joined by two outward half circles of equal radius
+ */
+std::optional<HoleMeasurement> asSlot(const Contour& contour,
+                                      const SegmentView& entities) {
+    if (contour.segments.size() != 4) {
+        return std::nullopt;
+    }
+
+    // Lines and arcs alternate; take the arcs from either phase
+    const size_t phase = entities[contour.segments[0].entity].arc() ? 0 : 1;
+    const auto* arc1 = entities[contour.segments[phase].entity].arc();
+    const auto* arc2 = entities[contour.segments[phase + 2].entity].arc();
+    const auto* line1 = entities[contour.segments[1 - phase].entity].line();
+    const auto* line2 = entities[contour.segments[3 - phase].entity].line();
+    if (!arc1 || !arc2 || !line1 || !line2) {
+        return std::nullopt;
+    }
+
+    const double radius = arc1->radius();
+    if (std::abs(arc2->radius() - radius) > ENDPOINT_SNAP_TOLERANCE ||
+        std::abs(arc1->sweepAngle() - PI) > SHAPE_ANGLE_TOLERANCE ||
+        std::abs(arc2->sweepAngle() - PI) > SHAPE_ANGLE_TOLERANCE) {
+        return std::nullopt;
+    }
+
+    // Sides parallel to the axis through the centers (not tapered or sheared)
+    const Point2D axis(arc2->center().x() - arc1->center().x(), arc2->center().y() - arc1->center().y());
+    const double span = GeometryMath::distance(arc1->center(), arc2->center());
+    for (const Line2D* line : {line1, line2}) {
+        const Point2D side(line->end().x() - line->start().x(), line->end().y() - line->start().y());
+        const double cross = side.x() * axis.y() - side.y() * axis.x();
+        if (std::abs(cross) > SHAPE_ANGLE_TOLERANCE * line->length() * span) {
+            return std::nullopt;
+        }
+    }
+
+    // Both half circles bulge away from each other (not a bone shape)
+    if (GeometryMath::distance(arc1->pointAt(0.5), arc2->center()) <= span ||
+        GeometryMath::distance(arc2->pointAt(0.5), arc1->center()) <= span) {
+        return std::nullopt;
+    }
+
+    const Point2D center((arc1->center().x() + arc2->center().x()) * 0.5,
+                         (arc1->center().y() + arc2->center().y()) * 0.5);
+    return HoleMeasurement{HoleShape::Slot, 2.0 * radius, center};
+}
+
+/**
+ * @brief Four lines, each at a right angle to the next
+ */
+std::optional<HoleMeasurement> asRectangle(const Contour& contour,
+                                           const SegmentView& entities) {
+    if (contour.segments.size() != 4) {
+        return std::nullopt;
+    }
+
+    Point2D corners[4];
+    Point2D directions[4];
+    double lengths[4];
+    for (size_t i = 0; i < 4; ++i) {
+        const auto* line = entities[contour.segments[i].entity].line();
+        if (!line) {
+            return std::nullopt;
+        }
+        const bool reversed = contour.segments[i].reversed;
+        const Point2D from = reversed ? line->end() : line->start();
+        const Point2D to = reversed ? line->start() : line->end();
+        corners[i] = from;
+        directions[i] = Point2D(to.x() - from.x(), to.y() - from.y());
+        lengths[i] = line->length();
+    }
+
+    for (size_t i = 0; i < 4; ++i) {
+        const Point2D& a = directions[i];
+        const Point2D& b = directions[(i + 1) % 4];
+        const double dot = a.x() * b.x() + a.y() * b.y();
+        if (std::abs(dot) > SHAPE_ANGLE_TOLERANCE * lengths[i] * lengths[(i + 1) % 4]) {
+            return std::nullopt;
+        }
+    }
+
+    const Point2D center((corners[0].x() + corners[1].x() + corners[2].x() + corners[3].x()) * 0.25,
+                         (corners[0].y() + corners[1].y() + corners[2].y() + corners[3].y()) * 0.25);
+    const double width = std::min({lengths[0], lengths[1], lengths[2], lengths[3]});
+    return HoleMeasurement{HoleShape::Rectangle, width, center};
+}
+
+/**
+ * @brief Square solver cell, ordered by the largest circle it could hold
+ */
+struct Cell {
+    Point2D center;
+    double half;       ///< Half the side length
+    double distance;   ///< Signed distance from center to outline (negative outside)
+    double potential;  ///< distance + half diagonal: upper bound inside the cell
+
+    bool operator<(const Cell& other) const noexcept {
+        return potential < other.potential;
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// MEASUREMENT
+// ============================================================================
+
+HoleMeasurement HoleMeasure::measure(const Contour& contour,
+                                     const SegmentView& entities) noexcept {
+    if (!contour.closed || contour.segments.empty()) {
+        return HoleMeasurement{};
+    }
+    if (auto circle = asCircle(contour, entities)) {
+        return *circle;
+    }
+    if (auto slot = asSlot(contour, entities)) {
+        return *slot;
+    }
+    if (auto rectangle = asRectangle(contour, entities)) {
+        return *rectangle;
+    }
+    return solveInscribedCircle(contour, entities);
+}
+
+HoleMeasurement HoleMeasure::solveInscribedCircle(const Contour& contour,
+                                                  const SegmentView& entities,
+                                                  size_t maxCells) noexcept {
+    HoleMeasurement result;
+    result.center = contour.bounds.center();
+    if (!contour.closed || contour.segments.empty()) {
+        return result;
+    }
+
+    const double width = contour.bounds.width();
+    const double height = contour.bounds.height();
+    double cellSize = std::min(width, height);
+    if (!(cellSize > 0.0)) {
+        return result;
+    }
+
+    const std::vector<Point2D> polygon = ContourTopology::outline(contour, entities);
+    const double precision = std::max(GEOMETRY_EPSILON, SOLVER_PRECISION * cellSize);
+
+    size_t evaluated = 0;
+    auto evaluate = [&](const Point2D& center, double half) {
+        evaluated++;
+        double distance = distanceToOutline(center, contour, entities);
+        if (!ContourTopology::containsPoint(polygon, center)) {
+            distance = -distance;
+        }
+        return Cell{center, half, distance, distance + half * SQRT2};
+    };
+
+    // Long thin contours: coarser initial cells so the cover fits the budget
+    const size_t coverBudget = std::max<size_t>(maxCells / 4, 1);
+    if ((width / cellSize) * (height / cellSize) > static_cast<double>(coverBudget)) {
+        cellSize = std::sqrt(width * height / static_cast<double>(coverBudget));
+    }
+
+    std::priority_queue<Cell> queue;
+    const double half = cellSize * 0.5;
+    for (double x = contour.bounds.minX(); x < contour.bounds.maxX(); x += cellSize) {
+        for (double y = contour.bounds.minY(); y < contour.bounds.maxY(); y += cellSize) {
+            queue.push(evaluate(Point2D(x + half, y + half), half));
+        }
+    }
+
+    Cell best = evaluate(contour.bounds.center(), 0.0);
+    while (!queue.empty() && evaluated < maxCells) {
+        const Cell cell = queue.top();
+        queue.pop();
+
+        if (cell.distance > best.distance) {
+            best = cell;
+        }
+        if (cell.potential - best.distance <= precision) {
+            continue;  // Cannot hold a noticeably larger circle
+        }
+
+        const double quarter = cell.half * 0.5;
+        for (int dx = -1; dx <= 1; dx += 2) {
+            for (int dy = -1; dy <= 1; dy += 2) {
+                queue.push(evaluate(Point2D(cell.center.x() + dx * quarter,
+                                            cell.center.y() + dy * quarter), quarter));
+            }
+        }
+    }
+
+    result.diameter = std::max(0.0, 2.0 * best.distance);
+    result.center = best.center;
+    return result;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
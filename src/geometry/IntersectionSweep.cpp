@@ -0,0 +1,115 @@
+#include "geometry/IntersectionSweep.h"
+#include "geometry/BoundingBox.h"
+#include "geometry/GeometryConstants.h"
+#include "geometry/GeometryValidator.h"
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+// Sorted entries per parallel chunk. Each entry's scan reaches forward past
+// the chunk end, so chunks are independent.
+constexpr size_t SWEEP_CHUNK_SIZE = 4096;
+
+// Swept entries between two polls of the cancellation token
+constexpr size_t CANCEL_CHECK_ENTRIES = 64;
+
+} // namespace
+
+IntersectionSweep::IntersectionSweep(double tolerance) noexcept
+    : tolerance_(tolerance) {
+}
+
+void IntersectionSweep::reserve(size_t count) {
+    entries_.reserve(count);
+}
+
+void IntersectionSweep::insert(size_t entityIndex, SegmentRef entity) {
+    const BoundingBox box = entity.visit([](auto&& geometry) {
+        using T = std::decay_t<decltype(geometry)>;
+        if constexpr (std::is_same_v<T, Line2D>) {
+            return BoundingBox::fromLine(geometry);
+        } else {
+            return BoundingBox::fromArc(geometry);
+        }
+    });
+
+    // NaN bounds would break the sort; such entities are reported by the
+    // entity checks anyway
+    if (!std::isfinite(box.minX()) || !std::isfinite(box.minY()) ||
+        !std::isfinite(box.maxX()) || !std::isfinite(box.maxY())) {
+        return;
+    }
+
+    // The kernels accept points within GEOMETRY_EPSILON of each segment, so
+    // boxes are widened to keep every pair they can report
+    const double margin = std::max(tolerance_, GEOMETRY_EPSILON) * 2.0;
+    entries_.push_back({box.minX() - margin, box.maxX() + margin,
+                        box.minY() - margin, box.maxY() + margin,
+                        entityIndex, entity});
+}
+
+std::vector<IntersectionHit> IntersectionSweep::findIntersections(size_t threadCount,
+                                                                  const CancellationToken* cancellation) const {
+    std::vector<IntersectionHit> hits;
+
+    const size_t n = entries_.size();
+    if (n < 2) {
+        return hits;
+    }
+
+    // Left edge order; ties by entity index so the walk is reproducible
+    std::vector<Entry> sorted = entries_;
+    std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) {
+        if (a.minX != b.minX) return a.minX < b.minX;
+        return a.entityIndex < b.entityIndex;
+    });
+
+    const size_t chunkCount = (n + SWEEP_CHUNK_SIZE - 1) / SWEEP_CHUNK_SIZE;
+    std::vector<std::vector<IntersectionHit>> chunkHits(chunkCount);
+
+    ParallelExecutor::forEachChunk(chunkCount, threadCount, [&](size_t chunk, size_t) {
+        auto& out = chunkHits[chunk];
+        const size_t begin = chunk * SWEEP_CHUNK_SIZE;
+        const size_t end = std::min(begin + SWEEP_CHUNK_SIZE, n);
+
+        for (size_t a = begin; a < end; ++a) {
+            // First poll before any work, so a chunk never starts on a
+            // cancelled run
+            if (cancellation && (a - begin) % CANCEL_CHECK_ENTRIES == 0 && cancellation->isCancelled()) {
+                return;
+            }
+            const Entry& left = sorted[a];
+            // Entries after `a` start at or right of left.minX; the ones
+            // starting before left.maxX overlap it in x
+            for (size_t b = a + 1; b < n && sorted[b].minX <= left.maxX; ++b) {
+                const Entry& right = sorted[b];
+                if (right.maxY < left.minY || right.minY > left.maxY) {
+                    continue;
+                }
+
+                const bool leftFirst = left.entityIndex < right.entityIndex;
+                const Entry& lower = leftFirst ? left : right;
+                const Entry& higher = leftFirst ? right : left;
+                const auto point = GeometryValidator::findIntersection(
+                    lower.entity, higher.entity, tolerance_);
+                if (point) {
+                    out.push_back({lower.entityIndex, higher.entityIndex, *point});
+                }
+            }
+        }
+    });
+
+    for (const auto& chunk : chunkHits) {
+        hits.insert(hits.end(), chunk.begin(), chunk.end());
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
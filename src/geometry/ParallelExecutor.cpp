@@ -0,0 +1,54 @@
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace OwnCAD {
+namespace Geometry {
+
+size_t ParallelExecutor::resolveThreadCount(size_t requested) noexcept {
+    if (requested > 0) {
+        return requested;
+    }
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<size_t>(hardware) : 1;
+}
+
+size_t ParallelExecutor::forEachChunk(size_t chunkCount, size_t threadCount,
+                                      const ChunkTask& task) noexcept {
+    if (chunkCount == 0) {
+        return 0;
+    }
+
+    const size_t threads = std::min(resolveThreadCount(threadCount), chunkCount);
+    std::atomic<size_t> next{0};
+
+    auto work = [&next, chunkCount, &task](size_t worker) {
+        for (size_t chunk = next.fetch_add(1, std::memory_order_relaxed);
+             chunk < chunkCount;
+             chunk = next.fetch_add(1, std::memory_order_relaxed)) {
+            task(chunk, worker);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    try {
+        pool.reserve(threads - 1);
+        for (size_t worker = 1; worker < threads; ++worker) {
+            pool.emplace_back(work, worker);
+        }
+    } catch (const std::exception&) {
+        // Out of threads or memory: carry on with the workers we have
+    }
+
+    work(0);  // Calling thread is worker 0
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return pool.size() + 1;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,154 @@
+#include "geometry/ProximitySweep.h"
+#include "geometry/BoundingBox.h"
+#include "geometry/GeometryConstants.h"
+#include "geometry/GeometryMath.h"
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+// Sorted entries per parallel chunk (see IntersectionSweep)
+constexpr size_t SWEEP_CHUNK_SIZE = 4096;
+
+// Swept entries between two polls of the cancellation token (see IntersectionSweep)
+constexpr size_t CANCEL_CHECK_ENTRIES = 64;
+
+Point2D startOf(SegmentRef entity) noexcept {
+    return entity.line() ? entity.line()->start() : entity.arc()->startPoint();
+}
+
+Point2D endOf(SegmentRef entity) noexcept {
+    return entity.line() ? entity.line()->end() : entity.arc()->endPoint();
+}
+
+/**
+ * @brief Check if two entities meet at a joint (an endpoint of each)
+ */
+bool areAdjacent(SegmentRef a, SegmentRef b) noexcept {
+    const Point2D aEnds[2] = {startOf(a), endOf(a)};
+    const Point2D bEnds[2] = {startOf(b), endOf(b)};
+    for (const Point2D& p : aEnds) {
+        for (const Point2D& q : bEnds) {
+            if (p.isEqual(q, ENDPOINT_SNAP_TOLERANCE)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+GeometryMath::ClosestPoints measure(SegmentRef a, SegmentRef b) noexcept {
+    if (const auto* lineA = a.line()) {
+        if (const auto* lineB = b.line()) {
+            return GeometryMath::closestPoints(*lineA, *lineB);
+        }
+        return GeometryMath::closestPoints(*lineA, *b.arc());
+    }
+    const Arc2D& arcA = *a.arc();
+    if (const auto* lineB = b.line()) {
+        GeometryMath::ClosestPoints swapped = GeometryMath::closestPoints(*lineB, arcA);
+        std::swap(swapped.first, swapped.second);
+        return swapped;
+    }
+    return GeometryMath::closestPoints(arcA, *b.arc());
+}
+
+} // namespace
+
+ProximitySweep::ProximitySweep(double spacing, double tolerance) noexcept
+    : spacing_(spacing)
+    , tolerance_(tolerance) {
+}
+
+void ProximitySweep::reserve(size_t count) {
+    entries_.reserve(count);
+}
+
+void ProximitySweep::insert(size_t entityIndex, SegmentRef entity) {
+    const BoundingBox box = entity.visit([](auto&& geometry) {
+        using T = std::decay_t<decltype(geometry)>;
+        if constexpr (std::is_same_v<T, Line2D>) {
+            return BoundingBox::fromLine(geometry);
+        } else {
+            return BoundingBox::fromArc(geometry);
+        }
+    });
+
+    if (!std::isfinite(box.minX()) || !std::isfinite(box.minY()) ||
+        !std::isfinite(box.maxX()) || !std::isfinite(box.maxY())) {
+        return;
+    }
+
+    // Half the spacing on each box: two boxes overlap whenever their
+    // entities are closer than the spacing
+    const double margin = spacing_ * 0.5 + GEOMETRY_EPSILON;
+    entries_.push_back({box.minX() - margin, box.maxX() + margin,
+                        box.minY() - margin, box.maxY() + margin,
+                        entityIndex, entity});
+}
+
+std::vector<ProximityHit> ProximitySweep::findClosePairs(size_t threadCount,
+                                                         const CancellationToken* cancellation) const {
+    std::vector<ProximityHit> hits;
+
+    const size_t n = entries_.size();
+    if (n < 2) {
+        return hits;
+    }
+
+    std::vector<Entry> sorted = entries_;
+    std::sort(sorted.begin(), sorted.end(), [](const Entry& a, const Entry& b) {
+        if (a.minX != b.minX) return a.minX < b.minX;
+        return a.entityIndex < b.entityIndex;
+    });
+
+    const size_t chunkCount = (n + SWEEP_CHUNK_SIZE - 1) / SWEEP_CHUNK_SIZE;
+    std::vector<std::vector<ProximityHit>> chunkHits(chunkCount);
+
+    ParallelExecutor::forEachChunk(chunkCount, threadCount, [&](size_t chunk, size_t) {
+        auto& out = chunkHits[chunk];
+        const size_t begin = chunk * SWEEP_CHUNK_SIZE;
+        const size_t end = std::min(begin + SWEEP_CHUNK_SIZE, n);
+
+        for (size_t a = begin; a < end; ++a) {
+            // First poll before any work, so a chunk never starts on a
+            // cancelled run
+            if (cancellation && (a - begin) % CANCEL_CHECK_ENTRIES == 0 && cancellation->isCancelled()) {
+                return;
+            }
+            const Entry& left = sorted[a];
+            for (size_t b = a + 1; b < n && sorted[b].minX <= left.maxX; ++b) {
+                const Entry& right = sorted[b];
+                if (right.maxY < left.minY || right.minY > left.maxY) {
+                    continue;
+                }
+
+                const bool leftFirst = left.entityIndex < right.entityIndex;
+                const Entry& lower = leftFirst ? left : right;
+                const Entry& higher = leftFirst ? right : left;
+                if (areAdjacent(lower.entity, higher.entity)) {
+                    continue;
+                }
+
+                const GeometryMath::ClosestPoints closest = measure(lower.entity, higher.entity);
+                if (closest.distance < spacing_ && closest.distance > tolerance_) {
+                    out.push_back({lower.entityIndex, higher.entityIndex,
+                                   closest.first, closest.second, closest.distance});
+                }
+            }
+        }
+    });
+
+    for (const auto& chunk : chunkHits) {
+        hits.insert(hits.end(), chunk.begin(), chunk.end());
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,93 @@
+#include "geometry/SegmentView.h"
+#include <algorithm>
+
+namespace OwnCAD {
+namespace Geometry {
+
+namespace {
+
+SegmentRef readVectorSegment(const void* record) noexcept {
+    return SegmentRef(*static_cast<const SegmentView::Segment*>(record));
+}
+
+const std::string& noHandle() noexcept {
+    static const std::string none;
+    return none;
+}
+
+} // namespace
+
+// ============================================================================
+// SEGMENT VIEW
+// ============================================================================
+
+SegmentView::SegmentView(const std::vector<Segment>& segments) noexcept
+    : chunkCount_(1), size_(segments.size()), readSegment_(readVectorSegment) {
+    single_.records = segments.data();
+    single_.stride = sizeof(Segment);
+    single_.count = segments.size();
+}
+
+SegmentView::SegmentView(const Chunk* chunks, size_t chunkCount, ReadSegment readSegment,
+                         ReadHandle readHandle, std::shared_ptr<const void> owner) noexcept
+    : chunks_(chunks), chunkCount_(chunkCount),
+      readSegment_(readSegment), readHandle_(readHandle), owner_(std::move(owner)) {
+    if (chunkCount_ > 0) {
+        size_ = chunks_[chunkCount_ - 1].start + chunks_[chunkCount_ - 1].count;
+    }
+}
+
+size_t SegmentView::chunkIndexOf(size_t index) const noexcept {
+    if (!chunks_) {
+        return 0;
+    }
+    // Last chunk starting at or before index
+    const Chunk* found = std::upper_bound(chunks_, chunks_ + chunkCount_, index,
+                                          [](size_t value, const Chunk& chunk) { return value < chunk.start; });
+    return static_cast<size_t>(found - chunks_) - 1;
+}
+
+SegmentRef SegmentView::operator[](size_t index) const noexcept {
+    const Chunk& chunk = chunkAt(chunkIndexOf(index));
+    return readSegment_(recordOf(chunk, index - chunk.start));
+}
+
+const std::string& SegmentView::handle(size_t index) const noexcept {
+    const Chunk& chunk = chunkAt(chunkIndexOf(index));
+    return readHandle_(recordOf(chunk, index - chunk.start));
+}
+
+// ============================================================================
+// HANDLE TABLE
+// ============================================================================
+
+HandleTable::HandleTable(std::vector<std::string> handles)
+    : list_(std::make_shared<const std::vector<std::string>>(std::move(handles))) {
+}
+
+HandleTable::HandleTable(SegmentView entities) {
+    if (entities.hasHandles() && entities.owner()) {
+        view_ = std::move(entities);
+    }
+}
+
+size_t HandleTable::size() const noexcept {
+    return list_ ? list_->size() : view_.size();
+}
+
+const std::string& HandleTable::operator[](size_t index) const noexcept {
+    if (list_) {
+        return index < list_->size() ? (*list_)[index] : noHandle();
+    }
+    return index < view_.size() ? view_.handle(index) : noHandle();
+}
+
+bool HandleTable::sharesStorage(const HandleTable& other) const noexcept {
+    if (list_ || other.list_) {
+        return list_ == other.list_;
+    }
+    return view_.owner() && view_.owner() == other.view_.owner();
+}
+
+} // namespace Geometry
+} // namespace OwnCAD
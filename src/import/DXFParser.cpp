@@ -1,8 +1,9 @@
 #include "import/DXFParser.h"
-#include <sstream>
-#include <cctype>
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
 #include <cmath>
-#include <limits>
+#include <iterator>
+#include <utility>
 
 namespace OwnCAD {
 namespace Import {
@@ -11,33 +12,60 @@ namespace Import {
 // PUBLIC API
 // ============================================================================
 
-DXFParseResult DXFParser::parseFile(const std::string& filePath) {
-    std::ifstream file(filePath, std::ios::in);
+DXFParseResult DXFParser::parseFile(const std::string& filePath, size_t threadCount) {
+    // Map the file and tokenize its bytes in place
+    std::optional<MappedFile> file = MappedFile::open(filePath);
 
-    if (!file.is_open()) {
+    if (!file) {
         DXFParseResult result;
         result.success = false;
         result.errors.push_back("Failed to open file: " + filePath);
         return result;
     }
 
-    return parse(file);
+    return parse(file->data(), threadCount);
 }
 
-DXFParseResult DXFParser::parseString(const std::string& content) {
-    std::istringstream stream(content);
-    return parse(stream);
+DXFParseResult DXFParser::parseString(const std::string& content, size_t threadCount) {
+    return parse(content, threadCount);
+}
+
+DXFParseResult DXFParser::parseFile(const std::string& filePath,
+                                    const EntityBatchCallback& onBatch,
+                                    size_t batchSize) {
+    std::optional<MappedFile> file = MappedFile::open(filePath);
+
+    if (!file) {
+        DXFParseResult result;
+        result.success = false;
+        result.errors.push_back("Failed to open file: " + filePath);
+        return result;
+    }
+
+    return parse(file->data(), 1, &onBatch, batchSize);
+}
+
+DXFParseResult DXFParser::parseString(const std::string& content,
+                                      const EntityBatchCallback& onBatch,
+                                      size_t batchSize) {
+    return parse(content, 1, &onBatch, batchSize);
 }
 
 // ============================================================================
 // CORE PARSING
 // ============================================================================
 
-DXFParseResult DXFParser::parse(std::istream& input) {
+DXFParseResult DXFParser::parse(std::string_view text, size_t threadCount,
+                                const EntityBatchCallback* onBatch, size_t batchSize) {
+    DXFTokenizer tokenizer(text);
     ParserState state;
+    if (onBatch && *onBatch) {
+        state.onBatch = onBatch;
+        state.batchSize = std::max<size_t>(batchSize, 1);
+    }
 
     int code;
-    std::string value;
+    DXFValue value;
 
     while (true) {
         // Check if we have a lookahead group to process first
@@ -47,7 +75,7 @@ DXFParseResult DXFParser::parse(std::istream& input) {
             state.lookahead.valid = false;
         } else {
             // Read next group from stream
-            if (!readGroup(input, code, value, state.lineNumber)) {
+            if (!readGroup(tokenizer, code, value, state.lineNumber)) {
                 break;  // End of stream
             }
         }
@@ -56,10 +84,12 @@ DXFParseResult DXFParser::parse(std::istream& input) {
         if (code == 0) {
             if (value == "SECTION") {
                 // Read section name
-                if (readGroup(input, code, value, state.lineNumber) && code == 2) {
+                if (readGroup(tokenizer, code, value, state.lineNumber) && code == 2) {
                     state.currentSection = value;
                     if (value == "ENTITIES") {
                         state.inEntitiesSection = true;
+                        // Large sections are parsed up to their end on worker threads
+                        parseEntitiesParallel(text, tokenizer, state, threadCount);
                     }
                 }
             }
@@ -76,94 +106,224 @@ DXFParseResult DXFParser::parse(std::istream& input) {
             else if (state.inEntitiesSection) {
                 // Parse the entity - parseLine/Arc/Circle will consume groups
                 // and set state.lookahead when they encounter the next entity
-                auto entity = parseEntity(input, value, state);
-                if (entity.has_value()) {
-                    state.result.entities.push_back(entity.value());
-                    state.result.totalEntities++;
-                } else {
-                    state.result.skippedEntities++;
-                }
+                addEntity(tokenizer, value, state);
                 // Lookahead will be processed in next iteration
             }
         }
     }
 
+    flushEntities(state);
     state.result.success = state.result.errors.empty();
-    return state.result;
+    return std::move(state.result);
 }
 
-bool DXFParser::readGroup(std::istream& input, int& code, std::string& value, size_t& lineNumber) {
-    std::string codeLine;
+bool DXFParser::readGroup(DXFTokenizer& tokenizer, int& code, DXFValue& value, size_t& lineNumber) {
+    const bool read = tokenizer.next(code, value);
+    lineNumber = tokenizer.lineNumber();
+    return read;
+}
+
+// ============================================================================
+// PARALLEL ENTITIES SECTION
+// ============================================================================
 
-    // Read group code
-    if (!std::getline(input, codeLine)) {
+bool DXFParser::parseEntitiesParallel(
+    std::string_view text,
+    DXFTokenizer& tokenizer,
+    ParserState& state,
+    size_t threadCount
+) {
+    const size_t sectionStart = tokenizer.position();
+    const size_t sectionLine = tokenizer.lineNumber();
+    const size_t threads = Geometry::ParallelExecutor::resolveThreadCount(threadCount);
+    if (threads < 2 || text.size() - sectionStart < 2 * MIN_CHUNK_BYTES) {
         return false;
     }
-    lineNumber++;
-    codeLine = trim(codeLine);
 
-    if (!stringToInt(codeLine, code)) {
+    // Pre-scan: entity boundaries only, values are not converted
+    std::vector<EntityStart> starts;
+    EntityStart sectionEnd{};
+    if (!scanEntities(tokenizer, starts, sectionEnd) || starts.size() < 2) {
+        tokenizer.seek(sectionStart, sectionLine);
         return false;
     }
 
-    // Read group value
-    if (!std::getline(input, value)) {
+    // Cut [first entity, section end) into ranges of about equal bytes
+    const size_t rangeBytes = sectionEnd.position - starts.front().position;
+    const size_t chunkCount = std::min({threads * 4, rangeBytes / MIN_CHUNK_BYTES, starts.size()});
+    if (chunkCount < 2) {
+        tokenizer.seek(sectionStart, sectionLine);
         return false;
     }
-    lineNumber++;
-    value = trim(value);
+    const size_t targetBytes = rangeBytes / chunkCount;
+    std::vector<size_t> chunkFirst;   // Index into starts of each chunk's first entity
+    chunkFirst.push_back(0);
+    for (size_t i = 1; i < starts.size(); ++i) {
+        if (starts[i].position - starts[chunkFirst.back()].position >= targetBytes) {
+            chunkFirst.push_back(i);
+        }
+    }
+
+    std::vector<ParserState> chunkStates(chunkFirst.size());
+    Geometry::ParallelExecutor::forEachChunk(chunkFirst.size(), threads, [&](size_t chunk, size_t) {
+        const EntityStart& begin = starts[chunkFirst[chunk]];
+        const size_t end = chunk + 1 < chunkFirst.size()
+            ? starts[chunkFirst[chunk + 1]].position
+            : sectionEnd.position;
+
+        // The view ends at the next chunk, so the last entity stops there
+        DXFTokenizer chunkTokenizer(text.substr(0, end));
+        chunkTokenizer.seek(begin.position, begin.lineNumber);
+        ParserState& chunkState = chunkStates[chunk];
+        chunkState.lineNumber = begin.lineNumber;
+        chunkState.inEntitiesSection = true;
+        parseEntityRange(chunkTokenizer, chunkState);
+    });
+
+    // Merge in file order
+    DXFParseResult& result = state.result;
+    size_t entityCount = result.entities.size();
+    for (const auto& chunkState : chunkStates) {
+        entityCount += chunkState.result.entities.size();
+    }
+    result.entities.reserve(entityCount);
+    for (auto& chunkState : chunkStates) {
+        DXFParseResult& part = chunkState.result;
+        result.entities.insert(result.entities.end(),
+                               std::make_move_iterator(part.entities.begin()),
+                               std::make_move_iterator(part.entities.end()));
+        result.errors.insert(result.errors.end(),
+                             std::make_move_iterator(part.errors.begin()),
+                             std::make_move_iterator(part.errors.end()));
+        result.warnings.insert(result.warnings.end(),
+                               std::make_move_iterator(part.warnings.begin()),
+                               std::make_move_iterator(part.warnings.end()));
+        result.totalEntities += part.totalEntities;
+        result.skippedEntities += part.skippedEntities;
+    }
 
+    // The sequential loop handles the group that ends the section
+    tokenizer.seek(sectionEnd.position, sectionEnd.lineNumber);
+    state.lineNumber = sectionEnd.lineNumber;
     return true;
 }
 
+bool DXFParser::scanEntities(
+    DXFTokenizer& tokenizer,
+    std::vector<EntityStart>& starts,
+    EntityStart& sectionEnd
+) {
+    int code;
+    DXFValue value;
+
+    while (true) {
+        const EntityStart here{tokenizer.position(), tokenizer.lineNumber()};
+        if (!tokenizer.next(code, value)) {
+            // Malformed group or no ENDSEC: the sequential loop recovers
+            // differently, so leave those files to it
+            return false;
+        }
+        if (code != 0) {
+            continue;
+        }
+        if (value == "ENDSEC" || value == "SECTION" || value == "EOF") {
+            sectionEnd = here;
+            return true;
+        }
+        starts.push_back(here);
+    }
+}
+
+void DXFParser::parseEntityRange(DXFTokenizer& tokenizer, ParserState& state) {
+    int code;
+    DXFValue value;
+
+    while (true) {
+        if (state.lookahead.valid) {
+            code = state.lookahead.code;
+            value = state.lookahead.value;
+            state.lookahead.valid = false;
+        } else if (!readGroup(tokenizer, code, value, state.lineNumber)) {
+            break;  // End of range
+        }
+
+        if (code == 0) {
+            addEntity(tokenizer, value, state);
+        }
+    }
+}
+
+void DXFParser::addEntity(DXFTokenizer& tokenizer, std::string_view entityType, ParserState& state) {
+    auto entity = parseEntity(tokenizer, entityType, state);
+    if (entity.has_value()) {
+        state.result.entities.push_back(std::move(*entity));
+        state.result.totalEntities++;
+        if (state.onBatch && state.result.entities.size() >= state.batchSize) {
+            flushEntities(state);
+        }
+    } else {
+        state.result.skippedEntities++;
+    }
+}
+
+void DXFParser::flushEntities(ParserState& state) {
+    if (!state.onBatch || state.result.entities.empty()) {
+        return;
+    }
+    std::vector<DXFEntity> batch;
+    batch.reserve(state.batchSize);
+    batch.swap(state.result.entities);
+    (*state.onBatch)(std::move(batch));
+}
+
 // ============================================================================
 // ENTITY PARSING
 // ============================================================================
 
 std::optional<DXFEntity> DXFParser::parseEntity(
-    std::istream& input,
-    const std::string& entityType,
+    DXFTokenizer& tokenizer,
+    std::string_view entityType,
     ParserState& state
 ) {
     if (entityType == "LINE") {
-        return parseLine(input, state);
+        return parseLine(tokenizer, state);
     }
     else if (entityType == "ARC") {
-        return parseArc(input, state);
+        return parseArc(tokenizer, state);
     }
     else if (entityType == "CIRCLE") {
-        return parseCircle(input, state);
+        return parseCircle(tokenizer, state);
     }
     else if (entityType == "LWPOLYLINE") {
-        return parseLWPolyline(input, state);
+        return parseLWPolyline(tokenizer, state);
     }
     else if (entityType == "ELLIPSE") {
-        return parseEllipse(input, state);
+        return parseEllipse(tokenizer, state);
     }
     else if (entityType == "SPLINE") {
-        return parseSpline(input, state);
+        return parseSpline(tokenizer, state);
     }
     else if (entityType == "POINT") {
-        return parsePoint(input, state);
+        return parsePoint(tokenizer, state);
     }
     else if (entityType == "SOLID") {
-        return parseSolid(input, state);
+        return parseSolid(tokenizer, state);
     }
     else {
         // Unsupported entity - skip it
-        skipEntity(input, state);
+        skipEntity(tokenizer, state);
         return std::nullopt;
     }
 }
 
-std::optional<DXFEntity> DXFParser::parseLine(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseLine(DXFTokenizer& tokenizer, ParserState& state) {
     DXFLine line;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
 
     // Read groups until we hit code 0 (next entity) or end of stream
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             // Save for next entity parsing
             state.lookahead = GroupPair(code, value);
@@ -185,7 +345,7 @@ std::optional<DXFEntity> DXFParser::parseLine(std::istream& input, ParserState&
                     state.result.errors.push_back(
                         "LINE: Invalid start X coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -194,7 +354,7 @@ std::optional<DXFEntity> DXFParser::parseLine(std::istream& input, ParserState&
                     state.result.errors.push_back(
                         "LINE: Invalid start Y coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -206,7 +366,7 @@ std::optional<DXFEntity> DXFParser::parseLine(std::istream& input, ParserState&
                     state.result.errors.push_back(
                         "LINE: Invalid end X coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -215,7 +375,7 @@ std::optional<DXFEntity> DXFParser::parseLine(std::istream& input, ParserState&
                     state.result.errors.push_back(
                         "LINE: Invalid end Y coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -233,13 +393,13 @@ std::optional<DXFEntity> DXFParser::parseLine(std::istream& input, ParserState&
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseArc(DXFTokenizer& tokenizer, ParserState& state) {
     DXFArc arc;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             // Save for next entity
             state.lookahead = GroupPair(code, value);
@@ -261,7 +421,7 @@ std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& s
                     state.result.errors.push_back(
                         "ARC: Invalid center X coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -270,7 +430,7 @@ std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& s
                     state.result.errors.push_back(
                         "ARC: Invalid center Y coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -282,7 +442,7 @@ std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& s
                     state.result.errors.push_back(
                         "ARC: Invalid radius at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -291,7 +451,7 @@ std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& s
                     state.result.errors.push_back(
                         "ARC: Invalid start angle at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -300,7 +460,7 @@ std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& s
                     state.result.errors.push_back(
                         "ARC: Invalid end angle at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -315,13 +475,13 @@ std::optional<DXFEntity> DXFParser::parseArc(std::istream& input, ParserState& s
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parseCircle(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseCircle(DXFTokenizer& tokenizer, ParserState& state) {
     DXFCircle circle;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             // Save for next entity
             state.lookahead = GroupPair(code, value);
@@ -343,7 +503,7 @@ std::optional<DXFEntity> DXFParser::parseCircle(std::istream& input, ParserState
                     state.result.errors.push_back(
                         "CIRCLE: Invalid center X coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -352,7 +512,7 @@ std::optional<DXFEntity> DXFParser::parseCircle(std::istream& input, ParserState
                     state.result.errors.push_back(
                         "CIRCLE: Invalid center Y coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -364,7 +524,7 @@ std::optional<DXFEntity> DXFParser::parseCircle(std::istream& input, ParserState
                     state.result.errors.push_back(
                         "CIRCLE: Invalid radius at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 break;
@@ -379,10 +539,10 @@ std::optional<DXFEntity> DXFParser::parseCircle(std::istream& input, ParserState
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parseLWPolyline(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseLWPolyline(DXFTokenizer& tokenizer, ParserState& state) {
     DXFLWPolyline polyline;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
     int numVertices = 0;
 
@@ -391,7 +551,7 @@ std::optional<DXFEntity> DXFParser::parseLWPolyline(std::istream& input, ParserS
     bool hasX = false;
     bool hasY = false;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             // Save for next entity
             state.lookahead = GroupPair(code, value);
@@ -434,7 +594,7 @@ std::optional<DXFEntity> DXFParser::parseLWPolyline(std::istream& input, ParserS
                     state.result.errors.push_back(
                         "LWPOLYLINE: Invalid X coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 hasX = true;
@@ -444,7 +604,7 @@ std::optional<DXFEntity> DXFParser::parseLWPolyline(std::istream& input, ParserS
                     state.result.errors.push_back(
                         "LWPOLYLINE: Invalid Y coordinate at line " + std::to_string(state.lineNumber)
                     );
-                    skipEntity(input, state);
+                    skipEntity(tokenizer, state);
                     return std::nullopt;
                 }
                 hasY = true;
@@ -477,13 +637,13 @@ std::optional<DXFEntity> DXFParser::parseLWPolyline(std::istream& input, ParserS
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parseEllipse(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseEllipse(DXFTokenizer& tokenizer, ParserState& state) {
     DXFEllipse ellipse;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             state.lookahead = GroupPair(code, value);
             break;
@@ -540,16 +700,16 @@ std::optional<DXFEntity> DXFParser::parseEllipse(std::istream& input, ParserStat
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parseSpline(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseSpline(DXFTokenizer& tokenizer, ParserState& state) {
     DXFSpline spline;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
 
     DXFVertex currentVertex;
     bool hasVertexData = false;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             state.lookahead = GroupPair(code, value);
             break;
@@ -622,13 +782,13 @@ std::optional<DXFEntity> DXFParser::parseSpline(std::istream& input, ParserState
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parsePoint(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parsePoint(DXFTokenizer& tokenizer, ParserState& state) {
     DXFPoint point;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             state.lookahead = GroupPair(code, value);
             break;
@@ -667,14 +827,14 @@ std::optional<DXFEntity> DXFParser::parsePoint(std::istream& input, ParserState&
     return entity;
 }
 
-std::optional<DXFEntity> DXFParser::parseSolid(std::istream& input, ParserState& state) {
+std::optional<DXFEntity> DXFParser::parseSolid(DXFTokenizer& tokenizer, ParserState& state) {
     DXFSolid solid;
     int code;
-    std::string value;
+    DXFValue value;
     size_t startLine = state.lineNumber;
     bool hasPoint4 = false;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             state.lookahead = GroupPair(code, value);
             break;
@@ -745,11 +905,11 @@ std::optional<DXFEntity> DXFParser::parseSolid(std::istream& input, ParserState&
     return entity;
 }
 
-void DXFParser::skipEntity(std::istream& input, ParserState& state) {
+void DXFParser::skipEntity(DXFTokenizer& tokenizer, ParserState& state) {
     int code;
-    std::string value;
+    DXFValue value;
 
-    while (readGroup(input, code, value, state.lineNumber)) {
+    while (readGroup(tokenizer, code, value, state.lineNumber)) {
         if (code == 0) {
             // Start of next entity - save it
             state.lookahead = GroupPair(code, value);
@@ -762,39 +922,12 @@ void DXFParser::skipEntity(std::istream& input, ParserState& state) {
 // UTILITY FUNCTIONS
 // ============================================================================
 
-bool DXFParser::stringToDouble(const std::string& str, double& result) {
-    try {
-        size_t pos;
-        result = std::stod(str, &pos);
-        return pos == str.length();
-    } catch (...) {
-        return false;
-    }
-}
-
-bool DXFParser::stringToInt(const std::string& str, int& result) {
-    try {
-        size_t pos;
-        result = std::stoi(str, &pos);
-        return pos == str.length();
-    } catch (...) {
-        return false;
-    }
+bool DXFParser::stringToDouble(const DXFValue& value, double& result) {
+    return value.toDouble(result);
 }
 
-std::string DXFParser::trim(const std::string& str) {
-    size_t start = 0;
-    size_t end = str.length();
-
-    while (start < end && std::isspace(static_cast<unsigned char>(str[start]))) {
-        ++start;
-    }
-
-    while (end > start && std::isspace(static_cast<unsigned char>(str[end - 1]))) {
-        --end;
-    }
-
-    return str.substr(start, end - start);
+bool DXFParser::stringToInt(const DXFValue& value, int& result) {
+    return value.toInt(result);
 }
 
 bool DXFParser::isValidNumber(double value) {
@@ -0,0 +1,437 @@
+#include "import/DXFTokenizer.h"
+#include <cerrno>
+#include <charconv>
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <xlocale.h>
+#endif
+#endif
+
+namespace OwnCAD {
+namespace Import {
+
+// ============================================================================
+// MAPPED FILE
+// ============================================================================
+
+std::optional<MappedFile> MappedFile::open(const std::string& filePath) {
+    MappedFile file;
+
+#ifdef _WIN32
+    HANDLE handle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return std::nullopt;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size)) {
+        CloseHandle(handle);
+        return std::nullopt;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(handle);
+        return file;  // Nothing to map
+    }
+    HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(handle);  // The mapping keeps the file open
+    if (mapping == nullptr) {
+        return std::nullopt;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        return std::nullopt;
+    }
+    file.mapping_ = mapping;
+    file.data_ = static_cast<const char*>(view);
+    file.size_ = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    if (info.st_size == 0) {
+        ::close(fd);
+        return file;  // mmap rejects empty ranges
+    }
+    void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file open
+    if (view == MAP_FAILED) {
+        return std::nullopt;
+    }
+    ::madvise(view, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    file.data_ = static_cast<const char*>(view);
+    file.size_ = static_cast<size_t>(info.st_size);
+#endif
+
+    return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(other.data_)
+    , size_(other.size_)
+#ifdef _WIN32
+    , mapping_(other.mapping_)
+#endif
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+#ifdef _WIN32
+    other.mapping_ = nullptr;
+#endif
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        other.data_ = nullptr;
+        other.size_ = 0;
+#ifdef _WIN32
+        mapping_ = other.mapping_;
+        other.mapping_ = nullptr;
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() noexcept {
+    if (data_ == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+#else
+    ::munmap(const_cast<char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+// ============================================================================
+// TOKENIZER
+// ============================================================================
+
+DXFTokenizer::DXFTokenizer(std::string_view text) noexcept
+    : text_(text) {
+    if (text_.substr(0, BINARY_SENTINEL.size()) == BINARY_SENTINEL) {
+        binary_ = true;
+        position_ = BINARY_SENTINEL.size();
+        // Files start with group 0: two zero bytes, or one before the
+        // "SECTION" of an R12 file with one-byte codes
+        shortCodes_ = text_.size() > position_ + 1 && text_[position_] == '\0' && text_[position_ + 1] != '\0';
+        return;
+    }
+    // UTF-8 byte order mark written by some editors
+    if (text_.size() >= 3 && text_.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        position_ = 3;
+    }
+}
+
+bool DXFTokenizer::nextLine(std::string_view& line) noexcept {
+    if (position_ >= text_.size()) {
+        return false;
+    }
+    const char* begin = text_.data() + position_;
+    const size_t remaining = text_.size() - position_;
+    const void* newline = std::memchr(begin, '\n', remaining);
+    const size_t length = newline ? static_cast<size_t>(static_cast<const char*>(newline) - begin)
+                                  : remaining;
+
+    line = std::string_view(begin, length);  // CR of a CRLF is trimmed with the rest
+    position_ += newline ? length + 1 : length;
+    ++lineNumber_;
+    return true;
+}
+
+bool DXFTokenizer::next(int& code, DXFValue& value) noexcept {
+    if (binary_) {
+        return nextBinary(code, value);
+    }
+    std::string_view line;
+    if (!nextLine(line) || !parseInt(trim(line), code)) {
+        return false;
+    }
+    if (!nextLine(line)) {
+        return false;
+    }
+    value = DXFValue(trim(line));
+    return true;
+}
+
+std::string_view DXFTokenizer::trim(std::string_view text) noexcept {
+    auto isSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+    };
+    size_t start = 0;
+    size_t end = text.size();
+    while (start < end && isSpace(text[start])) {
+        ++start;
+    }
+    while (end > start && isSpace(text[end - 1])) {
+        --end;
+    }
+    return text.substr(start, end - start);
+}
+
+namespace {
+
+/**
+ * @brief Drop a '+' sign, which from_chars does not accept
+ */
+std::string_view withoutPlus(std::string_view text) noexcept {
+    if (text.size() > 1 && text[0] == '+' && text[1] != '+' && text[1] != '-') {
+        text.remove_prefix(1);
+    }
+    return text;
+}
+
+} // namespace
+
+// ============================================================================
+// BINARY DXF
+// ============================================================================
+
+namespace {
+
+uint64_t readLittleEndian(const char* bytes, size_t count) noexcept {
+    uint64_t value = 0;
+    for (size_t i = 0; i < count; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    }
+    return value;
+}
+
+} // namespace
+
+bool DXFTokenizer::nextBinary(int& code, DXFValue& value) noexcept {
+    const char* data = text_.data();
+    const size_t size = text_.size();
+    size_t at = position_;
+
+    // Group code
+    if (shortCodes_) {
+        if (at + 1 > size) {
+            return false;
+        }
+        code = static_cast<unsigned char>(data[at++]);
+        if (code == 255) {   // Escape: a two-byte code follows
+            if (at + 2 > size) {
+                return false;
+            }
+            code = static_cast<int16_t>(readLittleEndian(data + at, 2));
+            at += 2;
+        }
+    } else {
+        if (at + 2 > size) {
+            return false;
+        }
+        code = static_cast<int16_t>(readLittleEndian(data + at, 2));
+        at += 2;
+    }
+
+    // Value, stored by the code's type
+    value = DXFValue();
+    auto fixed = [&](size_t bytes) {
+        if (at + bytes > size) {
+            return false;
+        }
+        const uint64_t raw = readLittleEndian(data + at, bytes);
+        at += bytes;
+        value.kind = DXFValue::Kind::Integer;
+        switch (bytes) {
+            case 1: value.integer = static_cast<int64_t>(raw); break;
+            case 2: value.integer = static_cast<int16_t>(raw); break;
+            case 4: value.integer = static_cast<int32_t>(raw); break;
+            default: value.integer = static_cast<int64_t>(raw); break;
+        }
+        return true;
+    };
+
+    switch (valueType(code)) {
+        case DXFValueType::String: {
+            const void* end = at < size ? std::memchr(data + at, '\0', size - at) : nullptr;
+            if (!end) {
+                return false;
+            }
+            const size_t length = static_cast<size_t>(static_cast<const char*>(end) - (data + at));
+            value.text = std::string_view(data + at, length);
+            at += length + 1;
+            break;
+        }
+        case DXFValueType::Double: {
+            if (at + 8 > size) {
+                return false;
+            }
+            const uint64_t raw = readLittleEndian(data + at, 8);
+            std::memcpy(&value.real, &raw, sizeof(raw));
+            value.kind = DXFValue::Kind::Real;
+            at += 8;
+            break;
+        }
+        case DXFValueType::Int16:
+            if (!fixed(2)) return false;
+            break;
+        case DXFValueType::Int32:
+            if (!fixed(4)) return false;
+            break;
+        case DXFValueType::Int64:
+            if (!fixed(8)) return false;
+            break;
+        case DXFValueType::Bool:
+            if (!fixed(1)) return false;
+            break;
+        case DXFValueType::Binary: {
+            if (at + 1 > size) {
+                return false;
+            }
+            const size_t length = static_cast<unsigned char>(data[at]);
+            if (at + 1 + length > size) {
+                return false;
+            }
+            value.text = std::string_view(data + at + 1, length);
+            at += 1 + length;
+            break;
+        }
+        case DXFValueType::Unknown:
+            return false;
+    }
+
+    position_ = at;
+    lineNumber_ += 2;
+    return true;
+}
+
+DXFValueType DXFTokenizer::valueType(int code) noexcept {
+    if (code < 0) return DXFValueType::String;            // Application codes (-1 to -5)
+    if (code <= 9) return DXFValueType::String;
+    if (code <= 59) return DXFValueType::Double;
+    if (code <= 79) return DXFValueType::Int16;
+    if (code >= 90 && code <= 99) return DXFValueType::Int32;
+    if (code >= 100 && code <= 109) return DXFValueType::String;
+    if (code >= 110 && code <= 149) return DXFValueType::Double;
+    if (code >= 160 && code <= 169) return DXFValueType::Int64;
+    if (code >= 170 && code <= 179) return DXFValueType::Int16;
+    if (code >= 210 && code <= 239) return DXFValueType::Double;
+    if (code >= 270 && code <= 289) return DXFValueType::Int16;
+    if (code >= 290 && code <= 299) return DXFValueType::Bool;
+    if (code >= 300 && code <= 309) return DXFValueType::String;
+    if (code >= 310 && code <= 319) return DXFValueType::Binary;
+    if (code >= 320 && code <= 369) return DXFValueType::String;
+    if (code >= 370 && code <= 389) return DXFValueType::Int16;
+    if (code >= 390 && code <= 399) return DXFValueType::String;
+    if (code >= 400 && code <= 409) return DXFValueType::Int16;
+    if (code >= 410 && code <= 419) return DXFValueType::String;
+    if (code >= 420 && code <= 429) return DXFValueType::Int32;
+    if (code >= 430 && code <= 439) return DXFValueType::String;
+    if (code >= 440 && code <= 459) return DXFValueType::Int32;
+    if (code >= 460 && code <= 469) return DXFValueType::Double;
+    if (code >= 470 && code <= 481) return DXFValueType::String;
+    if (code == 999) return DXFValueType::String;
+    if (code == 1004) return DXFValueType::Binary;
+    if (code >= 1000 && code <= 1009) return DXFValueType::String;
+    if (code >= 1010 && code <= 1059) return DXFValueType::Double;
+    if (code >= 1060 && code <= 1070) return DXFValueType::Int16;
+    if (code == 1071) return DXFValueType::Int32;
+    return DXFValueType::Unknown;
+}
+
+// ============================================================================
+// VALUES
+// ============================================================================
+
+bool DXFValue::toDouble(double& result) const noexcept {
+    switch (kind) {
+        case Kind::Real:
+            result = real;
+            return true;
+        case Kind::Integer:
+            result = static_cast<double>(integer);
+            return true;
+        default:
+            return DXFTokenizer::parseDouble(text, result);
+    }
+}
+
+bool DXFValue::toInt(int& result) const noexcept {
+    switch (kind) {
+        case Kind::Integer:
+            if (integer < INT32_MIN || integer > INT32_MAX) {
+                return false;
+            }
+            result = static_cast<int>(integer);
+            return true;
+        case Kind::Real:
+            return false;
+        default:
+            return DXFTokenizer::parseInt(text, result);
+    }
+}
+
+bool DXFTokenizer::parseDouble(std::string_view text, double& result) noexcept {
+    text = withoutPlus(text);
+    if (text.empty()) {
+        return false;
+    }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const char* last = text.data() + text.size();
+    const auto parsed = std::from_chars(text.data(), last, result);
+    return parsed.ec == std::errc() && parsed.ptr == last;
+#else
+    // No floating-point from_chars in this standard library. Parse in the
+    // "C" locale: QApplication applies the user's locale, and with a comma
+    // decimal separator plain strtod would stop at the '.'
+    char buffer[64];
+    if (text.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    char* end = nullptr;
+    errno = 0;
+#ifdef _WIN32
+    static const _locale_t cLocale = _create_locale(LC_NUMERIC, "C");
+    result = _strtod_l(buffer, &end, cLocale);
+#else
+    static const locale_t cLocale = newlocale(LC_NUMERIC_MASK, "C", locale_t(0));
+    result = strtod_l(buffer, &end, cLocale);
+#endif
+    return errno == 0 && end == buffer + text.size();
+#endif
+}
+
+bool DXFTokenizer::parseInt(std::string_view text, int& result) noexcept {
+    text = withoutPlus(text);
+    const char* last = text.data() + text.size();
+    const auto parsed = std::from_chars(text.data(), last, result);
+    return !text.empty() && parsed.ec == std::errc() && parsed.ptr == last;
+}
+
+} // namespace Import
+} // namespace OwnCAD
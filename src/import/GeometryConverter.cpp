@@ -2,49 +2,74 @@
 #include "geometry/GeometryConstants.h"
 #include <cmath>
 #include <sstream>
-#include <iostream>
 
 namespace OwnCAD {
 namespace Import {
 
 using namespace OwnCAD::Geometry;
 
+namespace {
+
+/**
+ * @brief Concatenate streamable parts into message text
+ */
+template <typename... Parts>
+std::string describe(const Parts&... parts) {
+    std::ostringstream out;
+    (out << ... << parts);
+    return out.str();
+}
+
+} // namespace
+
 // ============================================================================
 // PUBLIC API
 // ============================================================================
 
-ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEntities) {
+ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEntities,
+                                            ImportDiagnostics* diagnostics) {
     ConversionResult result;
-
-    std::cout << "\n=== GeometryConverter: Converting " << dxfEntities.size() << " DXF entities ===" << std::endl;
+    ImportDiagnostics::Counters counts;   // Merged once, at the end
+    const bool keepsDetails = diagnostics && diagnostics->wants(DiagnosticSeverity::Debug);
 
     for (size_t i = 0; i < dxfEntities.size(); ++i) {
         const auto& dxfEntity = dxfEntities[i];
-        std::cout << "\nEntity " << (i+1) << "/" << dxfEntities.size() << " (line " << dxfEntity.lineNumber << "):" << std::endl;
         std::optional<GeometryEntity> converted;
         std::string layer;
         std::string handle;
         int colorNumber = 256;  // Default: BYLAYER
 
+        // Count an outcome; format its text only if the sink keeps it
+        auto note = [&](DiagnosticSeverity severity, const auto&... parts) {
+            counts.add(dxfEntity.type, severity);
+            if (diagnostics && diagnostics->wants(severity)) {
+                diagnostics->report(severity, dxfEntity.type, dxfEntity.lineNumber, describe(parts...));
+            }
+        };
+        auto detail = [&](const auto&... parts) {
+            if (keepsDetails) {
+                diagnostics->report(DiagnosticSeverity::Debug, dxfEntity.type,
+                                    dxfEntity.lineNumber, describe(parts...));
+            }
+        };
+
         // Convert based on type
         std::visit([&](auto&& entity) {
             using T = std::decay_t<decltype(entity)>;
 
             if constexpr (std::is_same_v<T, DXFLine>) {
-                std::cout << "  Type: LINE" << std::endl;
-                std::cout << "  Start: (" << entity.startX << ", " << entity.startY << ")" << std::endl;
-                std::cout << "  End: (" << entity.endX << ", " << entity.endY << ")" << std::endl;
+                detail("LINE start (", entity.startX, ", ", entity.startY,
+                       ") end (", entity.endX, ", ", entity.endY, ")");
 
                 auto line = convertLine(entity);
                 if (line.has_value()) {
-                    double len = line->length();
-                    std::cout << "  ✅ VALID - Length: " << len << std::endl;
+                    note(DiagnosticSeverity::Info, "LINE accepted, length ", line->length());
                     converted = GeometryEntity(line.value());
                     layer = entity.layer;
                     handle = entity.handle;
                     colorNumber = entity.colorNumber;
                 } else{
-                    std::cout << "  ❌ REJECTED - Zero-length or invalid coordinates" << std::endl;
+                    note(DiagnosticSeverity::Error, "LINE rejected: zero-length or invalid coordinates");
                     result.errors.push_back(
                         createErrorMessage("LINE", "Invalid geometry (zero-length or bad coordinates)",
                                          dxfEntity.lineNumber)
@@ -53,20 +78,18 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 }
             }
             else if constexpr (std::is_same_v<T, DXFArc>) {
-                std::cout << "  Type: ARC" << std::endl;
-                std::cout << "  Center: (" << entity.centerX << ", " << entity.centerY << ")" << std::endl;
-                std::cout << "  Radius: " << entity.radius << std::endl;
-                std::cout << "  Angles: " << entity.startAngle << "° to " << entity.endAngle << "°" << std::endl;
+                detail("ARC center (", entity.centerX, ", ", entity.centerY, ") radius ", entity.radius,
+                       " angles ", entity.startAngle, " to ", entity.endAngle, " degrees");
 
                 auto arc = convertArc(entity);
                 if (arc.has_value()) {
-                    std::cout << "  ✅ VALID" << std::endl;
+                    note(DiagnosticSeverity::Info, "ARC accepted");
                     converted = GeometryEntity(arc.value());
                     layer = entity.layer;
                     handle = entity.handle;
                     colorNumber = entity.colorNumber;
                 } else {
-                    std::cout << "  ❌ REJECTED - Zero-radius or degenerate" << std::endl;
+                    note(DiagnosticSeverity::Error, "ARC rejected: zero-radius or degenerate");
                     result.errors.push_back(
                         createErrorMessage("ARC", "Invalid geometry (zero-radius or degenerate)",
                                          dxfEntity.lineNumber)
@@ -75,19 +98,17 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 }
             }
             else if constexpr (std::is_same_v<T, DXFCircle>) {
-                std::cout << "  Type: CIRCLE" << std::endl;
-                std::cout << "  Center: (" << entity.centerX << ", " << entity.centerY << ")" << std::endl;
-                std::cout << "  Radius: " << entity.radius << std::endl;
+                detail("CIRCLE center (", entity.centerX, ", ", entity.centerY, ") radius ", entity.radius);
 
                 auto arc = convertCircle(entity);
                 if (arc.has_value()) {
-                    std::cout << "  ✅ VALID (converted to full arc)" << std::endl;
+                    note(DiagnosticSeverity::Info, "CIRCLE accepted (converted to full arc)");
                     converted = GeometryEntity(arc.value());
                     layer = entity.layer;
                     handle = entity.handle;
                     colorNumber = entity.colorNumber;
                 } else {
-                    std::cout << "  ❌ REJECTED - Zero-radius" << std::endl;
+                    note(DiagnosticSeverity::Error, "CIRCLE rejected: zero-radius");
                     result.errors.push_back(
                         createErrorMessage("CIRCLE", "Invalid geometry (zero-radius)",
                                          dxfEntity.lineNumber)
@@ -96,30 +117,12 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 }
             }
             else if constexpr (std::is_same_v<T, DXFLWPolyline>) {
-                std::cout << "  Type: LWPOLYLINE" << std::endl;
-                std::cout << "  Vertices: " << entity.vertices.size() << std::endl;
-                std::cout << "  Closed: " << (entity.closed ? "yes" : "no") << std::endl;
-
-                // Check for bulge values
-                int bulgeCount = 0;
-                for (const auto& v : entity.vertices) {
-                    if (std::abs(v.bulge) > 1e-9) bulgeCount++;
-                }
-                if (bulgeCount > 0) {
-                    std::cout << "  Bulge segments: " << bulgeCount << " (will be converted to arcs)" << std::endl;
-                }
-
                 // Convert polyline to geometry segments (Line2D or Arc2D)
                 auto segments = convertPolyline(entity);
-
-                // Count segment types for logging
-                int lineCount = 0, arcCount = 0;
-                for (const auto& seg : segments) {
-                    if (std::holds_alternative<Geometry::Line2D>(seg)) lineCount++;
-                    else if (std::holds_alternative<Geometry::Arc2D>(seg)) arcCount++;
+                if (keepsDetails) {   // describeSegments() formats eagerly
+                    detail("LWPOLYLINE ", entity.vertices.size(), " vertices, ",
+                           entity.closed ? "closed" : "open", ", ", describeSegments(segments));
                 }
-                std::cout << "  Converted to " << segments.size() << " segments ("
-                          << lineCount << " lines, " << arcCount << " arcs)" << std::endl;
 
                 if (!segments.empty()) {
                     // Add all segments individually
@@ -138,9 +141,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                     // even though it created multiple segments
                     result.totalConverted++;
 
-                    std::cout << "  ✅ VALID - Polyline decomposed into " << segments.size() << " segments" << std::endl;
+                    note(DiagnosticSeverity::Info, "LWPOLYLINE accepted, decomposed into ",
+                         segments.size(), " segments");
                 } else {
-                    std::cout << "  ❌ REJECTED - No valid segments" << std::endl;
+                    note(DiagnosticSeverity::Error, "LWPOLYLINE rejected: no valid segments");
                     result.errors.push_back(
                         createErrorMessage("LWPOLYLINE", "No valid segments could be created",
                                          dxfEntity.lineNumber)
@@ -153,19 +157,18 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 handle.clear();
             }
             else if constexpr (std::is_same_v<T, DXFEllipse>) {
-                std::cout << "  Type: ELLIPSE" << std::endl;
-                std::cout << "  Center: (" << entity.centerX << ", " << entity.centerY << ")" << std::endl;
-                std::cout << "  Minor/Major ratio: " << entity.minorAxisRatio << std::endl;
+                detail("ELLIPSE center (", entity.centerX, ", ", entity.centerY,
+                       ") minor/major ratio ", entity.minorAxisRatio);
 
                 auto ellipse = convertEllipse(entity);
                 if (ellipse.has_value()) {
-                    std::cout << "  ✅ VALID" << std::endl;
+                    note(DiagnosticSeverity::Info, "ELLIPSE accepted");
                     converted = GeometryEntity(ellipse.value());
                     layer = entity.layer;
                     handle = entity.handle;
                     colorNumber = entity.colorNumber;
                 } else {
-                    std::cout << "  ❌ REJECTED - Invalid ellipse parameters" << std::endl;
+                    note(DiagnosticSeverity::Error, "ELLIPSE rejected: invalid ellipse parameters");
                     result.errors.push_back(
                         createErrorMessage("ELLIPSE", "Invalid geometry",
                                          dxfEntity.lineNumber)
@@ -174,13 +177,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 }
             }
             else if constexpr (std::is_same_v<T, DXFSpline>) {
-                std::cout << "  Type: SPLINE" << std::endl;
-                std::cout << "  Control points: " << entity.controlPoints.size() << std::endl;
-                std::cout << "  Degree: " << entity.degree << std::endl;
-
                 // Convert spline to line segments
                 auto lines = convertSpline(entity);
-                std::cout << "  Approximated with " << lines.size() << " line segments" << std::endl;
+                detail("SPLINE ", entity.controlPoints.size(), " control points, degree ",
+                       entity.degree, ", ", lines.size(), " line segments");
 
                 if (!lines.empty()) {
                     // Add all line segments individually
@@ -196,9 +196,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                     }
 
                     result.totalConverted++;
-                    std::cout << "  ✅ VALID - Spline approximated with " << lines.size() << " segments" << std::endl;
+                    note(DiagnosticSeverity::Info, "SPLINE accepted, approximated with ",
+                         lines.size(), " segments");
                 } else {
-                    std::cout << "  ❌ REJECTED - No valid segments" << std::endl;
+                    note(DiagnosticSeverity::Error, "SPLINE rejected: no valid segments");
                     result.errors.push_back(
                         createErrorMessage("SPLINE", "No valid line segments could be created",
                                          dxfEntity.lineNumber)
@@ -211,18 +212,17 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 handle.clear();
             }
             else if constexpr (std::is_same_v<T, DXFPoint>) {
-                std::cout << "  Type: POINT" << std::endl;
-                std::cout << "  Location: (" << entity.x << ", " << entity.y << ")" << std::endl;
+                detail("POINT (", entity.x, ", ", entity.y, ")");
 
                 auto point = convertPoint(entity);
                 if (point.has_value()) {
-                    std::cout << "  ✅ VALID" << std::endl;
+                    note(DiagnosticSeverity::Info, "POINT accepted");
                     converted = GeometryEntity(point.value());
                     layer = entity.layer;
                     handle = entity.handle;
                     colorNumber = entity.colorNumber;
                 } else {
-                    std::cout << "  ❌ REJECTED - Invalid coordinates" << std::endl;
+                    note(DiagnosticSeverity::Error, "POINT rejected: invalid coordinates");
                     result.errors.push_back(
                         createErrorMessage("POINT", "Invalid coordinates",
                                          dxfEntity.lineNumber)
@@ -231,12 +231,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 }
             }
             else if constexpr (std::is_same_v<T, DXFSolid>) {
-                std::cout << "  Type: SOLID" << std::endl;
-                std::cout << "  Shape: " << (entity.isTriangle ? "Triangle" : "Quadrilateral") << std::endl;
-
                 // Convert solid to line segments
                 auto lines = convertSolid(entity);
-                std::cout << "  Converted to " << lines.size() << " line segments" << std::endl;
+                detail("SOLID ", entity.isTriangle ? "triangle" : "quadrilateral", ", ",
+                       lines.size(), " line segments");
 
                 if (!lines.empty()) {
                     // Add all line segments individually
@@ -252,9 +250,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                     }
 
                     result.totalConverted++;
-                    std::cout << "  ✅ VALID - Solid converted to " << lines.size() << " segments" << std::endl;
+                    note(DiagnosticSeverity::Info, "SOLID accepted, converted to ",
+                         lines.size(), " segments");
                 } else {
-                    std::cout << "  ❌ REJECTED - No valid segments" << std::endl;
+                    note(DiagnosticSeverity::Error, "SOLID rejected: no valid segments");
                     result.errors.push_back(
                         createErrorMessage("SOLID", "No valid line segments could be created",
                                          dxfEntity.lineNumber)
@@ -268,11 +267,6 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
             }
             else if constexpr (std::is_same_v<T, DXFPolyline>) {
                 // Handle legacy POLYLINE (similar to LWPOLYLINE)
-                std::cout << "  Type: POLYLINE (legacy)" << std::endl;
-                std::cout << "  Vertices: " << entity.vertices.size() << std::endl;
-                std::cout << "  Closed: " << (entity.closed ? "yes" : "no") << std::endl;
-
-                // Convert as LWPOLYLINE
                 DXFLWPolyline lwPoly;
                 lwPoly.vertices = entity.vertices;
                 lwPoly.closed = entity.closed;
@@ -281,15 +275,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                 lwPoly.colorNumber = entity.colorNumber;
 
                 auto segments = convertPolyline(lwPoly);
-
-                // Count segment types for logging
-                int lineCount = 0, arcCount = 0;
-                for (const auto& seg : segments) {
-                    if (std::holds_alternative<Geometry::Line2D>(seg)) lineCount++;
-                    else if (std::holds_alternative<Geometry::Arc2D>(seg)) arcCount++;
+                if (keepsDetails) {
+                    detail("POLYLINE (legacy) ", entity.vertices.size(), " vertices, ",
+                           entity.closed ? "closed" : "open", ", ", describeSegments(segments));
                 }
-                std::cout << "  Converted to " << segments.size() << " segments ("
-                          << lineCount << " lines, " << arcCount << " arcs)" << std::endl;
 
                 if (!segments.empty()) {
                     for (const auto& segment : segments) {
@@ -304,9 +293,10 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
                     }
 
                     result.totalConverted++;
-                    std::cout << "  ✅ VALID - Polyline decomposed into " << segments.size() << " segments" << std::endl;
+                    note(DiagnosticSeverity::Info, "POLYLINE accepted, decomposed into ",
+                         segments.size(), " segments");
                 } else {
-                    std::cout << "  ❌ REJECTED - No valid segments" << std::endl;
+                    note(DiagnosticSeverity::Error, "POLYLINE rejected: no valid segments");
                     result.errors.push_back(
                         createErrorMessage("POLYLINE", "No valid segments could be created",
                                          dxfEntity.lineNumber)
@@ -335,23 +325,24 @@ ConversionResult GeometryConverter::convert(const std::vector<DXFEntity>& dxfEnt
         }
     }
 
-    std::cout << "\n=== Conversion Summary ===" << std::endl;
-    std::cout << "  Total converted: " << result.totalConverted << std::endl;
-    std::cout << "  Total failed: " << result.totalFailed << std::endl;
-    std::cout << "  Errors: " << result.errors.size() << std::endl;
-
-    if (!result.errors.empty()) {
-        std::cout << "\n  Error details:" << std::endl;
-        for (const auto& error : result.errors) {
-            std::cout << "    - " << error << std::endl;
-        }
+    if (diagnostics) {
+        diagnostics->merge(counts);
     }
-    std::cout << "========================\n" << std::endl;
 
     result.success = result.errors.empty();
     return result;
 }
 
+std::string GeometryConverter::describeSegments(const std::vector<GeometryEntity>& segments) {
+    size_t lineCount = 0;
+    size_t arcCount = 0;
+    for (const auto& segment : segments) {
+        if (std::holds_alternative<Geometry::Line2D>(segment)) lineCount++;
+        else if (std::holds_alternative<Geometry::Arc2D>(segment)) arcCount++;
+    }
+    return describe(segments.size(), " segments (", lineCount, " lines, ", arcCount, " arcs)");
+}
+
 // ============================================================================
 // INDIVIDUAL CONVERTERS
 // ============================================================================
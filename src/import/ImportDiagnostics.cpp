@@ -0,0 +1,139 @@
+#include "import/ImportDiagnostics.h"
+#include <cstdio>
+
+namespace OwnCAD {
+namespace Import {
+
+namespace {
+
+/**
+ * @brief Append text as a JSON string literal
+ */
+void appendJsonString(std::string& out, const std::string& text) {
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                    out += escaped;
+                } else {
+                    out += c;   // UTF-8 passes through
+                }
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+const char* toString(DiagnosticSeverity severity) noexcept {
+    switch (severity) {
+        case DiagnosticSeverity::Debug: return "debug";
+        case DiagnosticSeverity::Info: return "info";
+        case DiagnosticSeverity::Warning: return "warning";
+        case DiagnosticSeverity::Error: return "error";
+        default: return "invalid";
+    }
+}
+
+ImportDiagnostics::ImportDiagnostics()
+    : ImportDiagnostics(DiagnosticOptions()) {}
+
+ImportDiagnostics::ImportDiagnostics(const DiagnosticOptions& options)
+    : options_(options)
+    , keepsMessages_(options.maxMessages > 0) {
+    if (!options_.jsonLinesPath.empty()) {
+        file_.open(options_.jsonLinesPath, std::ios::out | std::ios::trunc);
+        keepsMessages_ = keepsMessages_ || file_.is_open();
+    }
+}
+
+// ============================================================================
+// REPORTING
+// ============================================================================
+
+void ImportDiagnostics::report(DiagnosticSeverity severity, DXFEntityType category,
+                               size_t lineNumber, std::string text) {
+    if (!wants(severity)) {
+        return;
+    }
+
+    std::string line;
+    if (file_.is_open()) {
+        line.reserve(text.size() + 80);
+        line += "{\"severity\":\"";
+        line += Import::toString(severity);
+        line += "\",\"category\":\"";
+        line += Import::toString(category);
+        line += "\",\"line\":";
+        line += std::to_string(lineNumber);
+        line += ",\"message\":";
+        appendJsonString(line, text);
+        line += "}\n";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!line.empty()) {
+        file_ << line;
+    }
+    if (messages_.size() < options_.maxMessages) {
+        messages_.push_back(DiagnosticMessage{severity, category, lineNumber, std::move(text)});
+    } else {
+        dropped_++;
+    }
+}
+
+void ImportDiagnostics::merge(const Counters& counters) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t category = 0; category < CATEGORY_COUNT; ++category) {
+        for (size_t severity = 0; severity < SEVERITY_COUNT; ++severity) {
+            totals_.counts[category][severity] += counters.counts[category][severity];
+        }
+    }
+    if (file_.is_open()) {
+        file_.flush();   // Once per batch, so a crash keeps what was reported
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+size_t ImportDiagnostics::count(DXFEntityType category, DiagnosticSeverity severity) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return totals_.counts[static_cast<size_t>(category)][static_cast<size_t>(severity)];
+}
+
+size_t ImportDiagnostics::total(DiagnosticSeverity severity) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t sum = 0;
+    for (const auto& perCategory : totals_.counts) {
+        sum += perCategory[static_cast<size_t>(severity)];
+    }
+    return sum;
+}
+
+std::vector<DiagnosticMessage> ImportDiagnostics::messages() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return messages_;
+}
+
+size_t ImportDiagnostics::droppedMessages() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dropped_;
+}
+
+bool ImportDiagnostics::fileOk() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return file_.is_open() && file_.good();
+}
+
+} // namespace Import
+} // namespace OwnCAD
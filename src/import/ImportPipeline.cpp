@@ -0,0 +1,237 @@
+#include "import/ImportPipeline.h"
+#include "import/BoundedQueue.h"
+#include "geometry/EntityRuleKernel.h"
+#include "geometry/ParallelExecutor.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <variant>
+
+namespace OwnCAD {
+namespace Import {
+
+using namespace OwnCAD::Geometry;
+
+namespace {
+
+struct ParsedBatch {
+    size_t sequence;
+    std::vector<DXFEntity> entities;
+};
+
+struct ConvertedBatch {
+    size_t sequence;
+    ConversionResult conversion;
+};
+
+/**
+ * @brief Third stage: per-entity rules over batches in file order
+ *
+ * Entity indices continue across batches and count lines and arcs only,
+ * as DocumentModel::validateSnapshot numbers them.
+ */
+class EntityChecker {
+public:
+    explicit EntityChecker(const ImportOptions& options)
+        : enabled_(options.checkEntities && !(options.rules.minCornerAngle > 0.0))
+        , kernel_(options.tolerance, options.rules) {}
+
+    void check(const std::vector<GeometryEntityWithMetadata>& batch) {
+        if (!enabled_) {
+            return;
+        }
+        entities_.clear();
+        for (const auto& record : batch) {
+            if (std::holds_alternative<Line2D>(record.entity)) {
+                entities_.push_back(std::get<Line2D>(record.entity));
+            } else if (std::holds_alternative<Arc2D>(record.entity)) {
+                entities_.push_back(std::get<Arc2D>(record.entity));
+            }
+        }
+        if (entities_.empty()) {
+            return;
+        }
+
+        records_.clear();
+        kernel_.run(entities_, noJoints_, 0, entities_.size(), records_);
+        for (const auto& record : records_) {
+            GeometryIssue issue = kernel_.toIssue(record, noJoints_);
+            issue.entityIndex += offset_;
+            issues_.push_back(issue);
+        }
+        offset_ += entities_.size();
+    }
+
+    std::shared_ptr<const std::vector<GeometryIssue>> issues() {
+        if (!enabled_) {
+            return nullptr;
+        }
+        return std::make_shared<const std::vector<GeometryIssue>>(std::move(issues_));
+    }
+
+private:
+    bool enabled_;
+    EntityRuleKernel kernel_;
+    const EntityColumns noJoints_;   // Corners need the whole document's contours
+    size_t offset_ = 0;
+    std::vector<std::variant<Line2D, Arc2D>> entities_;   // Scratch, reused per batch
+    std::vector<EntityIssueRecord> records_;
+    std::vector<GeometryIssue> issues_;
+};
+
+/**
+ * @brief Add a batch's messages and counts to the running total
+ */
+void mergeConversion(ConversionResult& total, ConversionResult&& part) {
+    total.errors.insert(total.errors.end(),
+                        std::make_move_iterator(part.errors.begin()),
+                        std::make_move_iterator(part.errors.end()));
+    total.warnings.insert(total.warnings.end(),
+                          std::make_move_iterator(part.warnings.begin()),
+                          std::make_move_iterator(part.warnings.end()));
+    total.totalConverted += part.totalConverted;
+    total.totalFailed += part.totalFailed;
+}
+
+} // namespace
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+ImportResult ImportPipeline::importFile(const std::string& filePath,
+                                        const ImportOptions& options,
+                                        const EntityCallback& onEntities) {
+    return run([&filePath](const DXFParser::EntityBatchCallback& onBatch, size_t batchSize) {
+        return DXFParser::parseFile(filePath, onBatch, batchSize);
+    }, options, onEntities);
+}
+
+ImportResult ImportPipeline::importString(const std::string& content,
+                                          const ImportOptions& options,
+                                          const EntityCallback& onEntities) {
+    return run([&content](const DXFParser::EntityBatchCallback& onBatch, size_t batchSize) {
+        return DXFParser::parseString(content, onBatch, batchSize);
+    }, options, onEntities);
+}
+
+// ============================================================================
+// STAGES
+// ============================================================================
+
+ImportResult ImportPipeline::run(const ParseFunction& parse,
+                                 const ImportOptions& options,
+                                 const EntityCallback& onEntities) {
+    ImportResult result;
+    EntityChecker checker(options);
+    std::atomic<size_t> inFlight{0};
+
+    // Converted batches may only run queueDepth ahead of the next one to
+    // deliver, so a slow batch cannot make the reorder buffer grow
+    const size_t depth = std::max<size_t>(options.queueDepth, 1);
+    std::mutex windowMutex;
+    std::condition_variable windowOpen;
+
+    // Stage 3, always on the calling thread and in file order
+    auto deliver = [&](ConversionResult&& conversion) {
+        checker.check(conversion.entities);
+        if (onEntities) {
+            onEntities(std::move(conversion.entities));
+        }
+        mergeConversion(result.conversion, std::move(conversion));
+        inFlight.fetch_sub(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(windowMutex);
+            result.batches++;
+        }
+        windowOpen.notify_all();
+    };
+    auto countBatch = [&]() {
+        const size_t now = inFlight.fetch_add(1, std::memory_order_relaxed) + 1;
+        result.peakBatchesInFlight = std::max(result.peakBatchesInFlight, now);  // Parser thread only
+    };
+
+    BoundedQueue<ParsedBatch> parsed(depth);
+    BoundedQueue<ConvertedBatch> converted(depth);
+    std::atomic<size_t> convertersLeft{0};
+
+    // Stage 2: convert batches in any order; the sequence number restores it
+    auto convert = [&]() {
+        while (std::optional<ParsedBatch> batch = parsed.pop()) {
+            ConvertedBatch out{batch->sequence, GeometryConverter::convert(batch->entities, options.diagnostics)};
+            batch->entities = std::vector<DXFEntity>();  // Free before waiting for room
+            {
+                std::unique_lock<std::mutex> lock(windowMutex);
+                windowOpen.wait(lock, [&] {
+                    return out.sequence < result.batches + depth;
+                });
+            }
+            converted.push(std::move(out));
+        }
+        if (convertersLeft.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            converted.close();
+        }
+    };
+
+    const size_t converterCount = ParallelExecutor::resolveThreadCount(options.threadCount);
+    std::vector<std::thread> workers;
+    bool started = true;
+    try {
+        convertersLeft.store(converterCount);
+        workers.reserve(converterCount + 1);
+        for (size_t i = 0; i < converterCount; ++i) {
+            workers.emplace_back(convert);
+        }
+        // Stage 1
+        workers.emplace_back([&]() {
+            size_t sequence = 0;
+            result.parse = parse([&](std::vector<DXFEntity>&& batch) {
+                countBatch();
+                parsed.push(ParsedBatch{sequence++, std::move(batch)});
+            }, options.batchSize);
+            parsed.close();
+        });
+    } catch (const std::exception&) {
+        started = false;
+    }
+
+    if (!started) {
+        // Out of threads: stop what runs and do every stage inline
+        parsed.close();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        result = ImportResult();
+        result.parse = parse([&](std::vector<DXFEntity>&& batch) {
+            countBatch();
+            deliver(GeometryConverter::convert(batch, options.diagnostics));
+        }, options.batchSize);
+    } else {
+        std::map<size_t, ConversionResult> early;  // Finished ahead of an earlier batch
+        size_t nextSequence = 0;
+        while (std::optional<ConvertedBatch> batch = converted.pop()) {
+            early.emplace(batch->sequence, std::move(batch->conversion));
+            for (auto it = early.find(nextSequence); it != early.end(); it = early.find(nextSequence)) {
+                deliver(std::move(it->second));
+                early.erase(it);
+                nextSequence++;
+            }
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    result.conversion.success = result.conversion.errors.empty();
+    result.entityIssues = checker.issues();
+    return result;
+}
+
+} // namespace Import
+} // namespace OwnCAD
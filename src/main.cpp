@@ -10,6 +10,8 @@
 #include <QActionGroup>
 #include <QKeySequence>
 #include <QStatusBar>
+#include <QProgressBar>
+#include <QElapsedTimer>
 #include <QToolBar>
 #include <QMessageBox>
 #include <QFileDialog>
@@ -17,6 +19,10 @@
 #include <QScrollArea>
 #include <QStringList>
 #include <QDebug>
+#include <QStandardPaths>
+#include <QDir>
+#include <QMetaObject>
+#include <future>
 
 // Geometry headers
 #include "geometry/Point2D.h"
@@ -29,10 +35,13 @@
 #include "model/DocumentModel.h"
 #include "model/CommandHistory.h"
 #include "model/EntityCommands.h"
+#include "model/ValidationScheduler.h"
+#include "model/ValidationCache.h"
 
 // UI headers
 #include "ui/CADCanvas.h"
 #include "ui/GridSettingsDialog.h"
+#include "ui/ManufacturingRulesDialog.h"
 #include "ui/ToolManager.h"
 #include "ui/MoveTool.h"
 #include "ui/RotateTool.h"
@@ -58,6 +67,7 @@ public:
     MainWindow(QWidget* parent = nullptr)
         : QMainWindow(parent)
         , document_(std::make_unique<DocumentModel>())
+        , validationScheduler_(std::make_unique<ValidationScheduler>(document_.get()))
         , canvas_(nullptr)
         , cursorPosLabel_(nullptr)
         , zoomLabel_(nullptr)
@@ -72,6 +82,13 @@ public:
         setWindowTitle("OwnCAD - Industrial 2D CAD Validator v0.1.0");
         setMinimumSize(1024, 768);
 
+        // Results of files opened before appear instantly
+        const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+        if (!cacheDir.isEmpty()) {
+            document_->setValidationCache(std::make_shared<ValidationCache>(
+                QDir(cacheDir).filePath("validation").toStdString()));
+        }
+
         // Create central CAD canvas
         setupCentralWidget();
 
@@ -91,6 +108,16 @@ public:
         runGeometrySelfTest();
     }
 
+    /**
+     * @brief Stops a running region check (it only reads its own copy).
+     */
+    ~MainWindow() override {
+        cancelRegionValidation();
+        if (regionWorker_.valid()) {
+            regionWorker_.wait();
+        }
+    }
+
     /**
      * @brief Get command history for undo/redo operations.
      * @return Pointer to CommandHistory (owned by MainWindow)
@@ -122,7 +149,7 @@ private:
                 this, &MainWindow::onActiveToolChanged);
         // Trigger validation when geometry changes via tools
         connect(toolMgr, &ToolManager::geometryChanged,
-                [this]() { document_->runValidationAsync(); });
+                validationScheduler_.get(), &ValidationScheduler::requestValidation);
 
         // Enable grid and snap by default
         canvas_->setGridVisible(true);
@@ -154,24 +181,45 @@ private:
                     statusBar()->showMessage(QString("Redo: %1").arg(desc), 2000);
                 });
 
-        // Trigger validation on any history change (undo/redo/execute)
+        // Trigger validation on any history change (undo/redo/execute);
+        // bursts are coalesced into one run by the scheduler
         connect(commandHistory_, &CommandHistory::historyChanged,
-                [this]() { document_->runValidationAsync(); });
-
-        // Setup async validation callback
-        document_->setValidationCompletionCallback(
-            [this](const ValidationResult& result) {
-                // Marshal back to main thread
-                QMetaObject::invokeMethod(this, [this, result]() {
-                        // 1. Finalize model state (Main Thread)
-                        document_->finalizeValidation(result);
-                        
-                        // 2. Update UI
-                        updateValidationStatus(); 
-                    }, 
-                    Qt::QueuedConnection);
-            }
-        );
+                validationScheduler_.get(), &ValidationScheduler::requestValidation);
+
+        // Scheduler applies only current results, on the main thread
+        connect(validationScheduler_.get(), &ValidationScheduler::validationFinished,
+                this, [this]() {
+                    validationProgressBar_->hide();
+                    updateValidationStatus();
+                    if (showReportAfterValidation_) {
+                        showReportAfterValidation_ = false;
+                        showValidationResults();
+                    }
+                });
+
+        // Progress appears only for checks that take noticeable time
+        connect(validationScheduler_.get(), &ValidationScheduler::validationStarted,
+                this, [this]() { validationClock_.start(); });
+
+        connect(validationScheduler_.get(), &ValidationScheduler::validationProgress,
+                this, [this](const QString& rule, quint64 processed, quint64 total) {
+                    if (validationClock_.elapsed() < VALIDATION_PROGRESS_DELAY_MS || total == 0) {
+                        return;
+                    }
+                    validationProgressBar_->setFormat(rule + " %p%");
+                    validationProgressBar_->setValue(static_cast<int>(processed * 100 / total));
+                    validationProgressBar_->show();
+                });
+
+        connect(validationScheduler_.get(), &ValidationScheduler::validationCancelled,
+                this, [this]() {
+                    validationProgressBar_->hide();
+                    showReportAfterValidation_ = false;
+                    validationLabel_->setText("Valid: -");
+                    validationLabel_->setStyleSheet("color: gray; font-weight: bold;");
+                    validationLabel_->setToolTip("Validation cancelled");
+                    statusBar()->showMessage("Validation cancelled", 3000);
+                });
     }
 
 private:
@@ -251,6 +299,10 @@ private:
 
         toolsMenu->addSeparator();
         toolsMenu->addAction("&Validate Geometry", this, &MainWindow::onValidate);
+        toolsMenu->addAction("Validate &View", this, &MainWindow::onValidateView);
+        toolsMenu->addAction("Validate S&election", this, &MainWindow::onValidateSelection);
+        toolsMenu->addAction("&Cancel Validation", this, &MainWindow::onCancelValidation);
+        toolsMenu->addAction("Manufacturing &Rules...", this, &MainWindow::onManufacturingRules);
 
         // Help menu
         QMenu* helpMenu = menuBar()->addMenu("&Help");
@@ -369,6 +421,13 @@ private:
         validationLabel_->setStyleSheet("color: green; font-weight: bold;");
         statusBar()->addPermanentWidget(validationLabel_);
 
+        // Validation progress (shown only while a long check runs)
+        validationProgressBar_ = new QProgressBar();
+        validationProgressBar_->setMaximumWidth(220);
+        validationProgressBar_->setRange(0, 100);
+        validationProgressBar_->hide();
+        statusBar()->addPermanentWidget(validationProgressBar_);
+
         // Zoom level indicator
         zoomLabel_ = new QLabel("Zoom: 1.00x");
         zoomLabel_->setMinimumWidth(100);
@@ -413,6 +472,8 @@ private:
 
 private slots:
     void onNew() {
+        validationScheduler_->cancel();
+        cancelRegionValidation();
         document_->clear();
         canvas_->clear();
         commandHistory_->clear();
@@ -433,7 +494,10 @@ private slots:
 
         statusBar()->showMessage("Loading DXF file...");
 
-        bool success = document_->loadDXFFile(fileName.toStdString());
+        // Results computed for the old document must not land on the new one
+        validationScheduler_->cancel();
+        cancelRegionValidation();
+        bool success = document_->loadDXFFile(fileName.toStdString(), false);
 
         if (success) {
             const auto& stats = document_->statistics();
@@ -451,10 +515,17 @@ private slots:
             commandHistory_->clear();
 
             // Load geometry into canvas
-            canvas_->setEntities(document_->entities());
+            canvas_->setSnapshot(document_->snapshot());
             canvas_->zoomExtents();
 
-            showValidationResults();
+            // Validate in the background; the report opens when it completes.
+            // A cached result is shown now and the run only confirms it.
+            const bool cached = document_->isValidationFromCache();
+            showReportAfterValidation_ = !cached;
+            validationScheduler_->validateNow();
+            if (cached) {
+                updateValidationStatus();
+            }
 
             // Status bar message - show DXF entities count (clearer for user)
             QString message = QString("Loaded: %1 DXF entities")
@@ -473,7 +544,13 @@ private slots:
             }
 
             message += " | Zoom: Extents";
+            if (cached) {
+                message += " | Validation: cached, confirming";
+            }
             statusBar()->showMessage(message, 5000);
+            if (cached) {
+                showValidationResults();
+            }
         } else {
             QString errorMsg = "Failed to load DXF file:\n\n";
             for (const auto& error : document_->importErrors()) {
@@ -489,7 +566,7 @@ private slots:
             statusBar()->showMessage("Nothing to undo", 2000);
         }
         // Refresh canvas after undo
-        canvas_->setEntities(document_->entities());
+        canvas_->setSnapshot(document_->snapshot());
     }
 
     void onRedo() {
@@ -497,7 +574,7 @@ private slots:
             statusBar()->showMessage("Nothing to redo", 2000);
         }
         // Refresh canvas after redo
-        canvas_->setEntities(document_->entities());
+        canvas_->setSnapshot(document_->snapshot());
     }
 
     void updateUndoRedoActions() {
@@ -529,6 +606,45 @@ private slots:
         showValidationResults();
     }
 
+    void onValidateView() {
+        startRegionValidation("Visible Area",
+                              document_->prepareRegion(canvas_->viewport().visibleBounds()));
+    }
+
+    void onValidateSelection() {
+        if (canvas_->selectedCount() == 0) {
+            statusBar()->showMessage("Nothing selected", 2000);
+            return;
+        }
+        startRegionValidation("Selection", document_->prepareRegion(canvas_->selectedHandles()));
+    }
+
+    void onCancelValidation() {
+        if (cancelRegionValidation()) {
+            statusBar()->showMessage("Validation cancelled", 3000);
+            return;
+        }
+        if (!validationScheduler_->isRunning() && !validationScheduler_->isPending()) {
+            statusBar()->showMessage("No validation in progress", 2000);
+            return;
+        }
+        validationScheduler_->cancel();
+    }
+
+    void onManufacturingRules() {
+        ManufacturingRulesDialog dialog(document_->manufacturingRules(), this);
+        if (dialog.exec() != QDialog::Accepted) {
+            return;
+        }
+
+        // Issues of the current result used the old limits
+        document_->setManufacturingRules(dialog.rules());
+        if (!document_->isEmpty()) {
+            validationScheduler_->validateNow();
+        }
+        statusBar()->showMessage("Manufacturing rules updated", 2000);
+    }
+
     void onZoomExtents() {
         canvas_->zoomExtents();
         statusBar()->showMessage("View: Zoom Extents", 2000);
@@ -687,6 +803,17 @@ private slots:
             message += "<p><b>Action required:</b> Fix invalid geometry before export.</p>";
         }
 
+        // Rules that hit their time budget checked only part of the drawing
+        if (!result.truncatedRules.empty()) {
+            message += "<h4 style='color: orange;'>Incomplete Checks</h4>";
+            message += "<p>These rules exceeded their time budget and did not check every entity:</p>";
+            message += "<ul>";
+            for (const auto& rule : result.truncatedRules) {
+                message += QString("<li>%1</li>").arg(QString::fromStdString(rule));
+            }
+            message += "</ul>";
+        }
+
         // Add import warnings if any
         if (!document_->importWarnings().empty()) {
             message += "<h4>Import Warnings</h4>";
@@ -706,6 +833,81 @@ private slots:
         msgBox.exec();
     }
 
+    // Issues of an on-demand check; the document-wide report is not touched
+    /**
+     * @brief Check a prepared region on a worker; the report opens when it finishes
+     *
+     * Only gathering the entities runs here. A newer request or a cancel
+     * drops the running check, and its result is never shown.
+     */
+    void startRegionValidation(const QString& scope, DocumentModel::PreparedRegion region) {
+        cancelRegionValidation();
+        if (regionWorker_.valid()) {
+            regionWorker_.wait();  // Cancelled above; stops at its next poll
+        }
+
+        const quint64 generation = ++regionGeneration_;
+        regionToken_ = region.control.cancellation;
+        regionRunning_ = true;
+        statusBar()->showMessage(QString("Validating %1...").arg(scope.toLower()));
+
+        regionWorker_ = std::async(std::launch::async,
+            [this, generation, scope, region = std::move(region)]() {
+                ValidationResult result = DocumentModel::validatePreparedRegion(region);
+
+                // Marshal back to the UI thread
+                QMetaObject::invokeMethod(this,
+                    [this, generation, scope, result = std::move(result)]() {
+                        if (generation != regionGeneration_ || result.cancelled) {
+                            return;  // Superseded or cancelled
+                        }
+                        regionRunning_ = false;
+                        statusBar()->clearMessage();
+                        showRegionResults(scope, result);
+                    },
+                    Qt::QueuedConnection);
+            });
+    }
+
+    /**
+     * @brief Drop the running region check, if any
+     * @return true if one was running
+     */
+    bool cancelRegionValidation() {
+        const bool running = regionRunning_;
+        regionGeneration_++;
+        regionToken_.cancel();
+        regionRunning_ = false;
+        return running;
+    }
+
+    void showRegionResults(const QString& scope, const ValidationResult& result) {
+        QString message = QString("<h3>Validation Report: %1</h3>").arg(scope);
+        if (result.passed()) {
+            message += "<p style='color: green; font-size: 14px;'><b>✓ NO ISSUES</b></p>";
+        } else {
+            message += QString("<p>Found <b>%1</b> issues:</p><ul>").arg(result.issueCount());
+            const size_t shown = std::min<size_t>(result.issueCount(), 20);
+            for (size_t i = 0; i < shown; ++i) {
+                const auto& issue = result.issues()[i];
+                message += QString("<li>[%1] %2</li>")
+                    .arg(QString::fromStdString(result.handleOf(issue.entityIndex)))
+                    .arg(QString::fromStdString(describe(issue)));
+            }
+            if (shown < result.issueCount()) {
+                message += QString("<li>... and %1 more</li>").arg(result.issueCount() - shown);
+            }
+            message += "</ul>";
+        }
+
+        QMessageBox msgBox(this);
+        msgBox.setWindowTitle("Validation Results");
+        msgBox.setTextFormat(Qt::RichText);
+        msgBox.setText(message);
+        msgBox.setIcon(result.passed() ? QMessageBox::Information : QMessageBox::Warning);
+        msgBox.exec();
+    }
+
     void onAbout() {
         QMessageBox::about(this, "About OwnCAD",
             "<h3>OwnCAD v0.1.0</h3>"
@@ -832,7 +1034,7 @@ private slots:
         commandHistory_->executeCommand(std::move(deleteCmd));
 
         // Refresh canvas
-        canvas_->setEntities(document_->entities());
+        canvas_->setSnapshot(document_->snapshot());
         canvas_->clearSelection();
 
         statusBar()->showMessage(
@@ -870,13 +1072,16 @@ private slots:
 
     void onGeometryChanged() {
         // Refresh canvas with current document entities
-        canvas_->setEntities(document_->entities());
+        canvas_->setSnapshot(document_->snapshot());
     }
 
 private:
     // Document model (holds all geometry and validation state)
     std::unique_ptr<DocumentModel> document_;
 
+    // Coalesces edit-driven validation (destroyed before document_)
+    std::unique_ptr<ValidationScheduler> validationScheduler_;
+
     // UI elements
     CADCanvas* canvas_;
     QToolBar* toolToolbar_;
@@ -888,6 +1093,18 @@ private:
     QLabel* selectionLabel_;
     QLabel* validationLabel_ = nullptr;
     QLabel* toolPromptLabel_;
+    QProgressBar* validationProgressBar_ = nullptr;
+
+    // Delay before validation progress is shown (short checks never show it)
+    static constexpr qint64 VALIDATION_PROGRESS_DELAY_MS = 500;
+    QElapsedTimer validationClock_;
+    bool showReportAfterValidation_ = false;
+
+    // View and selection checks run on their own worker, apart from the scheduler's
+    std::future<void> regionWorker_;
+    CancellationToken regionToken_;
+    quint64 regionGeneration_ = 0;
+    bool regionRunning_ = false;
 
     // Command history (undo/redo)
     CommandHistory* commandHistory_;
@@ -901,20 +1118,27 @@ private:
         const auto& result = document_->validationResult();
 
         // Extract all problematic entity handles from validation result
-        std::set<std::string> problematicHandles;
-        for (const auto& issue : result.issues) {
+        std::unordered_set<std::string> problematicHandles;
+        problematicHandles.reserve(result.issueCount());
+        for (const auto& issue : result.issues()) {
             // Add primary entity handle (if not empty)
-            if (!issue.entityHandle.empty()) {
-                problematicHandles.insert(issue.entityHandle);
+            const std::string& handle = result.handleOf(issue.entityIndex);
+            if (!handle.empty()) {
+                problematicHandles.insert(handle);
             }
-            // Add related entity handle (for duplicate/overlap issues)
-            if (!issue.relatedEntityHandle.empty()) {
-                problematicHandles.insert(issue.relatedEntityHandle);
+            // Add related entity handle (for duplicate/overlap issues and corners)
+            if (GeometryValidator::isPairIssue(issue.type) ||
+                issue.type == GeometryIssueType::SharpCorner) {
+                const std::string& related = result.handleOf(issue.relatedEntityIndex);
+                if (!related.empty()) {
+                    problematicHandles.insert(related);
+                }
             }
         }
 
-        // Update canvas highlighting
-        canvas_->setProblematicEntities(problematicHandles);
+        // Update canvas highlighting and the clustered issue overlay
+        canvas_->setProblematicEntities(std::move(problematicHandles));
+        canvas_->setIssueMarkers(IssueOverlay::markersFor(result, document_->snapshot()));
 
         // Update status bar indicator
         if (result.passed()) {
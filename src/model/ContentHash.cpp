@@ -0,0 +1,110 @@
+#include "model/ContentHash.h"
+#include <cstring>
+
+namespace OwnCAD {
+namespace Model {
+
+namespace {
+
+constexpr uint64_t C1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t C2 = 0x4cf5ad432745937fULL;
+
+inline uint64_t rotl(uint64_t x, int r) noexcept {
+    return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix(uint64_t k) noexcept {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+} // namespace
+
+std::string ContentHash::toHex() const {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(32, '0');
+    for (int i = 0; i < 16; ++i) {
+        text[15 - i] = digits[(high >> (4 * i)) & 0xf];
+        text[31 - i] = digits[(low >> (4 * i)) & 0xf];
+    }
+    return text;
+}
+
+ContentHasher::ContentHasher(uint64_t seed) noexcept
+    : h1_(seed), h2_(seed) {
+}
+
+void ContentHasher::mixBlock(uint64_t k1, uint64_t k2) noexcept {
+    k1 *= C1; k1 = rotl(k1, 31); k1 *= C2; h1_ ^= k1;
+    h1_ = rotl(h1_, 27); h1_ += h2_; h1_ = h1_ * 5 + 0x52dce729;
+
+    k2 *= C2; k2 = rotl(k2, 33); k2 *= C1; h2_ ^= k2;
+    h2_ = rotl(h2_, 31); h2_ += h1_; h2_ = h2_ * 5 + 0x38495ab5;
+}
+
+void ContentHasher::addWord(uint64_t word) noexcept {
+    ++wordCount_;
+    if (!hasPending_) {
+        pending_ = word;
+        hasPending_ = true;
+        return;
+    }
+    mixBlock(pending_, word);
+    hasPending_ = false;
+}
+
+void ContentHasher::addDouble(double value) noexcept {
+    if (value == 0.0) {
+        value = 0.0;  // -0.0 compares equal and must hash equal
+    }
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    addWord(bits);
+}
+
+void ContentHasher::addString(const std::string& text) noexcept {
+    addWord(text.size());
+    addBytes(text.data(), text.size());
+}
+
+void ContentHasher::addBytes(const char* data, size_t size) noexcept {
+    // Little-endian packing regardless of the host byte order
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t word = 0;
+        for (size_t b = 0; b < 8 && i + b < size; ++b) {
+            word |= uint64_t(static_cast<unsigned char>(data[i + b])) << (8 * b);
+        }
+        addWord(word);
+    }
+}
+
+ContentHash ContentHasher::finish() const noexcept {
+    uint64_t h1 = h1_;
+    uint64_t h2 = h2_;
+    if (hasPending_) {
+        uint64_t k1 = pending_;
+        k1 *= C1; k1 = rotl(k1, 31); k1 *= C2; h1 ^= k1;
+    }
+
+    const uint64_t length = wordCount_ * 8;
+    h1 ^= length;
+    h2 ^= length;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix(h1);
+    h2 = fmix(h2);
+    h1 += h2;
+    h2 += h1;
+
+    ContentHash hash;
+    hash.high = h1;
+    hash.low = h2;
+    return hash;
+}
+
+} // namespace Model
+} // namespace OwnCAD
@@ -1,10 +1,15 @@
 #include "model/DocumentModel.h"
+#include "model/ValidationCache.h"
 #include "import/DXFParser.h"
+#include "import/ImportPipeline.h"
 #include "export/GeometryExporter.h"
 #include "export/DXFWriter.h"
+#include "geometry/ContourTopology.h"
 #include "geometry/GeometryConstants.h"
 #include <algorithm>
+#include <numeric>
 #include <set>
+#include <unordered_set>
 
 namespace OwnCAD {
 namespace Model {
@@ -26,26 +31,39 @@ DocumentModel::~DocumentModel() {
 // LOADING
 // ============================================================================
 
-bool DocumentModel::loadDXFFile(const std::string& filePath) {
+bool DocumentModel::loadDXFFile(const std::string& filePath, bool validate) {
     // Clear previous state
     clear();
     filePath_ = filePath;
 
-    // Step 1: Parse DXF file
-    DXFParseResult parseResult = DXFParser::parseFile(filePath);
+    // Steps 1-2: Parse, convert and check entities in overlapping stages;
+    // converted batches go straight into storage
+    ImportOptions options;
+    options.threadCount = validationThreadCount_;
+    options.checkEntities = true;
+    options.rules = manufacturingRules_;
+    importDiagnostics_ = std::make_unique<ImportDiagnostics>(importDiagnosticOptions_);
+    options.diagnostics = importDiagnostics_.get();
+
+    resetSlots();
+    ImportResult imported = ImportPipeline::importFile(filePath, options,
+        [this](std::vector<GeometryEntityWithMetadata>&& batch) {
+            appendSlots(std::move(batch));
+        });
+    const DXFParseResult& parseResult = imported.parse;
+    ConversionResult& conversionResult = imported.conversion;
 
     if (!parseResult.success) {
+        assignEntities({});
         importErrors_ = parseResult.errors;
         importWarnings_ = parseResult.warnings;
         return false;
     }
+    finishSlots();
 
     // Store parse warnings
     importWarnings_ = parseResult.warnings;
 
-    // Step 2: Convert DXF entities to internal geometry model
-    ConversionResult conversionResult = GeometryConverter::convert(parseResult.entities);
-
     if (!conversionResult.success) {
         importErrors_ = conversionResult.errors;
         importWarnings_.insert(
@@ -56,9 +74,6 @@ bool DocumentModel::loadDXFFile(const std::string& filePath) {
         // Continue even with some conversion errors - load what we can
     }
 
-    // Store converted entities
-    entities_ = conversionResult.entities;
-
     // Store original DXF entity count (before decomposition)
     statistics_.dxfEntitiesImported = conversionResult.totalConverted;
 
@@ -69,25 +84,38 @@ bool DocumentModel::loadDXFFile(const std::string& filePath) {
         conversionResult.errors.end()
     );
 
-    // Step 3: Validate geometry
-    runValidation();
+    // Step 3: Take a result cached for the same content, or validate
+    loadedVersion_ = version_;
+    importedEntityIssues_ = imported.entityIssues;
+    const bool cached = adoptCachedValidation();
+    if (!cached && validate) {
+        runValidation();
+    }
 
-    // Step 4: Calculate statistics
-    calculateStatistics();
+    // Step 4: Calculate statistics (cached ones come with the result)
+    if (!cached) {
+        calculateStatistics();
+        if (validate) {
+            storeCachedValidation();
+        }
+    }
 
     // Step 5: Update handle generator to avoid conflicts with imported handles
     updateNextHandleNumber();
 
-    return !entities_.empty();
+    return !isEmpty();
 }
 
 void DocumentModel::clear() {
-    entities_.clear();
+    assignEntities({});
+    importedEntityIssues_.reset();
     validationResult_ = ValidationResult();
+    validationFromCache_ = false;
     statistics_ = DocumentStatistics();
     filePath_.clear();
     importErrors_.clear();
     importWarnings_.clear();
+    importDiagnostics_ = std::make_unique<ImportDiagnostics>();
 }
 
 // ============================================================================
@@ -95,21 +123,80 @@ void DocumentModel::clear() {
 // ============================================================================
 
 void DocumentModel::runValidation() {
-    if (entities_.empty()) {
+    if (isEmpty()) {
         validationResult_ = ValidationResult();
         return;
     }
 
-    // Snapshot entities and handles for validation
-    auto entityVariants = getEntityVariants();
-    auto handles = getEntityHandles();
-
     // Run validation synchronously with handle tracking
-    validationResult_ = GeometryValidator::validateEntitiesWithHandles(
-        entityVariants,
+    ValidationControl control;
+    control.threadCount = validationThreadCount_;
+    control.rules = manufacturingRules_;
+    if (version_ == loadedVersion_) {
+        control.entityIssues = importedEntityIssues_;
+    }
+    validationResult_ = validateSnapshot(snapshot(), control);
+    validationFromCache_ = false;
+    setValidationBaseline(validationResult_);
+}
+
+ValidationResult DocumentModel::validateSnapshot(const DocumentSnapshot& entities,
+                                                 const ValidationControl& control) {
+    // Rules read the snapshot's pages in place, and the result reads its
+    // handles from them too
+    const Geometry::SegmentView entityView = entities.segments();
+    const Geometry::HandleTable handles(entityView);
+
+    // The corner rule shares the snapshot's cached topology
+    ValidationControl ruleControl = control;
+    if (control.rules.minCornerAngle > 0.0 && !ruleControl.contours) {
+        ruleControl.contours = entities.contours();
+    }
+    ValidationResult result = GeometryValidator::validateEntitiesWithHandles(
+        entityView,
         handles,
-        GEOMETRY_EPSILON
+        GEOMETRY_EPSILON,
+        ruleControl
     );
+
+    // Contour rules share the snapshot's cached topology
+    if (!result.cancelled && control.rules.minHoleDiameter > 0.0) {
+        result.append(GeometryValidator::checkHoleSizes(
+            entityView, handles, *entities.contours(), ruleControl));
+    }
+    if (!result.cancelled && control.rules.featureSpacing() > 0.0) {
+        result.append(GeometryValidator::checkFeatureSpacing(
+            entityView, handles, *entities.contours(), ruleControl));
+    }
+    return result;
+}
+
+ValidationControl DocumentModel::beginValidation() {
+    ValidationControl control;
+    control.progress = validationProgressCallback_;
+    control.ruleBudget = validationRuleBudget_;
+    control.threadCount = validationThreadCount_;
+    control.rules = manufacturingRules_;
+    if (version_ == loadedVersion_) {
+        control.entityIssues = importedEntityIssues_;  // Unedited since import
+    }
+    validationToken_ = control.cancellation;
+    return control;
+}
+
+void DocumentModel::cancelValidation() {
+    validationToken_.cancel();
+}
+
+void DocumentModel::setManufacturingRules(const Geometry::ManufacturingRules& rules) {
+    manufacturingRules_ = rules;
+    incremental_.clear();  // Baseline contour issues used the old limits
+    importedEntityIssues_.reset();
+}
+
+void DocumentModel::setValidationProgressCallback(
+    std::function<void(const Geometry::ValidationProgress&)> callback) {
+    validationProgressCallback_ = callback;
 }
 
 void DocumentModel::runValidationAsync() {
@@ -117,7 +204,7 @@ void DocumentModel::runValidationAsync() {
         return; // Already running
     }
 
-    if (entities_.empty()) {
+    if (isEmpty()) {
         if (validationCallback_) {
             validationCallback_(ValidationResult()); // Immediate empty result
         }
@@ -126,23 +213,19 @@ void DocumentModel::runValidationAsync() {
 
     isValidating_ = true;
 
-    // Snapshot entities and handles to pass to worker thread (thread safety: copy)
-    // Note: This copying happens on the calling thread (Main Thread usually)
-    auto entityVariants = getEntityVariants();
-    auto handles = getEntityHandles();
+    // Hand the worker an immutable snapshot (O(1), no geometry copied here).
+    // Edits on the calling thread publish new pages and never touch it.
+    DocumentSnapshot entities = snapshot();
+    ValidationControl control = beginValidation();
 
     // Launch async task
     validationFuture_ = std::async(std::launch::async,
-        [this, variants = std::move(entityVariants), hdls = std::move(handles)]() mutable {
+        [this, entities = std::move(entities), control = std::move(control)]() {
             // This runs in background thread
-            ValidationResult result = GeometryValidator::validateEntitiesWithHandles(
-                variants,
-                hdls,
-                GEOMETRY_EPSILON
-            );
-
-            // Notify completion
-            if (validationCallback_) {
+            ValidationResult result = validateSnapshot(entities, control);
+
+            // Notify completion (a cancelled run has nothing to report)
+            if (validationCallback_ && !result.cancelled) {
                 validationCallback_(result);
             }
 
@@ -160,44 +243,553 @@ bool DocumentModel::isValidating() const {
 }
 
 void DocumentModel::finalizeValidation(const Geometry::ValidationResult& result) {
+    if (result.cancelled) {
+        return;  // Partial result - keep the previous one
+    }
     std::lock_guard<std::mutex> lock(validationMutex_);
     validationResult_ = result;
+    validationFromCache_ = false;
     calculateStatistics(); // Re-calculate stats based on new validation results
 }
 
-std::vector<std::variant<Line2D, Arc2D>> DocumentModel::getEntityVariants() const {
-    std::vector<std::variant<Line2D, Arc2D>> variants;
-    variants.reserve(entities_.size());
+void DocumentModel::finalizeValidation(const Geometry::ValidationResult& result,
+                                       uint64_t snapshotVersion) {
+    finalizeValidation(result);
+    if (!result.cancelled && snapshotVersion == version_) {
+        setValidationBaseline(result);
+        storeCachedValidation();
+    }
+}
+
+// ============================================================================
+// VALIDATION CACHE
+// ============================================================================
+
+ContentHash DocumentModel::contentHash() const {
+    // Bump when validation changes what it reports for the same input
+    constexpr uint64_t CONTENT_HASH_VERSION = 1;
+
+    ContentHasher hasher(CONTENT_HASH_VERSION);
+    hasher.addDouble(GEOMETRY_EPSILON);
+    hasher.addDouble(ENDPOINT_SNAP_TOLERANCE);
+    hasher.addDouble(manufacturingRules_.minHoleDiameter);
+    hasher.addDouble(manufacturingRules_.kerfWidth);
+    hasher.addDouble(manufacturingRules_.minFeatureSpacing);
+    hasher.addDouble(manufacturingRules_.minEdgeLength);
+    hasher.addDouble(manufacturingRules_.minCornerAngle);
+    hasher.addWord(statistics_.dxfEntitiesImported);
+    hasher.addWord(liveCount_);
+
+    for (const auto& record : snapshot()) {
+        hasher.addString(record.handle);
+        hasher.addWord(record.entity.index());
+        std::visit([&hasher](const auto& entity) {
+            using T = std::decay_t<decltype(entity)>;
+            if constexpr (std::is_same_v<T, Line2D>) {
+                hasher.addDouble(entity.start().x());
+                hasher.addDouble(entity.start().y());
+                hasher.addDouble(entity.end().x());
+                hasher.addDouble(entity.end().y());
+            } else if constexpr (std::is_same_v<T, Arc2D>) {
+                hasher.addDouble(entity.center().x());
+                hasher.addDouble(entity.center().y());
+                hasher.addDouble(entity.radius());
+                hasher.addDouble(entity.startAngle());
+                hasher.addDouble(entity.endAngle());
+                hasher.addWord(entity.isCounterClockwise() ? 1 : 0);
+            } else if constexpr (std::is_same_v<T, Ellipse2D>) {
+                hasher.addDouble(entity.center().x());
+                hasher.addDouble(entity.center().y());
+                hasher.addDouble(entity.majorAxisEnd().x());
+                hasher.addDouble(entity.majorAxisEnd().y());
+                hasher.addDouble(entity.minorAxisRatio());
+                hasher.addDouble(entity.startAngle());
+                hasher.addDouble(entity.endAngle());
+            } else if constexpr (std::is_same_v<T, Point2D>) {
+                hasher.addDouble(entity.x());
+                hasher.addDouble(entity.y());
+            }
+        }, record.entity);
+    }
+    return hasher.finish();
+}
+
+bool DocumentModel::adoptCachedValidation() {
+    if (!validationCache_ || isEmpty()) {
+        return false;
+    }
+    auto cached = validationCache_->find(contentHash(), liveCount_);
+    if (!cached) {
+        return false;
+    }
+
+    cached->result.handles = snapshot().segmentHandles();
+    {
+        std::lock_guard<std::mutex> lock(validationMutex_);
+        validationResult_ = std::move(cached->result);
+        statistics_ = cached->statistics;
+    }
+    // Not a baseline for incremental patches: the next run is a full one
+    // and confirms it
+    validationFromCache_ = true;
+    return true;
+}
+
+void DocumentModel::storeCachedValidation() {
+    if (!validationCache_ || isEmpty() || version_ != loadedVersion_ ||
+        !validationResult_.isComplete()) {
+        return;
+    }
+    validationCache_->store(contentHash(), validationResult_, statistics_, liveCount_);
+}
+
+// ============================================================================
+// INCREMENTAL VALIDATION
+// ============================================================================
+
+namespace {
+
+std::optional<std::variant<Line2D, Arc2D>> asValidated(const GeometryEntity& entity) {
+    if (const auto* line = std::get_if<Line2D>(&entity)) {
+        return std::variant<Line2D, Arc2D>(*line);
+    }
+    if (const auto* arc = std::get_if<Arc2D>(&entity)) {
+        return std::variant<Line2D, Arc2D>(*arc);
+    }
+    return std::nullopt;  // Ellipses and points are not validated
+}
+
+bool isValidated(const GeometryEntity& entity) noexcept {
+    return std::holds_alternative<Line2D>(entity) || std::holds_alternative<Arc2D>(entity);
+}
+
+/**
+ * @brief Point halfway along a line or arc (none for other entities)
+ */
+std::optional<Point2D> midpointOf(const GeometryEntity& entity) {
+    if (const auto* line = std::get_if<Line2D>(&entity)) {
+        return line->pointAt(0.5);
+    }
+    if (const auto* arc = std::get_if<Arc2D>(&entity)) {
+        return arc->pointAt(0.5);
+    }
+    return std::nullopt;
+}
+
+/**
+ * @brief Endpoints the contour topology joins (lines and arcs only)
+ */
+std::vector<Point2D> endpointsOf(const GeometryEntity& entity) {
+    if (const auto* line = std::get_if<Line2D>(&entity)) {
+        return {line->start(), line->end()};
+    }
+    if (const auto* arc = std::get_if<Arc2D>(&entity)) {
+        return {arc->startPoint(), arc->endPoint()};
+    }
+    return {};
+}
 
-    for (const auto& entityWithMeta : entities_) {
-        // Only extract Line2D and Arc2D for validation
-        // (GeometryValidator currently only supports these types)
-        if (std::holds_alternative<Line2D>(entityWithMeta.entity)) {
-            variants.push_back(std::get<Line2D>(entityWithMeta.entity));
-        } else if (std::holds_alternative<Arc2D>(entityWithMeta.entity)) {
-            variants.push_back(std::get<Arc2D>(entityWithMeta.entity));
+} // namespace
+
+void DocumentModel::setValidationBaseline(const Geometry::ValidationResult& result) {
+    std::vector<uint32_t> slotOfIndex;
+    slotOfIndex.reserve(liveCount_);
+    for (uint32_t slot : orderedSlots_) {
+        const EntitySlot& entry = slots_[slot];
+        if (entry.live && isValidated(recordOf(entry).entity)) {
+            slotOfIndex.push_back(slot);
         }
-        // Skip Ellipse2D and Point2D for now (no validator yet)
+    }
+    // Spacing compares whole contours with each other, and a corner
+    // depends on the segment after it; there is no local patch for either,
+    // so documents checked for them always validate fully
+    if (manufacturingRules_.featureSpacing() > 0.0 || manufacturingRules_.minCornerAngle > 0.0) {
+        incremental_.clear();
+        return;
+    }
+    if (!incremental_.setBaseline(result, slotOfIndex) || manufacturingRules_.minHoleDiameter <= 0.0) {
+        return;
     }
 
-    return variants;
+    // Slots in closed contours: an edit touching one can change the holes.
+    // Contours without area (a line drawn twice) neither are nor hold holes.
+    std::vector<uint32_t> loopSlots;
+    const auto contours = snapshot().contours();
+    for (const auto& contour : contours->contours()) {
+        if (!contour.closed || contour.area() <= MIN_CONTOUR_AREA) {
+            continue;
+        }
+        for (const auto& segment : contour.segments) {
+            if (segment.entity < slotOfIndex.size()) {
+                loopSlots.push_back(slotOfIndex[segment.entity]);
+            }
+        }
+    }
+    incremental_.setLoopSlots(loopSlots);
 }
 
-std::vector<std::string> DocumentModel::getEntityHandles() const {
-    std::vector<std::string> handles;
-    handles.reserve(entities_.size());
+bool DocumentModel::editsKeepContours() const {
+    if (manufacturingRules_.minHoleDiameter <= 0.0) {
+        return true;  // No contour rule to keep up to date
+    }
+
+    // Entities joined to a dirty entity's old or new endpoints, directly or
+    // through a chain of joints; only these can form or break a contour
+    std::vector<Point2D> frontier = incremental_.previousEndpoints();
+    std::unordered_set<uint32_t> component;
+    for (uint32_t slot : incremental_.dirtySlots()) {
+        if (incremental_.isLoopSlot(slot)) {
+            return false;
+        }
+        const EntitySlot& entry = slots_[slot];
+        if (entry.live && isValidated(recordOf(entry).entity)) {
+            component.insert(slot);
+            const std::vector<Point2D> ends = endpointsOf(recordOf(entry).entity);
+            frontier.insert(frontier.end(), ends.begin(), ends.end());
+        }
+    }
 
-    for (const auto& entityWithMeta : entities_) {
-        // Only extract handles for Line2D and Arc2D (parallel to getEntityVariants)
-        // Must maintain same order as getEntityVariants() for correct mapping
-        if (std::holds_alternative<Line2D>(entityWithMeta.entity) ||
-            std::holds_alternative<Arc2D>(entityWithMeta.entity)) {
-            handles.push_back(entityWithMeta.handle);
+    const double tolerance = ENDPOINT_SNAP_TOLERANCE;
+    while (!frontier.empty()) {
+        const Point2D point = frontier.back();
+        frontier.pop_back();
+
+        const BoundingBox window = BoundingBox::fromPoints(point, point).expand(tolerance);
+        for (const uint32_t other : spatialIndex_.queryWindowKeys(window)) {
+            const EntitySlot& entry = slots_[other];
+            if (!entry.live || component.count(other) > 0) {
+                continue;
+            }
+            const std::vector<Point2D> ends = endpointsOf(recordOf(entry).entity);
+            const bool joined = std::any_of(ends.begin(), ends.end(), [&](const Point2D& end) {
+                return end.isEqual(point, tolerance);
+            });
+            if (!joined) {
+                continue;
+            }
+            if (incremental_.isLoopSlot(other) || component.size() >= CONTOUR_COMPONENT_LIMIT) {
+                return false;
+            }
+            component.insert(other);
+            frontier.insert(frontier.end(), ends.begin(), ends.end());
         }
-        // Skip Ellipse2D and Point2D for now (no validator yet)
     }
 
-    return handles;
+    // No baseline loop involved; the edit keeps the contours if it closes none
+    // with an area
+    std::vector<uint32_t> members(component.begin(), component.end());
+    std::sort(members.begin(), members.end());
+    std::vector<std::variant<Line2D, Arc2D>> segments;
+    segments.reserve(members.size());
+    for (uint32_t slot : members) {
+        segments.push_back(*asValidated(recordOf(slots_[slot]).entity));
+    }
+    const ContourTopology local = ContourTopology::build(segments, tolerance, 1);
+    return std::none_of(local.contours().begin(), local.contours().end(), [](const Contour& contour) {
+        return contour.closed && contour.area() > MIN_CONTOUR_AREA;
+    });
+}
+
+bool DocumentModel::validateIncremental() {
+    if (!incremental_.hasBaseline() ||
+        incremental_.dirtyCount() > std::max(INCREMENTAL_MIN_DIRTY, liveCount_ / 8)) {
+        return false;
+    }
+    if (incremental_.dirtyCount() == 0) {
+        return true;  // Current result still holds
+    }
+    if (!editsKeepContours()) {
+        return false;  // Holes may have appeared, changed or gone
+    }
+
+    const std::vector<uint32_t> dirty = incremental_.dirtySlots();
+    for (uint32_t slot : dirty) {
+        incremental_.forget(slot);
+    }
+
+    // Wide enough for any pair the duplicate, overlap and intersection
+    // checks accept
+    const double margin = GEOMETRY_EPSILON * 4.0;
+
+    for (uint32_t slot : dirty) {
+        const EntitySlot& entry = slots_[slot];
+        if (!entry.live) {
+            continue;  // Removed: forgetting it was all there was to do
+        }
+        const auto validated = asValidated(recordOf(entry).entity);
+        if (!validated) {
+            continue;
+        }
+
+        incremental_.setEntityIssues(
+            slot, GeometryValidator::validateEntity(*validated, GEOMETRY_EPSILON, manufacturingRules_).issues());
+
+        // Re-pair with spatial neighbours; a pair of two dirty entities is
+        // compared once, from the lower slot
+        const BoundingBox window = SpatialIndex::boundsOf(recordOf(entry).entity).expand(margin);
+        for (const uint32_t other : spatialIndex_.queryWindowKeys(window)) {
+            if (other == slot || (other < slot && incremental_.isDirty(other))) {
+                continue;
+            }
+            const auto neighbour = asValidated(recordOf(slots_[other]).entity);
+            if (!neighbour) {
+                continue;
+            }
+
+            const bool first = entry.orderPosition < slots_[other].orderPosition;
+            const auto& lower = first ? *validated : *neighbour;
+            const auto& higher = first ? *neighbour : *validated;
+            const uint32_t lowerSlot = first ? slot : other;
+            const uint32_t higherSlot = first ? other : slot;
+
+            if (const auto type = GeometryValidator::comparePair(lower, higher, GEOMETRY_EPSILON)) {
+                incremental_.addRelation(lowerSlot, higherSlot, *type);
+            }
+            if (const auto point = GeometryValidator::findIntersection(lower, higher, GEOMETRY_EPSILON)) {
+                incremental_.addRelation(lowerSlot, higherSlot,
+                                         GeometryIssueType::SelfIntersection, point);
+            }
+        }
+    }
+    incremental_.clearDirty();
+
+    // Entity indices in current document order, looked up through the
+    // snapshot's page layouts for the slots with issues only; handles are
+    // the snapshot's
+    const DocumentSnapshot current = snapshot();
+    auto indexOf = [this, &current](uint32_t slot) {
+        if (slot >= slots_.size() || !slots_[slot].live) {
+            return IncrementalValidation::NO_INDEX;
+        }
+        const EntitySlot& entry = slots_[slot];
+        const size_t index = current.segmentIndexOf(current.pageStart(entry.orderPosition / PAGE_SIZE) +
+                                                    entry.pageOffset);
+        return index == DocumentSnapshot::NO_SEGMENT ? IncrementalValidation::NO_INDEX : index;
+    };
+
+    ValidationResult result = incremental_.assemble(indexOf, current.segmentHandles());
+
+    std::lock_guard<std::mutex> lock(validationMutex_);
+    validationResult_ = std::move(result);
+    countIssues();
+    return true;
+}
+
+// ============================================================================
+// REGION VALIDATION
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Issues of a result that involve at least one marked entity
+ */
+ValidationResult issuesInvolving(const ValidationResult& result, const std::vector<bool>& marked) {
+    ValidationResult kept;
+    kept.isValid = true;
+    kept.cancelled = result.cancelled;
+    kept.truncatedRules = result.truncatedRules;
+    kept.handles = result.handles;
+
+    auto isMarked = [&marked](size_t index) { return index < marked.size() && marked[index]; };
+    for (GeometryIssue issue : result.issues()) {
+        const std::vector<size_t> members = result.contourOf(issue);
+        const bool related = GeometryValidator::isPairIssue(issue.type) ||
+                             issue.type == GeometryIssueType::SharpCorner;
+        if (!isMarked(issue.entityIndex) && !(related && isMarked(issue.relatedEntityIndex)) &&
+            std::none_of(members.begin(), members.end(), isMarked)) {
+            continue;
+        }
+        if (!members.empty()) {
+            kept.setContour(issue, members);
+        }
+        if (GeometryValidator::isBlockingIssue(issue.type)) {
+            kept.isValid = false;
+        }
+        kept.add(issue);
+    }
+    kept.indexIssues();
+    return kept;
+}
+
+} // namespace
+
+ValidationResult DocumentModel::validateRegion(const BoundingBox& region,
+                                               const ValidationControl& control) const {
+    return validatePreparedRegion(prepareRegion(region, control));
+}
+
+ValidationResult DocumentModel::validateRegion(const std::vector<std::string>& handles,
+                                               const ValidationControl& control) const {
+    return validatePreparedRegion(prepareRegion(handles, control));
+}
+
+DocumentModel::PreparedRegion DocumentModel::prepareRegion(const BoundingBox& region,
+                                                           const ValidationControl& control) const {
+    // Entities crossing the window edge reach past it: search around
+    // everything they cover, not just the window
+    std::vector<uint32_t> requested;
+    BoundingBox covered = region;
+    for (const uint32_t slot : spatialIndex_.queryWindowKeys(region)) {
+        requested.push_back(slot);
+        covered = covered.merge(SpatialIndex::boundsOf(recordOf(slots_[slot]).entity));
+    }
+    const double halo = std::max(ENDPOINT_SNAP_TOLERANCE, manufacturingRules_.featureSpacing());
+    return prepareSlots(requested, {covered.expand(halo)}, control);
+}
+
+DocumentModel::PreparedRegion DocumentModel::prepareRegion(const std::vector<std::string>& handles,
+                                                           const ValidationControl& control) const {
+    // One window per entity: a scattered selection must not pull in
+    // everything between its members
+    const double halo = std::max(ENDPOINT_SNAP_TOLERANCE, manufacturingRules_.featureSpacing());
+    std::vector<uint32_t> requested;
+    std::vector<BoundingBox> windows;
+    for (const std::string& handle : handles) {
+        auto range = slotsByHandle_.equal_range(handle);
+        for (auto it = range.first; it != range.second; ++it) {
+            requested.push_back(it->second);
+            windows.push_back(SpatialIndex::boundsOf(recordOf(slots_[it->second]).entity).expand(halo));
+        }
+    }
+    return prepareSlots(requested, windows, control);
+}
+
+ValidationResult DocumentModel::validatePreparedRegion(const PreparedRegion& region) {
+    return issuesInvolving(validateSnapshot(region.entities, region.control), region.requested);
+}
+
+std::unordered_set<uint32_t> DocumentModel::joinedSlots(const std::vector<uint32_t>& seeds) const {
+    std::unordered_set<uint32_t> joined;
+    std::vector<Point2D> frontier;
+    auto join = [&](uint32_t slot) {
+        const EntitySlot& entry = slots_[slot];
+        if (entry.live && isValidated(recordOf(entry).entity) && joined.insert(slot).second) {
+            const std::vector<Point2D> ends = endpointsOf(recordOf(entry).entity);
+            frontier.insert(frontier.end(), ends.begin(), ends.end());
+        }
+    };
+    for (uint32_t slot : seeds) {
+        join(slot);
+    }
+
+    const double tolerance = ENDPOINT_SNAP_TOLERANCE;
+    while (!frontier.empty()) {
+        const Point2D point = frontier.back();
+        frontier.pop_back();
+
+        const BoundingBox window = BoundingBox::fromPoints(point, point).expand(tolerance);
+        for (const uint32_t other : spatialIndex_.queryWindowKeys(window)) {
+            if (joined.count(other) > 0) {
+                continue;
+            }
+            const std::vector<Point2D> ends = endpointsOf(recordOf(slots_[other]).entity);
+            if (std::any_of(ends.begin(), ends.end(), [&](const Point2D& end) {
+                    return end.isEqual(point, tolerance);
+                })) {
+                join(other);
+            }
+        }
+    }
+    return joined;
+}
+
+DocumentModel::PreparedRegion DocumentModel::prepareSlots(const std::vector<uint32_t>& requested,
+                                                          const std::vector<BoundingBox>& windows,
+                                                          const ValidationControl& control) const {
+    std::unordered_set<uint32_t> wanted(requested.begin(), requested.end());
+    std::unordered_set<uint32_t> members = wanted;
+    for (const BoundingBox& window : windows) {
+        for (const uint32_t slot : spatialIndex_.queryWindowKeys(window)) {
+            members.insert(slot);
+        }
+    }
+
+    // Hole size and spacing judge whole contours, and a contour is only a
+    // hole inside its parent: add every chain a requested entity lies on,
+    // with all chains enclosing it. A chain enclosing an entity crosses any
+    // ray from the entity to the document edge, so only the chains the
+    // shortest such ray meets are candidates, and of those only the ones
+    // whose bounds contain the entity. The validated subset then builds its
+    // own topology from them.
+    if (manufacturingRules_.minHoleDiameter > 0.0 || manufacturingRules_.featureSpacing() > 0.0) {
+        const BoundingBox extent = spatialIndex_.bounds();
+        std::unordered_map<uint32_t, size_t> chainOf;
+        std::vector<std::pair<BoundingBox, std::unordered_set<uint32_t>>> chains;
+        auto chainAt = [&](uint32_t slot) {
+            const auto found = chainOf.find(slot);
+            if (found != chainOf.end()) {
+                return found->second;
+            }
+            std::unordered_set<uint32_t> joined = joinedSlots({slot});
+            BoundingBox bounds;
+            for (uint32_t member : joined) {
+                bounds = bounds.merge(SpatialIndex::boundsOf(recordOf(slots_[member]).entity));
+                chainOf.emplace(member, chains.size());
+            }
+            chainOf.emplace(slot, chains.size());
+            chains.emplace_back(bounds, std::move(joined));
+            return chains.size() - 1;
+        };
+
+        std::unordered_set<size_t> added;
+        for (uint32_t slot : wanted) {
+            const std::optional<Point2D> from = midpointOf(recordOf(slots_[slot]).entity);
+            if (!from || !added.insert(chainAt(slot)).second) {
+                continue;  // Not validated, or its chain was handled already
+            }
+            const std::pair<BoundingBox, std::unordered_set<uint32_t>>& own = chains[chainAt(slot)];
+            members.insert(own.second.begin(), own.second.end());
+
+            std::vector<uint32_t> crossings;
+            for (const Point2D& edge : {Point2D(extent.maxX(), from->y()), Point2D(extent.minX(), from->y()),
+                                        Point2D(from->x(), extent.maxY()), Point2D(from->x(), extent.minY())}) {
+                std::vector<uint32_t> hits = spatialIndex_.queryWindowKeys(
+                    BoundingBox::fromPoints(*from, edge).expand(ENDPOINT_SNAP_TOLERANCE));
+                if (crossings.empty() || hits.size() < crossings.size()) {
+                    crossings = std::move(hits);
+                }
+            }
+            for (uint32_t crossing : crossings) {
+                if (!isValidated(recordOf(slots_[crossing]).entity)) {
+                    continue;
+                }
+                const size_t chain = chainAt(crossing);
+                if (chains[chain].first.contains(*from, ENDPOINT_SNAP_TOLERANCE) && added.insert(chain).second) {
+                    members.insert(chains[chain].second.begin(), chains[chain].second.end());
+                }
+            }
+        }
+    }
+
+    // Validated entities only, in document order, so indices and issue
+    // order match what a full run over the same entities reports
+    std::vector<uint32_t> subset;
+    subset.reserve(members.size());
+    for (uint32_t slot : members) {
+        if (slots_[slot].live && isValidated(recordOf(slots_[slot]).entity)) {
+            subset.push_back(slot);
+        }
+    }
+    std::sort(subset.begin(), subset.end(), [this](uint32_t a, uint32_t b) {
+        return slots_[a].order < slots_[b].order;
+    });
+
+    std::vector<GeometryEntityWithMetadata> records;
+    PreparedRegion region;
+    records.reserve(subset.size());
+    region.requested.reserve(subset.size());
+    for (uint32_t slot : subset) {
+        records.push_back(recordOf(slots_[slot]));
+        region.requested.push_back(wanted.count(slot) > 0);
+    }
+
+    region.entities = DocumentSnapshot::fromEntities(records);
+    region.control = control;
+    region.control.rules = manufacturingRules_;
+    region.control.contours.reset();
+    region.control.entityIssues.reset();
+    return region;
 }
 
 // ============================================================================
@@ -211,9 +803,9 @@ void DocumentModel::calculateStatistics() {
     statistics_.dxfEntitiesImported = originalCount;
 
     // Count actual geometry segments
-    statistics_.totalSegments = entities_.size();
+    statistics_.totalSegments = liveCount_;
 
-    for (const auto& entityWithMeta : entities_) {
+    for (const auto& entityWithMeta : entities()) {
         std::visit([&](auto&& entity) {
             using T = std::decay_t<decltype(entity)>;
 
@@ -232,8 +824,16 @@ void DocumentModel::calculateStatistics() {
         }, entityWithMeta.entity);
     }
 
-    // Count validation issues
-    for (const auto& issue : validationResult_.issues) {
+    countIssues();
+}
+
+void DocumentModel::countIssues() {
+    statistics_.invalidEntities = 0;
+    statistics_.zeroLengthLines = 0;
+    statistics_.zeroRadiusArcs = 0;
+    statistics_.numericallyUnstable = 0;
+
+    for (const auto& issue : validationResult_.issues()) {
         switch (issue.type) {
             case GeometryIssueType::ZeroLengthLine:
                 statistics_.zeroLengthLines++;
@@ -246,6 +846,10 @@ void DocumentModel::calculateStatistics() {
             case GeometryIssueType::NumericalInstability:
                 statistics_.numericallyUnstable++;
                 break;
+            case GeometryIssueType::FeaturesTooClose:
+            case GeometryIssueType::ShortEdge:
+            case GeometryIssueType::SharpCorner:
+                break;  // Manufacturing warnings on valid entities
             default:
                 statistics_.invalidEntities++;
                 break;
@@ -262,13 +866,374 @@ void DocumentModel::calculateStatistics() {
 std::vector<std::string> DocumentModel::getLayers() const {
     std::set<std::string> layerSet;
 
-    for (const auto& entityWithMeta : entities_) {
+    for (const auto& entityWithMeta : entities()) {
         layerSet.insert(entityWithMeta.layer);
     }
 
     return std::vector<std::string>(layerSet.begin(), layerSet.end());
 }
 
+void DocumentModel::rebuildSpatialIndex() {
+    spatialIndex_.clear();
+    for (uint32_t slot : orderedSlots_) {
+        const EntitySlot& entry = slots_[slot];
+        if (entry.live) {
+            spatialIndex_.insert(recordOf(entry).handle, SpatialIndex::boundsOf(recordOf(entry).entity), slot);
+        }
+    }
+}
+
+// ============================================================================
+// SLOT STORAGE
+// ============================================================================
+
+DocumentSnapshot DocumentModel::snapshot() const {
+    // Mutations leave the pages settled; publishing them takes a pointer
+    // per page, and only pages without a known layout are scanned
+    if (!snapshot_) {
+        snapshot_ = DocumentSnapshot(version_, std::vector<DocumentSnapshot::PagePtr>(pages_.begin(), pages_.end()),
+                                     pageLayouts_);
+        pageLayouts_ = snapshot_->pageLayouts();
+    }
+    return *snapshot_;
+}
+
+void DocumentModel::assignEntities(std::vector<GeometryEntityWithMetadata> entities) {
+    resetSlots();
+    slots_.reserve(entities.size());
+    orderedSlots_.reserve(entities.size());
+    slotsByHandle_.reserve(entities.size());
+    appendSlots(std::move(entities));
+    finishSlots();
+}
+
+void DocumentModel::resetSlots() {
+    // Generations keep counting across clears so old ids stay stale
+    slots_.clear();
+    freeSlots_.clear();
+    orderedSlots_.clear();
+    slotsByHandle_.clear();
+    spatialIndex_.clear();
+    pages_.clear();
+    pageLayouts_.clear();
+    stalePages_.clear();
+    revivedRecords_.clear();
+    snapshot_.reset();
+    orderSorted_ = true;
+    liveCount_ = 0;
+    tombstoneCount_ = 0;
+    nextOrder_ = ORDER_STEP;
+    orderEpoch_ = std::make_shared<OrderEpoch>();
+}
+
+void DocumentModel::appendSlots(std::vector<GeometryEntityWithMetadata>&& entities) {
+    // No reserve here: batches arrive one at a time, and exact reserves
+    // would reallocate on every batch instead of growing geometrically
+    for (auto& entity : entities) {
+        EntitySlot entry;
+        entry.order = nextOrder_;
+        entry.generation = nextGeneration_++;
+        entry.live = true;
+        nextOrder_ += ORDER_STEP;
+
+        const uint32_t slot = static_cast<uint32_t>(slots_.size());
+        entry.orderPosition = orderedSlots_.size();
+        if (entry.orderPosition % PAGE_SIZE == 0) {
+            pages_.push_back(std::make_shared<DocumentSnapshot::Page>());
+        }
+        dropPageLayout(pages_.size() - 1);
+        DocumentSnapshot::Page& page = *pages_.back();
+        entry.pageOffset = static_cast<uint32_t>(page.size());
+        slotsByHandle_.emplace(entity.handle, slot);
+        page.push_back(std::move(entity));
+
+        slots_.push_back(entry);
+        orderedSlots_.push_back(slot);
+        liveCount_++;
+    }
+    entities.clear();
+}
+
+void DocumentModel::finishSlots() {
+    rebuildSpatialIndex();
+    incremental_.clear();  // Slots renumbered; next validation is a full one
+    touch();
+}
+
+uint32_t DocumentModel::insertSlot(const GeometryEntityWithMetadata& entity, uint64_t order) {
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+
+    EntitySlot& entry = slots_[slot];
+    entry.order = order;
+    entry.generation = nextGeneration_++;
+    entry.live = true;
+
+    // Keys only grow on append; anything else is sorted lazily
+    if (!orderedSlots_.empty() && slots_[orderedSlots_.back()].order > order) {
+        orderSorted_ = false;
+    }
+    entry.orderPosition = orderedSlots_.size();
+    orderedSlots_.push_back(slot);
+    if (order >= nextOrder_) {
+        nextOrder_ = order + ORDER_STEP;
+    }
+
+    // The new position is the last one, so the record goes at the end of
+    // the last page; settlePages() moves an out-of-order one into place
+    touch();
+    if (entry.orderPosition % PAGE_SIZE == 0) {
+        pages_.push_back(std::make_shared<DocumentSnapshot::Page>());
+    }
+    DocumentSnapshot::Page& page = writablePage(pages_.size() - 1);
+    entry.pageOffset = static_cast<uint32_t>(page.size());
+    page.push_back(entity);
+
+    attachSlot(slot, page.back());
+    incremental_.markDirty(slot);
+    return slot;
+}
+
+void DocumentModel::appendEntity(const GeometryEntityWithMetadata& entity) {
+    insertSlot(entity, nextOrder_);
+}
+
+uint32_t DocumentModel::findSlot(const std::string& handle) const {
+    auto range = slotsByHandle_.equal_range(handle);
+    uint32_t best = NO_SLOT;
+    for (auto it = range.first; it != range.second; ++it) {
+        if (best == NO_SLOT || slots_[it->second].order < slots_[best].order) {
+            best = it->second;
+        }
+    }
+    return best;
+}
+
+GeometryEntityWithMetadata& DocumentModel::editRecord(uint32_t slot) {
+    const EntitySlot& entry = slots_[slot];
+    touch();
+    return writablePage(entry.orderPosition / PAGE_SIZE)[entry.pageOffset];
+}
+
+void DocumentModel::attachSlot(uint32_t slot, const GeometryEntityWithMetadata& record) {
+    slotsByHandle_.emplace(record.handle, slot);
+    spatialIndex_.insert(record.handle, SpatialIndex::boundsOf(record.entity), slot);
+    liveCount_++;
+}
+
+void DocumentModel::EntityCounts::add(const GeometryEntity& entity) noexcept {
+    if (std::holds_alternative<Line2D>(entity)) {
+        lines++;
+    } else if (std::holds_alternative<Arc2D>(entity)) {
+        arcs++;
+    }
+    total++;
+}
+
+void DocumentModel::applyCounts(const EntityCounts& counts, bool added) {
+    if (added) {
+        statistics_.totalLines += counts.lines;
+        statistics_.totalArcs += counts.arcs;
+        statistics_.totalSegments += counts.total;
+        statistics_.validEntities += counts.total;
+    } else {
+        statistics_.totalLines -= counts.lines;
+        statistics_.totalArcs -= counts.arcs;
+        statistics_.totalSegments -= counts.total;
+        statistics_.validEntities -= counts.total;
+    }
+}
+
+void DocumentModel::countEntity(const GeometryEntity& entity, bool added) {
+    EntityCounts counts;
+    counts.add(entity);
+    applyCounts(counts, added);
+}
+
+void DocumentModel::compactTombstones() {
+    if (tombstoneCount_ <= TOMBSTONE_COMPACT_MIN || tombstoneCount_ <= liveCount_) {
+        return;
+    }
+
+    // Drop tombstones from the order list (relative order is unchanged)
+    // and hand their slots back; generation 0 makes old ids stale
+    size_t write = 0;
+    for (uint32_t slot : orderedSlots_) {
+        EntitySlot& entry = slots_[slot];
+        if (entry.live) {
+            orderedSlots_[write++] = slot;
+        } else {
+            entry.generation = 0;
+            freeSlots_.push_back(slot);
+        }
+    }
+    orderedSlots_.resize(write);
+    tombstoneCount_ = 0;
+    rebuildPages(true);  // Live entities moved up to fill the gaps
+}
+
+void DocumentModel::renumberOrder() {
+    ensureOrder();
+    if (orderEpoch_.use_count() > 1) {
+        // Removal records (or older epochs) refer to these keys
+        orderEpoch_->keys.reserve(orderedSlots_.size());
+        for (uint32_t slot : orderedSlots_) {
+            orderEpoch_->keys.push_back(slots_[slot].order);
+        }
+        orderEpoch_->next = std::make_shared<OrderEpoch>();
+        orderEpoch_ = orderEpoch_->next;
+    }
+
+    uint64_t order = ORDER_STEP;
+    for (uint32_t slot : orderedSlots_) {
+        slots_[slot].order = order;
+        order += ORDER_STEP;
+    }
+    nextOrder_ = order;
+}
+
+uint64_t DocumentModel::currentOrderKey(const RemovedEntity& removed) const {
+    // Renumbering gives the key at position i the key (i + 1) * ORDER_STEP.
+    // A key between two old keys keeps its relative place in the new gap.
+    uint64_t key = removed.documentOrder;
+    for (const OrderEpoch* epoch = removed.orderEpoch.get(); epoch && epoch->next; epoch = epoch->next.get()) {
+        const std::vector<uint64_t>& keys = epoch->keys;
+        if (keys.empty()) {
+            continue;
+        }
+        const size_t position = static_cast<size_t>(
+            std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        if (position == keys.size()) {
+            key = keys.size() * ORDER_STEP + (key - keys.back());
+        } else if (keys[position] == key) {
+            key = (position + 1) * ORDER_STEP;
+        } else {
+            const uint64_t before = position > 0 ? keys[position - 1] : 0;
+            const long double fraction = static_cast<long double>(key - before) /
+                                         static_cast<long double>(keys[position] - before);
+            const uint64_t offset = static_cast<uint64_t>(fraction * ORDER_STEP);
+            key = position * ORDER_STEP + std::clamp<uint64_t>(offset, 1, ORDER_STEP - 1);
+        }
+    }
+    return key;
+}
+
+void DocumentModel::ensureOrder() {
+    if (orderSorted_) {
+        return;
+    }
+
+    std::stable_sort(orderedSlots_.begin(), orderedSlots_.end(),
+        [this](uint32_t a, uint32_t b) {
+            return slots_[a].order < slots_[b].order;
+        });
+
+    orderSorted_ = true;
+    rebuildPages(true);  // Records follow their slots to the new positions
+}
+
+void DocumentModel::touch() {
+    version_++;
+    snapshot_.reset();  // Its page references would force copies on write
+}
+
+DocumentSnapshot::Page& DocumentModel::writablePage(size_t pageIndex) {
+    // Only this (main) thread can take new references to a page, so a
+    // count of 1 stays 1 and the page may be written in place
+    PageStorage& page = pages_[pageIndex];
+    if (page.use_count() > 1) {
+        page = std::make_shared<DocumentSnapshot::Page>(*page);
+    }
+    dropPageLayout(pageIndex);
+    return *page;
+}
+
+void DocumentModel::dropPageLayout(size_t pageIndex) {
+    // A layout names its page by identity, which an in-place edit keeps
+    if (pageIndex < pageLayouts_.size()) {
+        pageLayouts_[pageIndex].reset();
+    }
+}
+
+void DocumentModel::rebuildPages(bool all) {
+    touch();
+
+    // A live slot's record sits at pageOffset in the page of its (old)
+    // orderPosition, or in revivedRecords_. Records are moved out of pages
+    // no snapshot holds and copied out of the rest.
+    std::vector<PageStorage> previous;
+    std::vector<size_t> rebuild;
+    if (all) {
+        previous = std::move(pages_);
+        pages_.assign((orderedSlots_.size() + PAGE_SIZE - 1) / PAGE_SIZE, nullptr);
+        rebuild.resize(pages_.size());
+        std::iota(rebuild.begin(), rebuild.end(), size_t(0));
+    } else {
+        std::sort(stalePages_.begin(), stalePages_.end());
+        stalePages_.erase(std::unique(stalePages_.begin(), stalePages_.end()), stalePages_.end());
+        rebuild = std::move(stalePages_);
+    }
+    std::vector<PageStorage>& sources = all ? previous : pages_;
+
+    for (size_t pageIndex : rebuild) {
+        const size_t begin = pageIndex * PAGE_SIZE;
+        const size_t end = std::min(begin + PAGE_SIZE, orderedSlots_.size());
+        auto page = std::make_shared<DocumentSnapshot::Page>();
+        page->reserve(end - begin);
+
+        for (size_t position = begin; position < end; ++position) {
+            const uint32_t slot = orderedSlots_[position];
+            EntitySlot& entry = slots_[slot];
+            if (entry.live) {
+                auto revived = revivedRecords_.empty() ? revivedRecords_.end() : revivedRecords_.find(slot);
+                if (revived != revivedRecords_.end()) {
+                    page->push_back(std::move(revived->second));
+                } else {
+                    PageStorage& source = sources[entry.orderPosition / PAGE_SIZE];
+                    GeometryEntityWithMetadata& record = (*source)[entry.pageOffset];
+                    if (source.use_count() == 1) {
+                        page->push_back(std::move(record));
+                    } else {
+                        page->push_back(record);
+                    }
+                }
+                entry.pageOffset = static_cast<uint32_t>(page->size() - 1);
+            }
+            entry.orderPosition = position;
+        }
+        pages_[pageIndex] = std::move(page);
+    }
+
+    stalePages_.clear();
+    revivedRecords_.clear();
+}
+
+void DocumentModel::settlePages() {
+    ensureOrder();  // Rebuilds every page if it has to sort
+    if (!stalePages_.empty()) {
+        rebuildPages(false);
+    }
+}
+
+uint32_t DocumentModel::slotAtIndex(size_t index) const {
+    const auto [pageIndex, offset] = snapshot().locate(index);
+    const size_t begin = pageIndex * PAGE_SIZE;
+    const size_t end = std::min(begin + PAGE_SIZE, orderedSlots_.size());
+    for (size_t position = begin; position < end; ++position) {
+        const EntitySlot& entry = slots_[orderedSlots_[position]];
+        if (entry.live && entry.pageOffset == offset) {
+            return orderedSlots_[position];
+        }
+    }
+    return NO_SLOT;
+}
+
 // ============================================================================
 // ENTITY CREATION
 // ============================================================================
@@ -292,7 +1257,7 @@ std::string DocumentModel::addLine(const Line2D& line, const std::string& layer)
     };
 
     // Add to collection
-    entities_.push_back(entityWithMeta);
+    appendEntity(entityWithMeta);
 
     // Update statistics
     statistics_.totalLines++;
@@ -321,7 +1286,7 @@ std::string DocumentModel::addArc(const Arc2D& arc, const std::string& layer) {
     };
 
     // Add to collection
-    entities_.push_back(entityWithMeta);
+    appendEntity(entityWithMeta);
 
     // Update statistics
     statistics_.totalArcs++;
@@ -339,48 +1304,74 @@ std::string DocumentModel::generateHandle() {
 }
 
 std::optional<size_t> DocumentModel::findEntityIndexByHandle(const std::string& handle) const {
-    for (size_t i = 0; i < entities_.size(); ++i) {
-        if (entities_[i].handle == handle) {
-            return i;
-        }
+    const uint32_t slot = findSlot(handle);
+    if (slot == NO_SLOT) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    const DocumentSnapshot current = snapshot();
+    const EntitySlot& entry = slots_[slot];
+    return current.pageStart(entry.orderPosition / PAGE_SIZE) + entry.pageOffset;
 }
 
-// ============================================================================
-// ENTITY MODIFICATION
-// ============================================================================
+std::vector<size_t> DocumentModel::queryWindowIndices(const BoundingBox& window) const {
+    std::vector<size_t> indices;
+    const std::vector<uint32_t> hits = spatialIndex_.queryWindowKeys(window);
+    if (hits.empty()) {
+        return indices;
+    }
+    const DocumentSnapshot current = snapshot();
+    indices.reserve(hits.size());
+    for (uint32_t slot : hits) {
+        const EntitySlot& entry = slots_[slot];
+        indices.push_back(current.pageStart(entry.orderPosition / PAGE_SIZE) + entry.pageOffset);
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
 
-GeometryEntityWithMetadata* DocumentModel::findEntityByHandle(const std::string& handle) {
-    for (auto& entity : entities_) {
-        if (entity.handle == handle) {
-            return &entity;
-        }
+std::optional<EntityId> DocumentModel::findEntityId(const std::string& handle) const {
+    const uint32_t slot = findSlot(handle);
+    if (slot == NO_SLOT) {
+        return std::nullopt;
     }
-    return nullptr;
+    return EntityId{slot, slots_[slot].generation};
 }
 
-const GeometryEntityWithMetadata* DocumentModel::findEntityByHandle(const std::string& handle) const {
-    for (const auto& entity : entities_) {
-        if (entity.handle == handle) {
-            return &entity;
-        }
+const GeometryEntityWithMetadata* DocumentModel::findEntity(EntityId id) const {
+    if (!id.isValid() || id.slot >= slots_.size()) {
+        return nullptr;
     }
-    return nullptr;
+    const EntitySlot& entry = slots_[id.slot];
+    if (!entry.live || entry.generation != id.generation) {
+        return nullptr;
+    }
+    return &recordOf(entry);
+}
+
+// ============================================================================
+// ENTITY MODIFICATION
+// ============================================================================
+
+const GeometryEntityWithMetadata* DocumentModel::findEntityByHandle(const std::string& handle) const {
+    const uint32_t slot = findSlot(handle);
+    return slot != NO_SLOT ? &recordOf(slots_[slot]) : nullptr;
 }
 
 bool DocumentModel::updateEntity(const std::string& handle, const GeometryEntity& newGeometry) {
-    GeometryEntityWithMetadata* entity = findEntityByHandle(handle);
-    if (!entity) {
+    const uint32_t slot = findSlot(handle);
+    if (slot == NO_SLOT) {
         return false;
     }
+    GeometryEntityWithMetadata* entity = &editRecord(slot);
 
     // Track old type for statistics update
     bool wasLine = std::holds_alternative<Line2D>(entity->entity);
     bool wasArc = std::holds_alternative<Arc2D>(entity->entity);
 
     // Replace geometry (metadata preserved)
+    incremental_.markDirty(slot, endpointsOf(entity->entity));
     entity->entity = newGeometry;
+    spatialIndex_.update(slot, SpatialIndex::boundsOf(newGeometry));
 
     // Track new type for statistics update
     bool isLine = std::holds_alternative<Line2D>(newGeometry);
@@ -396,33 +1387,106 @@ bool DocumentModel::updateEntity(const std::string& handle, const GeometryEntity
 }
 
 bool DocumentModel::removeEntity(const std::string& handle) {
-    auto it = std::find_if(entities_.begin(), entities_.end(),
-        [&handle](const GeometryEntityWithMetadata& e) {
-            return e.handle == handle;
-        });
+    return extractEntity(handle).has_value();
+}
 
-    if (it == entities_.end()) {
-        return false;
+std::optional<RemovedEntity> DocumentModel::extractEntity(const std::string& handle) {
+    const uint32_t slot = findSlot(handle);
+    if (slot == NO_SLOT) {
+        return std::nullopt;
     }
 
     // Update statistics before removal
-    if (std::holds_alternative<Line2D>(it->entity)) {
-        statistics_.totalLines--;
-    } else if (std::holds_alternative<Arc2D>(it->entity)) {
-        statistics_.totalArcs--;
+    countEntity(recordOf(slots_[slot]).entity, false);
+
+    RemovedEntity removed = detachSlot(slot);
+    compactTombstones();
+    settlePages();
+    return removed;
+}
+
+bool DocumentModel::restoreEntity(const RemovedEntity& removed) {
+    if (!reattach(removed)) {
+        return false;
     }
-    statistics_.totalSegments--;
-    statistics_.validEntities--;
+    settlePages();
+    countEntity(removed.entity.entity, true);
+    return true;
+}
 
-    // Remove entity
-    entities_.erase(it);
+RemovedEntity DocumentModel::detachSlot(uint32_t slot, bool unindexHandle) {
+    EntitySlot& entry = slots_[slot];
+
+    // Unindex (before the record is moved out - callers may pass its handle)
+    spatialIndex_.remove(slot);
+    if (unindexHandle) {
+        auto range = slotsByHandle_.equal_range(recordOf(entry).handle);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == slot) {
+                slotsByHandle_.erase(it);
+                break;
+            }
+        }
+    }
+
+    // The record leaves its page when settlePages() rebuilds it; a page
+    // no snapshot holds gives the record up without a copy
+    touch();
+    PageStorage& page = pages_[entry.orderPosition / PAGE_SIZE];
+    GeometryEntityWithMetadata& record = (*page)[entry.pageOffset];
+    RemovedEntity removed{page.use_count() == 1 ? std::move(record) : GeometryEntityWithMetadata(record),
+                          EntityId{slot, entry.generation}, entry.order, orderEpoch_};
+    stalePages_.push_back(entry.orderPosition / PAGE_SIZE);
+
+    // Leave a tombstone in document order
+    entry.live = false;
+    liveCount_--;
+    tombstoneCount_++;
+    incremental_.markDirty(slot, endpointsOf(removed.entity.entity));
+
+    return removed;
+}
+
+bool DocumentModel::reattach(const RemovedEntity& removed) {
+    const EntitySlot* tombstone = nullptr;
+    if (removed.id.isValid() && removed.id.slot < slots_.size()) {
+        tombstone = &slots_[removed.id.slot];
+        if (tombstone->generation != removed.id.generation) {
+            tombstone = nullptr;  // Slot was recycled
+        } else if (tombstone->live) {
+            return false;  // Already restored
+        }
+    }
+
+    if (tombstone) {
+        // Revive in place - order list untouched; the record rejoins its
+        // page when settlePages() rebuilds it
+        EntitySlot& entry = slots_[removed.id.slot];
+        entry.live = true;
+        tombstoneCount_--;
+        attachSlot(removed.id.slot, removed.entity);
+        incremental_.markDirty(removed.id.slot);
+        touch();
+        revivedRecords_.insert_or_assign(removed.id.slot, removed.entity);
+        stalePages_.push_back(entry.orderPosition / PAGE_SIZE);
+    } else {
+        // Tombstone compacted away: re-insert at the saved order key
+        const uint64_t order = currentOrderKey(removed);
+        auto range = slotsByHandle_.equal_range(removed.entity.handle);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (slots_[it->second].order == order) {
+                return false;  // Already restored
+            }
+        }
+        insertSlot(removed.entity, order);
+    }
 
     return true;
 }
 
 bool DocumentModel::restoreEntity(const Import::GeometryEntityWithMetadata& entity) {
     // Re-use restoreEntityAtIndex logic at the end of the collection
-    return restoreEntityAtIndex(entity, entities_.size());
+    return restoreEntityAtIndex(entity, liveCount_);
 }
 
 bool DocumentModel::restoreEntityAtIndex(const Import::GeometryEntityWithMetadata& entity, size_t index) {
@@ -432,25 +1496,26 @@ bool DocumentModel::restoreEntityAtIndex(const Import::GeometryEntityWithMetadat
     }
 
     // Clamp index to valid range
-    if (index > entities_.size()) {
-        index = entities_.size();
+    if (index >= liveCount_) {
+        appendEntity(entity);
+        countEntity(entity.entity, true);
+        return true;
     }
 
-    // Add entity back to collection at original position
-    entities_.insert(entities_.begin() + index, entity);
-
-    // Update statistics
-    std::visit([this](auto&& geom) {
-        using T = std::decay_t<decltype(geom)>;
-        if constexpr (std::is_same_v<T, Line2D>) {
-            statistics_.totalLines++;
-        } else if constexpr (std::is_same_v<T, Arc2D>) {
-            statistics_.totalArcs++;
-        }
-    }, entity.entity);
+    // Take a key between the entity now at `index` and whatever precedes it
+    // in the order list (live or tombstone), re-spacing keys if no gap is left
+    const size_t position = slots_[slotAtIndex(index)].orderPosition;
+    uint64_t next = slots_[orderedSlots_[position]].order;
+    uint64_t prev = position > 0 ? slots_[orderedSlots_[position - 1]].order : 0;
+    if (next - prev < 2) {
+        renumberOrder();  // Keys change, positions do not
+        next = slots_[orderedSlots_[position]].order;
+        prev = position > 0 ? slots_[orderedSlots_[position - 1]].order : 0;
+    }
 
-    statistics_.totalSegments++;
-    statistics_.validEntities++;
+    insertSlot(entity, prev + (next - prev) / 2);
+    settlePages();
+    countEntity(entity.entity, true);
 
     return true;
 }
@@ -474,7 +1539,7 @@ std::string DocumentModel::addEllipse(const Ellipse2D& ellipse, const std::strin
     };
 
     // Add to collection
-    entities_.push_back(entityWithMeta);
+    appendEntity(entityWithMeta);
 
     // Update statistics
     statistics_.totalSegments++;
@@ -497,7 +1562,7 @@ std::string DocumentModel::addPoint(const Point2D& point, const std::string& lay
     };
 
     // Add to collection
-    entities_.push_back(entityWithMeta);
+    appendEntity(entityWithMeta);
 
     // Update statistics
     statistics_.totalSegments++;
@@ -506,15 +1571,165 @@ std::string DocumentModel::addPoint(const Point2D& point, const std::string& lay
     return handle;
 }
 
+// ============================================================================
+// BATCH MUTATION
+// ============================================================================
+
+std::vector<std::string> DocumentModel::addEntities(const std::vector<GeometryEntity>& entities,
+                                                    const std::string& layer) {
+    return appendEntities(entities, &layer, 0);
+}
+
+std::vector<std::string> DocumentModel::addEntities(const std::vector<GeometryEntity>& entities,
+                                                    const std::vector<std::string>& layers) {
+    if (layers.size() != entities.size()) {
+        return std::vector<std::string>(entities.size());
+    }
+    return appendEntities(entities, layers.data(), 1);
+}
+
+std::vector<std::string> DocumentModel::appendEntities(const std::vector<GeometryEntity>& entities,
+                                                       const std::string* layers, size_t layerStride) {
+    std::vector<std::string> handles(entities.size());
+
+    slots_.reserve(slots_.size() + entities.size());
+    orderedSlots_.reserve(orderedSlots_.size() + entities.size());
+    slotsByHandle_.reserve(slotsByHandle_.size() + entities.size());
+
+    EntityCounts counts;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        const bool valid = std::visit([](auto&& geom) -> bool {
+            using T = std::decay_t<decltype(geom)>;
+            if constexpr (std::is_same_v<T, Point2D>) {
+                return true;  // Points are always valid
+            } else {
+                return geom.isValid();
+            }
+        }, entities[i]);
+
+        if (!valid) {
+            continue;
+        }
+
+        handles[i] = generateHandle();
+        appendEntity(GeometryEntityWithMetadata{
+            entities[i],            // entity
+            layers[i * layerStride],// layer
+            handles[i],             // handle
+            256,                    // colorNumber (BYLAYER)
+            0                       // sourceLineNumber (not from file)
+        });
+        counts.add(entities[i]);
+    }
+
+    applyCounts(counts, true);
+    return handles;
+}
+
+BatchResult DocumentModel::removeEntities(const std::vector<std::string>& handles,
+                                          std::vector<RemovedEntity>* removed) {
+    BatchResult result;
+    result.succeeded.resize(handles.size(), false);
+
+    EntityCounts counts;
+    std::vector<uint32_t> group;
+    for (size_t i = 0; i < handles.size(); ++i) {
+        // Take every slot of the handle off the handle index in one step
+        auto range = slotsByHandle_.equal_range(handles[i]);
+        if (range.first == range.second) {
+            continue;
+        }
+        group.clear();
+        for (auto it = range.first; it != range.second; ++it) {
+            group.push_back(it->second);
+        }
+        slotsByHandle_.erase(range.first, range.second);
+
+        for (uint32_t slot : group) {
+            counts.add(recordOf(slots_[slot]).entity);
+            RemovedEntity entity = detachSlot(slot, false);
+            if (removed) {
+                removed->push_back(std::move(entity));
+            }
+        }
+        result.succeeded[i] = true;
+        result.successCount++;
+    }
+
+    applyCounts(counts, false);
+    compactTombstones();
+    settlePages();
+    return result;
+}
+
+BatchResult DocumentModel::restoreEntities(const std::vector<RemovedEntity>& removed) {
+    BatchResult result;
+    result.succeeded.resize(removed.size(), false);
+
+    slotsByHandle_.reserve(slotsByHandle_.size() + removed.size());
+
+    EntityCounts counts;
+    for (size_t i = 0; i < removed.size(); ++i) {
+        if (reattach(removed[i])) {
+            counts.add(removed[i].entity.entity);
+            result.succeeded[i] = true;
+            result.successCount++;
+        }
+    }
+
+    settlePages();
+    applyCounts(counts, true);
+    return result;
+}
+
+BatchResult DocumentModel::updateEntities(const std::vector<std::string>& handles,
+                                          const std::vector<GeometryEntity>& geometries) {
+    BatchResult result;
+    result.succeeded.resize(handles.size(), false);
+
+    EntityCounts before;
+    EntityCounts after;
+    for (size_t i = 0; i < handles.size() && i < geometries.size(); ++i) {
+        const uint32_t slot = findSlot(handles[i]);
+        if (slot == NO_SLOT) {
+            continue;
+        }
+
+        GeometryEntityWithMetadata& record = editRecord(slot);
+        before.add(record.entity);
+        after.add(geometries[i]);
+
+        // Replace geometry (metadata preserved)
+        incremental_.markDirty(slot, endpointsOf(record.entity));
+        record.entity = geometries[i];
+        spatialIndex_.update(slot, SpatialIndex::boundsOf(record.entity));
+
+        result.succeeded[i] = true;
+        result.successCount++;
+    }
+
+    // Only line/arc counts can change; totals cancel out
+    statistics_.totalLines += after.lines;
+    statistics_.totalLines -= before.lines;
+    statistics_.totalArcs += after.arcs;
+    statistics_.totalArcs -= before.arcs;
+    return result;
+}
+
 // ============================================================================
 // DXF EXPORT
 // ============================================================================
 
-bool DocumentModel::exportDXFFile(const std::string& filePath) const {
+bool DocumentModel::exportDXFFile(const std::string& filePath, Export::DXFFormat format) const {
     exportErrors_.clear();
 
-    // Step 1: Convert internal geometry to DXF entities
-    Export::ExportResult exportResult = Export::GeometryExporter::exportToDXF(entities_);
+    // Step 1: Convert internal geometry to DXF entities, page by page
+    // straight from the snapshot (no intermediate entity list)
+    const DocumentSnapshot entities = snapshot();
+    Export::ExportResult exportResult;
+    for (size_t page = 0; page < entities.pageCount(); ++page) {
+        Export::GeometryExporter::appendToDXF(entities.page(page), exportResult);
+    }
 
     if (!exportResult.success || !exportResult.errors.empty()) {
         exportErrors_ = exportResult.errors;
@@ -522,7 +1737,7 @@ bool DocumentModel::exportDXFFile(const std::string& filePath) const {
     }
 
     // Step 2: Write DXF entities to file
-    bool writeSuccess = Export::DXFWriter::writeFile(filePath, exportResult.entities);
+    bool writeSuccess = Export::DXFWriter::writeFile(filePath, exportResult.entities, format);
 
     if (!writeSuccess) {
         exportErrors_.push_back("Failed to write DXF file: " + filePath);
@@ -539,7 +1754,7 @@ const std::vector<std::string>& DocumentModel::exportErrors() const noexcept {
 void DocumentModel::updateNextHandleNumber() {
     size_t maxHandle = 0;
 
-    for (const auto& entity : entities_) {
+    for (const auto& entity : entities()) {
         if (entity.handle.empty()) continue;
 
         try {
@@ -0,0 +1,186 @@
+#include "model/DocumentSnapshot.h"
+#include <algorithm>
+
+namespace OwnCAD {
+namespace Model {
+
+using namespace OwnCAD::Import;
+
+namespace {
+
+// Page capacity used by fromEntities (matches DocumentModel's page size)
+constexpr size_t WRAP_PAGE_SIZE = 1024;
+
+Geometry::SegmentRef readSegment(const void* record) noexcept {
+    return Geometry::SegmentRef(static_cast<const GeometryEntityWithMetadata*>(record)->entity);
+}
+
+const std::string& readHandle(const void* record) noexcept {
+    return static_cast<const GeometryEntityWithMetadata*>(record)->handle;
+}
+
+bool isSegment(const GeometryEntity& entity) noexcept {
+    return std::holds_alternative<Geometry::Line2D>(entity) || std::holds_alternative<Geometry::Arc2D>(entity);
+}
+
+/**
+ * @brief Find the lines and arcs of a page
+ */
+DocumentSnapshot::PageLayoutPtr layoutOf(const DocumentSnapshot::PagePtr& page) {
+    auto layout = std::make_shared<DocumentSnapshot::PageLayout>();
+    layout->page = page;
+    for (size_t offset = 0; offset < page->size(); ++offset) {
+        if (isSegment((*page)[offset].entity)) {
+            layout->offsets.push_back(static_cast<uint32_t>(offset));
+        }
+    }
+    layout->segmentCount = static_cast<uint32_t>(layout->offsets.size());
+    if (layout->segmentCount == page->size()) {
+        layout->offsets.clear();  // Dense: offsets are the positions themselves
+        layout->offsets.shrink_to_fit();
+    }
+    return layout;
+}
+
+bool describes(const DocumentSnapshot::PageLayoutPtr& layout, const DocumentSnapshot::PagePtr& page) noexcept {
+    // Owner comparison: an expired page never matches a new one
+    return layout && !layout->page.owner_before(page) && !page.owner_before(layout->page);
+}
+
+} // namespace
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+DocumentSnapshot::DocumentSnapshot()
+    : DocumentSnapshot(0, {}) {
+}
+
+DocumentSnapshot::DocumentSnapshot(uint64_t version, std::vector<PagePtr> pages)
+    : DocumentSnapshot(version, std::move(pages), {}) {
+}
+
+DocumentSnapshot::DocumentSnapshot(uint64_t version, std::vector<PagePtr> pages,
+                                   const std::vector<PageLayoutPtr>& known) {
+    static const PagePtr emptyPage = std::make_shared<const Page>();
+
+    auto data = std::make_shared<Data>();
+    data->version = version;
+    data->pages = std::move(pages);
+    data->pageStarts.reserve(data->pages.size());
+    data->layouts.reserve(data->pages.size());
+    data->segmentStarts.reserve(data->pages.size());
+
+    size_t segmentCount = 0;
+    for (size_t index = 0; index < data->pages.size(); ++index) {
+        PagePtr& page = data->pages[index];
+        if (!page) {
+            page = emptyPage;
+        }
+        data->pageStarts.push_back(data->size);
+        data->size += page->size();
+
+        const bool reuse = index < known.size() && describes(known[index], page);
+        data->layouts.push_back(reuse ? known[index] : layoutOf(page));
+
+        const PageLayout& layout = *data->layouts.back();
+        data->segmentStarts.push_back(segmentCount);
+        if (layout.segmentCount > 0) {
+            Geometry::SegmentView::Chunk chunk;
+            chunk.records = page->data();
+            chunk.stride = sizeof(GeometryEntityWithMetadata);
+            chunk.start = segmentCount;
+            chunk.count = layout.segmentCount;
+            chunk.offsets = layout.offsets.empty() ? nullptr : layout.offsets.data();
+            data->chunks.push_back(chunk);
+            segmentCount += layout.segmentCount;
+        }
+    }
+
+    data_ = std::move(data);
+}
+
+DocumentSnapshot DocumentSnapshot::fromEntities(const std::vector<GeometryEntityWithMetadata>& entities,
+                                                uint64_t version) {
+    std::vector<PagePtr> pages;
+    pages.reserve((entities.size() + WRAP_PAGE_SIZE - 1) / WRAP_PAGE_SIZE);
+
+    for (size_t start = 0; start < entities.size(); start += WRAP_PAGE_SIZE) {
+        const size_t end = std::min(start + WRAP_PAGE_SIZE, entities.size());
+        pages.push_back(std::make_shared<const Page>(entities.begin() + start, entities.begin() + end));
+    }
+
+    return DocumentSnapshot(version, std::move(pages));
+}
+
+// ============================================================================
+// ACCESS
+// ============================================================================
+
+const GeometryEntityWithMetadata& DocumentSnapshot::operator[](size_t index) const {
+    const auto [page, offset] = locate(index);
+    return (*data_->pages[page])[offset];
+}
+
+std::pair<size_t, size_t> DocumentSnapshot::locate(size_t index) const {
+    // Last page starting at or before index. Empty pages share their start
+    // with the following page, so (for index < size) this is never empty.
+    const auto& starts = data_->pageStarts;
+    const size_t page = static_cast<size_t>(
+        std::upper_bound(starts.begin(), starts.end(), index) - starts.begin()) - 1;
+    return {page, index - starts[page]};
+}
+
+bool DocumentSnapshot::sharesPage(const DocumentSnapshot& other, size_t index) const noexcept {
+    return index < data_->pages.size() && index < other.data_->pages.size() &&
+           data_->pages[index] == other.data_->pages[index];
+}
+
+std::vector<GeometryEntityWithMetadata> DocumentSnapshot::toVector() const {
+    std::vector<GeometryEntityWithMetadata> entities;
+    entities.reserve(data_->size);
+    for (const auto& page : data_->pages) {
+        entities.insert(entities.end(), page->begin(), page->end());
+    }
+    return entities;
+}
+
+// ============================================================================
+// DERIVED DATA
+// ============================================================================
+
+Geometry::SegmentView DocumentSnapshot::segments() const noexcept {
+    // Ellipses and points are not validated; the layouts leave them out
+    return Geometry::SegmentView(data_->chunks.data(), data_->chunks.size(),
+                                 readSegment, readHandle, data_);
+}
+
+Geometry::HandleTable DocumentSnapshot::segmentHandles() const {
+    return Geometry::HandleTable(segments());
+}
+
+size_t DocumentSnapshot::segmentIndexOf(size_t index) const {
+    const auto [page, offset] = locate(index);
+    const PageLayout& layout = *data_->layouts[page];
+    if (layout.offsets.empty()) {
+        // Dense, or no segment at all
+        return layout.segmentCount > 0 ? data_->segmentStarts[page] + offset : NO_SEGMENT;
+    }
+    const auto found = std::lower_bound(layout.offsets.begin(), layout.offsets.end(), offset);
+    if (found == layout.offsets.end() || *found != offset) {
+        return NO_SEGMENT;
+    }
+    return data_->segmentStarts[page] + static_cast<size_t>(found - layout.offsets.begin());
+}
+
+std::shared_ptr<const Geometry::ContourTopology> DocumentSnapshot::contours() const {
+    std::call_once(data_->contoursOnce, [this]() {
+        data_->contours = std::make_shared<const Geometry::ContourTopology>(
+            Geometry::ContourTopology::build(segments()));
+    });
+    return data_->contours;
+}
+
+} // namespace Model
+} // namespace OwnCAD
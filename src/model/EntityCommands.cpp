@@ -3,7 +3,7 @@
 #include "geometry/GeometryConstants.h"
 #include <QDebug>
 #include <cmath>
-#include <set>
+#include <algorithm>
 
 namespace OwnCAD {
 namespace Model {
@@ -138,35 +138,17 @@ bool CreateEntitiesCommand::execute()
         return false;
     }
 
-    m_generatedHandles.clear();
-    m_generatedHandles.reserve(m_entities.size());
-
-    for (const auto& entity : m_entities) {
-        std::string handle = std::visit([this](auto&& geom) -> std::string {
-            using T = std::decay_t<decltype(geom)>;
+    m_generatedHandles = m_documentModel->addEntities(m_entities, m_layer);
 
-            if constexpr (std::is_same_v<T, Line2D>) {
-                return m_documentModel->addLine(geom, m_layer);
-            } else if constexpr (std::is_same_v<T, Arc2D>) {
-                return m_documentModel->addArc(geom, m_layer);
-            } else if constexpr (std::is_same_v<T, Ellipse2D>) {
-                return m_documentModel->addEllipse(geom, m_layer);
-            } else if constexpr (std::is_same_v<T, Point2D>) {
-                return m_documentModel->addPoint(geom, m_layer);
-            }
-            return std::string();
-        }, entity);
-
-        if (handle.empty()) {
-            // Rollback all previously added entities
-            for (const auto& h : m_generatedHandles) {
-                m_documentModel->removeEntity(h);
-            }
-            m_generatedHandles.clear();
-            return false;
-        }
-
-        m_generatedHandles.push_back(handle);
+    auto rejected = std::find(m_generatedHandles.begin(), m_generatedHandles.end(), std::string());
+    if (rejected != m_generatedHandles.end()) {
+        // Rollback the entities that were added (all or nothing)
+        m_generatedHandles.erase(
+            std::remove(m_generatedHandles.begin(), m_generatedHandles.end(), std::string()),
+            m_generatedHandles.end());
+        m_documentModel->removeEntities(m_generatedHandles);
+        m_generatedHandles.clear();
+        return false;
     }
 
     m_executed = true;
@@ -179,10 +161,7 @@ bool CreateEntitiesCommand::undo()
         return false;
     }
 
-    // Remove in reverse order
-    for (auto it = m_generatedHandles.rbegin(); it != m_generatedHandles.rend(); ++it) {
-        m_documentModel->removeEntity(*it);
-    }
+    m_documentModel->removeEntities(m_generatedHandles);
 
     m_generatedHandles.clear();
     m_executed = false;
@@ -228,30 +207,23 @@ bool DeleteEntityCommand::execute()
         return false;
     }
 
-    // Save entity and index for undo
-    const auto* entity = m_documentModel->findEntityByHandle(m_handle);
-    if (!entity) {
+    // Remove entity, keeping it and its document order for undo
+    m_removedEntity = m_documentModel->extractEntity(m_handle);
+    if (!m_removedEntity) {
         return false;
     }
 
-    m_savedEntity = *entity;
-    m_originalIndex = m_documentModel->findEntityIndexByHandle(m_handle).value_or(0);
-
-    // Remove entity
-    bool success = m_documentModel->removeEntity(m_handle);
-    if (success) {
-        m_executed = true;
-    }
-    return success;
+    m_executed = true;
+    return true;
 }
 
 bool DeleteEntityCommand::undo()
 {
-    if (!m_executed || !m_savedEntity) {
+    if (!m_executed || !m_removedEntity) {
         return false;
     }
 
-    bool success = m_documentModel->restoreEntityAtIndex(*m_savedEntity, m_originalIndex);
+    bool success = m_documentModel->restoreEntity(*m_removedEntity);
     if (success) {
         m_executed = false;
     }
@@ -260,7 +232,7 @@ bool DeleteEntityCommand::undo()
 
 QString DeleteEntityCommand::description() const
 {
-    if (m_savedEntity) {
+    if (m_removedEntity) {
         return std::visit([](auto&& geom) -> QString {
             using T = std::decay_t<decltype(geom)>;
 
@@ -277,7 +249,7 @@ QString DeleteEntityCommand::description() const
                 return QStringLiteral("Delete Point");
             }
             return QStringLiteral("Delete Entity");
-        }, m_savedEntity->entity);
+        }, m_removedEntity->entity.entity);
     }
     return QStringLiteral("Delete Entity");
 }
@@ -307,47 +279,28 @@ bool DeleteEntitiesCommand::execute()
         return false;
     }
 
-    m_savedEntities.clear();
-    m_originalIndices.clear();
+    m_removedEntities.clear();
 
-    // Find and save entities in THEIR DOCUMENT ORDER to ensure correct restoration
-    const auto& allEntities = m_documentModel->entities();
-    std::set<std::string> targetHandles(m_handles.begin(), m_handles.end());
+    // Removes every entity with a target handle (decomposed polylines share
+    // one handle). Each removal records its document order for undo.
+    m_documentModel->removeEntities(m_handles, &m_removedEntities);
 
-    for (size_t i = 0; i < allEntities.size(); ++i) {
-        if (targetHandles.count(allEntities[i].handle)) {
-            m_savedEntities.push_back(allEntities[i]);
-            m_originalIndices.push_back(i);
-        }
-    }
-
-    if (m_savedEntities.empty()) {
+    if (m_removedEntities.empty()) {
         return false;
     }
 
-    // Remove all entities
-    for (const auto& savedEntity : m_savedEntities) {
-        m_documentModel->removeEntity(savedEntity.handle);
-    }
-
     m_executed = true;
     return true;
 }
 
 bool DeleteEntitiesCommand::undo()
 {
-    if (!m_executed || m_savedEntities.empty()) {
+    if (!m_executed || m_removedEntities.empty()) {
         return false;
     }
 
-    // Restore in ORIGINAL DOCUMENT ORDER (increasing index)
-    // Since we saved them in document order, we just iterate normally
-    bool allSuccess = true;
-    for (size_t i = 0; i < m_savedEntities.size(); ++i) {
-        if (!m_documentModel->restoreEntityAtIndex(m_savedEntities[i], m_originalIndices[i])) {
-            allSuccess = false;
-        }
-    }
+    // Each entity returns to its saved document order
+    bool allSuccess = m_documentModel->restoreEntities(m_removedEntities).allSucceeded();
 
     if (allSuccess) {
         m_executed = false;
@@ -357,7 +310,7 @@ bool DeleteEntitiesCommand::undo()
 
 QString DeleteEntitiesCommand::description() const
 {
-    size_t count = m_savedEntities.empty() ? m_handles.size() : m_savedEntities.size();
+    size_t count = m_removedEntities.empty() ? m_handles.size() : m_removedEntities.size();
     if (count == 1) {
         return QStringLiteral("Delete entity");
     }
@@ -465,6 +418,11 @@ bool MoveEntitiesCommand::merge(const Command* other)
 
 bool MoveEntitiesCommand::applyTranslation(double dx, double dy)
 {
+    std::vector<std::string> handles;
+    std::vector<GeometryEntity> geometries;
+    handles.reserve(m_handles.size());
+    geometries.reserve(m_handles.size());
+
     for (const auto& handle : m_handles) {
         auto* entityPtr = m_documentModel->findEntityByHandle(handle);
         if (!entityPtr) {
@@ -496,10 +454,12 @@ bool MoveEntitiesCommand::applyTranslation(double dx, double dy)
         }, entityPtr->entity);
 
         if (translated) {
-            m_documentModel->updateEntity(handle, *translated);
+            handles.push_back(handle);
+            geometries.push_back(*translated);
         }
     }
 
+    m_documentModel->updateEntities(handles, geometries);
     return true;
 }
 
@@ -570,6 +530,11 @@ bool RotateEntitiesCommand::isValid() const
 
 bool RotateEntitiesCommand::applyRotation(double angleRadians)
 {
+    std::vector<std::string> handles;
+    std::vector<GeometryEntity> geometries;
+    handles.reserve(m_handles.size());
+    geometries.reserve(m_handles.size());
+
     for (const auto& handle : m_handles) {
         auto* entityPtr = m_documentModel->findEntityByHandle(handle);
         if (!entityPtr) {
@@ -601,10 +566,12 @@ bool RotateEntitiesCommand::applyRotation(double angleRadians)
         }, entityPtr->entity);
 
         if (rotated) {
-            m_documentModel->updateEntity(handle, *rotated);
+            handles.push_back(handle);
+            geometries.push_back(*rotated);
         }
     }
 
+    m_documentModel->updateEntities(handles, geometries);
     return true;
 }
 
@@ -634,6 +601,11 @@ bool MirrorEntitiesCommand::execute()
     m_createdHandles.clear();
     m_originalEntities.clear();
 
+    // Collected per entity, then applied as one batch
+    std::vector<std::string> handles;
+    std::vector<std::string> layers;
+    std::vector<GeometryEntity> geometries;
+
     for (const auto& handle : m_handles) {
         auto* entityPtr = m_documentModel->findEntityByHandle(handle);
         if (!entityPtr) {
@@ -668,32 +640,26 @@ bool MirrorEntitiesCommand::execute()
         }
 
         if (m_keepOriginal) {
-            // Create a copy with the mirrored geometry
-            std::string newHandle = std::visit([this, &entityPtr](auto&& geom) -> std::string {
-                using T = std::decay_t<decltype(geom)>;
-
-                if constexpr (std::is_same_v<T, Line2D>) {
-                    return m_documentModel->addLine(geom, entityPtr->layer);
-                } else if constexpr (std::is_same_v<T, Arc2D>) {
-                    return m_documentModel->addArc(geom, entityPtr->layer);
-                } else if constexpr (std::is_same_v<T, Ellipse2D>) {
-                    return m_documentModel->addEllipse(geom, entityPtr->layer);
-                } else if constexpr (std::is_same_v<T, Point2D>) {
-                    return m_documentModel->addPoint(geom, entityPtr->layer);
-                }
-                return std::string();
-            }, *mirrored);
-
-            if (!newHandle.empty()) {
-                m_createdHandles.push_back(newHandle);
-            }
+            // Copy on the original's layer
+            layers.push_back(entityPtr->layer);
         } else {
             // Save original for undo
             m_originalEntities.push_back(*entityPtr);
+            handles.push_back(handle);
+        }
+        geometries.push_back(*mirrored);
+    }
 
-            // Replace with mirrored geometry
-            m_documentModel->updateEntity(handle, *mirrored);
+    if (m_keepOriginal) {
+        // Create copies with the mirrored geometry
+        for (auto& newHandle : m_documentModel->addEntities(geometries, layers)) {
+            if (!newHandle.empty()) {
+                m_createdHandles.push_back(std::move(newHandle));
+            }
         }
+    } else {
+        // Replace with mirrored geometry
+        m_documentModel->updateEntities(handles, geometries);
     }
 
     m_executed = true;
@@ -708,15 +674,19 @@ bool MirrorEntitiesCommand::undo()
 
     if (m_keepOriginal) {
         // Remove created copies
-        for (const auto& handle : m_createdHandles) {
-            m_documentModel->removeEntity(handle);
-        }
+        m_documentModel->removeEntities(m_createdHandles);
         m_createdHandles.clear();
     } else {
         // Restore original entities
+        std::vector<std::string> handles;
+        std::vector<GeometryEntity> geometries;
+        handles.reserve(m_originalEntities.size());
+        geometries.reserve(m_originalEntities.size());
         for (const auto& original : m_originalEntities) {
-            m_documentModel->updateEntity(original.handle, original.entity);
+            handles.push_back(original.handle);
+            geometries.push_back(original.entity);
         }
+        m_documentModel->updateEntities(handles, geometries);
     }
 
     m_executed = false;
@@ -0,0 +1,225 @@
+#include "model/IncrementalValidation.h"
+#include <algorithm>
+
+namespace OwnCAD {
+namespace Model {
+
+using Geometry::GeometryIssue;
+using Geometry::GeometryIssueType;
+using Geometry::GeometryValidator;
+using Geometry::ValidationResult;
+
+void IncrementalValidation::clear() {
+    hasBaseline_ = false;
+    dirty_.clear();
+    previousEndpoints_.clear();
+    loopSlots_.clear();
+    entityIssues_.clear();
+    relations_.clear();
+    contourIssues_.clear();
+}
+
+bool IncrementalValidation::setBaseline(const ValidationResult& result,
+                                        const std::vector<uint32_t>& slotOfIndex) {
+    clear();
+    if (!result.isComplete()) {
+        return false;
+    }
+
+    for (const auto& issue : result.issues()) {
+        if (issue.entityIndex >= slotOfIndex.size()) {
+            clear();
+            return false;  // Result is not of this document
+        }
+        const uint32_t slot = slotOfIndex[issue.entityIndex];
+
+        if (GeometryValidator::isPairIssue(issue.type)) {
+            if (issue.relatedEntityIndex >= slotOfIndex.size()) {
+                clear();
+                return false;
+            }
+            addRelation(slot, slotOfIndex[issue.relatedEntityIndex], issue.type, issue.location);
+        } else if (GeometryValidator::isContourIssue(issue.type)) {
+            ContourIssue contour{issue, {}};
+            for (size_t index : result.contourOf(issue)) {
+                if (index >= slotOfIndex.size()) {
+                    clear();
+                    return false;
+                }
+                contour.members.push_back(slotOfIndex[index]);
+            }
+            contourIssues_.push_back(std::move(contour));
+        } else {
+            entityIssues_[slot].push_back(issue);
+        }
+    }
+
+    hasBaseline_ = true;
+    return true;
+}
+
+void IncrementalValidation::markDirty(uint32_t slot,
+                                      const std::vector<Geometry::Point2D>& previousEndpoints) {
+    if (hasBaseline_ && dirty_.insert(slot).second && !previousEndpoints.empty()) {
+        previousEndpoints_[slot] = previousEndpoints;
+    }
+}
+
+std::vector<Geometry::Point2D> IncrementalValidation::previousEndpoints() const {
+    std::vector<Geometry::Point2D> points;
+    for (const auto& [slot, endpoints] : previousEndpoints_) {
+        points.insert(points.end(), endpoints.begin(), endpoints.end());
+    }
+    return points;
+}
+
+void IncrementalValidation::clearDirty() {
+    dirty_.clear();
+    previousEndpoints_.clear();
+}
+
+void IncrementalValidation::setLoopSlots(const std::vector<uint32_t>& loopSlots) {
+    loopSlots_ = std::unordered_set<uint32_t>(loopSlots.begin(), loopSlots.end());
+}
+
+std::vector<uint32_t> IncrementalValidation::dirtySlots() const {
+    std::vector<uint32_t> slots(dirty_.begin(), dirty_.end());
+    std::sort(slots.begin(), slots.end());
+    return slots;
+}
+
+void IncrementalValidation::forget(uint32_t slot) {
+    entityIssues_.erase(slot);
+
+    auto it = relations_.find(slot);
+    if (it == relations_.end()) {
+        return;
+    }
+
+    // Remove the mirrored entries on the other side of each relation
+    for (const auto& relation : it->second) {
+        auto other = relations_.find(relation.other);
+        if (other == relations_.end()) {
+            continue;
+        }
+        auto& list = other->second;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [slot](const Relation& r) { return r.other == slot; }),
+                   list.end());
+        if (list.empty()) {
+            relations_.erase(other);
+        }
+    }
+    relations_.erase(slot);
+}
+
+void IncrementalValidation::setEntityIssues(uint32_t slot, std::vector<GeometryIssue> issues) {
+    if (issues.empty()) {
+        entityIssues_.erase(slot);
+    } else {
+        entityIssues_[slot] = std::move(issues);
+    }
+}
+
+void IncrementalValidation::addRelation(uint32_t lower, uint32_t higher, GeometryIssueType type,
+                                        const std::optional<Geometry::Point2D>& location) {
+    relations_[lower].push_back({higher, type, true, location});
+    relations_[higher].push_back({lower, type, false, location});
+}
+
+ValidationResult IncrementalValidation::assemble(
+    const std::function<size_t(uint32_t)>& indexOf,
+    Geometry::HandleTable handles) const {
+    ValidationResult result;
+    result.isValid = true;
+    result.handles = std::move(handles);
+
+    // Entity checks, by entity index (order within an entity is preserved)
+    std::vector<std::pair<size_t, uint32_t>> checked;
+    checked.reserve(entityIssues_.size());
+    for (const auto& [slot, issues] : entityIssues_) {
+        const size_t index = indexOf(slot);
+        if (index != NO_INDEX) {
+            checked.emplace_back(index, slot);
+        }
+    }
+    std::sort(checked.begin(), checked.end());
+
+    for (const auto& [index, slot] : checked) {
+        for (const auto& issue : entityIssues_.at(slot)) {
+            GeometryIssue patched = issue;
+            patched.entityIndex = index;
+            result.add(patched);
+        }
+    }
+
+    // Pairwise issues, duplicates before intersections (rule order), then
+    // by (lower, higher); each pair is taken from its lower side
+    struct Pair {
+        bool intersection;
+        size_t first;
+        size_t second;
+        GeometryIssueType type;
+        std::optional<Geometry::Point2D> location;
+        bool operator<(const Pair& other) const {
+            if (intersection != other.intersection) return !intersection;
+            return first != other.first ? first < other.first : second < other.second;
+        }
+    };
+    std::vector<Pair> pairs;
+    for (const auto& [slot, relations] : relations_) {
+        for (const auto& relation : relations) {
+            if (!relation.lower) {
+                continue;
+            }
+            const size_t first = indexOf(slot);
+            const size_t second = indexOf(relation.other);
+            if (first != NO_INDEX && second != NO_INDEX) {
+                pairs.push_back({relation.type == GeometryIssueType::SelfIntersection,
+                                 first, second, relation.type, relation.location});
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    for (const auto& pair : pairs) {
+        GeometryIssue issue(pair.type, pair.first, pair.second);
+        issue.location = pair.location;
+        result.add(issue);
+    }
+
+    // Contour issues, by lowest entity index
+    std::vector<std::pair<size_t, const ContourIssue*>> contours;
+    for (const auto& contour : contourIssues_) {
+        size_t lowest = NO_INDEX;
+        for (uint32_t slot : contour.members) {
+            lowest = std::min(lowest, indexOf(slot));
+        }
+        contours.emplace_back(lowest, &contour);
+    }
+    std::sort(contours.begin(), contours.end());
+
+    for (const auto& [lowest, contour] : contours) {
+        GeometryIssue patched = contour->issue;
+        std::vector<size_t> members;
+        for (uint32_t slot : contour->members) {
+            members.push_back(indexOf(slot));
+        }
+        std::sort(members.begin(), members.end());
+        patched.entityIndex = lowest;
+        result.setContour(patched, members);
+        result.add(patched);
+    }
+
+    for (const auto& issue : result.issues()) {
+        if (GeometryValidator::isBlockingIssue(issue.type)) {
+            result.isValid = false;
+            break;
+        }
+    }
+    result.indexIssues();
+    return result;
+}
+
+} // namespace Model
+} // namespace OwnCAD
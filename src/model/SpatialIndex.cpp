@@ -0,0 +1,611 @@
+#include "model/SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace OwnCAD {
+namespace Model {
+
+using namespace OwnCAD::Geometry;
+
+namespace {
+
+// Cell size used until there are enough entities to measure (world units)
+constexpr double DEFAULT_CELL_SIZE = 10.0;
+
+// Entities touching more cells than this go to the oversized list
+constexpr int64_t MAX_CELLS_PER_ENTRY = 64;
+
+// Entity count that triggers the first adaptive re-bucketing
+constexpr size_t INITIAL_REBUILD_THRESHOLD = 64;
+
+// Upper bound on grid resolution across the document extent
+constexpr double MAX_GRID_DIMENSION = 65536.0;
+
+// Keeps cell coordinates (and ring arithmetic) far from int64 overflow
+constexpr double MAX_CELL_COORD = 1.0e15;
+
+bool sameBox(const BoundingBox& a, const BoundingBox& b) noexcept {
+    return a.minX() == b.minX() && a.minY() == b.minY() &&
+           a.maxX() == b.maxX() && a.maxY() == b.maxY();
+}
+
+std::vector<std::string> sortedUnique(std::vector<std::string> handles) {
+    std::sort(handles.begin(), handles.end());
+    handles.erase(std::unique(handles.begin(), handles.end()), handles.end());
+    return handles;
+}
+
+double distanceToBox(const Point2D& point, const BoundingBox& box) noexcept {
+    const double dx = std::max({box.minX() - point.x(), 0.0, point.x() - box.maxX()});
+    const double dy = std::max({box.minY() - point.y(), 0.0, point.y() - box.maxY()});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+SpatialIndex::SpatialIndex()
+    : boundsLeaves_(0)
+    , cellSize_(DEFAULT_CELL_SIZE)
+    , rebuildThreshold_(INITIAL_REBUILD_THRESHOLD) {
+}
+
+void SpatialIndex::clear() {
+    entries_.clear();
+    freeSlots_.clear();
+    slotByHandle_.clear();
+    slotByKey_.clear();
+    cells_.clear();
+    oversized_.clear();
+    boundsTree_.clear();
+    boundsLeaves_ = 0;
+    cellSize_ = DEFAULT_CELL_SIZE;
+    rebuildThreshold_ = INITIAL_REBUILD_THRESHOLD;
+}
+
+size_t SpatialIndex::CellKeyHash::operator()(const CellKey& key) const noexcept {
+    const uint64_t h = static_cast<uint64_t>(key.x) * 73856093ULL ^
+                       static_cast<uint64_t>(key.y) * 19349663ULL;
+    return static_cast<size_t>(h);
+}
+
+BoundingBox SpatialIndex::boundsOf(const Import::GeometryEntity& entity) noexcept {
+    return std::visit([](auto&& geom) -> BoundingBox {
+        using T = std::decay_t<decltype(geom)>;
+        if constexpr (std::is_same_v<T, Point2D>) {
+            return BoundingBox::fromPoints(geom, geom);
+        } else {
+            return geom.boundingBox();
+        }
+    }, entity);
+}
+
+// ============================================================================
+// MODIFICATION
+// ============================================================================
+
+bool SpatialIndex::insert(const std::string& handle, const BoundingBox& box, Key key) {
+    if (!box.isValid() || (key != NO_KEY && findSlot(key) != entries_.size())) {
+        return false;
+    }
+
+    size_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = entries_.size();
+        entries_.emplace_back();
+    }
+
+    Entry& entry = entries_[slot];
+    entry.handle = handle;
+    entry.key = key;
+    entry.box = box;
+    entry.live = true;
+    slotByHandle_.emplace(handle, slot);
+    if (key != NO_KEY) {
+        if (key >= slotByKey_.size()) {
+            slotByKey_.resize(static_cast<size_t>(key) + 1, SIZE_MAX);
+        }
+        slotByKey_[key] = slot;
+    }
+
+    placeEntry(slot);
+    setBoundsLeaf(slot);
+
+    if (slotByHandle_.size() > rebuildThreshold_) {
+        rebuild();
+    }
+    return true;
+}
+
+bool SpatialIndex::update(const std::string& handle,
+                          const BoundingBox& oldBox,
+                          const BoundingBox& newBox) {
+    if (!newBox.isValid()) {
+        return false;
+    }
+
+    return updateSlot(findSlot(handle, oldBox), newBox);
+}
+
+bool SpatialIndex::update(Key key, const BoundingBox& newBox) {
+    if (!newBox.isValid()) {
+        return false;
+    }
+    return updateSlot(findSlot(key), newBox);
+}
+
+bool SpatialIndex::updateSlot(size_t slot, const BoundingBox& newBox) {
+    if (slot == entries_.size()) {
+        return false;
+    }
+
+    unplaceEntry(slot);
+    entries_[slot].box = newBox;
+    placeEntry(slot);
+    setBoundsLeaf(slot);
+    return true;
+}
+
+bool SpatialIndex::remove(const std::string& handle, const BoundingBox& box) {
+    return removeSlot(findSlot(handle, box));
+}
+
+bool SpatialIndex::remove(Key key) {
+    return removeSlot(findSlot(key));
+}
+
+bool SpatialIndex::removeSlot(size_t slot) {
+    if (slot == entries_.size()) {
+        return false;
+    }
+
+    const Entry& entry = entries_[slot];
+    auto range = slotByHandle_.equal_range(entry.handle);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == slot) {
+            slotByHandle_.erase(it);
+            break;
+        }
+    }
+    if (entry.key != NO_KEY) {
+        slotByKey_[entry.key] = SIZE_MAX;
+    }
+
+    unplaceEntry(slot);
+    entries_[slot] = Entry();
+    setBoundsLeaf(slot);
+    freeSlots_.push_back(slot);
+    return true;
+}
+
+bool SpatialIndex::contains(const std::string& handle) const {
+    return slotByHandle_.count(handle) != 0;
+}
+
+size_t SpatialIndex::findSlot(const std::string& handle, const BoundingBox& box) const {
+    // Prefer the entry with a matching box; any entry of the handle otherwise
+    size_t fallback = entries_.size();
+    auto range = slotByHandle_.equal_range(handle);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (sameBox(entries_[it->second].box, box)) {
+            return it->second;
+        }
+        fallback = it->second;
+    }
+    return fallback;
+}
+
+size_t SpatialIndex::findSlot(Key key) const noexcept {
+    if (key >= slotByKey_.size() || slotByKey_[key] == SIZE_MAX) {
+        return entries_.size();
+    }
+    return slotByKey_[key];
+}
+
+BoundingBox SpatialIndex::bounds() const noexcept {
+    BoundingBox all = gridBounds();
+    for (size_t slot : oversized_) {
+        all = all.merge(entries_[slot].box);
+    }
+    return all;
+}
+
+BoundingBox SpatialIndex::gridBounds() const noexcept {
+    if (boundsLeaves_ == 0) {
+        return BoundingBox();
+    }
+    return boundsTree_[1];
+}
+
+// ============================================================================
+// GRID MAINTENANCE
+// ============================================================================
+
+int64_t SpatialIndex::cellCoord(double value) const noexcept {
+    const double cell = std::floor(value / cellSize_);
+    return static_cast<int64_t>(std::clamp(cell, -MAX_CELL_COORD, MAX_CELL_COORD));
+}
+
+void SpatialIndex::placeEntry(size_t slot) {
+    Entry& entry = entries_[slot];
+    entry.cellMinX = cellCoord(entry.box.minX());
+    entry.cellMinY = cellCoord(entry.box.minY());
+    entry.cellMaxX = cellCoord(entry.box.maxX());
+    entry.cellMaxY = cellCoord(entry.box.maxY());
+
+    const int64_t spanX = entry.cellMaxX - entry.cellMinX + 1;
+    const int64_t spanY = entry.cellMaxY - entry.cellMinY + 1;
+    entry.oversized = spanX > MAX_CELLS_PER_ENTRY || spanY > MAX_CELLS_PER_ENTRY ||
+                      spanX * spanY > MAX_CELLS_PER_ENTRY;
+
+    if (entry.oversized) {
+        oversized_.push_back(slot);
+        return;
+    }
+
+    for (int64_t x = entry.cellMinX; x <= entry.cellMaxX; ++x) {
+        for (int64_t y = entry.cellMinY; y <= entry.cellMaxY; ++y) {
+            cells_[CellKey{x, y}].push_back(slot);
+        }
+    }
+}
+
+void SpatialIndex::unplaceEntry(size_t slot) {
+    const Entry& entry = entries_[slot];
+
+    auto eraseSlot = [slot](std::vector<size_t>& slots) {
+        auto it = std::find(slots.begin(), slots.end(), slot);
+        if (it != slots.end()) {
+            *it = slots.back();
+            slots.pop_back();
+        }
+    };
+
+    if (entry.oversized) {
+        eraseSlot(oversized_);
+        return;
+    }
+
+    for (int64_t x = entry.cellMinX; x <= entry.cellMaxX; ++x) {
+        for (int64_t y = entry.cellMinY; y <= entry.cellMaxY; ++y) {
+            auto cell = cells_.find(CellKey{x, y});
+            if (cell == cells_.end()) {
+                continue;
+            }
+            eraseSlot(cell->second);
+            if (cell->second.empty()) {
+                cells_.erase(cell);
+            }
+        }
+    }
+}
+
+BoundingBox SpatialIndex::gridBox(size_t slot) const noexcept {
+    const Entry& entry = entries_[slot];
+    return (entry.live && !entry.oversized) ? entry.box : BoundingBox();
+}
+
+void SpatialIndex::setBoundsLeaf(size_t slot) {
+    if (slot >= boundsLeaves_) {
+        // Grow to the next power of two and rebuild the tree from entries
+        size_t leaves = std::max<size_t>(boundsLeaves_, 1);
+        while (leaves <= slot) {
+            leaves *= 2;
+        }
+        buildBoundsTree(leaves);
+        return;
+    }
+
+    size_t node = boundsLeaves_ + slot;
+    boundsTree_[node] = gridBox(slot);
+    for (node /= 2; node >= 1; node /= 2) {
+        boundsTree_[node] = boundsTree_[2 * node].merge(boundsTree_[2 * node + 1]);
+    }
+}
+
+void SpatialIndex::buildBoundsTree(size_t leaves) {
+    boundsLeaves_ = leaves;
+    boundsTree_.assign(2 * leaves, BoundingBox());
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        boundsTree_[leaves + i] = gridBox(i);
+    }
+    for (size_t node = leaves - 1; node >= 1; --node) {
+        boundsTree_[node] = boundsTree_[2 * node].merge(boundsTree_[2 * node + 1]);
+    }
+}
+
+void SpatialIndex::rebuild() {
+    // Size cells for the typical entity: twice the median extent, but never
+    // finer than the document extent allows.
+    std::vector<double> extents;
+    extents.reserve(slotByHandle_.size());
+    for (const auto& entry : entries_) {
+        if (entry.live) {
+            extents.push_back(std::max(entry.box.width(), entry.box.height()));
+        }
+    }
+
+    const BoundingBox all = bounds();
+    const double span = all.isValid() ? std::max(all.width(), all.height()) : 0.0;
+
+    double cellSize = DEFAULT_CELL_SIZE;
+    if (!extents.empty()) {
+        const size_t mid = extents.size() / 2;
+        std::nth_element(extents.begin(), extents.begin() + mid, extents.end());
+        cellSize = std::max(2.0 * extents[mid], span / MAX_GRID_DIMENSION);
+        if (!(cellSize > 0.0)) {
+            // Only points (or coincident boxes)
+            cellSize = (span > 0.0)
+                ? span / std::sqrt(static_cast<double>(extents.size()))
+                : DEFAULT_CELL_SIZE;
+        }
+    }
+    cellSize_ = cellSize;
+
+    cells_.clear();
+    oversized_.clear();
+    for (size_t slot = 0; slot < entries_.size(); ++slot) {
+        if (entries_[slot].live) {
+            placeEntry(slot);
+        }
+    }
+    if (boundsLeaves_ > 0) {
+        buildBoundsTree(boundsLeaves_);   // Entries may have changed lists
+    }
+
+    rebuildThreshold_ = std::max(INITIAL_REBUILD_THRESHOLD, 4 * slotByHandle_.size());
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+template <typename Visitor>
+void SpatialIndex::forEachInWindow(const BoundingBox& window, Visitor&& visit) const {
+    if (!window.isValid() || empty()) {
+        return;
+    }
+
+    const int64_t minX = cellCoord(window.minX());
+    const int64_t minY = cellCoord(window.minY());
+    const int64_t maxX = cellCoord(window.maxX());
+    const int64_t maxY = cellCoord(window.maxY());
+
+    auto visitCell = [&](const CellKey& key, const std::vector<size_t>& slots) {
+        for (size_t slot : slots) {
+            const Entry& entry = entries_[slot];
+            if (!window.intersects(entry.box)) {
+                continue;
+            }
+            // Report once: only from the cell holding the lower-left corner
+            // of the overlap, which both entry and window cover.
+            if (cellCoord(std::max(entry.box.minX(), window.minX())) != key.x ||
+                cellCoord(std::max(entry.box.minY(), window.minY())) != key.y) {
+                continue;
+            }
+            visit(slot);
+        }
+    };
+
+    const double windowCells = (static_cast<double>(maxX - minX) + 1.0) *
+                               (static_cast<double>(maxY - minY) + 1.0);
+    if (windowCells > static_cast<double>(cells_.size())) {
+        // Window larger than the occupied grid: walk occupied cells instead
+        for (const auto& cell : cells_) {
+            const CellKey& key = cell.first;
+            if (key.x >= minX && key.x <= maxX && key.y >= minY && key.y <= maxY) {
+                visitCell(key, cell.second);
+            }
+        }
+    } else {
+        for (int64_t x = minX; x <= maxX; ++x) {
+            for (int64_t y = minY; y <= maxY; ++y) {
+                auto cell = cells_.find(CellKey{x, y});
+                if (cell != cells_.end()) {
+                    visitCell(cell->first, cell->second);
+                }
+            }
+        }
+    }
+
+    for (size_t slot : oversized_) {
+        if (window.intersects(entries_[slot].box)) {
+            visit(slot);
+        }
+    }
+}
+
+std::vector<std::string> SpatialIndex::queryWindow(const BoundingBox& window) const {
+    std::vector<std::string> handles;
+    forEachInWindow(window, [&](size_t slot) {
+        handles.push_back(entries_[slot].handle);
+    });
+    return sortedUnique(std::move(handles));
+}
+
+std::vector<SpatialIndex::Key> SpatialIndex::queryWindowKeys(const BoundingBox& window) const {
+    std::vector<Key> keys;
+    forEachInWindow(window, [&](size_t slot) {
+        if (entries_[slot].key != NO_KEY) {
+            keys.push_back(entries_[slot].key);
+        }
+    });
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+std::vector<std::string> SpatialIndex::queryContained(const BoundingBox& window) const {
+    std::vector<std::string> handles;
+    forEachInWindow(window, [&](size_t slot) {
+        if (window.containsBox(entries_[slot].box)) {
+            handles.push_back(entries_[slot].handle);
+        }
+    });
+    return sortedUnique(std::move(handles));
+}
+
+std::vector<std::string> SpatialIndex::queryRadius(const Point2D& center, double radius) const {
+    std::vector<std::string> handles;
+    if (!(radius >= 0.0)) {
+        return handles;
+    }
+
+    const BoundingBox window = BoundingBox::fromPoints(
+        Point2D(center.x() - radius, center.y() - radius),
+        Point2D(center.x() + radius, center.y() + radius));
+
+    forEachInWindow(window, [&](size_t slot) {
+        if (distanceToBox(center, entries_[slot].box) <= radius) {
+            handles.push_back(entries_[slot].handle);
+        }
+    });
+    return sortedUnique(std::move(handles));
+}
+
+std::vector<std::string> SpatialIndex::queryNearest(const Point2D& point, size_t count) const {
+    std::vector<std::string> handles;
+    if (count == 0 || empty()) {
+        return handles;
+    }
+
+    // Max-heap of the best candidates so far: (distance, slot)
+    using Candidate = std::pair<double, size_t>;
+    auto closer = [this](const Candidate& a, const Candidate& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return entries_[a.second].handle < entries_[b.second].handle;
+    };
+    std::vector<Candidate> best;
+    best.reserve(count + 1);
+
+    auto consider = [&](size_t slot) {
+        const Candidate candidate{distanceToBox(point, entries_[slot].box), slot};
+        if (best.size() == count && !closer(candidate, best.front())) {
+            return;
+        }
+        // Entries spanning several cells are seen more than once, and
+        // entities sharing a handle count once (closest entity wins)
+        for (auto& existing : best) {
+            if (entries_[existing.second].handle != entries_[slot].handle) continue;
+            if (closer(candidate, existing)) {
+                existing = candidate;
+                std::make_heap(best.begin(), best.end(), closer);
+            }
+            return;
+        }
+        if (best.size() == count) {
+            std::pop_heap(best.begin(), best.end(), closer);
+            best.pop_back();
+        }
+        best.push_back(candidate);
+        std::push_heap(best.begin(), best.end(), closer);
+    };
+
+    for (size_t slot : oversized_) {
+        consider(slot);
+    }
+
+    // Visit grid cells in square rings around the query cell, clamped to the
+    // occupied cells. An entity not seen before ring r has its nearest box
+    // point at least (r - 1) cells away, so the walk ends once that is
+    // farther than the k-th best hit.
+    const BoundingBox grid = gridBounds();
+    if (grid.isValid()) {
+        const int64_t px = cellCoord(point.x());
+        const int64_t py = cellCoord(point.y());
+        const int64_t gridMinX = cellCoord(grid.minX());
+        const int64_t gridMinY = cellCoord(grid.minY());
+        const int64_t gridMaxX = cellCoord(grid.maxX());
+        const int64_t gridMaxY = cellCoord(grid.maxY());
+
+        const int64_t firstRing = std::max({int64_t(0), gridMinX - px, px - gridMaxX,
+                                            gridMinY - py, py - gridMaxY});
+        const int64_t lastRing = std::max({std::abs(px - gridMinX), std::abs(px - gridMaxX),
+                                           std::abs(py - gridMinY), std::abs(py - gridMaxY)});
+
+        auto finished = [&](int64_t ring) {
+            return best.size() == count &&
+                   best.front().first < static_cast<double>(ring - 1) * cellSize_;
+        };
+
+        // Cell lookups are bounded by the occupied cell count: once the rings
+        // have probed that many, the rest of the walk visits the occupied
+        // cells directly (sparse grids, or fewer handles than requested)
+        size_t probes = 0;
+        auto visitCell = [&](int64_t x, int64_t y) {
+            probes++;
+            auto cell = cells_.find(CellKey{x, y});
+            if (cell == cells_.end()) {
+                return;
+            }
+            for (size_t slot : cell->second) {
+                consider(slot);
+            }
+        };
+
+        int64_t ring = firstRing;
+        for (; ring <= lastRing && probes <= cells_.size(); ++ring) {
+            if (finished(ring)) {
+                ring = lastRing + 1;
+                break;
+            }
+
+            if (ring == 0) {
+                visitCell(px, py);
+                continue;
+            }
+
+            const int64_t xLo = std::max(px - ring, gridMinX);
+            const int64_t xHi = std::min(px + ring, gridMaxX);
+            for (int64_t y : {py - ring, py + ring}) {
+                if (y < gridMinY || y > gridMaxY) continue;
+                for (int64_t x = xLo; x <= xHi; ++x) {
+                    visitCell(x, y);
+                }
+            }
+            const int64_t yLo = std::max(py - ring + 1, gridMinY);
+            const int64_t yHi = std::min(py + ring - 1, gridMaxY);
+            for (int64_t x : {px - ring, px + ring}) {
+                if (x < gridMinX || x > gridMaxX) continue;
+                for (int64_t y = yLo; y <= yHi; ++y) {
+                    visitCell(x, y);
+                }
+            }
+        }
+
+        if (ring <= lastRing) {
+            std::vector<std::pair<int64_t, const std::vector<size_t>*>> remaining;
+            for (const auto& cell : cells_) {
+                const int64_t cellRing = std::max(std::abs(cell.first.x - px), std::abs(cell.first.y - py));
+                if (cellRing >= ring) {
+                    remaining.emplace_back(cellRing, &cell.second);
+                }
+            }
+            std::sort(remaining.begin(), remaining.end(),
+                      [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (const auto& cell : remaining) {
+                if (finished(cell.first)) {
+                    break;
+                }
+                for (size_t slot : *cell.second) {
+                    consider(slot);
+                }
+            }
+        }
+    }
+
+    std::sort(best.begin(), best.end(), closer);
+    handles.reserve(best.size());
+    for (const auto& candidate : best) {
+        handles.push_back(entries_[candidate.second].handle);
+    }
+    return handles;
+}
+
+} // namespace Model
+} // namespace OwnCAD
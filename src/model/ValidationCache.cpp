@@ -0,0 +1,358 @@
+#include "model/ValidationCache.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace OwnCAD {
+namespace Model {
+
+using namespace OwnCAD::Geometry;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr uint32_t CACHE_MAGIC = 0x3143564F;   // "OVC1" in little-endian files
+constexpr uint32_t CACHE_FORMAT_VERSION = 1;
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+class Writer {
+public:
+    template <typename T>
+    void put(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "plain values only");
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer_.append(bytes, sizeof(T));
+    }
+
+    void putPoint(const std::optional<Point2D>& point) {
+        put<uint8_t>(point.has_value() ? 1 : 0);
+        put<double>(point ? point->x() : 0.0);
+        put<double>(point ? point->y() : 0.0);
+    }
+
+    std::string& buffer() noexcept { return buffer_; }
+
+private:
+    std::string buffer_;
+};
+
+class Reader {
+public:
+    Reader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (size_ - offset_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return true;
+    }
+
+    bool getPoint(std::optional<Point2D>& point) {
+        uint8_t present = 0;
+        double x = 0.0;
+        double y = 0.0;
+        if (!get(present) || !get(x) || !get(y)) {
+            return false;
+        }
+        point.reset();
+        if (present != 0) {
+            point = Point2D(x, y);
+        }
+        return true;
+    }
+
+    size_t remaining() const noexcept { return size_ - offset_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t offset_ = 0;
+};
+
+void putStatistics(Writer& out, const DocumentStatistics& stats) {
+    for (size_t value : {stats.dxfEntitiesImported, stats.totalSegments, stats.totalLines,
+                         stats.totalArcs, stats.validEntities, stats.invalidEntities,
+                         stats.zeroLengthLines, stats.zeroRadiusArcs, stats.numericallyUnstable}) {
+        out.put<uint64_t>(value);
+    }
+}
+
+bool getStatistics(Reader& in, DocumentStatistics& stats) {
+    size_t* fields[] = {&stats.dxfEntitiesImported, &stats.totalSegments, &stats.totalLines,
+                        &stats.totalArcs, &stats.validEntities, &stats.invalidEntities,
+                        &stats.zeroLengthLines, &stats.zeroRadiusArcs, &stats.numericallyUnstable};
+    for (size_t* field : fields) {
+        uint64_t value = 0;
+        if (!in.get(value)) {
+            return false;
+        }
+        *field = static_cast<size_t>(value);
+    }
+    return true;
+}
+
+ContentHash digestOf(const char* data, size_t size) {
+    ContentHasher hasher;
+    hasher.addBytes(data, size);
+    return hasher.finish();
+}
+
+/**
+ * @brief Decode an entry; nullopt if anything does not check out
+ */
+std::optional<CachedValidation> decode(const std::string& bytes, const ContentHash& key,
+                                       size_t entityCount) {
+    if (bytes.size() < 2 * sizeof(uint64_t)) {
+        return std::nullopt;
+    }
+    const size_t payloadSize = bytes.size() - 2 * sizeof(uint64_t);
+    Reader trailer(bytes.data() + payloadSize, 2 * sizeof(uint64_t));
+    ContentHash stored;
+    trailer.get(stored.high);
+    trailer.get(stored.low);
+    if (stored != digestOf(bytes.data(), payloadSize)) {
+        return std::nullopt;  // Truncated or damaged
+    }
+
+    Reader in(bytes.data(), payloadSize);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    ContentHash entryKey;
+    uint64_t entities = 0;
+    if (!in.get(magic) || magic != CACHE_MAGIC || !in.get(version) || version != CACHE_FORMAT_VERSION ||
+        !in.get(entryKey.high) || !in.get(entryKey.low) || entryKey != key ||
+        !in.get(entities) || entities != entityCount) {
+        return std::nullopt;
+    }
+
+    CachedValidation entry;
+    uint8_t isValid = 0;
+    uint64_t issueCount = 0;
+    if (!getStatistics(in, entry.statistics) || !in.get(isValid) || !in.get(issueCount) ||
+        issueCount > in.remaining()) {
+        return std::nullopt;
+    }
+    entry.result.isValid = isValid != 0;
+    std::vector<GeometryIssue>& issues = entry.result.editIssues();
+    issues.resize(static_cast<size_t>(issueCount));
+    for (GeometryIssue& issue : issues) {
+        uint32_t type = 0;
+        uint8_t arc = 0;
+        uint64_t index = 0;
+        uint64_t related = 0;
+        if (!in.get(type) || type >= ISSUE_TYPE_COUNT || !in.get(arc) ||
+            !in.get(issue.contourBegin) || !in.get(issue.contourSize) ||
+            !in.get(index) || index >= entityCount || !in.get(related) || related >= entityCount ||
+            !in.get(issue.value) || !in.get(issue.limit) ||
+            !in.getPoint(issue.location) || !in.getPoint(issue.relatedLocation)) {
+            return std::nullopt;
+        }
+        issue.type = static_cast<GeometryIssueType>(type);
+        issue.arc = arc != 0;
+        issue.entityIndex = static_cast<size_t>(index);
+        issue.relatedEntityIndex = static_cast<size_t>(related);
+    }
+
+    uint64_t memberCount = 0;
+    if (!in.get(memberCount) || memberCount > in.remaining()) {
+        return std::nullopt;
+    }
+    entry.result.contourMembers.resize(static_cast<size_t>(memberCount));
+    for (size_t& member : entry.result.contourMembers) {
+        uint64_t value = 0;
+        if (!in.get(value) || value >= entityCount) {
+            return std::nullopt;
+        }
+        member = static_cast<size_t>(value);
+    }
+    for (const GeometryIssue& issue : entry.result.issues()) {
+        if (uint64_t(issue.contourBegin) + issue.contourSize > memberCount) {
+            return std::nullopt;
+        }
+    }
+    if (in.remaining() != 0) {
+        return std::nullopt;
+    }
+
+    entry.result.indexIssues();
+    return entry;
+}
+
+} // namespace
+
+// ============================================================================
+// VALIDATION CACHE
+// ============================================================================
+
+ValidationCache::ValidationCache(std::string directory, uint64_t maxBytes)
+    : directory_(std::move(directory))
+    , maxBytes_(maxBytes) {
+}
+
+std::string ValidationCache::pathOf(const ContentHash& key) const {
+    return (fs::path(directory_) / (key.toHex() + FILE_EXTENSION)).string();
+}
+
+std::optional<CachedValidation> ValidationCache::find(const ContentHash& key, size_t entityCount) {
+    const std::string path = pathOf(key);
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    auto entry = decode(bytes, key, entityCount);
+    std::error_code error;
+    if (!entry) {
+        fs::remove(path, error);  // Unusable; do not read it again
+        return std::nullopt;
+    }
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);  // Most recently used
+    return entry;
+}
+
+bool ValidationCache::store(const ContentHash& key, const ValidationResult& result,
+                            const DocumentStatistics& statistics, size_t entityCount) {
+    if (!result.isComplete() || maxBytes_ == 0) {
+        return false;
+    }
+
+    Writer out;
+    out.put<uint32_t>(CACHE_MAGIC);
+    out.put<uint32_t>(CACHE_FORMAT_VERSION);
+    out.put<uint64_t>(key.high);
+    out.put<uint64_t>(key.low);
+    out.put<uint64_t>(entityCount);
+    putStatistics(out, statistics);
+    out.put<uint8_t>(result.isValid ? 1 : 0);
+    out.put<uint64_t>(result.issues().size());
+    for (const GeometryIssue& issue : result.issues()) {
+        out.put<uint32_t>(static_cast<uint32_t>(issue.type));
+        out.put<uint8_t>(issue.arc ? 1 : 0);
+        out.put<uint32_t>(issue.contourBegin);
+        out.put<uint32_t>(issue.contourSize);
+        out.put<uint64_t>(issue.entityIndex);
+        out.put<uint64_t>(issue.relatedEntityIndex);
+        out.put<double>(issue.value);
+        out.put<double>(issue.limit);
+        out.putPoint(issue.location);
+        out.putPoint(issue.relatedLocation);
+    }
+    out.put<uint64_t>(result.contourMembers.size());
+    for (size_t member : result.contourMembers) {
+        out.put<uint64_t>(member);
+    }
+    const ContentHash digest = digestOf(out.buffer().data(), out.buffer().size());
+    out.put<uint64_t>(digest.high);
+    out.put<uint64_t>(digest.low);
+
+    if (out.buffer().size() > maxBytes_) {
+        return false;  // Would evict everything, itself included
+    }
+
+    std::error_code error;
+    fs::create_directories(directory_, error);
+
+    // Write aside and rename, so a reader never sees half an entry
+    const std::string path = pathOf(key);
+    const std::string partial = path + ".tmp";
+    {
+        std::ofstream file(partial, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+        file.write(out.buffer().data(), static_cast<std::streamsize>(out.buffer().size()));
+        if (!file) {
+            file.close();
+            fs::remove(partial, error);
+            return false;
+        }
+    }
+    fs::rename(partial, path, error);
+    if (error) {
+        fs::remove(partial, error);
+        return false;
+    }
+
+    evict(path);
+    return true;
+}
+
+void ValidationCache::clear() {
+    std::error_code error;
+    for (fs::directory_iterator it(directory_, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() == FILE_EXTENSION) {
+            std::error_code removeError;
+            fs::remove(it->path(), removeError);
+        }
+    }
+}
+
+uint64_t ValidationCache::totalBytes() const {
+    uint64_t total = 0;
+    std::error_code error;
+    for (fs::directory_iterator it(directory_, error), end; !error && it != end; it.increment(error)) {
+        std::error_code sizeError;
+        const auto size = it->file_size(sizeError);
+        if (!sizeError && it->path().extension() == FILE_EXTENSION) {
+            total += size;
+        }
+    }
+    return total;
+}
+
+void ValidationCache::evict(const std::string& keep) {
+    struct Entry {
+        fs::path path;
+        fs::file_time_type used;
+        uint64_t size;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (fs::directory_iterator it(directory_, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() != FILE_EXTENSION) {
+            continue;
+        }
+        std::error_code statError;
+        const uint64_t size = it->file_size(statError);
+        const auto used = it->last_write_time(statError);
+        if (!statError) {
+            entries.push_back({it->path(), used, size});
+            total += size;
+        }
+    }
+    if (total <= maxBytes_) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.used < b.used;
+    });
+    for (const Entry& entry : entries) {
+        if (total <= maxBytes_) {
+            break;
+        }
+        if (entry.path == fs::path(keep)) {
+            continue;  // Just written; file times may be too coarse to order it last
+        }
+        std::error_code removeError;
+        if (fs::remove(entry.path, removeError)) {
+            total -= entry.size;
+        }
+    }
+}
+
+} // namespace Model
+} // namespace OwnCAD
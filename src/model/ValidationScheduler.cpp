@@ -0,0 +1,160 @@
+#include "model/ValidationScheduler.h"
+#include "model/DocumentModel.h"
+#include <QMetaObject>
+
+namespace OwnCAD {
+namespace Model {
+
+using Geometry::ValidationResult;
+
+ValidationScheduler::ValidationScheduler(DocumentModel* document, QObject* parent)
+    : QObject(parent)
+    , m_document(document)
+{
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(DEFAULT_DEBOUNCE_MS);
+    connect(&m_debounceTimer, &QTimer::timeout, this, &ValidationScheduler::startRun);
+}
+
+ValidationScheduler::~ValidationScheduler()
+{
+    // The worker only touches its snapshot; its queued result is dropped
+    // together with this object's pending events. Stop it first so closing
+    // does not wait for a full run (through the run's own token: the
+    // document may already be gone).
+    m_generation++;
+    m_runToken.cancel();
+    if (m_worker.valid()) {
+        m_worker.wait();
+    }
+}
+
+void ValidationScheduler::requestValidation()
+{
+    m_generation++;
+    if (m_running) {
+        m_document->cancelValidation();  // Its result would be discarded anyway
+    }
+    m_debounceTimer.start();  // Restart: a burst of requests collapses into one run
+}
+
+void ValidationScheduler::validateNow()
+{
+    m_generation++;
+    m_debounceTimer.stop();
+    if (m_running) {
+        m_document->cancelValidation();
+    }
+    startRun();
+}
+
+void ValidationScheduler::cancel()
+{
+    const bool active = m_running || isPending();
+
+    m_generation++;  // In-flight result no longer matches and is discarded
+    m_debounceTimer.stop();
+    m_rerunPending = false;
+    if (m_running) {
+        m_document->cancelValidation();
+    }
+
+    if (active) {
+        emit validationCancelled();
+    }
+}
+
+void ValidationScheduler::setDebounceInterval(int milliseconds)
+{
+    m_debounceTimer.setInterval(milliseconds < 0 ? 0 : milliseconds);
+}
+
+void ValidationScheduler::startRun()
+{
+    if (!m_document) {
+        return;
+    }
+
+    if (m_running) {
+        // One worker at a time; rerun on the newest state when it finishes
+        m_rerunPending = true;
+        return;
+    }
+
+    const uint64_t generation = m_generation;
+
+    // Small edits are patched into the previous result on this thread
+    if (m_document->validateIncremental()) {
+        m_runsStarted++;
+        emit validationStarted(generation);
+        emit validationFinished(generation);
+        return;
+    }
+
+    DocumentSnapshot snapshot = m_document->snapshot();
+
+    // Forward progress to this thread, dropping reports from superseded runs
+    Geometry::ValidationControl control = m_document->beginValidation();
+    m_runToken = control.cancellation;
+    control.progress = [this, generation, forward = control.progress](
+                           const Geometry::ValidationProgress& progress) {
+        if (forward) {
+            forward(progress);
+        }
+        QMetaObject::invokeMethod(this,
+            [this, generation, progress]() {
+                if (generation == m_generation && m_running) {
+                    emit validationProgress(QString::fromUtf8(progress.rule),
+                                            progress.processed, progress.total);
+                }
+            },
+            Qt::QueuedConnection);
+    };
+
+    m_running = true;
+    m_runsStarted++;
+    emit validationStarted(generation);
+
+    m_worker = std::async(std::launch::async,
+        [this, generation, snapshot = std::move(snapshot), control = std::move(control)]() {
+            ValidationResult result = DocumentModel::validateSnapshot(snapshot, control);
+
+            // Marshal back to the scheduler's thread
+            QMetaObject::invokeMethod(this,
+                [this, generation, version = snapshot.version(), result = std::move(result)]() {
+                    onRunFinished(generation, version, result);
+                },
+                Qt::QueuedConnection);
+        });
+}
+
+void ValidationScheduler::onRunFinished(uint64_t generation, uint64_t version,
+                                        const ValidationResult& result)
+{
+    m_running = false;
+    if (m_worker.valid()) {
+        m_worker.get();  // Worker is past its last statement; just joins
+    }
+
+    const bool current = generation == m_generation;
+    if (current && !result.cancelled && version == m_document->version()) {
+        m_document->finalizeValidation(result, version);
+        emit validationFinished(generation);
+        return;
+    }
+
+    // Superseded. A request still in its debounce window reruns when the
+    // timer fires; one that fired while running reruns now; a cancelled run
+    // stays cancelled. If the document changed without a request, rerun.
+    if (m_debounceTimer.isActive()) {
+        m_rerunPending = false;
+    } else if (m_rerunPending || (current && !result.cancelled)) {
+        m_rerunPending = false;
+        startRun();
+    } else if (current) {
+        emit validationCancelled();  // Cancelled through DocumentModel::cancelValidation()
+    }
+}
+
+} // namespace Model
+} // namespace OwnCAD
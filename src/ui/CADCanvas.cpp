@@ -9,6 +9,7 @@
 #include "geometry/BoundingBox.h"
 #include "geometry/GeometryMath.h"
 #include "import/DXFColors.h"
+#include "model/DocumentModel.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QPaintEvent>
@@ -17,7 +18,9 @@
 #include <QKeyEvent>
 #include <QToolTip>
 #include <QDebug>
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 #include <variant>
 
 namespace OwnCAD {
@@ -96,6 +99,12 @@ void Viewport::setViewportSize(int width, int height) {
     viewportHeight_ = height;
 }
 
+Geometry::BoundingBox Viewport::visibleBounds() const {
+    return Geometry::BoundingBox::fromPoints(
+        screenToWorld(QPointF(0.0, 0.0)),
+        screenToWorld(QPointF(viewportWidth_, viewportHeight_)));
+}
+
 // ============================================================================
 // SNAP MANAGER IMPLEMENTATION
 // ============================================================================
@@ -337,6 +346,7 @@ CADCanvas::~CADCanvas() {
 }
 
 void CADCanvas::setDocumentModel(Model::DocumentModel* model) {
+    documentModel_ = model;
     toolManager_->setDocumentModel(model);
 }
 
@@ -351,7 +361,11 @@ void CADCanvas::clearSelection() {
 }
 
 void CADCanvas::setEntities(const std::vector<Import::GeometryEntityWithMetadata>& entities) {
-    entities_ = entities;
+    setSnapshot(Model::DocumentSnapshot::fromEntities(entities));
+}
+
+void CADCanvas::setSnapshot(const Model::DocumentSnapshot& snapshot) {
+    entities_ = snapshot;
 
     // Count entity types for logging
     int lineCount = 0;
@@ -378,7 +392,7 @@ void CADCanvas::setEntities(const std::vector<Import::GeometryEntityWithMetadata
 }
 
 void CADCanvas::clear() {
-    entities_.clear();
+    entities_ = Model::DocumentSnapshot();
     update();
 }
 
@@ -407,11 +421,16 @@ bool CADCanvas::isSnapEnabled(SnapManager::SnapMode mode) const {
     return snapManager_.isSnapEnabled(mode);
 }
 
-void CADCanvas::setProblematicEntities(const std::set<std::string>& handles) {
-    problematicEntityHandles_ = handles;
+void CADCanvas::setProblematicEntities(std::unordered_set<std::string> handles) {
+    problematicEntityHandles_ = std::move(handles);
     update();  // Trigger repaint to show highlights
 }
 
+void CADCanvas::setIssueMarkers(std::vector<IssueMarker> markers) {
+    issueOverlay_.setMarkers(std::move(markers));
+    update();
+}
+
 void CADCanvas::resetView() {
     viewport_.reset();
     update();
@@ -427,32 +446,37 @@ void CADCanvas::zoomExtents() {
     // Calculate bounding box of all entities
     std::optional<Geometry::BoundingBox> totalBBox;
 
-    for (const auto& entityWithMeta : entities_) {
-        const auto& entity = entityWithMeta.entity;
-
-        Geometry::BoundingBox bbox;
-        if (std::holds_alternative<Geometry::Line2D>(entity)) {
-            bbox = std::get<Geometry::Line2D>(entity).boundingBox();
-        } else if (std::holds_alternative<Geometry::Arc2D>(entity)) {
-            bbox = std::get<Geometry::Arc2D>(entity).boundingBox();
-        } else if (std::holds_alternative<Geometry::Ellipse2D>(entity)) {
-            bbox = std::get<Geometry::Ellipse2D>(entity).boundingBox();
-        } else if (std::holds_alternative<Geometry::Point2D>(entity)) {
-            // Point has no area, create tiny bbox around it
-            const auto& pt = std::get<Geometry::Point2D>(entity);
-            bbox = Geometry::BoundingBox::fromPoints(pt, pt);
-        } else {
-            continue;  // Skip unknown types
-        }
+    if (usesDocumentIndex()) {
+        // Maintained incrementally by the document - no pass over entities
+        totalBBox = documentModel_->bounds();
+    } else {
+        for (const auto& entityWithMeta : entities_) {
+            const auto& entity = entityWithMeta.entity;
+
+            Geometry::BoundingBox bbox;
+            if (std::holds_alternative<Geometry::Line2D>(entity)) {
+                bbox = std::get<Geometry::Line2D>(entity).boundingBox();
+            } else if (std::holds_alternative<Geometry::Arc2D>(entity)) {
+                bbox = std::get<Geometry::Arc2D>(entity).boundingBox();
+            } else if (std::holds_alternative<Geometry::Ellipse2D>(entity)) {
+                bbox = std::get<Geometry::Ellipse2D>(entity).boundingBox();
+            } else if (std::holds_alternative<Geometry::Point2D>(entity)) {
+                // Point has no area, create tiny bbox around it
+                const auto& pt = std::get<Geometry::Point2D>(entity);
+                bbox = Geometry::BoundingBox::fromPoints(pt, pt);
+            } else {
+                continue;  // Skip unknown types
+            }
 
-        if (totalBBox) {
-            totalBBox = totalBBox->merge(bbox);
-        } else {
-            totalBBox = bbox;
+            if (totalBBox) {
+                totalBBox = totalBBox->merge(bbox);
+            } else {
+                totalBBox = bbox;
+            }
         }
     }
 
-    if (!totalBBox) {
+    if (!totalBBox || !totalBBox->isValid()) {
         resetView();
         return;
     }
@@ -503,6 +527,9 @@ void CADCanvas::paintEvent(QPaintEvent* event) {
     // Render all entities
     renderEntities(painter);
 
+    // Validation issues, clustered when zoomed out
+    renderIssueOverlay(painter);
+
     // Render selection visuals (bounding box and grip points)
     renderSelectionBoundingBox(painter);
     renderGripPoints(painter);
@@ -859,6 +886,55 @@ void CADCanvas::renderSelectionBoundingBox(QPainter& painter) {
     painter.drawRect(rect);
 }
 
+void CADCanvas::renderIssueOverlay(QPainter& painter) {
+    if (issueOverlay_.isEmpty()) {
+        return;
+    }
+
+    // Clusters are cached per zoom bucket; only culling runs per paint
+    const auto& clusters = issueOverlay_.clusters(viewport_.zoomLevel());
+    const Geometry::BoundingBox visible = viewport_.visibleBounds();
+    const double margin = 2.0 * IssueOverlay::CELL_PIXELS / viewport_.zoomLevel();
+
+    const QColor errorColor(229, 57, 53);     // Red #E53935 (blocks export)
+    const QColor warningColor(251, 140, 0);   // Amber #FB8C00
+
+    painter.save();
+    QFont font = painter.font();
+    font.setBold(true);
+    painter.setFont(font);
+
+    for (const auto& cluster : clusters) {
+        if (!visible.contains(cluster.center, margin)) {
+            continue;
+        }
+        const QPointF center = viewport_.worldToScreen(cluster.center);
+        const QColor color = cluster.severity() == IssueSeverity::Error ? errorColor : warningColor;
+
+        if (cluster.isSingle()) {
+            // Individual issue: ring around its location
+            painter.setPen(QPen(color, 2));
+            painter.setBrush(Qt::NoBrush);
+            painter.drawEllipse(center, 7.0, 7.0);
+            continue;
+        }
+
+        // Cluster: filled disc sized by count, labeled with it
+        const double radius = 11.0 + 4.0 * std::log10(static_cast<double>(cluster.count));
+        QColor fill = color;
+        fill.setAlpha(200);
+        painter.setPen(QPen(color.darker(130), 1));
+        painter.setBrush(QBrush(fill));
+        painter.drawEllipse(center, radius, radius);
+
+        painter.setPen(Qt::white);
+        painter.drawText(QRectF(center.x() - radius, center.y() - radius, 2.0 * radius, 2.0 * radius),
+                         Qt::AlignCenter, QString::number(cluster.count));
+    }
+
+    painter.restore();
+}
+
 void CADCanvas::renderGripPoints(QPainter& painter) {
     // Only render if there are selected entities
     if (selectionManager_.isEmpty()) {
@@ -938,7 +1014,7 @@ void CADCanvas::mousePressEvent(QMouseEvent* event) {
         if (toolManager_->hasActiveTool()) {
             Geometry::Point2D worldPos = viewport_.screenToWorld(event->pos());
             // Apply snap to get precise point
-            auto snappedPoint = snapManager_.snap(worldPos, entities_, viewport_.zoomLevel());
+            auto snappedPoint = snapAt(worldPos);
             Geometry::Point2D inputPoint = snappedPoint.value_or(worldPos);
 
             ToolResult result = toolManager_->handleMousePress(inputPoint, event);
@@ -1012,7 +1088,7 @@ void CADCanvas::mouseMoveEvent(QMouseEvent* event) {
 
     // Calculate snap point (updates snapManager_ internal state for visual feedback)
     // Pass current zoom level for screen-space snap tolerance conversion
-    auto snappedPoint = snapManager_.snap(lastWorldPos_, entities_, viewport_.zoomLevel());
+    auto snappedPoint = snapAt(lastWorldPos_);
 
     // Forward to tool manager if tool is active
     if (toolManager_->hasActiveTool()) {
@@ -1090,7 +1166,7 @@ void CADCanvas::mouseReleaseEvent(QMouseEvent* event) {
     if (toolManager_->hasActiveTool()) {
         Geometry::Point2D worldPos = viewport_.screenToWorld(event->pos());
         // Apply snap to get precise point (same as press/move)
-        auto snappedPoint = snapManager_.snap(worldPos, entities_, viewport_.zoomLevel());
+        auto snappedPoint = snapAt(worldPos);
         Geometry::Point2D inputPoint = snappedPoint.value_or(worldPos);
 
         ToolResult result = toolManager_->handleMouseRelease(inputPoint, event);
@@ -1208,7 +1284,12 @@ std::string CADCanvas::hitTest(const Geometry::Point2D& point) {
     std::string closestHandle = "";
     double closestDist = worldTolerance; // Initialize with max acceptable distance
 
-    for (const auto& entityWithMeta : entities_) {
+    const auto searchBox = Geometry::BoundingBox::fromPoints(
+        Geometry::Point2D(point.x() - worldTolerance, point.y() - worldTolerance),
+        Geometry::Point2D(point.x() + worldTolerance, point.y() + worldTolerance));
+
+    for (size_t index : candidateEntities(searchBox)) {
+        const auto& entityWithMeta = entities_[index];
         const auto& entity = entityWithMeta.entity;
         double dist = std::numeric_limits<double>::max();
 
@@ -1232,6 +1313,50 @@ std::string CADCanvas::hitTest(const Geometry::Point2D& point) {
     return closestHandle;
 }
 
+bool CADCanvas::usesDocumentIndex() const {
+    // The index describes the document as it is now; it matches the canvas
+    // only while the snapshot is of the current version. Any edit, even one
+    // that keeps the entity count, makes the snapshot stale until the next
+    // setSnapshot(). Version 0 is an empty document (or setEntities()).
+    return documentModel_ != nullptr && entities_.version() != 0 &&
+           entities_.version() == documentModel_->version();
+}
+
+std::vector<size_t> CADCanvas::candidateEntities(const Geometry::BoundingBox& window) const {
+    if (!usesDocumentIndex()) {
+        std::vector<size_t> indices(entities_.size());
+        std::iota(indices.begin(), indices.end(), size_t(0));
+        return indices;
+    }
+
+    // Document order, so ties resolve as in a full scan; the snapshot is
+    // the document's current one, so its positions are the canvas's
+    return documentModel_->queryWindowIndices(window);
+}
+
+std::optional<Geometry::Point2D> CADCanvas::snapAt(const Geometry::Point2D& worldPos) {
+    // Only entities near the cursor can produce an object snap
+    const double worldTolerance = snapManager_.snapTolerancePixels() / viewport_.zoomLevel();
+    const auto searchBox = Geometry::BoundingBox::fromPoints(
+        Geometry::Point2D(worldPos.x() - worldTolerance, worldPos.y() - worldTolerance),
+        Geometry::Point2D(worldPos.x() + worldTolerance, worldPos.y() + worldTolerance));
+
+    std::vector<Import::GeometryEntityWithMetadata> nearby;
+    if (usesDocumentIndex()) {
+        for (size_t index : candidateEntities(searchBox)) {
+            nearby.push_back(entities_[index]);
+        }
+    } else {
+        // No index: filter by bounding box while walking the snapshot
+        for (const auto& entityWithMeta : entities_) {
+            if (searchBox.intersects(Model::SpatialIndex::boundsOf(entityWithMeta.entity))) {
+                nearby.push_back(entityWithMeta);
+            }
+        }
+    }
+    return snapManager_.snap(worldPos, nearby, viewport_.zoomLevel());
+}
+
 void CADCanvas::renderSelectionBox(QPainter& painter) {
     // Calculate rectangle from start to current position
     QRectF rect(boxSelectStartScreen_, boxSelectCurrentScreen_);
@@ -1266,7 +1391,8 @@ std::vector<std::string> CADCanvas::getEntitiesInBox(
 ) {
     std::vector<std::string> result;
 
-    for (const auto& entityWithMeta : entities_) {
+    for (size_t index : candidateEntities(selectionBox)) {
+        const auto& entityWithMeta = entities_[index];
         const auto& entity = entityWithMeta.entity;
         Geometry::BoundingBox entityBox;
 
@@ -0,0 +1,127 @@
+#include "ui/IssueOverlay.h"
+#include "model/SpatialIndex.h"
+#include <cmath>
+#include <unordered_map>
+#include <utility>
+
+namespace OwnCAD {
+namespace UI {
+
+using namespace OwnCAD::Geometry;
+
+namespace {
+
+struct CellHash {
+    size_t operator()(const std::pair<int64_t, int64_t>& cell) const noexcept {
+        return std::hash<uint64_t>()(static_cast<uint64_t>(cell.first) * 0x9E3779B97F4A7C15ULL ^
+                                     static_cast<uint64_t>(cell.second));
+    }
+};
+
+} // namespace
+
+std::vector<IssueMarker> IssueOverlay::markersFor(const ValidationResult& result,
+                                                  const Model::DocumentSnapshot& entities) {
+    std::vector<IssueMarker> markers;
+    if (result.issues().empty()) {
+        return markers;
+    }
+
+    // Issue indices count validated entities (lines and arcs) only
+    std::vector<Point2D> centers;
+    centers.reserve(entities.size());
+    for (const auto& record : entities) {
+        if (std::holds_alternative<Line2D>(record.entity) || std::holds_alternative<Arc2D>(record.entity)) {
+            centers.push_back(Model::SpatialIndex::boundsOf(record.entity).center());
+        }
+    }
+
+    markers.reserve(result.issues().size());
+    for (const auto& issue : result.issues()) {
+        IssueMarker marker;
+        if (issue.location) {
+            marker.location = *issue.location;
+        } else if (issue.entityIndex < centers.size()) {
+            marker.location = centers[issue.entityIndex];
+        } else {
+            continue;  // Result of another document
+        }
+        marker.severity = GeometryValidator::isBlockingIssue(issue.type)
+            ? IssueSeverity::Error : IssueSeverity::Warning;
+        markers.push_back(marker);
+    }
+    return markers;
+}
+
+int IssueOverlay::zoomBucket(double zoomLevel) noexcept {
+    if (!(zoomLevel > 0.0) || !std::isfinite(zoomLevel)) {
+        return 0;
+    }
+    return static_cast<int>(std::floor(std::log2(zoomLevel)));
+}
+
+void IssueOverlay::setMarkers(std::vector<IssueMarker> markers) {
+    markers_ = std::move(markers);
+    clustersValid_ = false;
+}
+
+void IssueOverlay::clear() {
+    markers_.clear();
+    clusters_.clear();
+    clustersValid_ = false;
+}
+
+const std::vector<IssueCluster>& IssueOverlay::clusters(double zoomLevel) {
+    const int bucket = zoomBucket(zoomLevel);
+    if (!clustersValid_ || bucket != bucket_) {
+        rebuild(bucket);
+    }
+    return clusters_;
+}
+
+void IssueOverlay::rebuild(int bucket) {
+    bucket_ = bucket;
+    clustersValid_ = true;
+    ++rebuildCount_;
+    clusters_.clear();
+
+    // World size of a cell: CELL_PIXELS at the bottom of the bucket,
+    // up to twice that at its top
+    const double cell = std::ldexp(CELL_PIXELS, -bucket);
+
+    std::unordered_map<std::pair<int64_t, int64_t>, size_t, CellHash> clusterOfCell;
+    clusterOfCell.reserve(markers_.size());
+    std::vector<double> sumX;
+    std::vector<double> sumY;
+    for (const auto& marker : markers_) {
+        if (!std::isfinite(marker.location.x()) || !std::isfinite(marker.location.y())) {
+            continue;  // Nowhere to draw it
+        }
+        const std::pair<int64_t, int64_t> key(
+            static_cast<int64_t>(std::floor(marker.location.x() / cell)),
+            static_cast<int64_t>(std::floor(marker.location.y() / cell)));
+
+        auto found = clusterOfCell.emplace(key, clusters_.size());
+        if (found.second) {
+            clusters_.emplace_back();
+            sumX.push_back(0.0);
+            sumY.push_back(0.0);
+        }
+        const size_t index = found.first->second;
+        IssueCluster& cluster = clusters_[index];
+        cluster.count++;
+        if (marker.severity == IssueSeverity::Error) {
+            cluster.errors++;
+        }
+        sumX[index] += marker.location.x();
+        sumY[index] += marker.location.y();
+    }
+
+    for (size_t i = 0; i < clusters_.size(); ++i) {
+        const double n = static_cast<double>(clusters_[i].count);
+        clusters_[i].center = Point2D(sumX[i] / n, sumY[i] / n);
+    }
+}
+
+} // namespace UI
+} // namespace OwnCAD
@@ -0,0 +1,86 @@
+#include "ui/ManufacturingRulesDialog.h"
+#include "geometry/GeometryConstants.h"
+#include <QVBoxLayout>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QDialogButtonBox>
+
+namespace OwnCAD {
+namespace UI {
+
+using Geometry::ManufacturingRules;
+
+ManufacturingRulesDialog::ManufacturingRulesDialog(const ManufacturingRules& current, QWidget* parent)
+    : QDialog(parent) {
+
+    setWindowTitle("Manufacturing Rules");
+    setModal(true);
+    setMinimumWidth(380);
+
+    setupUI(current);
+}
+
+QDoubleSpinBox* ManufacturingRulesDialog::addLimit(const QString& suffix, double maximum, double value) {
+    auto* spinBox = new QDoubleSpinBox(this);
+    spinBox->setRange(0.0, maximum);
+    spinBox->setDecimals(3);
+    spinBox->setSingleStep(0.1);
+    spinBox->setSuffix(suffix);
+    spinBox->setSpecialValueText("Off");  // Shown at 0: the rule is disabled
+    spinBox->setValue(value);
+    return spinBox;
+}
+
+void ManufacturingRulesDialog::setupUI(const ManufacturingRules& current) {
+    auto* mainLayout = new QVBoxLayout(this);
+
+    auto* rulesGroup = new QGroupBox("Limits");
+    auto* formLayout = new QFormLayout(rulesGroup);
+
+    minHoleDiameterSpinBox_ = addLimit(" mm", 1000.0, current.minHoleDiameter);
+    formLayout->addRow("Minimum hole diameter:", minHoleDiameterSpinBox_);
+
+    kerfWidthSpinBox_ = addLimit(" mm", 100.0, current.kerfWidth);
+    formLayout->addRow("Kerf width:", kerfWidthSpinBox_);
+
+    minFeatureSpacingSpinBox_ = addLimit(" mm", 1000.0, current.minFeatureSpacing);
+    formLayout->addRow("Minimum feature spacing:", minFeatureSpacingSpinBox_);
+
+    minEdgeLengthSpinBox_ = addLimit(" mm", 1000.0, current.minEdgeLength);
+    formLayout->addRow("Minimum edge length:", minEdgeLengthSpinBox_);
+
+    minCornerAngleSpinBox_ = addLimit(QStringLiteral("°"), 180.0,
+                                      current.minCornerAngle * 180.0 / Geometry::PI);
+    formLayout->addRow("Minimum corner angle:", minCornerAngleSpinBox_);
+
+    auto* infoLabel = new QLabel(
+        QString("<i>Limits apply to drawings in millimetres. A typical minimum hole "
+                "diameter is %1 mm; feature spacing defaults to twice the kerf width.</i>")
+            .arg(Geometry::TYPICAL_MIN_HOLE_DIAMETER, 0, 'g'));
+    infoLabel->setWordWrap(true);
+    formLayout->addRow("", infoLabel);
+
+    mainLayout->addWidget(rulesGroup);
+
+    auto* buttonBox = new QDialogButtonBox(
+        QDialogButtonBox::Ok | QDialogButtonBox::Cancel,
+        this
+    );
+    connect(buttonBox, &QDialogButtonBox::accepted, this, &QDialog::accept);
+    connect(buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    mainLayout->addWidget(buttonBox);
+}
+
+ManufacturingRules ManufacturingRulesDialog::rules() const {
+    ManufacturingRules rules;
+    rules.minHoleDiameter = minHoleDiameterSpinBox_->value();
+    rules.kerfWidth = kerfWidthSpinBox_->value();
+    rules.minFeatureSpacing = minFeatureSpacingSpinBox_->value();
+    rules.minEdgeLength = minEdgeLengthSpinBox_->value();
+    rules.minCornerAngle = minCornerAngleSpinBox_->value() * Geometry::PI / 180.0;
+    return rules;
+}
+
+} // namespace UI
+} // namespace OwnCAD
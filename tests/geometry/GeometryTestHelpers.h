@@ -0,0 +1,51 @@
+#pragma once
+
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include "geometry/Point2D.h"
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * @file GeometryTestHelpers.h
+ * @brief Shapes and handles shared by the geometry rule tests
+ */
+
+namespace OwnCAD {
+namespace Geometry {
+namespace Testing {
+
+using Segments = std::vector<std::variant<Line2D, Arc2D>>;
+
+/**
+ * @brief Appends a closed polygon, one line per side in corner order
+ */
+inline void addPolygon(Segments& segments, const std::vector<Point2D>& corners) {
+    for (size_t i = 0; i < corners.size(); ++i) {
+        segments.push_back(*Line2D::create(corners[i], corners[(i + 1) % corners.size()]));
+    }
+}
+
+/**
+ * @brief Appends an axis-aligned rectangle, counter-clockwise from (x, y)
+ */
+inline void addRectangle(Segments& segments, double x, double y, double w, double h) {
+    addPolygon(segments, {Point2D(x, y), Point2D(x + w, y), Point2D(x + w, y + h), Point2D(x, y + h)});
+}
+
+/**
+ * @brief Handles "H0", "H1", ... for each segment
+ */
+inline std::vector<std::string> numberedHandles(const Segments& segments) {
+    std::vector<std::string> handles;
+    handles.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        handles.push_back("H" + std::to_string(i));
+    }
+    return handles;
+}
+
+} // namespace Testing
+} // namespace Geometry
+} // namespace OwnCAD
@@ -0,0 +1,233 @@
+#include <QtTest/QtTest>
+#include "GeometryTestHelpers.h"
+#include "geometry/ContourTopology.h"
+#include "geometry/GeometryConstants.h"
+#include <chrono>
+#include <cmath>
+
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Geometry::Testing;
+
+class TestContourTopology : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmptyInput();
+    void testSquareWithSnappedGaps();
+    void testGapBeyondToleranceIsOpen();
+    void testFullCircle();
+    void testObroundWithArcs();
+    void testNesting();
+    void testCircleEnclosesContour();
+    void testBranchSplitsChains();
+    void testShortLineIsSkipped();
+    void testLargeSheet();
+};
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestContourTopology::testEmptyInput() {
+    const auto topology = ContourTopology::build({});
+    QVERIFY(topology.contours().empty());
+    QVERIFY(topology.roots().empty());
+    QCOMPARE(topology.nodeCount(), size_t(0));
+    QCOMPARE(topology.contourOf(0), ContourTopology::NONE);
+}
+
+void TestContourTopology::testSquareWithSnappedGaps() {
+    // Out of order, one edge reversed, corners off by less than the tolerance
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(10, 10 + 4e-7), Point2D(0, 10)));
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 0)));
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(0, 10 - 3e-7)));  // Reversed
+    segments.push_back(*Line2D::create(Point2D(10 + 5e-7, 0), Point2D(10, 10)));
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.contours().size(), size_t(1));
+    QCOMPARE(topology.closedCount(), size_t(1));
+    QCOMPARE(topology.nodeCount(), size_t(4));
+
+    const Contour& contour = topology.contours()[0];
+    QVERIFY(contour.closed);
+    QCOMPARE(contour.segments.size(), size_t(4));
+    QVERIFY(std::abs(contour.area() - 100.0) < 1e-4);
+    QCOMPARE(contour.depth, size_t(0));
+    QVERIFY(!contour.isHole());
+
+    // Consecutive segments share their joining node
+    size_t reversed = 0;
+    for (const auto& segment : contour.segments) {
+        reversed += segment.reversed ? 1 : 0;
+        QCOMPARE(topology.contourOf(segment.entity), size_t(0));
+    }
+    QVERIFY(reversed == 1 || reversed == 3);
+    for (size_t node = 0; node < topology.nodeCount(); ++node) {
+        QCOMPARE(topology.nodeDegree(node), size_t(2));
+    }
+}
+
+void TestContourTopology::testGapBeyondToleranceIsOpen() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 10, 10);
+    segments[3] = *Line2D::create(Point2D(0, 10), Point2D(0, 0.001));
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.contours().size(), size_t(1));
+    QCOMPARE(topology.openCount(), size_t(1));
+
+    const Contour& contour = topology.contours()[0];
+    QVERIFY(!contour.closed);
+    QCOMPARE(contour.segments.size(), size_t(4));
+    QCOMPARE(contour.area(), 0.0);
+    QCOMPARE(topology.nodeDegree(contour.startNode), size_t(1));
+    QCOMPARE(topology.nodeDegree(contour.endNode), size_t(1));
+    QVERIFY(topology.roots().empty());
+}
+
+void TestContourTopology::testFullCircle() {
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(5, 5), 2.0, 0.0, TWO_PI, true));
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.closedCount(), size_t(1));
+    QCOMPARE(topology.nodeCount(), size_t(1));
+    QCOMPARE(topology.nodeDegree(0), size_t(2));
+    QVERIFY(std::abs(topology.contours()[0].area() - PI * 4.0) < 1e-9);
+}
+
+void TestContourTopology::testObroundWithArcs() {
+    // Slot 10 long, 4 wide: two lines and two half circles, mixed directions
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 0)));
+    segments.push_back(*Arc2D::create(Point2D(10, 2), 2.0, -HALF_PI, HALF_PI, true));
+    segments.push_back(*Line2D::create(Point2D(0, 4), Point2D(10, 4)));  // Reversed
+    segments.push_back(*Arc2D::create(Point2D(0, 2), 2.0, -HALF_PI, HALF_PI, false));
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.contours().size(), size_t(1));
+    const Contour& contour = topology.contours()[0];
+    QVERIFY(contour.closed);
+    QVERIFY(std::abs(contour.area() - (40.0 + PI * 4.0)) < 1e-6);
+    QVERIFY(std::abs(contour.bounds.minX() - -2.0) < 1e-9);
+    QVERIFY(std::abs(contour.bounds.maxX() - 12.0) < 1e-9);
+}
+
+void TestContourTopology::testNesting() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 100, 100);                              // Outer
+    addRectangle(segments, 10, 10, 30, 30);                              // Hole
+    segments.push_back(*Arc2D::create(Point2D(25, 25), 5.0, 0.0, TWO_PI, true));  // Island
+    addRectangle(segments, 60, 60, 10, 10);                              // Second hole
+    addRectangle(segments, 200, 0, 50, 50);                              // Separate part
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.closedCount(), size_t(5));
+
+    const size_t outer = topology.contourOf(0);
+    const size_t hole = topology.contourOf(4);
+    const size_t island = topology.contourOf(8);
+    const size_t secondHole = topology.contourOf(9);
+    const size_t part = topology.contourOf(13);
+    const auto& contours = topology.contours();
+
+    QCOMPARE(contours[outer].depth, size_t(0));
+    QCOMPARE(contours[hole].depth, size_t(1));
+    QCOMPARE(contours[island].depth, size_t(2));
+    QCOMPARE(contours[secondHole].depth, size_t(1));
+    QCOMPARE(contours[part].depth, size_t(0));
+
+    QVERIFY(contours[hole].isHole());
+    QVERIFY(contours[secondHole].isHole());
+    QVERIFY(!contours[island].isHole());
+
+    QCOMPARE(contours[hole].parent, outer);
+    QCOMPARE(contours[island].parent, hole);
+    QCOMPARE(contours[outer].parent, ContourTopology::NONE);
+    QCOMPARE(contours[outer].children.size(), size_t(2));
+    QCOMPARE(contours[hole].children, std::vector<size_t>{island});
+
+    std::vector<size_t> roots{outer, part};
+    std::sort(roots.begin(), roots.end());
+    QCOMPARE(topology.roots(), roots);
+}
+
+void TestContourTopology::testCircleEnclosesContour() {
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(0, 0), 10.0, 0.0, TWO_PI, true));
+    addRectangle(segments, -2, -2, 4, 4);
+
+    const auto topology = ContourTopology::build(segments);
+    const auto& circle = topology.contours()[topology.contourOf(0)];
+    const auto& square = topology.contours()[topology.contourOf(1)];
+    QVERIFY(std::abs(circle.bounds.width() - 20.0) < 1e-9);
+    QCOMPARE(square.parent, topology.contourOf(0));
+    QVERIFY(square.isHole());
+}
+
+void TestContourTopology::testBranchSplitsChains() {
+    // T: three arms meeting at (5, 0)
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(5, 0)));
+    segments.push_back(*Line2D::create(Point2D(5, 0), Point2D(10, 0)));
+    segments.push_back(*Line2D::create(Point2D(5, 0), Point2D(5, 5)));
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.contours().size(), size_t(3));
+    QCOMPARE(topology.openCount(), size_t(3));
+    QCOMPARE(topology.nodeCount(), size_t(4));
+
+    size_t branches = 0;
+    for (size_t node = 0; node < topology.nodeCount(); ++node) {
+        if (topology.nodeDegree(node) == 3) {
+            branches++;
+        }
+    }
+    QCOMPARE(branches, size_t(1));
+}
+
+void TestContourTopology::testShortLineIsSkipped() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 10, 10);
+    segments.push_back(*Line2D::create(Point2D(10, 10), Point2D(10 + 2e-7, 10)));
+
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.contourOf(4), ContourTopology::NONE);
+    QCOMPARE(topology.contours().size(), size_t(1));
+    QVERIFY(topology.contours()[0].closed);
+}
+
+void TestContourTopology::testLargeSheet() {
+    // 20k parts (a rectangle with a round hole): 100k segments
+    Segments segments;
+    for (int i = 0; i < 20000; ++i) {
+        const double x = (i % 200) * 30.0;
+        const double y = (i / 200) * 30.0;
+        addRectangle(segments, x, y, 20, 20);
+        segments.push_back(*Arc2D::create(Point2D(x + 10, y + 10), 4.0, 0.0, TWO_PI, true));
+    }
+    addRectangle(segments, -10, -10, 6020, 3020);  // Sheet outline around everything
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto topology = ContourTopology::build(segments, ENDPOINT_SNAP_TOLERANCE, 1);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    QVERIFY(elapsed < std::chrono::seconds(1));
+
+    QCOMPARE(topology.closedCount(), size_t(40001));
+    QCOMPARE(topology.openCount(), size_t(0));
+    QCOMPARE(topology.roots().size(), size_t(1));
+    QCOMPARE(topology.contours()[topology.contourOf(4)].depth, size_t(2));
+    QCOMPARE(topology.contours()[topology.contourOf(0)].depth, size_t(1));
+
+    // Nesting does not depend on the thread count
+    const auto parallel = ContourTopology::build(segments, ENDPOINT_SNAP_TOLERANCE, 4);
+    QCOMPARE(parallel.contours().size(), topology.contours().size());
+    for (size_t c = 0; c < topology.contours().size(); ++c) {
+        QCOMPARE(parallel.contours()[c].parent, topology.contours()[c].parent);
+        QCOMPARE(parallel.contours()[c].depth, topology.contours()[c].depth);
+    }
+}
+
+QTEST_MAIN(TestContourTopology)
+#include "test_ContourTopology.moc"
@@ -2,7 +2,9 @@
 #include "geometry/GeometryValidator.h"
 #include "geometry/GeometryMath.h"
 #include "geometry/GeometryConstants.h"
+#include "geometry/DuplicateIndex.h"
 #include <cmath>
+#include <random>
 
 using namespace OwnCAD::Geometry;
 
@@ -72,8 +74,20 @@ private slots:
     // =========================================================================
     void testIssueContainsEntityHandles();
 
+    // =========================================================================
+    // LINE DUPLICATE INDEX TESTS
+    // =========================================================================
+    void testLineIndexMatchesPairwiseScan();
+    void testLineIndexNearParallelAcrossBuckets();
+    void testLineIndexShortLines();
+    void testArcIndexMatchesPairwiseScan();
+    void testDetectDuplicatesIssueOrder();
+
 private:
     static constexpr double TOLERANCE = GEOMETRY_EPSILON;
+
+    static std::vector<DuplicatePair> pairwiseLinePairs(
+        const std::vector<Line2D>& lines, double tolerance);
 };
 
 // =============================================================================
@@ -398,13 +412,277 @@ void TestDuplicateDetection::testIssueContainsEntityHandles() {
     QVERIFY(!result.isValid);
     QVERIFY(result.issueCount() == 1);
 
-    const auto& issue = result.issues[0];
+    const auto& issue = result.issues()[0];
     QVERIFY(issue.type == GeometryIssueType::DuplicateLine);
-    QVERIFY(issue.entityHandle == "HANDLE_001");
-    QVERIFY(issue.relatedEntityHandle == "HANDLE_002");
+    QVERIFY(result.handleOf(issue.entityIndex) == "HANDLE_001");
+    QVERIFY(result.handleOf(issue.relatedEntityIndex) == "HANDLE_002");
     QVERIFY(issue.entityIndex == 0);
     QVERIFY(issue.relatedEntityIndex == 1);
 }
 
+// =============================================================================
+// LINE DUPLICATE INDEX TESTS
+// =============================================================================
+
+std::vector<DuplicatePair> TestDuplicateDetection::pairwiseLinePairs(
+    const std::vector<Line2D>& lines, double tolerance) {
+    std::vector<DuplicatePair> pairs;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        for (size_t j = i + 1; j < lines.size(); ++j) {
+            if (GeometryValidator::areLinesDuplicate(lines[i], lines[j], tolerance)) {
+                pairs.push_back({i, j, GeometryIssueType::DuplicateLine});
+            } else if (GeometryValidator::areLinesOverlapping(lines[i], lines[j], tolerance)) {
+                pairs.push_back({i, j, GeometryIssueType::OverlappingLines});
+            }
+        }
+    }
+    return pairs;
+}
+
+void TestDuplicateDetection::testLineIndexMatchesPairwiseScan() {
+    // Random lines plus perturbed copies, reversed copies and collinear
+    // sub-segments at arbitrary angles must give exactly the pairwise result
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> coord(-500.0, 500.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    for (double tolerance : {TOLERANCE, 1e-3, 0.5}) {
+        std::vector<Line2D> lines;
+        while (lines.size() < 600) {
+            Point2D a(coord(rng), coord(rng));
+            Point2D b(coord(rng), coord(rng));
+            auto base = Line2D::create(a, b);
+            if (!base) continue;
+            lines.push_back(*base);
+
+            const double jitter = tolerance * (unit(rng) - 0.5);
+            switch (lines.size() % 4) {
+                case 0: {
+                    auto copy = Line2D::create(Point2D(b.x() + jitter, b.y()), a);
+                    if (copy) lines.push_back(*copy);
+                    break;
+                }
+                case 1: {
+                    auto sub = Line2D::create(base->pointAt(unit(rng)),
+                                              base->pointAt(1.0 + unit(rng)));
+                    if (sub) lines.push_back(*sub);
+                    break;
+                }
+                case 2: {
+                    auto shifted = Line2D::create(Point2D(a.x(), a.y() + 2.0 * tolerance),
+                                                  Point2D(b.x(), b.y() + 2.0 * tolerance));
+                    if (shifted) lines.push_back(*shifted);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        LineDuplicateIndex index(tolerance);
+        for (size_t i = 0; i < lines.size(); ++i) {
+            index.insert(i, lines[i]);
+        }
+        QCOMPARE(index.size(), lines.size());
+
+        const auto expected = pairwiseLinePairs(lines, tolerance);
+        const auto actual = index.findPairs();
+        QVERIFY(!expected.empty());
+        QCOMPARE(actual.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            QCOMPARE(actual[k].first, expected[k].first);
+            QCOMPARE(actual[k].second, expected[k].second);
+            QVERIFY(actual[k].type == expected[k].type);
+        }
+    }
+}
+
+void TestDuplicateDetection::testLineIndexShortLines() {
+    // Lines below the bucket-width percentile: slivers lying on long lines,
+    // touching their ends, duplicated and reversed, at any angle
+    std::mt19937 rng(777);
+    std::uniform_real_distribution<double> coord(-500.0, 500.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // Slivers after every 5th line sit around the percentile; after every
+    // 50th they are all below it and the long lines keep fine buckets
+    for (auto [tolerance, every] : {std::pair(1e-3, 5), std::pair(0.05, 5), std::pair(1e-3, 50)}) {
+        std::vector<Line2D> lines;
+        int count = 0;
+        while (lines.size() < 3000) {
+            const Point2D a(coord(rng), coord(rng));
+            auto base = Line2D::create(a, Point2D(coord(rng), coord(rng)));
+            if (!base) continue;
+            lines.push_back(*base);
+            if (++count % every != 0) {
+                continue;
+            }
+
+            // A sliver 1-5 tolerances long somewhere on the base line
+            const double t = unit(rng);
+            const double step = (1.0 + 4.0 * unit(rng)) * tolerance / base->length();
+            auto sliver = Line2D::create(base->pointAt(t), base->pointAt(t + step));
+            if (!sliver) continue;
+            lines.push_back(*sliver);
+
+            switch (lines.size() % 3) {
+                case 0: {
+                    auto reversed = Line2D::create(sliver->end(), sliver->start());
+                    if (reversed) lines.push_back(*reversed);
+                    break;
+                }
+                case 1: {
+                    // Crosses the base line: touches it but does not overlap
+                    const double angle = unit(rng) * TWO_PI;
+                    auto crossing = Line2D::create(
+                        base->pointAt(t), Point2D(base->pointAt(t).x() + 2.0 * tolerance * std::cos(angle),
+                                                  base->pointAt(t).y() + 2.0 * tolerance * std::sin(angle)));
+                    if (crossing) lines.push_back(*crossing);
+                    break;
+                }
+                default: {
+                    auto end = Line2D::create(base->pointAt(1.0 - step / 2.0), base->pointAt(1.0 + step));
+                    if (end) lines.push_back(*end);
+                    break;
+                }
+            }
+        }
+
+        LineDuplicateIndex index(tolerance);
+        for (size_t i = 0; i < lines.size(); ++i) {
+            index.insert(i, lines[i]);
+        }
+
+        const auto expected = pairwiseLinePairs(lines, tolerance);
+        QVERIFY(!expected.empty());
+        for (size_t threads : {size_t(1), size_t(4)}) {
+            const auto actual = index.findPairs(threads);
+            QCOMPARE(actual.size(), expected.size());
+            for (size_t k = 0; k < expected.size(); ++k) {
+                QCOMPARE(actual[k].first, expected[k].first);
+                QCOMPARE(actual[k].second, expected[k].second);
+                QVERIFY(actual[k].type == expected[k].type);
+            }
+        }
+    }
+}
+
+void TestDuplicateDetection::testLineIndexNearParallelAcrossBuckets() {
+    // Collinear overlapping segments whose directions differ by less than
+    // the tolerance allows, spread around the whole half-circle
+    const double tolerance = 1e-3;
+    std::vector<Line2D> lines;
+    for (int k = 0; k < 360; ++k) {
+        const double angle = k * PI / 180.0 + 1e-7 * k;
+        const double c = std::cos(angle);
+        const double s = std::sin(angle);
+        auto line1 = Line2D::create(Point2D(0, 0), Point2D(10.0 * c, 10.0 * s));
+        auto line2 = Line2D::create(Point2D(5.0 * c, 5.0 * s),
+                                    Point2D(20.0 * c - 1e-5 * s, 20.0 * s + 1e-5 * c));
+        QVERIFY(line1.has_value() && line2.has_value());
+        lines.push_back(*line1);
+        lines.push_back(*line2);
+    }
+
+    LineDuplicateIndex index(tolerance);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        index.insert(i, lines[i]);
+    }
+
+    const auto expected = pairwiseLinePairs(lines, tolerance);
+    const auto actual = index.findPairs();
+    QVERIFY(expected.size() >= 360);
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t k = 0; k < expected.size(); ++k) {
+        QCOMPARE(actual[k].first, expected[k].first);
+        QCOMPARE(actual[k].second, expected[k].second);
+    }
+}
+
+void TestDuplicateDetection::testArcIndexMatchesPairwiseScan() {
+    // Arcs on a few shared circles (with jitter across cell boundaries),
+    // mixed directions and ranges crossing 0/2π
+    std::mt19937 rng(4242);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    for (double tolerance : {TOLERANCE, 1e-3}) {
+        std::vector<Arc2D> arcs;
+        while (arcs.size() < 500) {
+            const double jitter = tolerance * (unit(rng) * 2.2 - 1.1);
+            const Point2D center(std::floor(unit(rng) * 4) + jitter,
+                                 std::floor(unit(rng) * 4) - jitter);
+            const double radius = std::floor(unit(rng) * 3) + 1.0 + 0.5 * jitter;
+            const double start = (arcs.size() % 5 == 0)
+                ? std::floor(unit(rng) * 8) * PI / 4 + jitter
+                : unit(rng) * TWO_PI;
+            const double end = start + unit(rng) * 4.0 - 0.5;
+
+            auto arc = Arc2D::create(center, radius, start, end, unit(rng) < 0.5);
+            if (arc) arcs.push_back(*arc);
+        }
+
+        ArcDuplicateIndex index(tolerance);
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            index.insert(i, arcs[i]);
+        }
+
+        std::vector<DuplicatePair> expected;
+        for (size_t i = 0; i < arcs.size(); ++i) {
+            for (size_t j = i + 1; j < arcs.size(); ++j) {
+                if (GeometryValidator::areArcsDuplicate(arcs[i], arcs[j], tolerance)) {
+                    expected.push_back({i, j, GeometryIssueType::DuplicateArc});
+                } else if (GeometryValidator::areArcsCoincident(arcs[i], arcs[j], tolerance)) {
+                    expected.push_back({i, j, GeometryIssueType::CoincidentArcs});
+                }
+            }
+        }
+
+        const auto actual = index.findPairs();
+        QVERIFY(!expected.empty());
+        QCOMPARE(actual.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            QCOMPARE(actual[k].first, expected[k].first);
+            QCOMPARE(actual[k].second, expected[k].second);
+            QVERIFY(actual[k].type == expected[k].type);
+        }
+    }
+}
+
+void TestDuplicateDetection::testDetectDuplicatesIssueOrder() {
+    // Issues must come out in (i, j) order with lines and arcs interleaved
+    auto line1 = Line2D::create(Point2D(0, 0), Point2D(10, 0));
+    auto arc1 = Arc2D::create(Point2D(0, 0), 5.0, 0, M_PI, true);
+    auto line2 = Line2D::create(Point2D(5, 0), Point2D(15, 0));  // Overlaps line1
+    auto arc2 = Arc2D::create(Point2D(0, 0), 5.0, 0, M_PI, true);  // Duplicate of arc1
+    auto line3 = Line2D::create(Point2D(10, 0), Point2D(0, 0));  // Duplicate of line1
+    QVERIFY(line1 && arc1 && line2 && arc2 && line3);
+
+    std::vector<std::variant<Line2D, Arc2D>> entities = {*line1, *arc1, *line2, *arc2, *line3};
+    std::vector<std::string> handles = {"A", "B", "C", "D", "E"};
+
+    auto result = GeometryValidator::detectDuplicates(entities, handles, TOLERANCE);
+
+    QVERIFY(!result.isValid);
+    QCOMPARE(result.issueCount(), size_t(4));
+
+    QVERIFY(result.issues()[0].type == GeometryIssueType::OverlappingLines);
+    QCOMPARE(result.issues()[0].entityIndex, size_t(0));
+    QCOMPARE(result.issues()[0].relatedEntityIndex, size_t(2));
+
+    QVERIFY(result.issues()[1].type == GeometryIssueType::DuplicateLine);
+    QCOMPARE(result.issues()[1].entityIndex, size_t(0));
+    QCOMPARE(result.issues()[1].relatedEntityIndex, size_t(4));
+
+    QVERIFY(result.issues()[2].type == GeometryIssueType::DuplicateArc);
+    QCOMPARE(result.issues()[2].entityIndex, size_t(1));
+    QCOMPARE(result.issues()[2].relatedEntityIndex, size_t(3));
+    QVERIFY(result.handleOf(result.issues()[2].entityIndex) == "B");
+    QVERIFY(result.handleOf(result.issues()[2].relatedEntityIndex) == "D");
+
+    QVERIFY(result.issues()[3].type == GeometryIssueType::OverlappingLines);
+    QCOMPARE(result.issues()[3].entityIndex, size_t(2));
+    QCOMPARE(result.issues()[3].relatedEntityIndex, size_t(4));
+}
+
 QTEST_MAIN(TestDuplicateDetection)
 #include "test_DuplicateDetection.moc"
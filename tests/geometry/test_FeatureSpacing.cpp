@@ -0,0 +1,295 @@
+#include <QtTest/QtTest>
+#include "GeometryTestHelpers.h"
+#include "geometry/GeometryValidator.h"
+#include "geometry/ContourTopology.h"
+#include "geometry/GeometryMath.h"
+#include "geometry/ProximitySweep.h"
+#include "geometry/GeometryConstants.h"
+#include <chrono>
+#include <random>
+
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Geometry::Testing;
+
+class TestFeatureSpacing : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAdjacentSegmentsIgnored();
+    void testHoleNearEdge();
+    void testOneIssuePerFeaturePair();
+    void testNarrowNeckInOneContour();
+    void testFilletedRectangleIgnored();
+    void testTessellatedCircleIgnored();
+    void testTouchingLeftToOtherRules();
+    void testSpacingFromKerfWidth();
+    void testSweepMatchesPairwiseScan();
+    void testCancelledSweepStops();
+    void testLargeSheet();
+
+private:
+    static ValidationResult check(const Segments& segments, double spacing, size_t threadCount = 1);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+ValidationResult TestFeatureSpacing::check(const Segments& segments, double spacing, size_t threadCount) {
+    const std::vector<std::string> handles = numberedHandles(segments);
+    ValidationControl control;
+    control.rules.minFeatureSpacing = spacing;
+    control.threadCount = threadCount;
+    const auto topology = ContourTopology::build(segments);
+    return GeometryValidator::checkFeatureSpacing(segments, handles, topology, control);
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestFeatureSpacing::testAdjacentSegmentsIgnored() {
+    // Every side meets its neighbours at a corner; opposite sides are far apart
+    Segments segments;
+    addRectangle(segments, 0, 0, 10, 10);
+    segments.push_back(*Line2D::create(Point2D(10, 10), Point2D(10.5, 10.2)));  // Short lead-out
+
+    QVERIFY(check(segments, 2.0).passed());
+}
+
+void TestFeatureSpacing::testHoleNearEdge() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 100, 100);
+    segments.push_back(*Arc2D::create(Point2D(5, 50), 4.0, 0.0, TWO_PI, true));    // 1 mm web
+    segments.push_back(*Arc2D::create(Point2D(50, 50), 4.0, 0.0, TWO_PI, true));   // Far from all
+
+    const auto result = check(segments, 2.0);
+    QVERIFY(result.isValid);
+    QCOMPARE(result.issueCount(), size_t(1));
+
+    const auto& issue = result.issues()[0];
+    QVERIFY(issue.type == GeometryIssueType::FeaturesTooClose);
+    QCOMPARE(issue.entityIndex, size_t(3));
+    QCOMPARE(issue.relatedEntityIndex, size_t(4));
+    QCOMPARE(result.handleOf(issue.entityIndex), std::string("H3"));
+    QCOMPARE(result.handleOf(issue.relatedEntityIndex), std::string("H4"));
+    QVERIFY(issue.location->isEqual(Point2D(0, 50), 1e-9));
+    QVERIFY(issue.relatedLocation->isEqual(Point2D(1, 50), 1e-9));
+    QCOMPARE(describe(issue),
+             std::string("Minimum distance between features is 1.000 mm (recommended minimum: 2.000 mm)"));
+
+    QVERIFY(GeometryValidator::isPairIssue(issue.type));
+    QVERIFY(!GeometryValidator::isBlockingIssue(issue.type));
+    QCOMPARE(toString(GeometryIssueType::FeaturesTooClose), std::string("Features too close"));
+}
+
+void TestFeatureSpacing::testOneIssuePerFeaturePair() {
+    // Two parts 0.5 apart: sides and corners are close in several places
+    Segments segments;
+    addRectangle(segments, 0, 0, 10, 10);
+    addRectangle(segments, 10.5, 0, 10, 10);
+    addRectangle(segments, 10.5, 10.8, 10, 10);  // 0.8 above the second part
+
+    const auto result = check(segments, 1.0);
+    QCOMPARE(result.issueCount(), size_t(3));
+
+    // Parts 0 and 1 at 0.5; of the equally close segment pairs the lowest
+    // is reported (bottom of part 0, bottom of part 1)
+    QCOMPARE(result.issues()[0].entityIndex, size_t(0));
+    QCOMPARE(result.issues()[0].relatedEntityIndex, size_t(4));
+    QVERIFY(std::abs(GeometryMath::distance(*result.issues()[0].location,
+                                            *result.issues()[0].relatedLocation) - 0.5) < 1e-9);
+    // Part 0 and 2 meet only corner to corner, part 1 and 2 side to side
+    QCOMPARE(result.issues()[1].entityIndex, size_t(1));
+    QCOMPARE(result.issues()[1].relatedEntityIndex, size_t(8));
+    QCOMPARE(result.issues()[2].entityIndex, size_t(5));
+    QCOMPARE(result.issues()[2].relatedEntityIndex, size_t(8));
+}
+
+void TestFeatureSpacing::testNarrowNeckInOneContour() {
+    // Part with a 1 mm wide slot cut in from the top edge
+    Segments segments;
+    addPolygon(segments, {Point2D(0, 0), Point2D(10, 0), Point2D(10, 10), Point2D(5.5, 10),
+                          Point2D(5.5, 3), Point2D(4.5, 3), Point2D(4.5, 10), Point2D(0, 10)});
+
+    const auto result = check(segments, 2.0);
+    QCOMPARE(result.issueCount(), size_t(1));
+    const auto topology = ContourTopology::build(segments);
+    QCOMPARE(topology.contourOf(result.issues()[0].entityIndex),
+             topology.contourOf(result.issues()[0].relatedEntityIndex));
+    QVERIFY(describe(result.issues()[0]).find("is 1.000 mm") != std::string::npos);
+}
+
+void TestFeatureSpacing::testFilletedRectangleIgnored() {
+    // Sides on either side of a 0.5 mm fillet are 0.7 mm apart at the corner
+    Segments segments;
+    const double r = 0.5;
+    segments.push_back(*Line2D::create(Point2D(r, 0), Point2D(10 - r, 0)));
+    segments.push_back(*Arc2D::create(Point2D(10 - r, r), r, -HALF_PI, 0.0, true));
+    segments.push_back(*Line2D::create(Point2D(10, r), Point2D(10, 10 - r)));
+    segments.push_back(*Arc2D::create(Point2D(10 - r, 10 - r), r, 0.0, HALF_PI, true));
+    segments.push_back(*Line2D::create(Point2D(10 - r, 10), Point2D(r, 10)));
+    segments.push_back(*Arc2D::create(Point2D(r, 10 - r), r, HALF_PI, PI, true));
+    segments.push_back(*Line2D::create(Point2D(0, 10 - r), Point2D(0, r)));
+    segments.push_back(*Arc2D::create(Point2D(r, r), r, PI, PI + HALF_PI, true));
+
+    QCOMPARE(ContourTopology::build(segments).contours().size(), size_t(1));
+    QVERIFY(check(segments, 2.0).passed());
+}
+
+void TestFeatureSpacing::testTessellatedCircleIgnored() {
+    auto polygonCircle = [](Segments& segments, const Point2D& center, double radius, size_t sides) {
+        std::vector<Point2D> corners;
+        for (size_t i = 0; i < sides; ++i) {
+            const double angle = TWO_PI * static_cast<double>(i) / static_cast<double>(sides);
+            corners.emplace_back(center.x() + radius * std::cos(angle), center.y() + radius * std::sin(angle));
+        }
+        addPolygon(segments, corners);
+    };
+
+    // Neighbouring chords a few segments apart are closer than the spacing
+    Segments segments;
+    polygonCircle(segments, Point2D(0, 0), 5.0, 64);
+    QVERIFY(check(segments, 1.0).passed());
+
+    // Smaller than the spacing across: left to the hole size rule
+    Segments small;
+    polygonCircle(small, Point2D(0, 0), 0.4, 16);
+    QVERIFY(check(small, 1.0).passed());
+}
+
+void TestFeatureSpacing::testTouchingLeftToOtherRules() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 10, 10);
+    segments.push_back(*Line2D::create(Point2D(5, 5), Point2D(15, 5)));  // Crosses the right side
+
+    // Crossing pair has distance 0 and is a self-intersection; the line's
+    // far end is 5 mm from everything
+    QVERIFY(check(segments, 2.0).passed());
+}
+
+void TestFeatureSpacing::testSpacingFromKerfWidth() {
+    QCOMPARE(ManufacturingRules{}.featureSpacing(), 0.0);
+    QCOMPARE((ManufacturingRules{3.0, 0.4, 0.0}.featureSpacing()), 0.8);
+    QCOMPARE((ManufacturingRules{3.0, 0.4, 1.5}.featureSpacing()), 1.5);
+
+    Segments segments;
+    addRectangle(segments, 0, 0, 10, 10);
+    addRectangle(segments, 10.6, 0, 10, 10);
+
+    const auto topology = ContourTopology::build(segments);
+    ValidationControl control;
+    QVERIFY(GeometryValidator::checkFeatureSpacing(segments, {}, topology, control).passed());
+    control.rules.kerfWidth = 0.4;
+    QCOMPARE(GeometryValidator::checkFeatureSpacing(segments, {}, topology, control).issueCount(),
+             size_t(1));
+}
+
+void TestFeatureSpacing::testSweepMatchesPairwiseScan() {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coordinate(0.0, 200.0);
+    std::uniform_real_distribution<double> extent(-6.0, 6.0);
+    std::uniform_real_distribution<double> angle(0.0, TWO_PI);
+
+    Segments segments;
+    for (int i = 0; i < 1500; ++i) {
+        const Point2D start(coordinate(rng), coordinate(rng));
+        if (i % 3 == 0) {
+            const double from = angle(rng);
+            segments.push_back(*Arc2D::create(start, 0.5 + std::abs(extent(rng)), from,
+                                              from + 0.5 + angle(rng) / 2.0, i % 2 == 0));
+        } else {
+            segments.push_back(*Line2D::create(
+                start, Point2D(start.x() + extent(rng), start.y() + extent(rng))));
+        }
+    }
+
+    const double spacing = 1.5;
+    auto measure = [](const std::variant<Line2D, Arc2D>& a, const std::variant<Line2D, Arc2D>& b) {
+        if (std::holds_alternative<Line2D>(a) && std::holds_alternative<Line2D>(b)) {
+            return GeometryMath::closestPoints(std::get<Line2D>(a), std::get<Line2D>(b)).distance;
+        }
+        if (std::holds_alternative<Line2D>(a)) {
+            return GeometryMath::closestPoints(std::get<Line2D>(a), std::get<Arc2D>(b)).distance;
+        }
+        if (std::holds_alternative<Line2D>(b)) {
+            return GeometryMath::closestPoints(std::get<Line2D>(b), std::get<Arc2D>(a)).distance;
+        }
+        return GeometryMath::closestPoints(std::get<Arc2D>(a), std::get<Arc2D>(b)).distance;
+    };
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        for (size_t j = i + 1; j < segments.size(); ++j) {
+            const double d = measure(segments[i], segments[j]);
+            if (d < spacing && d > GEOMETRY_EPSILON) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+    QVERIFY(!expected.empty());
+
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        ProximitySweep sweep(spacing, GEOMETRY_EPSILON);
+        for (size_t i = 0; i < segments.size(); ++i) {
+            sweep.insert(i, segments[i]);
+        }
+        const auto hits = sweep.findClosePairs(threads);
+        QCOMPARE(hits.size(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            QCOMPARE(hits[k].first, expected[k].first);
+            QCOMPARE(hits[k].second, expected[k].second);
+        }
+    }
+}
+
+void TestFeatureSpacing::testCancelledSweepStops() {
+    // Parallel lines 1 mm apart: every neighbouring pair is too close
+    Segments segments;
+    for (int i = 0; i < 2000; ++i) {
+        segments.push_back(*Line2D::create(Point2D(0, i), Point2D(10, i)));
+    }
+    ProximitySweep sweep(1.5, GEOMETRY_EPSILON);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        sweep.insert(i, segments[i]);
+    }
+
+    CancellationToken idle;
+    QCOMPARE(sweep.findClosePairs(4, &idle).size(), size_t(1999));
+
+    // Every chunk polls before its first entry, so a cancelled run finds nothing
+    CancellationToken cancelled;
+    cancelled.cancel();
+    QVERIFY(sweep.findClosePairs(1, &cancelled).empty());
+    QVERIFY(sweep.findClosePairs(4, &cancelled).empty());
+}
+
+void TestFeatureSpacing::testLargeSheet() {
+    // 5k parts (a rectangle with a round hole) 2 mm apart, plus a sheet outline
+    Segments segments;
+    for (int i = 0; i < 5000; ++i) {
+        const double x = (i % 100) * 22.0;
+        const double y = (i / 100) * 22.0;
+        addRectangle(segments, x, y, 20, 20);
+        segments.push_back(*Arc2D::create(Point2D(x + 10, y + 10), 4.0, 0.0, TWO_PI, true));
+    }
+    addRectangle(segments, -10, -10, 2220, 1120);
+    // One hole pushed against its part's edge
+    segments[4] = *Arc2D::create(Point2D(5, 10), 4.0, 0.0, TWO_PI, true);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = check(segments, 1.5);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    QVERIFY(elapsed < std::chrono::seconds(1));
+
+    QCOMPARE(result.issueCount(), size_t(1));
+    QCOMPARE(result.issues()[0].entityIndex, size_t(3));
+    QCOMPARE(result.issues()[0].relatedEntityIndex, size_t(4));
+
+    const auto parallel = check(segments, 2.5, 4);
+    QCOMPARE(parallel.issueCount(), check(segments, 2.5, 1).issueCount());
+    QVERIFY(parallel.issueCount() > 5000);  // Every neighbouring part pair
+}
+
+QTEST_MAIN(TestFeatureSpacing)
+#include "test_FeatureSpacing.moc"
@@ -1,6 +1,7 @@
 #include <QtTest/QtTest>
 #include "geometry/GeometryMath.h"
 #include "geometry/GeometryConstants.h"
+#include <random>
 
 using namespace OwnCAD::Geometry;
 using namespace OwnCAD::Geometry::GeometryMath;
@@ -14,6 +15,7 @@ private slots:
     void testAngleBetweenPoints();
     void testArcCalculations();
     void testToleranceUtilities();
+    void testClosestPoints();
 };
 
 void TestGeometryMath::testDistance() {
@@ -110,5 +112,76 @@ void TestGeometryMath::testToleranceUtilities() {
     QCOMPARE(clamp(15.0, 0.0, 10.0), 10.0);
 }
 
+void TestGeometryMath::testClosestPoints() {
+    const Line2D bottom = *Line2D::create(Point2D(0, 0), Point2D(10, 0));
+    const Line2D parallel = *Line2D::create(Point2D(2, 3), Point2D(8, 3));
+    QCOMPARE(closestPoints(bottom, parallel).distance, 3.0);
+
+    const Line2D crossing = *Line2D::create(Point2D(5, -1), Point2D(5, 1));
+    const auto cross = closestPoints(bottom, crossing);
+    QCOMPARE(cross.distance, 0.0);
+    QVERIFY(cross.first.isEqual(Point2D(5, 0), 1e-12));
+
+    // Circle above the segment: nearest where the segment passes the center
+    const Arc2D circle = *Arc2D::create(Point2D(4, 5), 2.0, 0.0, TWO_PI, true);
+    const auto lineArc = closestPoints(bottom, circle);
+    QVERIFY(std::abs(lineArc.distance - 3.0) < 1e-12);
+    QVERIFY(lineArc.first.isEqual(Point2D(4, 0), 1e-12));
+    QVERIFY(lineArc.second.isEqual(Point2D(4, 3), 1e-12));
+
+    // Facing half circles: interior points on the line of centers
+    const Arc2D left = *Arc2D::create(Point2D(0, 0), 1.0, -HALF_PI, HALF_PI, true);
+    const Arc2D right = *Arc2D::create(Point2D(5, 0), 1.0, HALF_PI, PI + HALF_PI, true);
+    const auto arcs = closestPoints(left, right);
+    QVERIFY(std::abs(arcs.distance - 3.0) < 1e-12);
+    QVERIFY(arcs.first.isEqual(Point2D(1, 0), 1e-12));
+    QVERIFY(arcs.second.isEqual(Point2D(4, 0), 1e-12));
+
+    // Random pairs against dense sampling: never above the sampled minimum,
+    // never meaningfully below it
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> coordinate(-10.0, 10.0);
+    std::uniform_real_distribution<double> angle(0.0, TWO_PI);
+    auto randomArc = [&]() {
+        const double from = angle(rng);
+        return *Arc2D::create(Point2D(coordinate(rng), coordinate(rng)), 1.0 + std::abs(coordinate(rng)) / 2.0,
+                              from, from + 0.3 + angle(rng) * 0.8, rng() % 2 == 0);
+    };
+    auto randomLine = [&]() {
+        return *Line2D::create(Point2D(coordinate(rng), coordinate(rng)),
+                               Point2D(coordinate(rng), coordinate(rng)));
+    };
+    auto sampled = [](auto pointOnA, auto pointOnB) {
+        constexpr int SAMPLES = 400;
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i <= SAMPLES; ++i) {
+            for (int j = 0; j <= SAMPLES; ++j) {
+                best = std::min(best, distance(pointOnA(double(i) / SAMPLES),
+                                               pointOnB(double(j) / SAMPLES)));
+            }
+        }
+        return best;
+    };
+
+    for (int trial = 0; trial < 60; ++trial) {
+        const Line2D line = randomLine();
+        const Arc2D arc1 = randomArc();
+        const Arc2D arc2 = randomArc();
+        auto onLine = [&](double t) { return line.pointAt(t); };
+        auto onArc1 = [&](double t) { return arc1.pointAt(t); };
+        auto onArc2 = [&](double t) { return arc2.pointAt(t); };
+
+        const double lineArc = closestPoints(line, arc1).distance;
+        const double sampledLineArc = sampled(onLine, onArc1);
+        QVERIFY(lineArc <= sampledLineArc + 1e-9);
+        QVERIFY(lineArc >= sampledLineArc - 0.1);
+
+        const double arcArc = closestPoints(arc1, arc2).distance;
+        const double sampledArcArc = sampled(onArc1, onArc2);
+        QVERIFY(arcArc <= sampledArcArc + 1e-9);
+        QVERIFY(arcArc >= sampledArcArc - 0.1);
+    }
+}
+
 QTEST_MAIN(TestGeometryMath)
 #include "test_GeometryMath.moc"
@@ -0,0 +1,298 @@
+#include <QtTest/QtTest>
+#include "GeometryTestHelpers.h"
+#include "geometry/GeometryValidator.h"
+#include "geometry/ContourTopology.h"
+#include "geometry/HoleMeasure.h"
+#include "geometry/GeometryConstants.h"
+#include <chrono>
+#include <cmath>
+
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Geometry::Testing;
+
+class TestHoleSize : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCircle();
+    void testSplitCircle();
+    void testSlot();
+    void testTaperedSlotUsesSolver();
+    void testRotatedRectangle();
+    void testSolverMatchesFastPaths();
+    void testSolverIrregularShapes();
+    void testRuleReportsSmallHoles();
+    void testKerfWidthAdded();
+    void testIslandsAreNotHoles();
+    void testDisabledRule();
+    void testPerforatedPanel();
+
+private:
+    static void addSlot(Segments& segments, double x, double y, double length, double width);
+    static HoleMeasurement measureOnly(const Segments& segments);
+    static ValidationResult check(const Segments& segments, const ManufacturingRules& rules,
+                                  size_t threadCount = 1);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+void TestHoleSize::addSlot(Segments& segments, double x, double y, double length, double width) {
+    const double r = width / 2.0;
+    segments.push_back(*Line2D::create(Point2D(x, y), Point2D(x + length, y)));
+    segments.push_back(*Arc2D::create(Point2D(x + length, y + r), r, -HALF_PI, HALF_PI, true));
+    segments.push_back(*Line2D::create(Point2D(x + length, y + width), Point2D(x, y + width)));
+    segments.push_back(*Arc2D::create(Point2D(x, y + r), r, HALF_PI, PI + HALF_PI, true));
+}
+
+HoleMeasurement TestHoleSize::measureOnly(const Segments& segments) {
+    const auto topology = ContourTopology::build(segments);
+    if (topology.contours().size() != 1 || !topology.contours()[0].closed) {
+        return HoleMeasurement{};
+    }
+    return HoleMeasure::measure(topology.contours()[0], segments);
+}
+
+ValidationResult TestHoleSize::check(const Segments& segments, const ManufacturingRules& rules,
+                                     size_t threadCount) {
+    const std::vector<std::string> handles = numberedHandles(segments);
+    ValidationControl control;
+    control.rules = rules;
+    control.threadCount = threadCount;
+    const auto topology = ContourTopology::build(segments);
+    return GeometryValidator::checkHoleSizes(segments, handles, topology, control);
+}
+
+// =============================================================================
+// FAST PATHS
+// =============================================================================
+
+void TestHoleSize::testCircle() {
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(3, 4), 1.25, 0.0, TWO_PI, true));
+
+    const auto hole = measureOnly(segments);
+    QVERIFY(hole.shape == HoleShape::Circle);
+    QCOMPARE(hole.diameter, 2.5);
+    QVERIFY(hole.center.isEqual(Point2D(3, 4), 1e-12));
+}
+
+void TestHoleSize::testSplitCircle() {
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(0, 0), 2.0, 0.0, PI, true));
+    segments.push_back(*Arc2D::create(Point2D(0, 0), 2.0, PI, TWO_PI, true));
+
+    const auto hole = measureOnly(segments);
+    QVERIFY(hole.shape == HoleShape::Circle);
+    QCOMPARE(hole.diameter, 4.0);
+}
+
+void TestHoleSize::testSlot() {
+    Segments segments;
+    addSlot(segments, 10, 20, 8, 2.5);
+
+    const auto hole = measureOnly(segments);
+    QVERIFY(hole.shape == HoleShape::Slot);
+    QVERIFY(std::abs(hole.diameter - 2.5) < 1e-9);
+    QVERIFY(hole.center.isEqual(Point2D(14, 21.25), 1e-9));
+}
+
+void TestHoleSize::testTaperedSlotUsesSolver() {
+    // Equal half circles, but the second is turned a quarter: the sides converge
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(0, 0), 1.0, HALF_PI, PI + HALF_PI, true));
+    segments.push_back(*Line2D::create(Point2D(0, -1), Point2D(11, 0)));
+    segments.push_back(*Arc2D::create(Point2D(10, 0), 1.0, 0.0, PI, true));
+    segments.push_back(*Line2D::create(Point2D(9, 0), Point2D(0, 1)));
+
+    const auto hole = measureOnly(segments);
+    QVERIFY(hole.shape != HoleShape::Slot);
+    QVERIFY(hole.diameter > 1.95);
+    QVERIFY(hole.diameter < 1.995);   // Sides closer than the 2 mm the half circles suggest
+}
+
+void TestHoleSize::testRotatedRectangle() {
+    const double c = std::cos(PI / 6.0);
+    const double s = std::sin(PI / 6.0);
+    auto rotate = [&](double x, double y) { return Point2D(x * c - y * s + 5, x * s + y * c + 5); };
+
+    Segments segments;
+    addPolygon(segments, {rotate(0, 0), rotate(10, 0), rotate(10, 4), rotate(0, 4)});
+
+    const auto hole = measureOnly(segments);
+    QVERIFY(hole.shape == HoleShape::Rectangle);
+    QVERIFY(std::abs(hole.diameter - 4.0) < 1e-9);
+    QVERIFY(hole.center.isEqual(rotate(5, 2), 1e-9));
+}
+
+// =============================================================================
+// INSCRIBED-CIRCLE SOLVER
+// =============================================================================
+
+void TestHoleSize::testSolverMatchesFastPaths() {
+    Segments rectangle;
+    addRectangle(rectangle, 0, 0, 10, 4);
+    const auto rectTopology = ContourTopology::build(rectangle);
+    const auto rectHole = HoleMeasure::solveInscribedCircle(rectTopology.contours()[0], rectangle);
+    QVERIFY(rectHole.shape == HoleShape::Irregular);
+    QVERIFY(std::abs(rectHole.diameter - 4.0) <= 2e-3 * 4.0);
+
+    Segments slot;
+    addSlot(slot, 0, 0, 20, 3);
+    const auto slotTopology = ContourTopology::build(slot);
+    const auto slotHole = HoleMeasure::solveInscribedCircle(slotTopology.contours()[0], slot);
+    QVERIFY(std::abs(slotHole.diameter - 3.0) <= 2e-3 * 3.0);
+
+    Segments circle;
+    circle.push_back(*Arc2D::create(Point2D(0, 0), 5.0, 0.0, TWO_PI, true));
+    const auto circleTopology = ContourTopology::build(circle);
+    const auto circleHole = HoleMeasure::solveInscribedCircle(circleTopology.contours()[0], circle);
+    QVERIFY(std::abs(circleHole.diameter - 10.0) <= 2e-3 * 10.0);
+    QVERIFY(circleHole.center.isEqual(Point2D(0, 0), 0.05));
+}
+
+void TestHoleSize::testSolverIrregularShapes() {
+    // Right triangle 3-4-5: inradius (3 + 4 - 5) / 2 = 1
+    Segments triangle;
+    addPolygon(triangle, {Point2D(0, 0), Point2D(4, 0), Point2D(0, 3)});
+    const auto triangleHole = measureOnly(triangle);
+    QVERIFY(triangleHole.shape == HoleShape::Irregular);
+    QVERIFY(std::abs(triangleHole.diameter - 2.0) <= 2e-3 * 3.0);
+    QVERIFY(triangleHole.center.isEqual(Point2D(1, 1), 0.05));
+
+    // L with arms 2 wide: the circle in the corner touches both outer edges
+    // and the inner corner, r = 2√2 / (1 + √2)
+    Segments ell;
+    addPolygon(ell, {Point2D(0, 0), Point2D(10, 0), Point2D(10, 2), Point2D(2, 2),
+                     Point2D(2, 10), Point2D(0, 10)});
+    const double radius = 2.0 * std::sqrt(2.0) / (1.0 + std::sqrt(2.0));
+    const auto ellHole = measureOnly(ell);
+    QVERIFY(std::abs(ellHole.diameter - 2.0 * radius) <= 2e-3 * 10.0);
+
+    // Budget exhausted: still a lower bound
+    const auto topology = ContourTopology::build(ell);
+    const auto coarse = HoleMeasure::solveInscribedCircle(topology.contours()[0], ell, 16);
+    QVERIFY(coarse.diameter <= ellHole.diameter + 1e-9);
+}
+
+// =============================================================================
+// RULE
+// =============================================================================
+
+void TestHoleSize::testRuleReportsSmallHoles() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 100, 100);                                       // 0-3: part
+    segments.push_back(*Arc2D::create(Point2D(20, 20), 5.0, 0.0, TWO_PI, true));  // 4: 10 mm hole
+    addSlot(segments, 40, 40, 10, 2);                                              // 5-8: 2 mm slot
+    segments.push_back(*Arc2D::create(Point2D(80, 80), 1.0, 0.0, TWO_PI, true));  // 9: 2 mm hole
+
+    const auto result = check(segments, ManufacturingRules{TYPICAL_MIN_HOLE_DIAMETER});
+    QVERIFY(!result.isValid);
+    QCOMPARE(result.issueCount(), size_t(2));
+
+    const auto& slot = result.issues()[0];
+    QVERIFY(slot.type == GeometryIssueType::HoleTooSmall);
+    QCOMPARE(slot.entityIndex, size_t(5));
+    QCOMPARE(result.handleOf(slot.entityIndex), std::string("H5"));
+    QCOMPARE(result.contourOf(slot), (std::vector<size_t>{5, 6, 7, 8}));
+    QCOMPARE(result.handleOf(8), std::string("H8"));
+    QVERIFY(slot.location->isEqual(Point2D(45, 41), 1e-9));
+    QCOMPARE(describe(slot),
+             std::string("Hole diameter (2.000 mm) is below minimum cuttable size (3.000 mm)"));
+
+    QCOMPARE(result.issues()[1].entityIndex, size_t(9));
+    QCOMPARE(result.contourOf(result.issues()[1]), (std::vector<size_t>{9}));
+
+    QVERIFY(GeometryValidator::isContourIssue(GeometryIssueType::HoleTooSmall));
+    QVERIFY(!GeometryValidator::isPairIssue(GeometryIssueType::HoleTooSmall));
+    QVERIFY(GeometryValidator::isBlockingIssue(GeometryIssueType::HoleTooSmall));
+    QCOMPARE(toString(GeometryIssueType::HoleTooSmall), std::string("Hole too small"));
+}
+
+void TestHoleSize::testKerfWidthAdded() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 50, 50);
+    segments.push_back(*Arc2D::create(Point2D(25, 25), 1.7, 0.0, TWO_PI, true));  // 3.4 mm
+
+    QVERIFY(check(segments, ManufacturingRules{3.0, 0.0}).passed());
+
+    const auto result = check(segments, ManufacturingRules{3.0, 0.5});
+    QCOMPARE(result.issueCount(), size_t(1));
+    QCOMPARE(describe(result.issues()[0]),
+             std::string("Hole diameter (3.400 mm) is below minimum cuttable size (3.500 mm)"));
+}
+
+void TestHoleSize::testIslandsAreNotHoles() {
+    // A small part inside a large hole, and a small outer part on its own
+    Segments segments;
+    addRectangle(segments, 0, 0, 100, 100);
+    addRectangle(segments, 10, 10, 80, 80);
+    segments.push_back(*Arc2D::create(Point2D(50, 50), 1.0, 0.0, TWO_PI, true));
+    addRectangle(segments, 200, 0, 2, 2);
+
+    QVERIFY(check(segments, ManufacturingRules{TYPICAL_MIN_HOLE_DIAMETER}).passed());
+}
+
+void TestHoleSize::testDisabledRule() {
+    Segments segments;
+    addRectangle(segments, 0, 0, 50, 50);
+    segments.push_back(*Arc2D::create(Point2D(25, 25), 0.5, 0.0, TWO_PI, true));
+
+    QCOMPARE(check(segments, ManufacturingRules{TYPICAL_MIN_HOLE_DIAMETER}).issueCount(), size_t(1));
+    QVERIFY(check(segments, ManufacturingRules{0.0, 1.0}).passed());
+    QVERIFY(check(segments, ManufacturingRules{}).passed());  // Off by default
+}
+
+void TestHoleSize::testPerforatedPanel() {
+    // 20k holes: round, slotted, square and triangular, every fifth one too small
+    Segments segments;
+    addRectangle(segments, -10, -10, 4020, 2020);
+    size_t expected = 0;
+    for (int i = 0; i < 20000; ++i) {
+        const double x = (i % 200) * 20.0;
+        const double y = (i / 200) * 20.0;
+        const bool small = i % 5 == 0;
+        expected += small ? 1 : 0;
+        switch (i % 4) {
+            case 0:
+                segments.push_back(*Arc2D::create(Point2D(x + 5, y + 5), small ? 1.0 : 4.0,
+                                                  0.0, TWO_PI, true));
+                break;
+            case 1:
+                addSlot(segments, x + 2, y + 2, 6, small ? 2.0 : 5.0);
+                break;
+            case 2:
+                addRectangle(segments, x, y, 10, small ? 2.0 : 8.0);
+                break;
+            default:
+                addPolygon(segments, {Point2D(x, y), Point2D(x + 10, y),
+                                      Point2D(x, y + (small ? 2.0 : 10.0))});
+                break;
+        }
+    }
+
+    const auto topology = ContourTopology::build(segments);
+    std::vector<std::string> handles(segments.size());
+    ValidationControl control;
+    control.rules.minHoleDiameter = TYPICAL_MIN_HOLE_DIAMETER;
+    control.threadCount = 1;
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto serial = GeometryValidator::checkHoleSizes(segments, handles, topology, control);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    QVERIFY(elapsed < std::chrono::seconds(1));
+    QCOMPARE(serial.issueCount(), expected);
+
+    control.threadCount = 4;
+    const auto parallel = GeometryValidator::checkHoleSizes(segments, handles, topology, control);
+    QCOMPARE(parallel.issueCount(), serial.issueCount());
+    for (size_t i = 0; i < serial.issues().size(); ++i) {
+        QCOMPARE(parallel.issues()[i].entityIndex, serial.issues()[i].entityIndex);
+        QCOMPARE(describe(parallel.issues()[i]), describe(serial.issues()[i]));
+        QCOMPARE(parallel.contourOf(parallel.issues()[i]), serial.contourOf(serial.issues()[i]));
+    }
+}
+
+QTEST_MAIN(TestHoleSize)
+#include "test_HoleSize.moc"
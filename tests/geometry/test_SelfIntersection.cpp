@@ -0,0 +1,245 @@
+#include <QtTest/QtTest>
+#include "GeometryTestHelpers.h"
+#include "geometry/GeometryValidator.h"
+#include "geometry/IntersectionSweep.h"
+#include "geometry/GeometryConstants.h"
+#include <chrono>
+#include <cmath>
+#include <random>
+
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Geometry::Testing;
+
+class TestSelfIntersection : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCrossingLines();
+    void testSharedEndpointsIgnored();
+    void testSnappedCornersIgnored();
+    void testTJunctionReported();
+    void testLineThroughCircle();
+    void testArcsSharingEndpoints();
+    void testCollinearOverlapLeftToDuplicates();
+    void testValidateEntitiesReportsAfterDuplicates();
+    void testMatchesPairwiseScan();
+    void testCancelledSweepStops();
+    void testLargeSheet();
+
+private:
+    static ValidationResult detect(const Segments& segments, size_t threadCount = 1);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+ValidationResult TestSelfIntersection::detect(const Segments& segments, size_t threadCount) {
+    ValidationControl control;
+    control.threadCount = threadCount;
+    return GeometryValidator::detectSelfIntersections(segments, {}, GEOMETRY_EPSILON, control);
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestSelfIntersection::testCrossingLines() {
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 10)));
+    segments.push_back(*Line2D::create(Point2D(20, 0), Point2D(30, 0)));  // Far away
+    segments.push_back(*Line2D::create(Point2D(0, 10), Point2D(10, 0)));
+
+    const auto result = detect(segments);
+    QVERIFY(!result.isValid);
+    QCOMPARE(result.issueCount(), size_t(1));
+
+    const auto& issue = result.issues()[0];
+    QVERIFY(issue.type == GeometryIssueType::SelfIntersection);
+    QCOMPARE(issue.entityIndex, size_t(0));
+    QCOMPARE(issue.relatedEntityIndex, size_t(2));
+    QVERIFY(issue.location.has_value());
+    QVERIFY(issue.location->isEqual(Point2D(5, 5), 1e-9));
+    QCOMPARE(describe(issue), std::string("Segments intersect at (5.000000, 5.000000)"));
+    QVERIFY(GeometryValidator::isPairIssue(issue.type));
+    QVERIFY(GeometryValidator::isBlockingIssue(issue.type));
+}
+
+void TestSelfIntersection::testSharedEndpointsIgnored() {
+    // Closed part with a hole: every segment meets its neighbours only at joints
+    Segments segments;
+    addRectangle(segments, 0, 0, 20, 20);
+    segments.push_back(*Arc2D::create(Point2D(10, 10), 4.0, 0.0, TWO_PI, true));
+    segments.push_back(*Line2D::create(Point2D(20, 20), Point2D(30, 30)));  // Lead-out from a corner
+
+    QVERIFY(detect(segments).passed());
+}
+
+void TestSelfIntersection::testSnappedCornersIgnored() {
+    // Corners off by less than ENDPOINT_SNAP_TOLERANCE, edges cross slightly
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(-4e-7, 0), Point2D(10, 0)));
+    segments.push_back(*Line2D::create(Point2D(0, -3e-7), Point2D(0, 10)));
+
+    QVERIFY(detect(segments).passed());
+}
+
+void TestSelfIntersection::testTJunctionReported() {
+    // The end of one segment on the interior of another is not a joint
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 0)));
+    segments.push_back(*Line2D::create(Point2D(5, 0), Point2D(5, 5)));
+
+    const auto result = detect(segments);
+    QCOMPARE(result.issueCount(), size_t(1));
+    QVERIFY(result.issues()[0].location->isEqual(Point2D(5, 0), 1e-9));
+}
+
+void TestSelfIntersection::testLineThroughCircle() {
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(0, 0), 5.0, 0.0, TWO_PI, true));
+    segments.push_back(*Line2D::create(Point2D(-10, 0), Point2D(0, 0)));  // Enters once
+
+    const auto result = detect(segments);
+    QCOMPARE(result.issueCount(), size_t(1));
+    QCOMPARE(result.issues()[0].entityIndex, size_t(0));
+    QCOMPARE(result.issues()[0].relatedEntityIndex, size_t(1));
+    QVERIFY(result.issues()[0].location->isEqual(Point2D(-5, 0), 1e-9));
+}
+
+void TestSelfIntersection::testArcsSharingEndpoints() {
+    // Lens: two arcs meeting only at their shared endpoints (0, ±3)
+    Segments segments;
+    segments.push_back(*Arc2D::create(Point2D(-4, 0), 5.0, -std::atan2(3.0, 4.0),
+                                      std::atan2(3.0, 4.0), true));
+    segments.push_back(*Arc2D::create(Point2D(4, 0), 5.0, PI - std::atan2(3.0, 4.0),
+                                      PI + std::atan2(3.0, 4.0), true));
+    QVERIFY(detect(segments).passed());
+
+    // A third arc through the lens crosses both
+    segments.push_back(*Arc2D::create(Point2D(0, -6), 6.5, 0.0, PI, true));
+    const auto result = detect(segments);
+    QCOMPARE(result.issueCount(), size_t(2));
+    QCOMPARE(result.issues()[0].entityIndex, size_t(0));
+    QCOMPARE(result.issues()[0].relatedEntityIndex, size_t(2));
+    QCOMPARE(result.issues()[1].entityIndex, size_t(1));
+    QCOMPARE(result.issues()[1].relatedEntityIndex, size_t(2));
+}
+
+void TestSelfIntersection::testCollinearOverlapLeftToDuplicates() {
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 0)));
+    segments.push_back(*Line2D::create(Point2D(5, 0), Point2D(15, 0)));
+    segments.push_back(*Arc2D::create(Point2D(50, 50), 2.0, 0.0, PI, true));
+    segments.push_back(*Arc2D::create(Point2D(50, 50), 2.0, HALF_PI, PI + HALF_PI, true));
+
+    QVERIFY(detect(segments).passed());
+}
+
+void TestSelfIntersection::testValidateEntitiesReportsAfterDuplicates() {
+    Segments segments;
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 10)));
+    segments.push_back(*Line2D::create(Point2D(0, 10), Point2D(10, 0)));
+    segments.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 10)));  // Duplicate of 0, crosses 1
+    const std::vector<std::string> handles{"A", "B", "C"};
+
+    const auto result = GeometryValidator::validateEntitiesWithHandles(
+        segments, handles, GEOMETRY_EPSILON);
+    QVERIFY(!result.isValid);
+    QCOMPARE(result.issueCount(), size_t(3));
+    QVERIFY(result.issues()[0].type == GeometryIssueType::DuplicateLine);
+    QVERIFY(result.issues()[1].type == GeometryIssueType::SelfIntersection);
+    QCOMPARE(result.handleOf(result.issues()[1].entityIndex), std::string("A"));
+    QCOMPARE(result.handleOf(result.issues()[1].relatedEntityIndex), std::string("B"));
+    QVERIFY(result.issues()[2].type == GeometryIssueType::SelfIntersection);
+    QCOMPARE(result.handleOf(result.issues()[2].entityIndex), std::string("B"));
+    QCOMPARE(result.handleOf(result.issues()[2].relatedEntityIndex), std::string("C"));
+    QCOMPARE(toString(GeometryIssueType::SelfIntersection), std::string("Self-intersection"));
+}
+
+void TestSelfIntersection::testMatchesPairwiseScan() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::uniform_real_distribution<double> extent(-8.0, 8.0);
+    std::uniform_real_distribution<double> angle(0.0, TWO_PI);
+
+    Segments segments;
+    for (int i = 0; i < 1500; ++i) {
+        const Point2D start(coordinate(rng), coordinate(rng));
+        if (i % 3 == 0) {
+            const double from = angle(rng);
+            segments.push_back(*Arc2D::create(start, 1.0 + std::abs(extent(rng)), from,
+                                              from + 0.5 + angle(rng) / 2.0, i % 2 == 0));
+        } else {
+            segments.push_back(*Line2D::create(
+                start, Point2D(start.x() + extent(rng), start.y() + extent(rng))));
+        }
+    }
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        for (size_t j = i + 1; j < segments.size(); ++j) {
+            if (GeometryValidator::findIntersection(segments[i], segments[j], GEOMETRY_EPSILON)) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+    QVERIFY(!expected.empty());
+
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        const auto result = detect(segments, threads);
+        QCOMPARE(result.issueCount(), expected.size());
+        for (size_t k = 0; k < expected.size(); ++k) {
+            QCOMPARE(result.issues()[k].entityIndex, expected[k].first);
+            QCOMPARE(result.issues()[k].relatedEntityIndex, expected[k].second);
+        }
+    }
+}
+
+void TestSelfIntersection::testCancelledSweepStops() {
+    // A lattice of crossing lines: every horizontal crosses every vertical
+    IntersectionSweep sweep(GEOMETRY_EPSILON);
+    Segments segments;
+    for (int i = 0; i < 200; ++i) {
+        segments.push_back(*Line2D::create(Point2D(-1, i), Point2D(200, i)));
+        segments.push_back(*Line2D::create(Point2D(i + 0.5, -1), Point2D(i + 0.5, 200)));
+    }
+    for (size_t i = 0; i < segments.size(); ++i) {
+        sweep.insert(i, segments[i]);
+    }
+
+    CancellationToken idle;
+    QCOMPARE(sweep.findIntersections(4, &idle).size(), size_t(200 * 200));
+
+    // Every chunk polls before its first entry, so a cancelled run finds nothing
+    CancellationToken cancelled;
+    cancelled.cancel();
+    QVERIFY(sweep.findIntersections(1, &cancelled).empty());
+    QVERIFY(sweep.findIntersections(4, &cancelled).empty());
+}
+
+void TestSelfIntersection::testLargeSheet() {
+    // 20k parts (a rectangle with a round hole): 100k segments, plus a sheet outline
+    Segments segments;
+    for (int i = 0; i < 20000; ++i) {
+        const double x = (i % 200) * 30.0;
+        const double y = (i / 200) * 30.0;
+        addRectangle(segments, x, y, 20, 20);
+        segments.push_back(*Arc2D::create(Point2D(x + 10, y + 10), 4.0, 0.0, TWO_PI, true));
+    }
+    addRectangle(segments, -10, -10, 6020, 3020);
+    // One stray cut across the first part's hole
+    segments.push_back(*Line2D::create(Point2D(5, 10), Point2D(15, 10)));
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto result = detect(segments);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    QVERIFY(elapsed < std::chrono::seconds(1));
+
+    QCOMPARE(result.issueCount(), size_t(1));
+    QCOMPARE(result.issues()[0].entityIndex, size_t(4));
+    QCOMPARE(result.issues()[0].relatedEntityIndex, segments.size() - 1);
+}
+
+QTEST_MAIN(TestSelfIntersection)
+#include "test_SelfIntersection.moc"
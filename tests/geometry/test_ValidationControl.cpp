@@ -0,0 +1,279 @@
+#include <QtTest/QtTest>
+#include "geometry/GeometryValidator.h"
+#include "geometry/GeometryConstants.h"
+#include "geometry/DuplicateIndex.h"
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace OwnCAD::Geometry;
+
+class TestValidationControl : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDefaultControlMatchesPlainOverload();
+    void testCancelledTokenStopsValidation();
+    void testCancelFromProgressCallback();
+    void testDuplicateSweepPollsCancellation();
+    void testProgressReportsEachRule();
+    void testRuleBudgetTruncatesRule();
+    void testTokenCopiesShareState();
+    void testResultIndependentOfThreadCount();
+
+private:
+    static void makeLines(size_t count,
+                          std::vector<std::variant<Line2D, Arc2D>>& entities,
+                          std::vector<std::string>& handles);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+void TestValidationControl::makeLines(size_t count,
+                                      std::vector<std::variant<Line2D, Arc2D>>& entities,
+                                      std::vector<std::string>& handles) {
+    for (size_t i = 0; i < count; ++i) {
+        const double y = static_cast<double>(i);
+        entities.push_back(*Line2D::create(Point2D(0, y), Point2D(10, y)));
+        handles.push_back(std::to_string(i));
+    }
+    // One duplicate so a complete run always reports an issue
+    entities.push_back(*Line2D::create(Point2D(0, 0), Point2D(10, 0)));
+    handles.push_back("dup");
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestValidationControl::testDefaultControlMatchesPlainOverload() {
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    makeLines(500, entities, handles);
+
+    const auto plain = GeometryValidator::validateEntitiesWithHandles(
+        entities, handles, GEOMETRY_EPSILON);
+    const auto controlled = GeometryValidator::validateEntitiesWithHandles(
+        entities, handles, GEOMETRY_EPSILON, ValidationControl());
+
+    QVERIFY(plain.isComplete());
+    QVERIFY(controlled.isComplete());
+    QCOMPARE(controlled.issueCount(), plain.issueCount());
+    QCOMPARE(controlled.isValid, plain.isValid);
+    QVERIFY(plain.issueCount() > 0);
+}
+
+void TestValidationControl::testCancelledTokenStopsValidation() {
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    makeLines(500, entities, handles);
+
+    ValidationControl control;
+    control.cancellation.cancel();
+
+    const auto result = GeometryValidator::validateEntitiesWithHandles(
+        entities, handles, GEOMETRY_EPSILON, control);
+    QVERIFY(result.cancelled);
+    QVERIFY(!result.isComplete());
+    QCOMPARE(result.issueCount(), size_t(0));
+
+    const auto duplicates = GeometryValidator::detectDuplicates(
+        entities, handles, GEOMETRY_EPSILON, control);
+    QVERIFY(duplicates.cancelled);
+    QCOMPARE(duplicates.issueCount(), size_t(0));
+}
+
+void TestValidationControl::testCancelFromProgressCallback() {
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    makeLines(10000, entities, handles);
+
+    // Cancel from inside the run, as a UI thread would while it is running
+    ValidationControl control;
+    control.progressInterval = 100;
+    size_t lastProcessed = 0;
+    control.progress = [&control, &lastProcessed](const ValidationProgress& progress) {
+        lastProcessed = progress.processed;
+        if (progress.processed >= 1000) {
+            control.cancellation.cancel();
+        }
+    };
+
+    const auto result = GeometryValidator::validateEntitiesWithHandles(
+        entities, handles, GEOMETRY_EPSILON, control);
+    QVERIFY(result.cancelled);
+    QVERIFY(lastProcessed < entities.size());
+}
+
+void TestValidationControl::testDuplicateSweepPollsCancellation() {
+    // Every line and circle doubled, each pair in a cell of its own
+    const size_t count = 20 * CANCEL_CHECK_CELLS;
+    std::vector<Line2D> lines;
+    std::vector<Arc2D> arcs;
+    for (size_t i = 0; i < count; ++i) {
+        const double y = 100.0 * static_cast<double>(i);
+        lines.push_back(*Line2D::create(Point2D(0, y), Point2D(10, y)));
+        lines.push_back(lines.back());
+        arcs.push_back(*Arc2D::create(Point2D(0, y), 1.0, 0.0, TWO_PI, true));
+        arcs.push_back(arcs.back());
+    }
+    LineDuplicateIndex lineIndex(GEOMETRY_EPSILON);
+    ArcDuplicateIndex arcIndex(GEOMETRY_EPSILON);
+    for (size_t i = 0; i < lines.size(); ++i) {
+        lineIndex.insert(i, lines[i]);
+        arcIndex.insert(i, arcs[i]);
+    }
+
+    CancellationToken live;
+    CancellationToken cancelled;
+    cancelled.cancel();
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        QCOMPARE(lineIndex.findPairs(threads, &live).size(), count);
+        QCOMPARE(arcIndex.findPairs(threads, &live).size(), count);
+        QVERIFY(lineIndex.findPairs(threads, &cancelled).size() < count / 2);   // Stopped mid-sweep
+        QVERIFY(arcIndex.findPairs(threads, &cancelled).size() < count / 2);
+    }
+}
+
+void TestValidationControl::testProgressReportsEachRule() {
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    makeLines(1000, entities, handles);
+
+    ValidationControl control;
+    control.progressInterval = 64;
+    std::vector<ValidationProgress> reports;
+    control.progress = [&reports](const ValidationProgress& progress) {
+        reports.push_back(progress);
+    };
+
+    const auto result = GeometryValidator::validateEntitiesWithHandles(
+        entities, handles, GEOMETRY_EPSILON, control);
+    QVERIFY(result.isComplete());
+
+    bool entityChecksDone = false;
+    bool duplicatesDone = false;
+    bool intersectionsDone = false;
+    for (const auto& report : reports) {
+        QVERIFY(report.processed <= report.total);
+        QCOMPARE(report.total, entities.size());
+        const std::string rule = report.rule;
+        if (rule == GeometryValidator::RULE_ENTITY_CHECKS && report.processed == report.total) {
+            entityChecksDone = true;
+        }
+        if (rule == GeometryValidator::RULE_DUPLICATES && report.processed == report.total) {
+            duplicatesDone = true;
+        }
+        if (rule == GeometryValidator::RULE_SELF_INTERSECTIONS && report.processed == report.total) {
+            intersectionsDone = true;
+        }
+    }
+    QVERIFY(entityChecksDone);
+    QVERIFY(duplicatesDone);
+    QVERIFY(intersectionsDone);
+    QVERIFY(reports.size() > 2);
+}
+
+void TestValidationControl::testRuleBudgetTruncatesRule() {
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    makeLines(1000, entities, handles);
+
+    // A slow progress consumer pushes every rule over a 1 ms budget
+    ValidationControl control;
+    control.progressInterval = 100;
+    control.ruleBudget = std::chrono::milliseconds(1);
+    control.progress = [](const ValidationProgress&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    };
+
+    const auto result = GeometryValidator::validateEntitiesWithHandles(
+        entities, handles, GEOMETRY_EPSILON, control);
+    QVERIFY(!result.cancelled);
+    QVERIFY(!result.isComplete());
+    QCOMPARE(result.truncatedRules.size(), size_t(3));
+    QCOMPARE(result.truncatedRules[0], std::string(GeometryValidator::RULE_ENTITY_CHECKS));
+    QCOMPARE(result.truncatedRules[1], std::string(GeometryValidator::RULE_DUPLICATES));
+    QCOMPARE(result.truncatedRules[2], std::string(GeometryValidator::RULE_SELF_INTERSECTIONS));
+}
+
+void TestValidationControl::testTokenCopiesShareState() {
+    CancellationToken token;
+    const CancellationToken copy = token;
+    QVERIFY(!copy.isCancelled());
+
+    token.cancel();
+    QVERIFY(copy.isCancelled());
+    QVERIFY(!CancellationToken().isCancelled());
+}
+
+void TestValidationControl::testResultIndependentOfThreadCount() {
+    // Axis-aligned grid lines (two crowded direction buckets), lines at
+    // random angles (many small buckets) and arcs, with planted duplicates
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(0.0, 1000.0);
+    std::uniform_int_distribution<int> grid(0, 400);
+
+    for (int i = 0; i < 20000; ++i) {
+        const double a = grid(rng) * 2.5;
+        const double b = grid(rng) * 2.5;
+        const double len = 1.0 + grid(rng) % 10;
+        if (i % 2 == 0) {
+            entities.push_back(*Line2D::create(Point2D(a, b), Point2D(a + len, b)));
+        } else {
+            entities.push_back(*Line2D::create(Point2D(a, b), Point2D(a, b + len)));
+        }
+    }
+    for (int i = 0; i < 8000; ++i) {
+        const Point2D start(coord(rng), coord(rng));
+        entities.push_back(*Line2D::create(start, Point2D(start.x() + coord(rng) / 50.0 + 0.1,
+                                                          start.y() + coord(rng) / 50.0)));
+    }
+    for (int i = 0; i < 6000; ++i) {
+        const Point2D center(grid(rng) * 2.5, grid(rng) * 2.5);
+        const double startAngle = (grid(rng) % 8) * 0.785;
+        entities.push_back(*Arc2D::create(center, 1.0 + grid(rng) % 3, startAngle,
+                                          startAngle + 1.5, grid(rng) % 2 == 0));
+    }
+    for (int i = 0; i < 500; ++i) {
+        entities.push_back(entities[static_cast<size_t>(grid(rng)) * 80]);
+    }
+    for (size_t i = 0; i < entities.size(); ++i) {
+        handles.push_back(std::to_string(i));
+    }
+
+    auto run = [&](size_t threads) {
+        ValidationControl control;
+        control.threadCount = threads;
+        return GeometryValidator::validateEntitiesWithHandles(entities, handles,
+                                                              GEOMETRY_EPSILON, control);
+    };
+
+    const ValidationResult serial = run(1);
+    QVERIFY(serial.isComplete());
+    QVERIFY(serial.issueCount() >= 500);
+
+    for (size_t threads : {size_t(2), size_t(3), size_t(8), size_t(16), size_t(0)}) {
+        const ValidationResult parallel = run(threads);
+        QVERIFY(parallel.isComplete());
+        QCOMPARE(parallel.isValid, serial.isValid);
+        QCOMPARE(parallel.issueCount(), serial.issueCount());
+        for (size_t i = 0; i < serial.issues().size(); ++i) {
+            const auto& a = serial.issues()[i];
+            const auto& b = parallel.issues()[i];
+            QVERIFY(a.type == b.type);
+            QCOMPARE(b.entityIndex, a.entityIndex);
+            QCOMPARE(b.relatedEntityIndex, a.relatedEntityIndex);
+            QCOMPARE(parallel.handleOf(b.entityIndex), serial.handleOf(a.entityIndex));
+            QCOMPARE(parallel.handleOf(b.relatedEntityIndex), serial.handleOf(a.relatedEntityIndex));
+            QCOMPARE(describe(b), describe(a));
+        }
+    }
+}
+
+QTEST_MAIN(TestValidationControl)
+#include "test_ValidationControl.moc"
@@ -0,0 +1,168 @@
+#include <QtTest/QtTest>
+#include "geometry/GeometryValidator.h"
+#include "geometry/GeometryConstants.h"
+#include <string>
+#include <type_traits>
+
+using namespace OwnCAD::Geometry;
+
+class TestValidationResult : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIssuesAreCompact();
+    void testTypeIndex();
+    void testIndexFollowsEdits();
+    void testHandlesResolvedFromTable();
+    void testAppendRebasesContours();
+    void testDescribeFormatsOnDemand();
+
+private:
+    using Segments = std::vector<std::variant<Line2D, Arc2D>>;
+    static Segments dirtySegments(size_t count);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+TestValidationResult::Segments TestValidationResult::dirtySegments(size_t count) {
+    // Every third line is duplicated, every fifth is nearly degenerate
+    Segments segments;
+    for (size_t i = 0; i < count; ++i) {
+        const double y = static_cast<double>(i);
+        const double length = (i % 5 == 0) ? 5e-9 : 10.0;
+        segments.push_back(*Line2D::create(Point2D(0, y), Point2D(length, y)));
+        if (i % 3 == 0) {
+            segments.push_back(segments.back());
+        }
+    }
+    return segments;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestValidationResult::testIssuesAreCompact() {
+    QVERIFY(std::is_trivially_copyable<GeometryIssue>::value);
+    QVERIFY(sizeof(GeometryIssue) <= 96);
+}
+
+void TestValidationResult::testTypeIndex() {
+    const Segments segments = dirtySegments(3000);
+    const auto result = GeometryValidator::validateEntitiesWithHandles(segments, {}, GEOMETRY_EPSILON);
+
+    QVERIFY(result.hasIssueType(GeometryIssueType::DuplicateLine));
+    QVERIFY(result.hasIssueType(GeometryIssueType::NumericalInstability));
+    QVERIFY(!result.hasIssueType(GeometryIssueType::ZeroRadiusArc));
+
+    size_t total = 0;
+    for (size_t t = 0; t < ISSUE_TYPE_COUNT; ++t) {
+        const auto type = static_cast<GeometryIssueType>(t);
+        const auto positions = result.issuePositionsOfType(type);
+        const auto issues = result.getIssuesOfType(type);
+        QCOMPARE(issues.size(), positions.size());
+        for (size_t k = 0; k < positions.size(); ++k) {
+            QVERIFY(result.issues()[positions[k]].type == type);
+            QCOMPARE(issues[k].entityIndex, result.issues()[positions[k]].entityIndex);
+            QVERIFY(k == 0 || positions[k - 1] < positions[k]);
+        }
+        total += positions.size();
+    }
+    QCOMPARE(total, result.issueCount());
+}
+
+void TestValidationResult::testIndexFollowsEdits() {
+    auto result = GeometryValidator::validateEntitiesWithHandles(dirtySegments(30), {}, GEOMETRY_EPSILON);
+    QVERIFY(!result.hasIssueType(GeometryIssueType::HoleTooSmall));
+
+    // Added issues extend the index
+    result.add(GeometryIssue(GeometryIssueType::HoleTooSmall, 0));
+    QVERIFY(result.hasIssueType(GeometryIssueType::HoleTooSmall));
+    QCOMPARE(result.issuePositionsOfType(GeometryIssueType::HoleTooSmall),
+             std::vector<size_t>{result.issueCount() - 1});
+
+    // An edit that keeps the count: queries scan until reindexed
+    const size_t duplicates = result.getIssuesOfType(GeometryIssueType::DuplicateLine).size();
+    QVERIFY(duplicates > 0);
+    for (GeometryIssue& issue : result.editIssues()) {
+        if (issue.type == GeometryIssueType::DuplicateLine) {
+            issue.type = GeometryIssueType::OverlappingLines;
+        }
+    }
+    QVERIFY(!result.hasIssueType(GeometryIssueType::DuplicateLine));
+    QCOMPARE(result.getIssuesOfType(GeometryIssueType::OverlappingLines).size(), duplicates);
+
+    result.indexIssues();
+    QVERIFY(!result.hasIssueType(GeometryIssueType::DuplicateLine));
+    QCOMPARE(result.issuePositionsOfType(GeometryIssueType::OverlappingLines).size(), duplicates);
+}
+
+void TestValidationResult::testHandlesResolvedFromTable() {
+    const Segments segments = dirtySegments(4);
+    const std::vector<std::string> handles{"A", "B", "C"};  // Shorter than the entity list
+    const auto result = GeometryValidator::validateEntitiesWithHandles(segments, handles, GEOMETRY_EPSILON);
+
+    QVERIFY(!result.handles.empty());
+    QCOMPARE(result.handleOf(1), std::string("B"));
+    QCOMPARE(result.handleOf(10), std::string());
+
+    // A table passed in is shared, not copied
+    const HandleTable table(handles);
+    const auto shared = GeometryValidator::validateEntitiesWithHandles(segments, table, GEOMETRY_EPSILON);
+    QVERIFY(shared.handles.sharesStorage(table));
+    QVERIFY(ValidationResult().handleOf(0).empty());
+}
+
+void TestValidationResult::testAppendRebasesContours() {
+    ValidationResult first;
+    first.isValid = true;
+    GeometryIssue hole(GeometryIssueType::HoleTooSmall, 2);
+    first.setContour(hole, {2, 3, 4});
+    first.add(hole);
+
+    ValidationResult second;
+    second.isValid = false;
+    second.handles = HandleTable(std::vector<std::string>{"X"});
+    GeometryIssue other(GeometryIssueType::HoleTooSmall, 7);
+    second.setContour(other, {7, 8});
+    second.add(other);
+    second.truncatedRules.push_back(GeometryValidator::RULE_HOLE_SIZE);
+
+    first.append(std::move(second));
+    QVERIFY(!first.isValid);
+    QCOMPARE(first.issueCount(), size_t(2));
+    QCOMPARE(first.contourOf(first.issues()[0]), (std::vector<size_t>{2, 3, 4}));
+    QCOMPARE(first.contourOf(first.issues()[1]), (std::vector<size_t>{7, 8}));
+    QCOMPARE(first.handleOf(0), std::string("X"));
+    QCOMPARE(first.truncatedRules.size(), size_t(1));
+    QCOMPARE(first.issuePositionsOfType(GeometryIssueType::HoleTooSmall).size(), size_t(2));
+    QVERIFY(first.contourOf(GeometryIssue(GeometryIssueType::DuplicateLine, 0)).empty());
+}
+
+void TestValidationResult::testDescribeFormatsOnDemand() {
+    GeometryIssue hole(GeometryIssueType::HoleTooSmall, 0);
+    hole.value = 2.0;
+    hole.limit = 3.0;
+    QCOMPARE(describe(hole),
+             std::string("Hole diameter (2.000 mm) is below minimum cuttable size (3.000 mm)"));
+
+    GeometryIssue unstable(GeometryIssueType::NumericalInstability, 0);
+    QCOMPARE(describe(unstable),
+             std::string("Line length is close to tolerance boundary (numerically unstable)"));
+    unstable.arc = true;
+    QCOMPARE(describe(unstable),
+             std::string("Arc parameters are close to tolerance boundary (numerically unstable)"));
+
+    GeometryIssue crossing(GeometryIssueType::SelfIntersection, 0, 1);
+    QCOMPARE(describe(crossing), std::string("Segments intersect"));
+    crossing.location = Point2D(1.5, 2.0);
+    QCOMPARE(describe(crossing), std::string("Segments intersect at (1.500000, 2.000000)"));
+
+    QCOMPARE(describe(GeometryIssue(GeometryIssueType::DuplicateArc, 0, 1)),
+             std::string(GeometryValidator::pairDescription(GeometryIssueType::DuplicateArc)));
+}
+
+QTEST_MAIN(TestValidationResult)
+#include "test_ValidationResult.moc"
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "import/DXFEntity.h"
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+/**
+ * @file DXFTestHelpers.h
+ * @brief Synthetic DXF drawings and parse fingerprints shared by the
+ *        import and DXF tests
+ *
+ * Entity i is the (i % mix.size())-th sample of the mix, placed at
+ * x = i * spacing. Values are exact in 15 decimals so text and binary
+ * round trips agree.
+ */
+
+namespace OwnCAD {
+namespace Import {
+namespace Testing {
+
+/**
+ * @brief Entity templates a drawing is mixed from
+ */
+enum class Sample {
+    Line,           ///< Handle, layer and color
+    Arc,
+    Circle,
+    Polyline,       ///< Closed three-vertex LWPOLYLINE with a bulge
+    Ellipse,
+    Spline,         ///< Cubic, four control points
+    Point,
+    Solid,
+    Text,           ///< Unsupported, skipped by the parser
+    ZeroLine,       ///< Parses, fails conversion (zero length)
+    BadArc,         ///< Parses, fails conversion (negative radius)
+    BadNumber,      ///< LINE with an unparsable coordinate (parse error)
+    ShortPolyline   ///< LWPOLYLINE with one vertex (parse error)
+};
+
+/**
+ * @brief ENTITIES section body: count entities cycling through the mix
+ */
+inline std::string entities(size_t count, const std::vector<Sample>& mix, double spacing = 1.0) {
+    std::ostringstream out;
+    out.precision(17);
+    for (size_t i = 0; i < count; ++i) {
+        const double x = static_cast<double>(i) * spacing;
+        switch (mix[i % mix.size()]) {
+            case Sample::Line:
+                out << "0\nLINE\n5\n" << std::hex << (0x100 + i) << std::dec << "\n8\nCut\n62\n1\n"
+                    << "10\n" << x << "\n20\n0.5\n30\n0\n11\n" << x + 1 << "\n21\n2.5\n31\n0\n";
+                break;
+            case Sample::Arc:
+                out << "0\nARC\n5\nA" << i << "\n8\nCut\n62\n256\n10\n" << x
+                    << "\n20\n1\n30\n0\n40\n2.5\n50\n0\n51\n90\n";
+                break;
+            case Sample::Circle:
+                out << "0\nCIRCLE\n5\nC" << i << "\n8\nHoles\n62\n3\n10\n" << x
+                    << "\n20\n-4\n30\n0\n40\n1.25\n";
+                break;
+            case Sample::Polyline:
+                out << "0\nLWPOLYLINE\n5\nP" << i << "\n8\nCut\n62\n256\n90\n3\n70\n1\n10\n" << x
+                    << "\n20\n0\n42\n0.5\n10\n" << x + 1 << "\n20\n0\n10\n" << x + 1 << "\n20\n1\n";
+                break;
+            case Sample::Ellipse:
+                out << "0\nELLIPSE\n5\nE" << i << "\n8\nCut\n62\n5\n10\n" << x << "\n20\n3\n30\n0\n"
+                    << "11\n2\n21\n0.5\n31\n0\n40\n0.5\n41\n0.25\n42\n1.5\n";
+                break;
+            case Sample::Spline:
+                out << "0\nSPLINE\n5\nK" << i << "\n8\nCut\n62\n256\n70\n8\n71\n3\n72\n8\n73\n4\n"
+                    << "40\n0\n40\n0\n40\n0\n40\n0\n40\n1\n40\n1\n40\n1\n40\n1\n"
+                    << "10\n" << x << "\n20\n0\n30\n0\n10\n" << x + 1 << "\n20\n2\n30\n0\n"
+                    << "10\n" << x + 2 << "\n20\n-2\n30\n0\n10\n" << x + 3 << "\n20\n0\n30\n0.5\n";
+                break;
+            case Sample::Point:
+                out << "0\nPOINT\n5\nT" << i << "\n8\nMarks\n62\n256\n10\n" << x << "\n20\n7\n30\n0\n";
+                break;
+            case Sample::Solid:
+                out << "0\nSOLID\n5\nS" << i << "\n8\nFill\n62\n256\n10\n" << x << "\n20\n0\n30\n0\n11\n"
+                    << x + 1 << "\n21\n0\n31\n0\n12\n" << x << "\n22\n1\n32\n0\n13\n" << x + 1
+                    << "\n23\n1\n33\n0\n";
+                break;
+            case Sample::Text:
+                out << "0\nTEXT\n8\nNotes\n1\nPart " << i << "\n10\n" << x << "\n20\n0\n";
+                break;
+            case Sample::ZeroLine:
+                out << "0\nLINE\n10\n" << x << "\n20\n20\n11\n" << x << "\n21\n20\n";
+                break;
+            case Sample::BadArc:
+                out << "0\nARC\n10\n" << x << "\n20\n30\n40\n-1\n50\n0\n51\n90\n";
+                break;
+            case Sample::BadNumber:
+                out << "0\nLINE\n10\nbad" << i << "\n20\n0\n11\n1\n21\n1\n";
+                break;
+            case Sample::ShortPolyline:
+                out << "0\nLWPOLYLINE\n90\n1\n10\n" << x << "\n20\n0\n";
+                break;
+        }
+    }
+    return out.str();
+}
+
+/**
+ * @brief Complete drawing: one ENTITIES section holding entities()
+ */
+inline std::string drawing(size_t count, const std::vector<Sample>& mix, double spacing = 1.0) {
+    return "0\nSECTION\n2\nENTITIES\n" + entities(count, mix, spacing) + "0\nENDSEC\n0\nEOF\n";
+}
+
+/**
+ * @brief Every field of every parsed entity, plus the counters and messages
+ *
+ * Doubles are printed with 17 significant digits, so two results have the
+ * same fingerprint only if they are bit for bit the same.
+ */
+inline std::string fingerprint(const DXFParseResult& result) {
+    static_assert(std::variant_size_v<DXFEntityVariant> == 9, "Fingerprint the new entity type");
+
+    std::ostringstream out;
+    out.precision(17);
+    auto vertices = [&out](const std::vector<DXFVertex>& list) {
+        out << " [";
+        for (const auto& vertex : list) {
+            out << ' ' << vertex.x << ',' << vertex.y << ',' << vertex.z << ',' << vertex.bulge;
+        }
+        out << " ]";
+    };
+
+    out << result.success << ' ' << result.totalEntities << ' ' << result.skippedEntities << '\n';
+    for (const auto& entity : result.entities) {
+        out << toString(entity.type) << '@' << entity.lineNumber << ' ' << entity.data.index() << ' ';
+        std::visit([&](const auto& data) {
+            using T = std::decay_t<decltype(data)>;
+            out << data.layer << '/' << data.handle << '/' << data.colorNumber;
+            if constexpr (std::is_same_v<T, DXFLine>) {
+                out << ' ' << data.startX << ' ' << data.startY << ' ' << data.startZ
+                    << ' ' << data.endX << ' ' << data.endY << ' ' << data.endZ;
+            } else if constexpr (std::is_same_v<T, DXFArc>) {
+                out << ' ' << data.centerX << ' ' << data.centerY << ' ' << data.centerZ
+                    << ' ' << data.radius << ' ' << data.startAngle << ' ' << data.endAngle;
+            } else if constexpr (std::is_same_v<T, DXFCircle>) {
+                out << ' ' << data.centerX << ' ' << data.centerY << ' ' << data.centerZ << ' ' << data.radius;
+            } else if constexpr (std::is_same_v<T, DXFPolyline> || std::is_same_v<T, DXFLWPolyline>) {
+                out << ' ' << data.closed;
+                vertices(data.vertices);
+            } else if constexpr (std::is_same_v<T, DXFEllipse>) {
+                out << ' ' << data.centerX << ' ' << data.centerY << ' ' << data.centerZ
+                    << ' ' << data.majorAxisX << ' ' << data.majorAxisY << ' ' << data.majorAxisZ
+                    << ' ' << data.minorAxisRatio << ' ' << data.startParameter << ' ' << data.endParameter;
+            } else if constexpr (std::is_same_v<T, DXFSpline>) {
+                out << ' ' << data.degree << ' ' << data.closed << ' ' << data.periodic << ' ' << data.rational;
+                vertices(data.controlPoints);
+                out << " [";
+                for (double knot : data.knots) {
+                    out << ' ' << knot;
+                }
+                out << " ]";
+            } else if constexpr (std::is_same_v<T, DXFPoint>) {
+                out << ' ' << data.x << ' ' << data.y << ' ' << data.z;
+            } else if constexpr (std::is_same_v<T, DXFSolid>) {
+                out << ' ' << data.x1 << ' ' << data.y1 << ' ' << data.z1
+                    << ' ' << data.x2 << ' ' << data.y2 << ' ' << data.z2
+                    << ' ' << data.x3 << ' ' << data.y3 << ' ' << data.z3
+                    << ' ' << data.x4 << ' ' << data.y4 << ' ' << data.z4 << ' ' << data.isTriangle;
+            }
+        }, entity.data);
+        out << '\n';
+    }
+    for (const auto& error : result.errors) {
+        out << "E " << error << '\n';
+    }
+    for (const auto& warning : result.warnings) {
+        out << "W " << warning << '\n';
+    }
+    return out.str();
+}
+
+} // namespace Testing
+} // namespace Import
+} // namespace OwnCAD
@@ -0,0 +1,247 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "import/DXFTokenizer.h"
+#include "import/DXFParser.h"
+#include <chrono>
+#include <clocale>
+#include <fstream>
+#include <sstream>
+
+using namespace OwnCAD::Import;
+
+class TestDXFTokenizer : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testLineEndings();
+    void testTrimAndInnerSpaces();
+    void testByteOrderMark();
+    void testMalformedGroupCode();
+    void testNumbers();
+    void testMappedFile();
+    void testParseFileMatchesParseString();
+    void testThroughput();
+
+private:
+    static std::string lineDXF(size_t count, const char* newline);
+};
+
+std::string TestDXFTokenizer::lineDXF(size_t count, const char* newline) {
+    std::ostringstream out;
+    out << "0" << newline << "SECTION" << newline << "2" << newline << "ENTITIES" << newline;
+    for (size_t i = 0; i < count; ++i) {
+        out << "  0" << newline << "LINE" << newline
+            << "  5" << newline << std::hex << (0x100 + i) << std::dec << newline
+            << "  8" << newline << "Cut Layer" << newline
+            << " 10" << newline << (i * 1.25) << newline
+            << " 20" << newline << "-" << (i * 0.5) << newline
+            << " 11" << newline << (i * 1.25 + 10.0) << newline
+            << " 21" << newline << "+" << (i * 0.5 + 3.0) << newline;
+    }
+    out << "0" << newline << "ENDSEC" << newline << "0" << newline << "EOF" << newline;
+    return out.str();
+}
+
+void TestDXFTokenizer::testLineEndings() {
+    for (const char* newline : {"\n", "\r\n"}) {
+        const std::string text = std::string("0") + newline + "LINE" + newline + "10" + newline + "1.5";
+        DXFTokenizer tokenizer(text);
+        int code = -1;
+        DXFValue value;
+
+        QVERIFY(tokenizer.next(code, value));
+        QCOMPARE(code, 0);
+        QVERIFY(value == "LINE");
+        QCOMPARE(tokenizer.lineNumber(), size_t(2));
+
+        QVERIFY(tokenizer.next(code, value));   // Last line has no newline
+        QCOMPARE(code, 10);
+        QVERIFY(value == "1.5");
+        QCOMPARE(tokenizer.lineNumber(), size_t(4));
+
+        QVERIFY(!tokenizer.next(code, value));
+    }
+}
+
+void TestDXFTokenizer::testTrimAndInnerSpaces() {
+    const std::string text = "  8 \r\n\t Cut  Layer 2 \t\r\n";
+    DXFTokenizer tokenizer(text);
+    int code = 0;
+    DXFValue value;
+    QVERIFY(tokenizer.next(code, value));
+    QCOMPARE(code, 8);
+    QVERIFY(value == "Cut  Layer 2");
+    QVERIFY(value.text.data() >= text.data() && value.text.data() < text.data() + text.size());  // No copy
+
+    QVERIFY(DXFTokenizer::trim(" \t ").empty());
+    QVERIFY(DXFTokenizer::trim("").empty());
+}
+
+void TestDXFTokenizer::testByteOrderMark() {
+    DXFTokenizer tokenizer("\xEF\xBB\xBF" "0\nSECTION\n");
+    int code = -1;
+    DXFValue value;
+    QVERIFY(tokenizer.next(code, value));
+    QCOMPARE(code, 0);
+    QVERIFY(value == "SECTION");
+}
+
+void TestDXFTokenizer::testMalformedGroupCode() {
+    DXFTokenizer tokenizer("0\nLINE\nten\n1.0\n");
+    int code = 0;
+    DXFValue value;
+    QVERIFY(tokenizer.next(code, value));
+    QVERIFY(!tokenizer.next(code, value));
+    QCOMPARE(tokenizer.lineNumber(), size_t(3));
+}
+
+void TestDXFTokenizer::testNumbers() {
+    double d = 0.0;
+    QVERIFY(DXFTokenizer::parseDouble("1.5", d));
+    QCOMPARE(d, 1.5);
+    QVERIFY(DXFTokenizer::parseDouble("+1.5", d));
+    QCOMPARE(d, 1.5);
+    QVERIFY(DXFTokenizer::parseDouble("-2.5e3", d));
+    QCOMPARE(d, -2500.0);
+    QVERIFY(DXFTokenizer::parseDouble(".25", d));
+    QCOMPARE(d, 0.25);
+    QVERIFY(!DXFTokenizer::parseDouble("1.5x", d));
+    QVERIFY(!DXFTokenizer::parseDouble("abc", d));
+    QVERIFY(!DXFTokenizer::parseDouble("", d));
+    QVERIFY(!DXFTokenizer::parseDouble("+", d));
+    QVERIFY(!DXFTokenizer::parseDouble("+-1", d));
+    QVERIFY(!DXFTokenizer::parseDouble("1e999", d));
+
+    // Independent of the process locale (QApplication applies the user's)
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    for (const char* name : {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8"}) {
+        if (std::setlocale(LC_NUMERIC, name)) {
+            QVERIFY(DXFTokenizer::parseDouble("2.75", d));
+            QCOMPARE(d, 2.75);
+            break;
+        }
+    }
+    std::setlocale(LC_NUMERIC, previous.c_str());
+
+    int i = 0;
+    QVERIFY(DXFTokenizer::parseInt("42", i));
+    QCOMPARE(i, 42);
+    QVERIFY(DXFTokenizer::parseInt("+7", i));
+    QCOMPARE(i, 7);
+    QVERIFY(DXFTokenizer::parseInt("-1", i));
+    QCOMPARE(i, -1);
+    QVERIFY(!DXFTokenizer::parseInt("1.0", i));
+    QVERIFY(!DXFTokenizer::parseInt("99999999999", i));
+    QVERIFY(!DXFTokenizer::parseInt("", i));
+}
+
+void TestDXFTokenizer::testMappedFile() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const std::string path = dir.path().toStdString() + "/part.dxf";
+    const std::string empty = dir.path().toStdString() + "/empty.dxf";
+    std::ofstream(path, std::ios::binary) << "0\nEOF\n";
+    std::ofstream(empty, std::ios::binary).flush();
+
+    auto file = MappedFile::open(path);
+    QVERIFY(file.has_value());
+    QVERIFY(file->data() == "0\nEOF\n");
+
+    MappedFile moved = std::move(*file);
+    QCOMPARE(moved.size(), size_t(6));
+    QCOMPARE(file->size(), size_t(0));
+
+    auto none = MappedFile::open(empty);
+    QVERIFY(none.has_value());
+    QVERIFY(none->data().empty());
+
+    QVERIFY(!MappedFile::open(dir.path().toStdString() + "/missing.dxf").has_value());
+    QVERIFY(!MappedFile::open(dir.path().toStdString()).has_value());   // Directory
+}
+
+void TestDXFTokenizer::testParseFileMatchesParseString() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const std::string content = lineDXF(50, "\r\n");
+    const std::string path = dir.path().toStdString() + "/lines.dxf";
+    std::ofstream(path, std::ios::binary) << content;
+
+    const DXFParseResult fromFile = DXFParser::parseFile(path);
+    const DXFParseResult fromString = DXFParser::parseString(content);
+    QVERIFY(fromFile.success);
+    QCOMPARE(fromFile.entities.size(), size_t(50));
+    QCOMPARE(fromString.entities.size(), fromFile.entities.size());
+
+    for (size_t i = 0; i < fromFile.entities.size(); ++i) {
+        const auto& a = std::get<DXFLine>(fromFile.entities[i].data);
+        const auto& b = std::get<DXFLine>(fromString.entities[i].data);
+        QVERIFY(a.layer == "Cut Layer");
+        QVERIFY(a.handle == b.handle);
+        QCOMPARE(a.startX, b.startX);
+        QCOMPARE(a.startY, b.startY);
+        QCOMPARE(a.endY, double(i) * 0.5 + 3.0);
+        QCOMPARE(fromFile.entities[i].lineNumber, fromString.entities[i].lineNumber);
+    }
+    QCOMPARE(fromFile.entities[1].lineNumber, size_t(4 + 2 + 14));  // "LINE" value line of the second entity
+
+    const DXFParseResult missing = DXFParser::parseFile(dir.path().toStdString() + "/missing.dxf");
+    QVERIFY(!missing.success);
+    QCOMPARE(missing.errors.size(), size_t(1));
+}
+
+void TestDXFTokenizer::testThroughput() {
+    const std::string content = lineDXF(20000, "\r\n");
+    using Clock = std::chrono::steady_clock;
+
+    // Previous approach: getline, trim into a new string, std::stoi/std::stod
+    auto trimCopy = [](const std::string& s) {
+        size_t start = s.find_first_not_of(" \t\r\n");
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return start == std::string::npos ? std::string() : s.substr(start, end - start + 1);
+    };
+    double streamSum = 0.0;
+    size_t streamGroups = 0;
+    const auto streamStart = Clock::now();
+    {
+        std::istringstream input(content);
+        std::string codeLine;
+        std::string value;
+        while (std::getline(input, codeLine) && std::getline(input, value)) {
+            const int code = std::stoi(trimCopy(codeLine));
+            value = trimCopy(value);
+            if (code >= 10 && code < 60) {
+                streamSum += std::stod(value);
+            }
+            ++streamGroups;
+        }
+    }
+    const double streamSeconds = std::chrono::duration<double>(Clock::now() - streamStart).count();
+
+    double tokenSum = 0.0;
+    size_t tokenGroups = 0;
+    const auto tokenStart = Clock::now();
+    {
+        DXFTokenizer tokenizer(content);
+        int code = 0;
+        DXFValue value;
+        double number = 0.0;
+        while (tokenizer.next(code, value)) {
+            if (code >= 10 && code < 60 && DXFTokenizer::parseDouble(value, number)) {
+                tokenSum += number;
+            }
+            ++tokenGroups;
+        }
+    }
+    const double tokenSeconds = std::chrono::duration<double>(Clock::now() - tokenStart).count();
+
+    QCOMPARE(tokenGroups, streamGroups);
+    QCOMPARE(tokenSum, streamSum);
+    qDebug() << "stream:" << streamSeconds * 1000.0 << "ms, tokenizer:" << tokenSeconds * 1000.0
+             << "ms, speedup" << streamSeconds / tokenSeconds;
+
+    // Loose bound so the test stays stable on loaded machines
+    QVERIFY(tokenSeconds * 2.0 < streamSeconds);
+}
+
+QTEST_MAIN(TestDXFTokenizer)
+#include "test_DXFTokenizer.moc"
@@ -0,0 +1,188 @@
+#include <QtTest/QtTest>
+#include "DXFTestHelpers.h"
+#include "import/ImportDiagnostics.h"
+#include "import/ImportPipeline.h"
+#include <QTemporaryDir>
+#include <fstream>
+
+using namespace OwnCAD::Import;
+using namespace OwnCAD::Import::Testing;
+
+// Every third line has zero length
+const std::vector<Sample> MIX = {Sample::Line, Sample::Line, Sample::ZeroLine};
+
+class TestImportDiagnostics : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDefaultCountsOnly();
+    void testLevelFiltersMessages();
+    void testMessageCap();
+    void testJsonLines();
+    void testPipelineCounts();
+
+private:
+    static std::vector<DXFEntity> sample();
+};
+
+/**
+ * @brief Two good lines, a zero-length line, a circle and a bad arc
+ */
+std::vector<DXFEntity> TestImportDiagnostics::sample() {
+    std::vector<DXFEntity> entities;
+    auto addLine = [&](double x1, double x2, size_t lineNumber) {
+        DXFLine line;
+        line.layer = "Cut";
+        line.startX = x1;
+        line.endX = x2;
+        line.endY = 1.0;
+        DXFEntity entity;
+        entity.type = DXFEntityType::Line;
+        entity.data = line;
+        entity.lineNumber = lineNumber;
+        entities.push_back(entity);
+    };
+    addLine(0.0, 5.0, 10);
+    addLine(1.0, 7.0, 24);
+
+    DXFLine zero;
+    zero.layer = "Cut";
+    DXFEntity degenerate;
+    degenerate.type = DXFEntityType::Line;
+    degenerate.data = zero;
+    degenerate.lineNumber = 38;
+    entities.push_back(degenerate);
+
+    DXFCircle circle;
+    circle.layer = "Cut";
+    circle.radius = 2.0;
+    DXFEntity round;
+    round.type = DXFEntityType::Circle;
+    round.data = circle;
+    round.lineNumber = 52;
+    entities.push_back(round);
+
+    DXFArc arc;
+    arc.layer = "Cut";
+    arc.radius = -1.0;
+    DXFEntity bad;
+    bad.type = DXFEntityType::Arc;
+    bad.data = arc;
+    bad.lineNumber = 64;
+    entities.push_back(bad);
+    return entities;
+}
+
+void TestImportDiagnostics::testDefaultCountsOnly() {
+    ImportDiagnostics diagnostics;
+    QVERIFY(!diagnostics.wants(DiagnosticSeverity::Error));
+
+    const ConversionResult result = GeometryConverter::convert(sample(), &diagnostics);
+    QCOMPARE(result.totalConverted, size_t(3));
+    QCOMPARE(diagnostics.count(DXFEntityType::Line, DiagnosticSeverity::Info), size_t(2));
+    QCOMPARE(diagnostics.count(DXFEntityType::Line, DiagnosticSeverity::Error), size_t(1));
+    QCOMPARE(diagnostics.count(DXFEntityType::Circle, DiagnosticSeverity::Info), size_t(1));
+    QCOMPARE(diagnostics.count(DXFEntityType::Arc, DiagnosticSeverity::Error), size_t(1));
+    QCOMPARE(diagnostics.total(DiagnosticSeverity::Info), result.totalConverted);
+    QCOMPARE(diagnostics.total(DiagnosticSeverity::Error), result.totalFailed);
+    QCOMPARE(diagnostics.total(DiagnosticSeverity::Debug), size_t(0));   // Details are not counted
+    QVERIFY(diagnostics.messages().empty());
+    QCOMPARE(diagnostics.droppedMessages(), size_t(0));
+
+    // Without a sink the result is the same
+    const ConversionResult silent = GeometryConverter::convert(sample());
+    QCOMPARE(silent.totalConverted, result.totalConverted);
+    QVERIFY(silent.errors == result.errors);
+}
+
+void TestImportDiagnostics::testLevelFiltersMessages() {
+    DiagnosticOptions options;
+    options.level = DiagnosticSeverity::Error;
+    options.maxMessages = 100;
+    ImportDiagnostics errorsOnly(options);
+    GeometryConverter::convert(sample(), &errorsOnly);
+
+    const auto messages = errorsOnly.messages();
+    QCOMPARE(messages.size(), size_t(2));
+    QVERIFY(messages[0].severity == DiagnosticSeverity::Error);
+    QVERIFY(messages[0].category == DXFEntityType::Line);
+    QCOMPARE(messages[0].lineNumber, size_t(38));
+    QVERIFY(messages[1].category == DXFEntityType::Arc);
+    QCOMPARE(messages[1].lineNumber, size_t(64));
+    QCOMPARE(errorsOnly.total(DiagnosticSeverity::Info), size_t(3));   // Still counted
+
+    options.level = DiagnosticSeverity::Debug;
+    ImportDiagnostics everything(options);
+    GeometryConverter::convert(sample(), &everything);
+    QCOMPARE(everything.messages().size(), size_t(10));   // A detail and an outcome each
+    QVERIFY(everything.messages()[0].severity == DiagnosticSeverity::Debug);
+    QVERIFY(everything.messages()[0].text.find("LINE start (0, 0)") != std::string::npos);
+}
+
+void TestImportDiagnostics::testMessageCap() {
+    DiagnosticOptions options;
+    options.maxMessages = 2;
+    ImportDiagnostics diagnostics(options);
+    GeometryConverter::convert(sample(), &diagnostics);
+
+    QCOMPARE(diagnostics.messages().size(), size_t(2));
+    QCOMPARE(diagnostics.droppedMessages(), size_t(3));
+    QCOMPARE(diagnostics.total(DiagnosticSeverity::Info) + diagnostics.total(DiagnosticSeverity::Error),
+             size_t(5));
+}
+
+void TestImportDiagnostics::testJsonLines() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const std::string path = dir.filePath("import.jsonl").toStdString();
+
+    DiagnosticOptions options;
+    options.jsonLinesPath = path;
+    {
+        ImportDiagnostics diagnostics(options);
+        QVERIFY(diagnostics.fileOk());
+        QVERIFY(diagnostics.wants(DiagnosticSeverity::Info));   // A file alone keeps messages
+        GeometryConverter::convert(sample(), &diagnostics);
+        diagnostics.report(DiagnosticSeverity::Warning, DXFEntityType::Unknown, 7,
+                           "quote \" slash \\ tab\t end");
+        QVERIFY(diagnostics.messages().empty());
+        QCOMPARE(diagnostics.droppedMessages(), size_t(6));
+    }
+
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    QCOMPARE(lines.size(), size_t(6));
+    QCOMPARE(lines[2], std::string("{\"severity\":\"error\",\"category\":\"LINE\",\"line\":38,"
+                                   "\"message\":\"LINE rejected: zero-length or invalid coordinates\"}"));
+    QCOMPARE(lines[5], std::string("{\"severity\":\"warning\",\"category\":\"UNKNOWN\",\"line\":7,"
+                                   "\"message\":\"quote \\\" slash \\\\ tab\\t end\"}"));
+
+    options.jsonLinesPath = dir.filePath("missing/import.jsonl").toStdString();
+    ImportDiagnostics unwritable(options);
+    QVERIFY(!unwritable.fileOk());
+    QVERIFY(!unwritable.wants(DiagnosticSeverity::Error));
+}
+
+void TestImportDiagnostics::testPipelineCounts() {
+    DiagnosticOptions diagnosticOptions;
+    diagnosticOptions.level = DiagnosticSeverity::Error;
+    diagnosticOptions.maxMessages = 10000;
+    ImportDiagnostics diagnostics(diagnosticOptions);
+
+    ImportOptions options;
+    options.batchSize = 50;
+    options.threadCount = 4;
+    options.diagnostics = &diagnostics;
+    const ImportResult result = ImportPipeline::importString(drawing(3000, MIX), options, nullptr);
+
+    QCOMPARE(diagnostics.count(DXFEntityType::Line, DiagnosticSeverity::Info), size_t(2000));
+    QCOMPARE(diagnostics.count(DXFEntityType::Line, DiagnosticSeverity::Error), size_t(1000));
+    QCOMPARE(diagnostics.total(DiagnosticSeverity::Error), result.conversion.totalFailed);
+    QCOMPARE(diagnostics.messages().size(), size_t(1000));
+}
+
+QTEST_MAIN(TestImportDiagnostics)
+#include "test_ImportDiagnostics.moc"
@@ -0,0 +1,165 @@
+#include <QtTest/QtTest>
+#include "DXFTestHelpers.h"
+#include "import/ImportPipeline.h"
+#include <sstream>
+
+using namespace OwnCAD::Import;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import::Testing;
+
+// Lines, arcs, circles and polylines, with degenerate and invalid ones
+const std::vector<Sample> MIX = {Sample::Line, Sample::Arc, Sample::Circle, Sample::Polyline,
+                                 Sample::ZeroLine, Sample::BadArc};
+constexpr double SPACING = 10.0;
+
+class TestImportPipeline : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSameAsParseAndConvert();
+    void testBatchesInFlightBounded();
+    void testEntityIssuesMatchValidator();
+    void testCornerRuleLeavesIssuesUnset();
+    void testMissingFile();
+
+private:
+    static std::string fingerprint(const std::vector<GeometryEntityWithMetadata>& entities);
+    static std::vector<GeometryEntityWithMetadata> import(const std::string& content,
+                                                          const ImportOptions& options,
+                                                          ImportResult& result);
+};
+
+std::string TestImportPipeline::fingerprint(const std::vector<GeometryEntityWithMetadata>& entities) {
+    std::ostringstream out;
+    out.precision(17);
+    for (const auto& record : entities) {
+        out << record.entity.index() << ' ' << record.handle << ' ' << record.layer << ' '
+            << record.colorNumber << ' ' << record.sourceLineNumber << '\n';
+    }
+    return out.str();
+}
+
+std::vector<GeometryEntityWithMetadata> TestImportPipeline::import(const std::string& content,
+                                                                   const ImportOptions& options,
+                                                                   ImportResult& result) {
+    std::vector<GeometryEntityWithMetadata> stored;
+    result = ImportPipeline::importString(content, options,
+        [&stored](std::vector<GeometryEntityWithMetadata>&& batch) {
+            stored.insert(stored.end(),
+                          std::make_move_iterator(batch.begin()),
+                          std::make_move_iterator(batch.end()));
+        });
+    return stored;
+}
+
+void TestImportPipeline::testSameAsParseAndConvert() {
+    const std::string content = drawing(3000, MIX, SPACING);
+    const DXFParseResult parsed = DXFParser::parseString(content);
+    const ConversionResult expected = GeometryConverter::convert(parsed.entities);
+
+    for (size_t threads : {size_t(1), size_t(4)}) {
+        ImportOptions options;
+        options.batchSize = 100;
+        options.threadCount = threads;
+        ImportResult result;
+        const auto stored = import(content, options, result);
+
+        QVERIFY(result.parse.success);
+        QVERIFY(result.parse.entities.empty());        // Streamed, not kept
+        QCOMPARE(result.parse.totalEntities, parsed.totalEntities);
+        QCOMPARE(result.conversion.totalConverted, expected.totalConverted);
+        QCOMPARE(result.conversion.totalFailed, expected.totalFailed);
+        QVERIFY(result.conversion.errors == expected.errors);
+        QVERIFY(result.conversion.warnings == expected.warnings);
+        QCOMPARE(result.conversion.success, expected.success);
+        QCOMPARE(stored.size(), expected.entities.size());
+        QVERIFY(fingerprint(stored) == fingerprint(expected.entities));
+        QCOMPARE(result.batches, size_t((parsed.totalEntities + 99) / 100));
+    }
+}
+
+void TestImportPipeline::testBatchesInFlightBounded() {
+    ImportOptions options;
+    options.batchSize = 10;
+    options.queueDepth = 2;
+    options.threadCount = 2;
+    ImportResult result;
+    const auto stored = import(drawing(6000, MIX, SPACING), options, result);
+
+    QVERIFY(!stored.empty());
+    QVERIFY(result.batches > 100);
+    QVERIFY(result.peakBatchesInFlight >= 1);
+    // Both queues full, one batch per converter, one being parsed, one delivered
+    QVERIFY(result.peakBatchesInFlight <= 2 * options.queueDepth + options.threadCount + 2);
+}
+
+void TestImportPipeline::testEntityIssuesMatchValidator() {
+    ImportOptions options;
+    options.batchSize = 64;
+    options.threadCount = 3;
+    options.checkEntities = true;
+    options.rules.minEdgeLength = 3.0;       // Flags the lines
+    ImportResult result;
+    const auto stored = import(drawing(1200, MIX, SPACING), options, result);
+    QVERIFY(result.entityIssues);
+    QVERIFY(!result.entityIssues->empty());
+
+    std::vector<std::variant<Line2D, Arc2D>> entities;
+    std::vector<std::string> handles;
+    for (const auto& record : stored) {
+        if (std::holds_alternative<Line2D>(record.entity)) {
+            entities.push_back(std::get<Line2D>(record.entity));
+        } else if (std::holds_alternative<Arc2D>(record.entity)) {
+            entities.push_back(std::get<Arc2D>(record.entity));
+        } else {
+            continue;
+        }
+        handles.push_back(record.handle);
+    }
+
+    ValidationControl control;
+    control.rules = options.rules;
+    const ValidationResult full =
+        GeometryValidator::validateEntitiesWithHandles(entities, handles, options.tolerance, control);
+    control.entityIssues = result.entityIssues;
+    const ValidationResult reused =
+        GeometryValidator::validateEntitiesWithHandles(entities, handles, options.tolerance, control);
+
+    QCOMPARE(reused.isValid, full.isValid);
+    QCOMPARE(reused.issues().size(), full.issues().size());
+    for (size_t i = 0; i < full.issues().size(); ++i) {
+        QCOMPARE(reused.issues()[i].type, full.issues()[i].type);
+        QCOMPARE(reused.issues()[i].entityIndex, full.issues()[i].entityIndex);
+        QCOMPARE(reused.issues()[i].relatedEntityIndex, full.issues()[i].relatedEntityIndex);
+        QCOMPARE(reused.issues()[i].value, full.issues()[i].value);
+        QCOMPARE(reused.issues()[i].arc, full.issues()[i].arc);
+    }
+}
+
+void TestImportPipeline::testCornerRuleLeavesIssuesUnset() {
+    ImportOptions options;
+    options.checkEntities = true;
+    options.rules.minCornerAngle = 0.5;
+    ImportResult result;
+    import(drawing(60, MIX, SPACING), options, result);
+    QVERIFY(!result.entityIssues);
+
+    options.checkEntities = false;
+    options.rules.minCornerAngle = 0.0;
+    import(drawing(60, MIX, SPACING), options, result);
+    QVERIFY(!result.entityIssues);
+}
+
+void TestImportPipeline::testMissingFile() {
+    size_t delivered = 0;
+    const ImportResult result = ImportPipeline::importFile(
+        "/nonexistent/drawing.dxf", ImportOptions(),
+        [&delivered](std::vector<GeometryEntityWithMetadata>&& batch) { delivered += batch.size(); });
+    QVERIFY(!result.parse.success);
+    QVERIFY(!result.parse.errors.empty());
+    QCOMPARE(delivered, size_t(0));
+    QCOMPARE(result.batches, size_t(0));
+}
+
+QTEST_MAIN(TestImportPipeline)
+#include "test_ImportPipeline.moc"
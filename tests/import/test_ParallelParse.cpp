@@ -0,0 +1,77 @@
+#include <QtTest/QtTest>
+#include "DXFTestHelpers.h"
+#include "import/DXFParser.h"
+
+using namespace OwnCAD::Import;
+using namespace OwnCAD::Import::Testing;
+
+// Six of every nine entities parse; the last two are parse errors
+const std::vector<Sample> MIX = {Sample::Line, Sample::Arc, Sample::Circle, Sample::Polyline,
+                                 Sample::Ellipse, Sample::Spline, Sample::Text,
+                                 Sample::BadNumber, Sample::ShortPolyline};
+
+class TestParallelParse : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testIdenticalToSequential();
+    void testSectionsAroundEntities();
+    void testMalformedGroupFallsBack();
+    void testMissingEndsec();
+    void testSmallFileUnchanged();
+
+private:
+    static void compare(const std::string& content);
+};
+
+void TestParallelParse::compare(const std::string& content) {
+    const DXFParseResult sequential = DXFParser::parseString(content, 1);
+    const DXFParseResult parallel = DXFParser::parseString(content, 4);
+    QCOMPARE(parallel.entities.size(), sequential.entities.size());
+    QCOMPARE(parallel.errors.size(), sequential.errors.size());
+    QVERIFY(fingerprint(parallel) == fingerprint(sequential));
+}
+
+void TestParallelParse::testIdenticalToSequential() {
+    const std::string content = drawing(40000, MIX);
+    QVERIFY(content.size() > 4 * DXFParser::MIN_CHUNK_BYTES);   // Several chunks
+    compare(content);
+
+    const DXFParseResult result = DXFParser::parseString(content, 4);
+    QCOMPARE(result.totalEntities, size_t(26668));   // Six of every nine parse
+    QCOMPARE(result.errors.size(), size_t(2 * 4444));
+}
+
+void TestParallelParse::testSectionsAroundEntities() {
+    // Groups before the first entity, a HEADER before and an OBJECTS
+    // section after, and a second ENTITIES section
+    const std::string body = entities(20000, MIX);
+    const std::string content =
+        "0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1015\n0\nENDSEC\n"
+        "0\nSECTION\n2\nENTITIES\n5\nstray\n" + body + "0\nENDSEC\n"
+        "0\nSECTION\n2\nOBJECTS\n0\nDICTIONARY\n5\nC\n0\nENDSEC\n"
+        "0\nSECTION\n2\nENTITIES\n" + body + "0\nENDSEC\n0\nEOF\n";
+    compare(content);
+    QCOMPARE(DXFParser::parseString(content, 4).totalEntities,
+             2 * DXFParser::parseString("0\nSECTION\n2\nENTITIES\n" + body, 1).totalEntities);
+}
+
+void TestParallelParse::testMalformedGroupFallsBack() {
+    std::string content = "0\nSECTION\n2\nENTITIES\n" + entities(20000, MIX);
+    content += "ten\n1.0\n" + entities(20000, MIX) + "0\nENDSEC\n0\nEOF\n";
+    compare(content);
+}
+
+void TestParallelParse::testMissingEndsec() {
+    compare("0\nSECTION\n2\nENTITIES\n" + entities(20000, MIX));
+    compare("0\nSECTION\n2\nENTITIES\n" + entities(20000, MIX) + "0\nEOF\n");
+}
+
+void TestParallelParse::testSmallFileUnchanged() {
+    const std::string content = drawing(14, MIX);
+    compare(content);
+    QCOMPARE(DXFParser::parseString(content, 4).totalEntities, size_t(11));
+}
+
+QTEST_MAIN(TestParallelParse)
+#include "test_ParallelParse.moc"
@@ -0,0 +1,302 @@
+#include <QtTest/QtTest>
+#include "../import/DXFTestHelpers.h"
+#include <QTemporaryDir>
+#include "export/DXFWriter.h"
+#include "import/DXFParser.h"
+#include "import/DXFTokenizer.h"
+#include "model/DocumentModel.h"
+#include "model/ExportValidator.h"
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+using namespace OwnCAD::Import;
+using namespace OwnCAD::Export;
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import::Testing;
+
+// Every entity parses and the writer supports every type (it has no SPLINE)
+const std::vector<Sample> MIX = {Sample::Line, Sample::Arc, Sample::Circle, Sample::Polyline,
+                                 Sample::Ellipse, Sample::Point, Sample::Solid};
+constexpr double SPACING = 0.25;
+
+class TestBinaryDXF : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testSentinel();
+    void testTypedValues();
+    void testOneByteCodes();
+    void testMalformedGroups();
+    void testSameEntitiesAsText();
+    void testExactDoubles();
+    void testParallelParse();
+    void testDocumentRoundTrip();
+    void testRoundTripBenchmark();
+
+private:
+    static std::string write(const std::vector<DXFEntity>& entities, DXFFormat format);
+    static void code(std::string& out, int groupCode);
+    static void text(std::string& out, int groupCode, const std::string& value);
+    static void number(std::string& out, int groupCode, double value);
+};
+
+std::string TestBinaryDXF::write(const std::vector<DXFEntity>& entities, DXFFormat format) {
+    std::ostringstream out(std::ios::out | std::ios::binary);
+    if (!DXFWriter::writeStream(out, entities, format)) {
+        return std::string();
+    }
+    return out.str();
+}
+
+void TestBinaryDXF::code(std::string& out, int groupCode) {
+    out += static_cast<char>(groupCode & 0xFF);
+    out += static_cast<char>((groupCode >> 8) & 0xFF);
+}
+
+void TestBinaryDXF::text(std::string& out, int groupCode, const std::string& value) {
+    code(out, groupCode);
+    out += value;
+    out += '\0';
+}
+
+void TestBinaryDXF::number(std::string& out, int groupCode, double value) {
+    code(out, groupCode);
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        out += static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+}
+
+void TestBinaryDXF::testSentinel() {
+    const DXFParseResult parsed = DXFParser::parseString(drawing(12, MIX, SPACING), 1);
+    const std::string binary = write(parsed.entities, DXFFormat::Binary);
+    QCOMPARE(binary.compare(0, DXFTokenizer::BINARY_SENTINEL.size(),
+                            std::string(DXFTokenizer::BINARY_SENTINEL)), 0);
+    QVERIFY(DXFTokenizer(binary).isBinary());
+    QVERIFY(!DXFTokenizer(write(parsed.entities, DXFFormat::Ascii)).isBinary());
+    QVERIFY(!DXFTokenizer("AutoCAD Binary DXF\n").isBinary());   // Truncated sentinel is text
+}
+
+void TestBinaryDXF::testTypedValues() {
+    std::string bytes(DXFTokenizer::BINARY_SENTINEL);
+    text(bytes, 0, "SECTION");
+    number(bytes, 10, -1.0 / 3.0);
+    code(bytes, 62);
+    bytes += std::string("\xFE\xFF", 2);                         // int16 -2
+    code(bytes, 90);
+    bytes += std::string("\x40\x42\x0F\x00", 4);                 // int32 1000000
+    code(bytes, 290);
+    bytes += '\x01';                                             // bool
+    code(bytes, 310);
+    bytes += std::string("\x03\x00\x01\x02", 4);                 // 3-byte chunk
+    text(bytes, 8, "");
+
+    DXFTokenizer tokenizer(bytes);
+    int groupCode = -1;
+    DXFValue value;
+    QVERIFY(tokenizer.next(groupCode, value));
+    QCOMPARE(groupCode, 0);
+    QVERIFY(value == "SECTION");
+    QCOMPARE(tokenizer.lineNumber(), size_t(2));
+
+    double real = 0.0;
+    int integer = 0;
+    QVERIFY(tokenizer.next(groupCode, value));
+    QCOMPARE(groupCode, 10);
+    QVERIFY(value.kind == DXFValue::Kind::Real);
+    QVERIFY(value.toDouble(real));
+    QCOMPARE(real, -1.0 / 3.0);                                  // Bit-exact
+    QVERIFY(!value.toInt(integer));
+
+    QVERIFY(tokenizer.next(groupCode, value));
+    QCOMPARE(groupCode, 62);
+    QVERIFY(value.toInt(integer));
+    QCOMPARE(integer, -2);
+
+    QVERIFY(tokenizer.next(groupCode, value));
+    QVERIFY(value.toInt(integer));
+    QCOMPARE(integer, 1000000);
+    QVERIFY(value.toDouble(real));
+    QCOMPARE(real, 1000000.0);
+
+    QVERIFY(tokenizer.next(groupCode, value));
+    QCOMPARE(groupCode, 290);
+    QCOMPARE(value.integer, int64_t(1));
+
+    QVERIFY(tokenizer.next(groupCode, value));
+    QCOMPARE(groupCode, 310);
+    QCOMPARE(value.text.size(), size_t(3));
+
+    QVERIFY(tokenizer.next(groupCode, value));
+    QCOMPARE(groupCode, 8);
+    QVERIFY(value == "");
+    QVERIFY(!tokenizer.next(groupCode, value));
+    QCOMPARE(tokenizer.position(), bytes.size());
+    QCOMPARE(tokenizer.lineNumber(), size_t(14));
+
+    QVERIFY(DXFTokenizer::valueType(40) == DXFValueType::Double);
+    QVERIFY(DXFTokenizer::valueType(70) == DXFValueType::Int16);
+    QVERIFY(DXFTokenizer::valueType(5) == DXFValueType::String);
+    QVERIFY(DXFTokenizer::valueType(1004) == DXFValueType::Binary);
+    QVERIFY(DXFTokenizer::valueType(85) == DXFValueType::Unknown);
+}
+
+void TestBinaryDXF::testOneByteCodes() {
+    // R12: one-byte codes, 255 escapes a two-byte code
+    std::string bytes(DXFTokenizer::BINARY_SENTINEL);
+    bytes += '\0';
+    bytes += std::string("SECTION") + '\0';
+    bytes += '\x02';
+    bytes += std::string("ENTITIES") + '\0';
+    bytes += '\0';
+    bytes += std::string("POINT") + '\0';
+    bytes += '\x08';
+    bytes += std::string("0") + '\0';
+    bytes += '\x0A';
+    const double x = 12.5;
+    uint64_t bits = 0;
+    std::memcpy(&bits, &x, sizeof(bits));
+    for (int i = 0; i < 8; ++i) {
+        bytes += static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    bytes += '\xFF';
+    bytes += std::string("\x14\x00", 2);                         // Code 20, escaped
+    for (int i = 0; i < 8; ++i) {
+        bytes += static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+    bytes += '\0';
+    bytes += std::string("ENDSEC") + '\0';
+    bytes += '\0';
+    bytes += std::string("EOF") + '\0';
+
+    const DXFParseResult result = DXFParser::parseString(bytes, 1);
+    QVERIFY(result.success);
+    QCOMPARE(result.entities.size(), size_t(1));
+    const auto& point = std::get<DXFPoint>(result.entities[0].data);
+    QCOMPARE(point.x, 12.5);
+    QCOMPARE(point.y, 12.5);
+    QCOMPARE(point.layer, std::string("0"));
+}
+
+void TestBinaryDXF::testMalformedGroups() {
+    const DXFParseResult parsed = DXFParser::parseString(drawing(30, MIX, SPACING), 1);
+    const std::string binary = write(parsed.entities, DXFFormat::Binary);
+
+    // Cut inside the entities: the parse stops there without reading past the end
+    for (size_t cut : {binary.size() / 2, binary.size() / 2 + 3, binary.size() - 1}) {
+        const DXFParseResult truncated = DXFParser::parseString(binary.substr(0, cut), 4);
+        QVERIFY(truncated.entities.size() <= parsed.entities.size());
+    }
+
+    // A code with no defined type ends the stream
+    std::string bytes(DXFTokenizer::BINARY_SENTINEL);
+    text(bytes, 0, "SECTION");
+    code(bytes, 85);
+    bytes += "junk";
+    DXFTokenizer tokenizer(bytes);
+    int groupCode = 0;
+    DXFValue value;
+    QVERIFY(tokenizer.next(groupCode, value));
+    QVERIFY(!tokenizer.next(groupCode, value));
+}
+
+void TestBinaryDXF::testSameEntitiesAsText() {
+    const DXFParseResult source = DXFParser::parseString(drawing(600, MIX, SPACING), 1);
+    QCOMPARE(source.entities.size(), size_t(600));
+
+    const DXFParseResult fromText = DXFParser::parseString(write(source.entities, DXFFormat::Ascii), 1);
+    const DXFParseResult fromBinary = DXFParser::parseString(write(source.entities, DXFFormat::Binary), 1);
+    QVERIFY(fromBinary.success);
+    QCOMPARE(fromBinary.entities.size(), source.entities.size());
+    QVERIFY(fingerprint(fromBinary) == fingerprint(fromText));   // Line numbers included
+}
+
+void TestBinaryDXF::testExactDoubles() {
+    const DXFParseResult source = DXFParser::parseString(
+        "0\nSECTION\n2\nENTITIES\n0\nLINE\n8\n0\n10\n0.1\n20\n1e-17\n11\n123456789.123456789\n21\n"
+        "-3.3333333333333335\n0\nENDSEC\n0\nEOF\n", 1);
+    QCOMPARE(source.entities.size(), size_t(1));
+
+    const DXFParseResult fromBinary = DXFParser::parseString(write(source.entities, DXFFormat::Binary), 1);
+    const auto& original = std::get<DXFLine>(source.entities[0].data);
+    const auto& line = std::get<DXFLine>(fromBinary.entities[0].data);
+    QCOMPARE(line.startX, original.startX);
+    QCOMPARE(line.startY, original.startY);
+    QCOMPARE(line.endX, original.endX);
+    QCOMPARE(line.endY, original.endY);
+
+    // Fixed 15 decimals in text round 1e-17 to zero
+    const DXFParseResult fromText = DXFParser::parseString(write(source.entities, DXFFormat::Ascii), 1);
+    QVERIFY(std::get<DXFLine>(fromText.entities[0].data).startY != original.startY);
+}
+
+void TestBinaryDXF::testParallelParse() {
+    const DXFParseResult source = DXFParser::parseString(drawing(30000, MIX, SPACING), 1);
+    const std::string binary = write(source.entities, DXFFormat::Binary);
+    QVERIFY(binary.size() > 4 * DXFParser::MIN_CHUNK_BYTES);   // Several chunks
+
+    const DXFParseResult sequential = DXFParser::parseString(binary, 1);
+    const DXFParseResult parallel = DXFParser::parseString(binary, 4);
+    QCOMPARE(parallel.entities.size(), source.entities.size());
+    QVERIFY(fingerprint(parallel) == fingerprint(sequential));
+}
+
+void TestBinaryDXF::testDocumentRoundTrip() {
+    DocumentModel original;
+    original.addLine(*Line2D::create(Point2D(0.1, 0.2), Point2D(100.0 / 3.0, 1e-9)), "Cut");
+    original.addArc(*Arc2D::create(Point2D(50, 50), 25.0 / 7.0, 0.1, 1.5708, true), "Cut");
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const std::string path = dir.filePath("part.dxf").toStdString();
+    QVERIFY(original.exportDXFFile(path, DXFFormat::Binary));
+
+    DocumentModel reimported;
+    QVERIFY(reimported.loadDXFFile(path));
+    QCOMPARE(reimported.entities().size(), original.entities().size());
+    QVERIFY(ExportValidator::validatePrecision(original, reimported, 1e-12).withinTolerance);
+    QVERIFY(ExportValidator::validateLayers(original, reimported).matches);
+}
+
+void TestBinaryDXF::testRoundTripBenchmark() {
+    const DXFParseResult source = DXFParser::parseString(drawing(60000, MIX, SPACING), 1);
+    using Clock = std::chrono::steady_clock;
+
+    auto roundTrip = [&](DXFFormat format, size_t& bytes, double& writeSeconds, double& readSeconds) {
+        const auto writeStart = Clock::now();
+        const std::string content = write(source.entities, format);
+        const auto readStart = Clock::now();
+        const DXFParseResult result = DXFParser::parseString(content, 1);
+        const auto readEnd = Clock::now();
+        bytes = content.size();
+        writeSeconds = std::chrono::duration<double>(readStart - writeStart).count();
+        readSeconds = std::chrono::duration<double>(readEnd - readStart).count();
+        return result.entities.size();
+    };
+
+    size_t textBytes = 0;
+    size_t binaryBytes = 0;
+    double textWrite = 0.0;
+    double textRead = 0.0;
+    double binaryWrite = 0.0;
+    double binaryRead = 0.0;
+    QCOMPARE(roundTrip(DXFFormat::Ascii, textBytes, textWrite, textRead), source.entities.size());
+    QCOMPARE(roundTrip(DXFFormat::Binary, binaryBytes, binaryWrite, binaryRead), source.entities.size());
+
+    qDebug() << "text:" << textBytes / 1024 << "KB, write" << textWrite * 1000.0 << "ms, read"
+             << textRead * 1000.0 << "ms";
+    qDebug() << "binary:" << binaryBytes / 1024 << "KB, write" << binaryWrite * 1000.0 << "ms, read"
+             << binaryRead * 1000.0 << "ms";
+
+    QVERIFY(binaryBytes < textBytes);
+    // Loose bound so the test stays stable on loaded machines
+    QVERIFY(binaryWrite + binaryRead < textWrite + textRead);
+}
+
+QTEST_MAIN(TestBinaryDXF)
+#include "test_BinaryDXF.moc"
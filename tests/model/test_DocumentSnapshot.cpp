@@ -0,0 +1,305 @@
+#include <QtTest/QtTest>
+#include "model/DocumentSnapshot.h"
+#include "model/DocumentModel.h"
+#include "geometry/Line2D.h"
+#include "geometry/Point2D.h"
+#include <random>
+#include <thread>
+
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import;
+
+class TestDocumentSnapshot : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testEmptySnapshot();
+    void testFromEntities();
+    void testSnapshotIsImmutable();
+    void testUnchangedPagesAreShared();
+    void testUnheldPagesEditedInPlace();
+    void testVersionTracksEdits();
+    void testMatchesDocumentOrderUnderRandomEdits();
+    void testReadFromWorkerThread();
+    void testContoursCachedPerVersion();
+    void testValidationSharesSnapshotTables();
+    void testSnapshotReusesPageLayouts();
+
+private:
+    static std::vector<std::string> addLines(DocumentModel& doc, size_t count);
+    static std::vector<std::string> handlesOf(const DocumentSnapshot& snapshot);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+std::vector<std::string> TestDocumentSnapshot::addLines(DocumentModel& doc, size_t count) {
+    std::vector<GeometryEntity> lines;
+    for (size_t i = 0; i < count; ++i) {
+        const double y = static_cast<double>(i);
+        lines.push_back(*Line2D::create(Point2D(0, y), Point2D(10, y)));
+    }
+    return doc.addEntities(lines);
+}
+
+std::vector<std::string> TestDocumentSnapshot::handlesOf(const DocumentSnapshot& snapshot) {
+    std::vector<std::string> handles;
+    for (const auto& entity : snapshot) {
+        handles.push_back(entity.handle);
+    }
+    return handles;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestDocumentSnapshot::testEmptySnapshot() {
+    DocumentSnapshot snapshot;
+    QVERIFY(snapshot.empty());
+    QCOMPARE(snapshot.size(), size_t(0));
+    QVERIFY(snapshot.begin() == snapshot.end());
+
+    DocumentModel doc;
+    QVERIFY(doc.snapshot().empty());
+}
+
+void TestDocumentSnapshot::testFromEntities() {
+    std::vector<GeometryEntityWithMetadata> entities;
+    for (int i = 0; i < 2500; ++i) {
+        entities.push_back({Point2D(i, 0), "0", std::to_string(i), 256, 0});
+    }
+
+    const DocumentSnapshot snapshot = DocumentSnapshot::fromEntities(entities, 7);
+    QCOMPARE(snapshot.version(), uint64_t(7));
+    QCOMPARE(snapshot.size(), entities.size());
+    QVERIFY(snapshot.pageCount() > 1);
+    QVERIFY(snapshot[1500].handle == "1500");
+    QVERIFY(handlesOf(snapshot).back() == "2499");
+    QCOMPARE(snapshot.toVector().size(), entities.size());
+}
+
+void TestDocumentSnapshot::testSnapshotIsImmutable() {
+    DocumentModel doc;
+    const auto handles = addLines(doc, 100);
+
+    const DocumentSnapshot before = doc.snapshot();
+    QVERIFY(doc.removeEntity(handles[10]));
+    QVERIFY(doc.updateEntity(handles[20], *Line2D::create(Point2D(5, 5), Point2D(6, 6))));
+    doc.addPoint(Point2D(1, 1));
+
+    // The earlier snapshot still shows the document as it was
+    QCOMPARE(before.size(), size_t(100));
+    QVERIFY(before[10].handle == handles[10]);
+    QCOMPARE(std::get<Line2D>(before[20].entity).start().y(), 20.0);
+
+    const DocumentSnapshot after = doc.snapshot();
+    QCOMPARE(after.size(), size_t(100));
+    QVERIFY(after[10].handle == handles[11]);
+    QCOMPARE(std::get<Line2D>(after[19].entity).start().y(), 5.0);
+}
+
+void TestDocumentSnapshot::testUnchangedPagesAreShared() {
+    DocumentModel doc;
+    const auto handles = addLines(doc, 5000);
+
+    const DocumentSnapshot before = doc.snapshot();
+    QVERIFY(before.pageCount() >= 4);
+
+    // One edit in the middle rebuilds only its own page
+    QVERIFY(doc.updateEntity(handles[2500], *Line2D::create(Point2D(1, 1), Point2D(2, 2))));
+    const DocumentSnapshot after = doc.snapshot();
+    QCOMPARE(after.pageCount(), before.pageCount());
+
+    size_t shared = 0;
+    for (size_t page = 0; page < after.pageCount(); ++page) {
+        if (after.sharesPage(before, page)) {
+            shared++;
+        }
+    }
+    QCOMPARE(shared, after.pageCount() - 1);
+}
+
+void TestDocumentSnapshot::testUnheldPagesEditedInPlace() {
+    DocumentModel doc;
+    const auto handles = addLines(doc, 5000);
+    const DocumentSnapshot::Page* storage = &doc.snapshot().page(2);
+
+    // No snapshot is held: the pages are the document's storage, written
+    // without a copy
+    QVERIFY(doc.updateEntity(handles[2500], *Line2D::create(Point2D(1, 1), Point2D(2, 2))));
+    QCOMPARE(&doc.snapshot().page(2), storage);
+
+    // A held snapshot keeps the page; the edit writes to a copy
+    const DocumentSnapshot held = doc.snapshot();
+    QVERIFY(doc.updateEntity(handles[2501], *Line2D::create(Point2D(3, 3), Point2D(4, 4))));
+    QCOMPARE(&held.page(2), storage);
+    QVERIFY(&doc.snapshot().page(2) != storage);
+    QCOMPARE(std::get<Line2D>(held[2501].entity).start().y(), 2501.0);
+    QCOMPARE(std::get<Line2D>(doc.snapshot()[2501].entity).start().y(), 3.0);
+}
+
+void TestDocumentSnapshot::testVersionTracksEdits() {
+    DocumentModel doc;
+    const auto handles = addLines(doc, 10);
+
+    const uint64_t version = doc.version();
+    const DocumentSnapshot first = doc.snapshot();
+    QCOMPARE(first.version(), version);
+
+    // No edits: the cached snapshot is returned as is
+    QVERIFY(doc.snapshot().sharesPage(first, 0));
+    QCOMPARE(doc.version(), version);
+
+    QVERIFY(doc.removeEntity(handles[0]));
+    QVERIFY(doc.version() > version);
+    QCOMPARE(doc.snapshot().version(), doc.version());
+
+    doc.clear();
+    QVERIFY(doc.snapshot().empty());
+}
+
+void TestDocumentSnapshot::testMatchesDocumentOrderUnderRandomEdits() {
+    DocumentModel doc;
+    const std::vector<std::string> original = addLines(doc, 3000);
+    std::vector<bool> live(original.size(), true);
+    std::vector<std::pair<size_t, RemovedEntity>> removed;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, original.size() - 1);
+    for (int step = 1; step <= 2000; ++step) {
+        const int action = std::uniform_int_distribution<int>(0, 2)(rng);
+        const size_t index = pick(rng);
+        if (action == 0 && live[index]) {
+            auto entity = doc.extractEntity(original[index]);
+            QVERIFY(entity.has_value());
+            removed.emplace_back(index, std::move(*entity));
+            live[index] = false;
+        } else if (action == 1 && !removed.empty()) {
+            // Restore in any order; entities return to their original place
+            const size_t which = std::uniform_int_distribution<size_t>(0, removed.size() - 1)(rng);
+            QVERIFY(doc.restoreEntity(removed[which].second));
+            live[removed[which].first] = true;
+            removed.erase(removed.begin() + static_cast<std::ptrdiff_t>(which));
+        } else if (live[index]) {
+            QVERIFY(doc.updateEntity(original[index], Point2D(step, 0)));
+        }
+
+        if (step % 100 == 0) {
+            std::vector<std::string> expected;
+            for (size_t i = 0; i < original.size(); ++i) {
+                if (live[i]) {
+                    expected.push_back(original[i]);
+                }
+            }
+
+            const DocumentSnapshot snapshot = doc.snapshot();
+            QVERIFY(handlesOf(snapshot) == expected);
+            for (size_t i = 0; i < expected.size(); i += 97) {
+                QVERIFY(snapshot[i].handle == expected[i]);
+                QCOMPARE(*doc.findEntityIndexByHandle(expected[i]), i);
+            }
+        }
+    }
+}
+
+void TestDocumentSnapshot::testReadFromWorkerThread() {
+    DocumentModel doc;
+    addLines(doc, 4000);
+
+    const DocumentSnapshot snapshot = doc.snapshot();
+    size_t workerCount = 0;
+    std::thread worker([snapshot, &workerCount]() {
+        for (const auto& entity : snapshot) {
+            if (std::holds_alternative<Line2D>(entity.entity)) {
+                workerCount++;
+            }
+        }
+    });
+
+    // Keep editing the live document while the worker reads
+    for (int i = 0; i < 500; ++i) {
+        doc.addPoint(Point2D(i, i));
+        (void)doc.snapshot();
+    }
+    worker.join();
+
+    QCOMPARE(workerCount, size_t(4000));
+    QCOMPARE(doc.snapshot().size(), size_t(4500));
+}
+
+void TestDocumentSnapshot::testContoursCachedPerVersion() {
+    DocumentModel doc;
+    doc.addLine(*Line2D::create(Point2D(0, 0), Point2D(10, 0)));
+    doc.addLine(*Line2D::create(Point2D(10, 0), Point2D(10, 10)));
+    doc.addPoint(Point2D(5, 5));  // Not a segment; does not shift indices
+    const std::string last = doc.addLine(*Line2D::create(Point2D(10, 10), Point2D(0, 0)));
+
+    const auto contours = doc.contours();
+    QCOMPARE(contours->closedCount(), size_t(1));
+    QCOMPARE(contours->contourOf(2), size_t(0));
+
+    // Same version: same build, whichever copy of the snapshot asks
+    const DocumentSnapshot copy = doc.snapshot();
+    QCOMPARE(copy.contours().get(), contours.get());
+    QCOMPARE(doc.contours().get(), contours.get());
+
+    // An edit publishes a new version with its own topology
+    QVERIFY(doc.removeEntity(last));
+    const auto edited = doc.contours();
+    QVERIFY(edited.get() != contours.get());
+    QCOMPARE(edited->openCount(), size_t(1));
+    QCOMPARE(contours->closedCount(), size_t(1));  // Old snapshot unchanged
+}
+
+void TestDocumentSnapshot::testValidationSharesSnapshotTables() {
+    DocumentModel doc;
+    addLines(doc, 50);
+    doc.addPoint(Point2D(5, 5));  // Not validated; not in the tables
+
+    const DocumentSnapshot snapshot = doc.snapshot();
+    QCOMPARE(snapshot.segments().size(), size_t(50));
+    QCOMPARE(snapshot.segmentHandles().size(), size_t(50));
+
+    // The view reads the pages in place; nothing is copied
+    QCOMPARE(snapshot.segments()[0].line(), std::get_if<Line2D>(&snapshot[0].entity));
+    QCOMPARE(snapshot.segments()[49].line(), std::get_if<Line2D>(&snapshot[49].entity));
+    QCOMPARE(&snapshot.segmentHandles()[7], &snapshot[7].handle);
+    QVERIFY(snapshot.segmentHandles().sharesStorage(doc.snapshot().segmentHandles()));
+
+    // The result reports against the snapshot's own handles
+    const ValidationResult result = DocumentModel::validateSnapshot(snapshot, doc.beginValidation());
+    QVERIFY(result.handles.sharesStorage(snapshot.segmentHandles()));
+    QCOMPARE(result.handleOf(3), snapshot[3].handle);
+}
+
+void TestDocumentSnapshot::testSnapshotReusesPageLayouts() {
+    DocumentModel doc;
+    addLines(doc, 3000);  // Three pages
+    const DocumentSnapshot before = doc.snapshot();
+
+    // An edit rescans only the page it wrote
+    const std::string handle = before[2500].handle;
+    QVERIFY(doc.updateEntity(handle, GeometryEntity(Point2D(1, 1))));
+    const DocumentSnapshot after = doc.snapshot();
+    QCOMPARE(after.pageLayouts().size(), size_t(3));
+    QCOMPARE(after.pageLayouts()[0].get(), before.pageLayouts()[0].get());
+    QCOMPARE(after.pageLayouts()[1].get(), before.pageLayouts()[1].get());
+    QVERIFY(after.pageLayouts()[2].get() != before.pageLayouts()[2].get());
+
+    // The point left the segments; the older snapshot still sees the line
+    QCOMPARE(after.segments().size(), size_t(2999));
+    QCOMPARE(before.segments().size(), size_t(3000));
+    QCOMPARE(after.segmentHandles()[2500], before[2501].handle);
+
+    // Positions map to segment indices through the layouts
+    QCOMPARE(after.segmentIndexOf(10), size_t(10));
+    QCOMPARE(after.segmentIndexOf(2500), DocumentSnapshot::NO_SEGMENT);
+    QCOMPARE(after.segmentIndexOf(2501), size_t(2500));
+    QCOMPARE(before.segmentIndexOf(2501), size_t(2501));
+}
+
+QTEST_MAIN(TestDocumentSnapshot)
+#include "test_DocumentSnapshot.moc"
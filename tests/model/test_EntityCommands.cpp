@@ -5,6 +5,7 @@
 #include "geometry/Arc2D.h"
 #include "geometry/Point2D.h"
 #include "geometry/GeometryConstants.h"
+#include <algorithm>
 
 using namespace OwnCAD::Model;
 using namespace OwnCAD::Geometry;
@@ -39,11 +40,14 @@ private slots:
     void testDeleteEntityCommand_Execute();
     void testDeleteEntityCommand_Undo();
     void testDeleteEntityCommand_NonexistentHandle();
+    void testDeleteEntityCommand_StableId();
 
     // DeleteEntitiesCommand tests
     void testDeleteEntitiesCommand_Execute();
     void testDeleteEntitiesCommand_Undo();
     void testDeleteEntitiesCommand_PartialSelection();
+    void testDeleteEntitiesCommand_UndoRestoresOrder();
+    void testDeleteEntitiesCommand_UndoAcrossRenumber();
 
     // MoveEntitiesCommand tests
     void testMoveEntitiesCommand_Execute();
@@ -63,6 +67,10 @@ private slots:
     void testMirrorEntitiesCommand_KeepOriginal();
     void testMirrorEntitiesCommand_ArcDirectionInverted();
 
+    // DocumentModel batch API tests
+    void testBatchAddRemoveRestore();
+    void testBatchUpdate_PerItemStatus();
+
 private:
     DocumentModel* m_model = nullptr;
 
@@ -269,6 +277,25 @@ void TestEntityCommands::testDeleteEntityCommand_NonexistentHandle() {
     QVERIFY(!cmd.isValid());
 }
 
+void TestEntityCommands::testDeleteEntityCommand_StableId() {
+    std::string h1 = addTestLine(0, 0, 10, 0);
+    addTestLine(10, 0, 10, 10);
+
+    auto id = m_model->findEntityId(h1);
+    QVERIFY(id.has_value());
+    QVERIFY(m_model->findEntity(*id) != nullptr);
+
+    DeleteEntityCommand cmd(m_model, h1);
+    QVERIFY(cmd.execute());
+    QVERIFY(m_model->findEntity(*id) == nullptr);
+
+    // Undo revives the same slot at its original position
+    QVERIFY(cmd.undo());
+    QVERIFY(m_model->findEntity(*id) != nullptr);
+    QVERIFY(*m_model->findEntityId(h1) == *id);
+    QCOMPARE(m_model->entities()[0].handle, h1);
+}
+
 // =============================================================================
 // DELETE ENTITIES COMMAND TESTS
 // =============================================================================
@@ -305,6 +332,104 @@ void TestEntityCommands::testDeleteEntitiesCommand_PartialSelection() {
     QCOMPARE(m_model->entities().size(), static_cast<size_t>(0));
 }
 
+void TestEntityCommands::testDeleteEntitiesCommand_UndoRestoresOrder() {
+    std::vector<std::string> original;
+    for (int i = 0; i < 3000; ++i) {
+        original.push_back(addTestLine(i, 0, i, 10));
+    }
+
+    // Every third entity, then most of the rest (enough tombstones to compact)
+    std::vector<std::string> first;
+    std::vector<std::string> second;
+    for (size_t i = 0; i < original.size(); ++i) {
+        if (i % 3 == 0) {
+            first.push_back(original[i]);
+        } else if (i % 20 != 1) {
+            second.push_back(original[i]);
+        }
+    }
+
+    DeleteEntitiesCommand cmd1(m_model, first);
+    DeleteEntitiesCommand cmd2(m_model, second);
+    QVERIFY(cmd1.execute());
+    QVERIFY(cmd2.execute());
+    QCOMPARE(m_model->entities().size(), original.size() - first.size() - second.size());
+
+    QVERIFY(cmd2.undo());
+    QVERIFY(cmd1.undo());
+
+    const auto& entities = m_model->entities();
+    QCOMPARE(entities.size(), original.size());
+    for (size_t i = 0; i < entities.size(); ++i) {
+        QCOMPARE(entities[i].handle, original[i]);
+    }
+    QCOMPARE(*m_model->findEntityIndexByHandle(original[1234]), size_t(1234));
+
+    // Redo/undo out of stack order still lands every entity in place
+    QVERIFY(cmd1.redo());
+    QVERIFY(cmd2.redo());
+    QVERIFY(cmd1.undo());
+    QVERIFY(cmd2.undo());
+    QVERIFY(std::equal(original.begin(), original.end(), m_model->entities().begin(),
+        [](const std::string& handle, const GeometryEntityWithMetadata& entity) {
+            return handle == entity.handle;
+        }));
+}
+
+void TestEntityCommands::testDeleteEntitiesCommand_UndoAcrossRenumber() {
+    std::vector<std::string> original;
+    for (int i = 0; i < 3000; ++i) {
+        original.push_back(addTestLine(i, 0, i, 10));
+    }
+
+    // Two of every three: enough tombstones to compact them away
+    std::vector<std::string> doomed;
+    for (size_t i = 0; i < original.size(); ++i) {
+        if (i % 3 != 0) {
+            doomed.push_back(original[i]);
+        }
+    }
+    DeleteEntitiesCommand cmd(m_model, doomed);
+    QVERIFY(cmd.execute());
+
+    // Inserts at one place use up the key gap and re-space every key
+    auto line = Line2D::create(Point2D(0, 20), Point2D(1, 20));
+    QVERIFY(line.has_value());
+    std::vector<std::string> inserted;
+    for (int i = 0; i < 40; ++i) {
+        inserted.push_back("INSERT" + std::to_string(i));
+        QVERIFY(m_model->restoreEntityAtIndex(
+            GeometryEntityWithMetadata{*line, "0", inserted.back(), 256, 0}, 1));
+    }
+    QCOMPARE(m_model->entities()[1].handle, inserted.back());
+    QCOMPARE(m_model->entities()[41].handle, original[3]);
+    for (const auto& handle : inserted) {
+        QVERIFY(m_model->removeEntity(handle));
+    }
+
+    QVERIFY(cmd.undo());
+    QVERIFY(std::equal(original.begin(), original.end(), m_model->entities().begin(),
+        [](const std::string& handle, const GeometryEntityWithMetadata& entity) {
+            return handle == entity.handle;
+        }));
+    QCOMPARE(m_model->entities().size(), original.size());
+
+    // And again with the inserts still in place: both keep their order
+    QVERIFY(cmd.redo());
+    for (size_t i = 0; i < inserted.size(); ++i) {
+        QVERIFY(m_model->restoreEntityAtIndex(
+            GeometryEntityWithMetadata{*line, "0", inserted[i], 256, 0}, 1 + i));
+    }
+    QVERIFY(cmd.undo());
+    std::vector<std::string> originals;
+    std::vector<std::string> inserts;
+    for (const auto& entity : m_model->entities()) {
+        (entity.handle.rfind("INSERT", 0) == 0 ? inserts : originals).push_back(entity.handle);
+    }
+    QVERIFY(originals == original);
+    QVERIFY(inserts == inserted);
+}
+
 // =============================================================================
 // MOVE ENTITIES COMMAND TESTS
 // =============================================================================
@@ -521,5 +646,80 @@ void TestEntityCommands::testMirrorEntitiesCommand_ArcDirectionInverted() {
     QVERIFY(!arc->isCounterClockwise());
 }
 
+// =============================================================================
+// DOCUMENT MODEL BATCH API TESTS
+// =============================================================================
+
+void TestEntityCommands::testBatchAddRemoveRestore() {
+    std::vector<GeometryEntity> entities;
+    for (int i = 0; i < 1000; ++i) {
+        auto line = Line2D::create(Point2D(i, 0), Point2D(i, 10));
+        QVERIFY(line.has_value());
+        entities.push_back(GeometryEntity{*line});
+    }
+    auto arc = Arc2D::create(Point2D(0, 0), 5.0, 0.0, M_PI, true);
+    QVERIFY(arc.has_value());
+    entities.push_back(GeometryEntity{*arc});
+
+    const auto handles = m_model->addEntities(entities, "CUT");
+    QCOMPARE(handles.size(), entities.size());
+    QCOMPARE(m_model->entities().size(), entities.size());
+    QCOMPARE(m_model->statistics().totalLines, size_t(1000));
+    QCOMPARE(m_model->statistics().totalArcs, size_t(1));
+    QCOMPARE(m_model->entities()[500].handle, handles[500]);
+    QCOMPARE(m_model->entities()[500].layer, std::string("CUT"));
+
+    // Every other entity plus an unknown handle
+    std::vector<std::string> toRemove;
+    for (size_t i = 0; i < handles.size(); i += 2) {
+        toRemove.push_back(handles[i]);
+    }
+    toRemove.push_back("MISSING");
+
+    std::vector<RemovedEntity> removed;
+    BatchResult result = m_model->removeEntities(toRemove, &removed);
+    QCOMPARE(result.successCount, toRemove.size() - 1);
+    QVERIFY(!result.succeeded.back());
+    QVERIFY(!result.allSucceeded());
+    QCOMPARE(removed.size(), toRemove.size() - 1);
+    QCOMPARE(m_model->entities().size(), entities.size() - removed.size());
+    QCOMPARE(m_model->statistics().totalSegments, m_model->entities().size());
+    QCOMPARE(m_model->spatialIndex().size(), m_model->entities().size());
+
+    result = m_model->restoreEntities(removed);
+    QVERIFY(result.allSucceeded());
+    QCOMPARE(m_model->statistics().totalLines, size_t(1000));
+    QCOMPARE(m_model->statistics().totalArcs, size_t(1));
+    for (size_t i = 0; i < handles.size(); ++i) {
+        QCOMPARE(m_model->entities()[i].handle, handles[i]);
+    }
+
+    // Restoring twice is rejected per item
+    result = m_model->restoreEntities(removed);
+    QCOMPARE(result.successCount, size_t(0));
+    QCOMPARE(m_model->entities().size(), entities.size());
+}
+
+void TestEntityCommands::testBatchUpdate_PerItemStatus() {
+    std::string h1 = addTestLine(0, 0, 10, 0);
+    std::string h2 = addTestLine(0, 5, 10, 5);
+
+    auto moved = Line2D::create(Point2D(100, 100), Point2D(110, 100));
+    auto arc = Arc2D::create(Point2D(50, 50), 5.0, 0.0, M_PI, true);
+    QVERIFY(moved.has_value() && arc.has_value());
+
+    BatchResult result = m_model->updateEntities(
+        {h1, "MISSING", h2},
+        {GeometryEntity{*moved}, GeometryEntity{*moved}, GeometryEntity{*arc}});
+    QCOMPARE(result.successCount, size_t(2));
+    QVERIFY(result.succeeded[0] && !result.succeeded[1] && result.succeeded[2]);
+
+    // Type change is reflected in statistics and the index
+    QCOMPARE(m_model->statistics().totalLines, size_t(1));
+    QCOMPARE(m_model->statistics().totalArcs, size_t(1));
+    QVERIFY(std::holds_alternative<Arc2D>(m_model->entities()[1].entity));
+    QCOMPARE(m_model->bounds().maxX(), 110.0);
+}
+
 QTEST_MAIN(TestEntityCommands)
 #include "test_EntityCommands.moc"
@@ -0,0 +1,335 @@
+#include <QtTest/QtTest>
+#include "model/DocumentModel.h"
+#include "geometry/Arc2D.h"
+#include "geometry/Ellipse2D.h"
+#include "geometry/Line2D.h"
+#include "geometry/Point2D.h"
+#include <chrono>
+#include <random>
+
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import;
+
+class TestIncrementalValidation : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testNoBaselineFallsBack();
+    void testMoveOntoDuplicate();
+    void testRemoveAndRestore();
+    void testMoveAcrossCreatesIntersection();
+    void testHoleIssuesCarriedOrRecomputed();
+    void testSpacingRuleValidatesFully();
+    void testMatchesFullValidationUnderRandomEdits();
+    void testLargeChangeFallsBack();
+    void testSingleMoveIsFast();
+
+private:
+    static void validateFully(DocumentModel& doc);
+    static void compareWithFull(const DocumentModel& doc);
+    static std::vector<std::string> addGrid(DocumentModel& doc, size_t count);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+void TestIncrementalValidation::validateFully(DocumentModel& doc) {
+    const auto result = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    doc.finalizeValidation(result, doc.version());
+}
+
+void TestIncrementalValidation::compareWithFull(const DocumentModel& doc) {
+    ValidationControl control;
+    control.rules = doc.manufacturingRules();
+    const ValidationResult expected = DocumentModel::validateSnapshot(doc.snapshot(), control);
+    const ValidationResult actual = doc.validationResult();
+
+    QCOMPARE(actual.isValid, expected.isValid);
+    QCOMPARE(actual.issueCount(), expected.issueCount());
+    for (size_t i = 0; i < expected.issues().size(); ++i) {
+        const auto& a = expected.issues()[i];
+        const auto& b = actual.issues()[i];
+        QVERIFY(a.type == b.type);
+        QCOMPARE(b.entityIndex, a.entityIndex);
+        QCOMPARE(actual.handleOf(b.entityIndex), expected.handleOf(a.entityIndex));
+        QCOMPARE(describe(b), describe(a));
+        QCOMPARE(actual.contourOf(b), expected.contourOf(a));
+        if (GeometryValidator::isPairIssue(a.type)) {
+            QCOMPARE(b.relatedEntityIndex, a.relatedEntityIndex);
+            QCOMPARE(actual.handleOf(b.relatedEntityIndex), expected.handleOf(a.relatedEntityIndex));
+        }
+    }
+}
+
+std::vector<std::string> TestIncrementalValidation::addGrid(DocumentModel& doc, size_t count) {
+    std::vector<GeometryEntity> lines;
+    for (size_t i = 0; i < count; ++i) {
+        const double x = static_cast<double>(i % 300) * 20.0;
+        const double y = static_cast<double>(i / 300) * 20.0;
+        lines.push_back(*Line2D::create(Point2D(x, y), Point2D(x + 10, y + 5)));
+    }
+    return doc.addEntities(lines);
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestIncrementalValidation::testNoBaselineFallsBack() {
+    DocumentModel doc;
+    addGrid(doc, 10);
+    QVERIFY(!doc.validateIncremental());
+
+    validateFully(doc);
+    QVERIFY(doc.validateIncremental());  // Nothing changed
+
+    doc.clear();
+    addGrid(doc, 10);
+    QVERIFY(!doc.validateIncremental());
+}
+
+void TestIncrementalValidation::testMoveOntoDuplicate() {
+    DocumentModel doc;
+    const auto handles = addGrid(doc, 100);
+    validateFully(doc);
+    QVERIFY(doc.validationResult().isValid);
+
+    // Move entity 50 onto entity 10: one duplicate pair, lower index first
+    const auto* target = doc.findEntityByHandle(handles[10]);
+    QVERIFY(target);
+    QVERIFY(doc.updateEntity(handles[50], target->entity));
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+
+    const auto& issues = doc.validationResult().issues();
+    QCOMPARE(issues.size(), size_t(1));
+    QVERIFY(issues[0].type == GeometryIssueType::DuplicateLine);
+    QCOMPARE(issues[0].entityIndex, size_t(10));
+    QCOMPARE(issues[0].relatedEntityIndex, size_t(50));
+    QCOMPARE(doc.statistics().invalidEntities, size_t(1));
+
+    // Move it away again
+    QVERIFY(doc.updateEntity(handles[50], *Line2D::create(Point2D(-50, -50), Point2D(-40, -50))));
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+    QVERIFY(doc.validationResult().isValid);
+    QCOMPARE(doc.statistics().invalidEntities, size_t(0));
+}
+
+void TestIncrementalValidation::testRemoveAndRestore() {
+    DocumentModel doc;
+    const auto handles = addGrid(doc, 100);
+    doc.addLine(*Line2D::create(Point2D(0, 0), Point2D(10, 5)));  // Duplicate of entity 0
+    doc.addPoint(Point2D(3, 3));
+    validateFully(doc);
+    QCOMPARE(doc.validationResult().issueCount(), size_t(1));
+
+    // Removing an entity shifts the indices of everything after it
+    auto removed = doc.extractEntity(handles[0]);
+    QVERIFY(removed.has_value());
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+    QVERIFY(doc.validationResult().isValid);
+
+    QVERIFY(doc.restoreEntity(*removed));
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+    QCOMPARE(doc.validationResult().issueCount(), size_t(1));
+    QCOMPARE(doc.validationResult().issues()[0].entityIndex, size_t(0));
+    QCOMPARE(doc.validationResult().issues()[0].relatedEntityIndex, size_t(100));
+}
+
+void TestIncrementalValidation::testMoveAcrossCreatesIntersection() {
+    DocumentModel doc;
+    const auto handles = addGrid(doc, 100);
+    validateFully(doc);
+
+    // Entity 10 runs (200, 0) -> (210, 5); lay entity 50 across it
+    QVERIFY(doc.updateEntity(handles[50], *Line2D::create(Point2D(200, 5), Point2D(210, 0))));
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+
+    const auto& issues = doc.validationResult().issues();
+    QCOMPARE(issues.size(), size_t(1));
+    QVERIFY(issues[0].type == GeometryIssueType::SelfIntersection);
+    QCOMPARE(issues[0].entityIndex, size_t(10));
+    QCOMPARE(issues[0].relatedEntityIndex, size_t(50));
+    QVERIFY(issues[0].location.has_value());
+    QVERIFY(issues[0].location->isEqual(Point2D(205, 2.5), 1e-9));
+}
+
+void TestIncrementalValidation::testHoleIssuesCarriedOrRecomputed() {
+    DocumentModel doc;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = TYPICAL_MIN_HOLE_DIAMETER;
+    doc.setManufacturingRules(rules);
+    const auto handles = addGrid(doc, 100);
+    doc.addLine(*Line2D::create(Point2D(-100, -100), Point2D(-50, -100)));
+    doc.addLine(*Line2D::create(Point2D(-50, -100), Point2D(-50, -50)));
+    doc.addLine(*Line2D::create(Point2D(-50, -50), Point2D(-100, -50)));
+    doc.addLine(*Line2D::create(Point2D(-100, -50), Point2D(-100, -100)));
+    const std::string hole = doc.addArc(*Arc2D::create(Point2D(-75, -75), 1.0, 0.0, TWO_PI, true));
+    validateFully(doc);
+    QCOMPARE(doc.validationResult().issueCount(), size_t(1));
+    QVERIFY(doc.validationResult().issues()[0].type == GeometryIssueType::HoleTooSmall);
+
+    // Edits away from any closed contour keep the hole issue, reindexed
+    auto removed = doc.extractEntity(handles[0]);
+    QVERIFY(removed.has_value());
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+    QCOMPARE(doc.validationResult().issues()[0].entityIndex, size_t(103));
+
+    // A lead-in joined to the part outline changes its contours
+    const std::string leadIn = doc.addLine(*Line2D::create(Point2D(-110, -110), Point2D(-100, -100)));
+    QVERIFY(!doc.validateIncremental());
+    validateFully(doc);
+    compareWithFull(doc);
+
+    // Removing it closes the outline again
+    QVERIFY(doc.removeEntity(leadIn));
+    QVERIFY(!doc.validateIncremental());
+    validateFully(doc);
+
+    // Resizing the hole itself
+    QVERIFY(doc.updateEntity(hole, *Arc2D::create(Point2D(-75, -75), 5.0, 0.0, TWO_PI, true)));
+    QVERIFY(!doc.validateIncremental());
+    validateFully(doc);
+    QVERIFY(doc.validationResult().isValid);
+
+    // Rules disabled: no contour bookkeeping, edits near loops patch in place
+    doc.setManufacturingRules(ManufacturingRules{0.0, 0.0});
+    QVERIFY(!doc.validateIncremental());  // Baseline dropped with the old limits
+    validateFully(doc);
+    QVERIFY(doc.updateEntity(hole, *Arc2D::create(Point2D(-75, -75), 1.0, 0.0, TWO_PI, true)));
+    QVERIFY(doc.validateIncremental());
+    QVERIFY(doc.validationResult().isValid);
+}
+
+void TestIncrementalValidation::testSpacingRuleValidatesFully() {
+    DocumentModel doc;
+    const auto handles = addGrid(doc, 100);
+    doc.setManufacturingRules(ManufacturingRules{3.0, 0.0, 15.0});
+    validateFully(doc);
+    QVERIFY(doc.validationResult().isValid);  // Warnings only
+    QVERIFY(doc.validationResult().hasIssueType(GeometryIssueType::FeaturesTooClose));
+
+    QVERIFY(doc.updateEntity(handles[50], *Line2D::create(Point2D(-50, -50), Point2D(-40, -50))));
+    QVERIFY(!doc.validateIncremental());
+}
+
+void TestIncrementalValidation::testMatchesFullValidationUnderRandomEdits() {
+    DocumentModel doc;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> grid(0, 40);
+    std::uniform_int_distribution<int> kind(0, 9);
+
+    auto randomEntity = [&]() -> GeometryEntity {
+        const Point2D start(grid(rng) * 2.5, grid(rng) * 2.5);
+        switch (kind(rng)) {
+            case 0:
+                return *Arc2D::create(start, 1.0 + grid(rng) % 3, (grid(rng) % 8) * 0.785,
+                                      (grid(rng) % 8) * 0.785 + 1.5, grid(rng) % 2 == 0);
+            case 1:
+                return *Ellipse2D::create(start, Point2D(start.x() + 3, start.y()), 0.5);
+            case 2:
+                return start;
+            case 3:  // Numerically unstable
+                return *Line2D::create(start, Point2D(start.x() + 5e-9, start.y()));
+            default: {
+                const double length = 1.0 + grid(rng) % 5;
+                return grid(rng) % 2 == 0
+                    ? *Line2D::create(start, Point2D(start.x() + length, start.y()))
+                    : *Line2D::create(start, Point2D(start.x(), start.y() + length));
+            }
+        }
+    };
+
+    std::vector<GeometryEntity> initial;
+    for (int i = 0; i < 2000; ++i) {
+        initial.push_back(randomEntity());
+    }
+    doc.addEntities(initial);
+    validateFully(doc);
+    QVERIFY(!doc.validationResult().isValid);
+
+    std::vector<RemovedEntity> removed;
+    for (int round = 0; round < 200; ++round) {
+        const auto snapshot = doc.snapshot();
+        const int edits = 1 + grid(rng) % 4;
+        for (int e = 0; e < edits; ++e) {
+            const size_t index = static_cast<size_t>(rng() % snapshot.size());
+            const std::string handle = snapshot[index].handle;
+            switch (grid(rng) % 4) {
+                case 0:
+                    doc.updateEntity(handle, randomEntity());
+                    break;
+                case 1:
+                    if (auto entity = doc.extractEntity(handle)) {
+                        removed.push_back(std::move(*entity));
+                    }
+                    break;
+                case 2:
+                    if (!removed.empty()) {
+                        doc.restoreEntity(removed.back());
+                        removed.pop_back();
+                    }
+                    break;
+                default:
+                    doc.addEntities({randomEntity()});
+                    break;
+            }
+        }
+
+        QVERIFY(doc.validateIncremental());
+        compareWithFull(doc);
+    }
+}
+
+void TestIncrementalValidation::testLargeChangeFallsBack() {
+    DocumentModel doc;
+    const auto handles = addGrid(doc, 1000);
+    validateFully(doc);
+
+    for (size_t i = 0; i < 500; ++i) {
+        doc.removeEntity(handles[i]);
+    }
+    QVERIFY(!doc.validateIncremental());
+
+    validateFully(doc);
+    QVERIFY(doc.validateIncremental());
+    compareWithFull(doc);
+}
+
+void TestIncrementalValidation::testSingleMoveIsFast() {
+    DocumentModel doc;
+    const auto handles = addGrid(doc, 100000);
+
+    const auto fullStart = std::chrono::steady_clock::now();
+    validateFully(doc);
+    const auto fullTime = std::chrono::steady_clock::now() - fullStart;
+
+    const auto* target = doc.findEntityByHandle(handles[1000]);
+    QVERIFY(target);
+    QVERIFY(doc.updateEntity(handles[70000], target->entity));
+
+    const auto start = std::chrono::steady_clock::now();
+    QVERIFY(doc.validateIncremental());
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto ms = [](auto duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    const QString timings = QString("full: %1 ms, incremental: %2 ms").arg(ms(fullTime)).arg(ms(elapsed));
+    QCOMPARE(doc.validationResult().issueCount(), size_t(1));
+
+    // Absolute bound as well: patching one edit must not cost a pass over
+    // the document, however slow the full validation is on this machine
+    QVERIFY2(ms(elapsed) < 5.0, qPrintable(timings));
+    QVERIFY2(elapsed * 10 < fullTime, qPrintable(timings));
+}
+
+QTEST_MAIN(TestIncrementalValidation)
+#include "test_IncrementalValidation.moc"
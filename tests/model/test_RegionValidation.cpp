@@ -0,0 +1,299 @@
+#include <QtTest/QtTest>
+#include "model/DocumentModel.h"
+#include "geometry/Arc2D.h"
+#include "geometry/Line2D.h"
+#include "geometry/Point2D.h"
+#include <chrono>
+#include <future>
+#include <set>
+#include <tuple>
+
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import;
+
+class TestRegionValidation : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRegionMatchesFullValidation();
+    void testHaloNeighboursNotReportedAlone();
+    void testSelection();
+    void testDocumentResultUntouched();
+    void testSpacingAcrossRegionEdge();
+    void testHoleInPartOutsideRegion();
+    void testRegionFasterThanFullRun();
+    void testNestedContoursFoundLocally();
+    void testContourRulesStayLocal();
+    void testPreparedRegionOnWorker();
+
+private:
+    using IssueKey = std::tuple<int, std::string, std::string>;
+    static std::vector<std::string> addDirtyGrid(DocumentModel& doc, size_t count);
+    static std::set<IssueKey> keysOf(const ValidationResult& result,
+                                     const std::set<std::string>& involving);
+    static void addSquare(DocumentModel& doc, double x, double y, double size);
+    static BoundingBox window(double minX, double minY, double maxX, double maxY);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+std::vector<std::string> TestRegionValidation::addDirtyGrid(DocumentModel& doc, size_t count) {
+    // Rows of 100 cells 20 mm apart; every 7th cell has a duplicate and every
+    // 11th a crossing diagonal
+    std::vector<GeometryEntity> lines;
+    for (size_t i = 0; i < count; ++i) {
+        const double x = static_cast<double>(i % 100) * 20.0;
+        const double y = static_cast<double>(i / 100) * 20.0;
+        lines.push_back(*Line2D::create(Point2D(x, y), Point2D(x + 10, y + 5)));
+        if (i % 7 == 0) {
+            lines.push_back(lines.back());
+        }
+        if (i % 11 == 0) {
+            lines.push_back(*Line2D::create(Point2D(x, y + 5), Point2D(x + 10, y)));
+        }
+    }
+    return doc.addEntities(lines);
+}
+
+std::set<TestRegionValidation::IssueKey> TestRegionValidation::keysOf(
+    const ValidationResult& result, const std::set<std::string>& involving) {
+    std::set<IssueKey> keys;
+    for (const auto& issue : result.issues()) {
+        const std::string& handle = result.handleOf(issue.entityIndex);
+        const std::string related = GeometryValidator::isPairIssue(issue.type)
+            ? result.handleOf(issue.relatedEntityIndex) : std::string();
+        if (involving.empty() || involving.count(handle) > 0 || involving.count(related) > 0) {
+            keys.emplace(static_cast<int>(issue.type), handle, related);
+        }
+    }
+    return keys;
+}
+
+void TestRegionValidation::addSquare(DocumentModel& doc, double x, double y, double size) {
+    const Point2D a(x, y), b(x + size, y), c(x + size, y + size), d(x, y + size);
+    doc.addEntities({*Line2D::create(a, b), *Line2D::create(b, c),
+                     *Line2D::create(c, d), *Line2D::create(d, a)});
+}
+
+BoundingBox TestRegionValidation::window(double minX, double minY, double maxX, double maxY) {
+    return BoundingBox::fromPoints(Point2D(minX, minY), Point2D(maxX, maxY));
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestRegionValidation::testRegionMatchesFullValidation() {
+    DocumentModel doc;
+    addDirtyGrid(doc, 500);
+    const ValidationResult full = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+
+    const BoundingBox region = window(195.0, 15.0, 405.0, 65.0);
+    std::set<std::string> inside;
+    for (const auto& handle : doc.spatialIndex().queryWindow(region)) {
+        inside.insert(handle);
+    }
+    QVERIFY(inside.size() > 20);
+
+    const ValidationResult local = doc.validateRegion(region);
+    QVERIFY(local.isComplete());
+    QVERIFY(!local.isValid);
+    QVERIFY(local.hasIssueType(GeometryIssueType::DuplicateLine));
+    QVERIFY(local.hasIssueType(GeometryIssueType::SelfIntersection));
+    QCOMPARE(keysOf(local, {}), keysOf(full, inside));
+}
+
+void TestRegionValidation::testHaloNeighboursNotReportedAlone() {
+    DocumentModel doc;
+    const auto handles = doc.addEntities({
+        *Line2D::create(Point2D(0, 0), Point2D(10, 10)),      // 0: inside
+        *Line2D::create(Point2D(0, 10), Point2D(20, 0)),      // 1: crosses 0, reaches outside
+        *Line2D::create(Point2D(12, 2), Point2D(18, 2)),      // 2: outside, crosses 1
+        *Line2D::create(Point2D(12, 2), Point2D(18, 2)),      // 3: duplicate of 2, outside
+    });
+
+    const ValidationResult local = doc.validateRegion(window(-1.0, -1.0, 10.5, 10.5));
+    std::set<std::string> reported;
+    for (const auto& issue : local.issues()) {
+        reported.insert(local.handleOf(issue.entityIndex));
+        reported.insert(local.handleOf(issue.relatedEntityIndex));
+    }
+    QVERIFY(!local.hasIssueType(GeometryIssueType::DuplicateLine));  // 2-3 involve no requested entity
+    QCOMPARE(local.getIssuesOfType(GeometryIssueType::SelfIntersection).size(), size_t(3));
+    QVERIFY(reported.count(handles[0]) > 0);
+    QVERIFY(reported.count(handles[2]) > 0);  // As the partner of 1
+}
+
+void TestRegionValidation::testSelection() {
+    DocumentModel doc;
+    const auto handles = addDirtyGrid(doc, 300);
+    const ValidationResult full = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+
+    const std::vector<std::string> selected{handles[0], handles[1], handles[140], "missing"};
+    const ValidationResult local = doc.validateRegion(selected);
+    const std::set<std::string> involving(selected.begin(), selected.end());
+    QVERIFY(!local.passed());
+    QCOMPARE(keysOf(local, {}), keysOf(full, involving));
+
+    QVERIFY(doc.validateRegion(std::vector<std::string>{}).passed());
+}
+
+void TestRegionValidation::testDocumentResultUntouched() {
+    DocumentModel doc;
+    addDirtyGrid(doc, 100);
+    doc.finalizeValidation(DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation()),
+                           doc.version());
+    const size_t before = doc.validationResult().issueCount();
+
+    const ValidationResult local = doc.validateRegion(window(0.0, 0.0, 50.0, 50.0));
+    QVERIFY(local.issueCount() < before);
+    QCOMPARE(doc.validationResult().issueCount(), before);
+    QVERIFY(doc.validateIncremental());  // Baseline kept
+}
+
+void TestRegionValidation::testSpacingAcrossRegionEdge() {
+    DocumentModel doc;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = 0.0;
+    rules.minFeatureSpacing = 2.0;
+    doc.setManufacturingRules(rules);
+    addSquare(doc, 0, 0, 10);
+    addSquare(doc, 11, 0, 10);   // 1 mm away, outside the region
+    addSquare(doc, 40, 0, 10);
+
+    const ValidationResult local = doc.validateRegion(window(-1.0, -1.0, 10.5, 11.0));
+    QVERIFY(local.isValid);  // Warnings only
+    QCOMPARE(local.getIssuesOfType(GeometryIssueType::FeaturesTooClose).size(), size_t(1));
+}
+
+void TestRegionValidation::testHoleInPartOutsideRegion() {
+    DocumentModel doc;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = TYPICAL_MIN_HOLE_DIAMETER;
+    doc.setManufacturingRules(rules);
+    addSquare(doc, 0, 0, 100);
+    addSquare(doc, 50, 50, 1);   // 1 mm hole; the outline is far outside the window
+    std::set<std::string> hole;
+    for (size_t i = 4; i < 8; ++i) {
+        hole.insert(doc.entities()[i].handle);
+    }
+
+    const ValidationResult local = doc.validateRegion(window(45.0, 45.0, 55.0, 55.0));
+    const auto holes = local.getIssuesOfType(GeometryIssueType::HoleTooSmall);
+    QCOMPARE(holes.size(), size_t(1));
+    QVERIFY(hole.count(local.handleOf(holes[0].entityIndex)) > 0);
+    QCOMPARE(local.contourOf(holes[0]).size(), size_t(4));
+
+    const ValidationResult full = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    QCOMPARE(keysOf(local, {}), keysOf(full, hole));
+}
+
+void TestRegionValidation::testRegionFasterThanFullRun() {
+    DocumentModel doc;
+    std::vector<GeometryEntity> lines;
+    for (size_t i = 0; i < 100000; ++i) {
+        const double x = static_cast<double>(i % 400) * 20.0;
+        const double y = static_cast<double>(i / 400) * 20.0;
+        lines.push_back(*Line2D::create(Point2D(x, y), Point2D(x + 10, y + 5)));
+    }
+    doc.addEntities(lines);
+    doc.snapshot();  // Built once, as the scheduler keeps it current
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    const ValidationResult full = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    const auto fullTime = Clock::now() - start;
+
+    start = Clock::now();
+    const ValidationResult local = doc.validateRegion(window(1000.0, 1000.0, 1200.0, 1200.0));
+    const auto regionTime = Clock::now() - start;
+
+    QVERIFY(full.passed());
+    QVERIFY(local.passed());
+    QVERIFY(regionTime * 20 < fullTime);
+}
+
+void TestRegionValidation::testNestedContoursFoundLocally() {
+    DocumentModel doc;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = TYPICAL_MIN_HOLE_DIAMETER;
+    doc.setManufacturingRules(rules);
+    addSquare(doc, 0, 0, 100);     // Part
+    addSquare(doc, 10, 10, 80);    // Cut-out
+    addSquare(doc, 20, 20, 60);    // Part inside the cut-out
+    addSquare(doc, 50, 50, 1);     // 1 mm hole in the inner part
+    addSquare(doc, 120, 45, 10);   // Separate part crossing the same row
+    std::set<std::string> hole;
+    for (size_t i = 12; i < 16; ++i) {
+        hole.insert(doc.entities()[i].handle);
+    }
+
+    // Only the enclosing outlines make the small square a hole
+    const ValidationResult local = doc.validateRegion(window(49.0, 49.0, 52.0, 52.0));
+    const ValidationResult full = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    QCOMPARE(local.getIssuesOfType(GeometryIssueType::HoleTooSmall).size(), size_t(1));
+    QCOMPARE(keysOf(local, {}), keysOf(full, hole));
+}
+
+void TestRegionValidation::testContourRulesStayLocal() {
+    DocumentModel doc;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = TYPICAL_MIN_HOLE_DIAMETER;
+    rules.minFeatureSpacing = 1.0;
+    doc.setManufacturingRules(rules);
+    std::vector<GeometryEntity> squares;
+    for (size_t i = 0; i < 25000; ++i) {
+        const double x = static_cast<double>(i % 250) * 20.0;
+        const double y = static_cast<double>(i / 250) * 20.0;
+        const Point2D a(x, y), b(x + 10, y), c(x + 10, y + 10), d(x, y + 10);
+        squares.push_back(*Line2D::create(a, b));
+        squares.push_back(*Line2D::create(b, c));
+        squares.push_back(*Line2D::create(c, d));
+        squares.push_back(*Line2D::create(d, a));
+    }
+    doc.addEntities(squares);
+    doc.snapshot();
+
+    // The region check must not build the topology of the whole document
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    const ValidationResult full = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    const auto fullTime = Clock::now() - start;
+
+    start = Clock::now();
+    const ValidationResult local = doc.validateRegion(window(1000.0, 1000.0, 1100.0, 1100.0));
+    const auto regionTime = Clock::now() - start;
+
+    QVERIFY(full.passed());
+    QVERIFY(local.passed());
+    const auto ms = [](auto duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    };
+    QVERIFY2(regionTime * 20 < fullTime,
+             qPrintable(QString("full: %1 ms, region: %2 ms").arg(ms(fullTime)).arg(ms(regionTime))));
+}
+
+void TestRegionValidation::testPreparedRegionOnWorker() {
+    DocumentModel doc;
+    const auto handles = addDirtyGrid(doc, 300);
+    const BoundingBox region = window(0.0, 0.0, 200.0, 40.0);
+    const ValidationResult expected = doc.validateRegion(region);
+
+    // The prepared entities are a copy: edits after preparing do not reach
+    // the worker
+    const DocumentModel::PreparedRegion prepared = doc.prepareRegion(region);
+    QVERIFY(doc.removeEntity(handles[0]));
+    auto worker = std::async(std::launch::async, [&prepared]() {
+        return DocumentModel::validatePreparedRegion(prepared);
+    });
+    const ValidationResult local = worker.get();
+
+    QVERIFY(!local.passed());
+    QCOMPARE(keysOf(local, {}), keysOf(expected, {}));
+}
+
+QTEST_MAIN(TestRegionValidation)
+#include "test_RegionValidation.moc"
@@ -0,0 +1,416 @@
+#include <QtTest/QtTest>
+#include "model/SpatialIndex.h"
+#include "model/DocumentModel.h"
+#include "geometry/Line2D.h"
+#include "geometry/Arc2D.h"
+#include "geometry/Point2D.h"
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import;
+
+class TestSpatialIndex : public QObject {
+    Q_OBJECT
+
+private slots:
+    // Index behaviour
+    void testEmptyIndex();
+    void testWindowQueryMatchesLinearScan();
+    void testContainedQuery();
+    void testRadiusQuery();
+    void testNearestQuery();
+    void testNearestQuerySparseGrid();
+    void testUpdateAndRemove();
+    void testBoundsAfterRemoval();
+    void testSharedHandles();
+    void testKeyedEntries();
+    void testOversizedEntries();
+
+    // DocumentModel integration
+    void testDocumentModelKeepsIndexInSync();
+    void testDocumentWindowIndices();
+
+private:
+    struct Item {
+        std::string handle;
+        BoundingBox box;
+    };
+
+    static std::vector<Item> randomItems(size_t count, unsigned seed);
+    static std::vector<std::string> linearWindow(const std::vector<Item>& items,
+                                                 const BoundingBox& window);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+std::vector<TestSpatialIndex::Item> TestSpatialIndex::randomItems(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> coord(-1000.0, 1000.0);
+    std::uniform_real_distribution<double> size(0.0, 20.0);
+
+    std::vector<Item> items;
+    for (size_t i = 0; i < count; ++i) {
+        const double x = coord(rng);
+        const double y = coord(rng);
+        items.push_back({"H" + std::to_string(i),
+                         BoundingBox::fromPoints(Point2D(x, y),
+                                                 Point2D(x + size(rng), y + size(rng)))});
+    }
+    return items;
+}
+
+std::vector<std::string> TestSpatialIndex::linearWindow(const std::vector<Item>& items,
+                                                        const BoundingBox& window) {
+    std::vector<std::string> handles;
+    for (const auto& item : items) {
+        if (window.intersects(item.box)) {
+            handles.push_back(item.handle);
+        }
+    }
+    std::sort(handles.begin(), handles.end());
+    return handles;
+}
+
+// =============================================================================
+// INDEX BEHAVIOUR
+// =============================================================================
+
+void TestSpatialIndex::testEmptyIndex() {
+    SpatialIndex index;
+    QVERIFY(index.empty());
+    QVERIFY(!index.bounds().isValid());
+    QVERIFY(index.queryWindow(BoundingBox::fromPoints(Point2D(-1, -1), Point2D(1, 1))).empty());
+    QVERIFY(index.queryNearest(Point2D(0, 0), 5).empty());
+    QVERIFY(!index.insert("A", BoundingBox()));  // Invalid box rejected
+}
+
+void TestSpatialIndex::testWindowQueryMatchesLinearScan() {
+    const auto items = randomItems(5000, 1);
+    SpatialIndex index;
+    for (const auto& item : items) {
+        QVERIFY(index.insert(item.handle, item.box));
+    }
+    QCOMPARE(index.size(), items.size());
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> coord(-1100.0, 1100.0);
+    for (int q = 0; q < 200; ++q) {
+        const BoundingBox window = BoundingBox::fromPoints(
+            Point2D(coord(rng), coord(rng)), Point2D(coord(rng), coord(rng)));
+        QVERIFY(index.queryWindow(window) == linearWindow(items, window));
+    }
+
+    // Window covering everything
+    const BoundingBox all = BoundingBox::fromPoints(Point2D(-1e6, -1e6), Point2D(1e6, 1e6));
+    QCOMPARE(index.queryWindow(all).size(), items.size());
+}
+
+void TestSpatialIndex::testContainedQuery() {
+    SpatialIndex index;
+    index.insert("IN", BoundingBox::fromPoints(Point2D(1, 1), Point2D(2, 2)));
+    index.insert("CROSS", BoundingBox::fromPoints(Point2D(4, 4), Point2D(6, 6)));
+    index.insert("OUT", BoundingBox::fromPoints(Point2D(10, 10), Point2D(11, 11)));
+
+    const BoundingBox window = BoundingBox::fromPoints(Point2D(0, 0), Point2D(5, 5));
+    const auto contained = index.queryContained(window);
+    QCOMPARE(contained.size(), size_t(1));
+    QVERIFY(contained[0] == "IN");
+
+    const auto crossing = index.queryWindow(window);
+    QCOMPARE(crossing.size(), size_t(2));
+}
+
+void TestSpatialIndex::testRadiusQuery() {
+    const auto items = randomItems(3000, 3);
+    SpatialIndex index;
+    for (const auto& item : items) {
+        index.insert(item.handle, item.box);
+    }
+
+    const Point2D center(12.5, -40.0);
+    const double radius = 75.0;
+
+    std::vector<std::string> expected;
+    for (const auto& item : items) {
+        const double dx = std::max({item.box.minX() - center.x(), 0.0, center.x() - item.box.maxX()});
+        const double dy = std::max({item.box.minY() - center.y(), 0.0, center.y() - item.box.maxY()});
+        if (std::sqrt(dx * dx + dy * dy) <= radius) {
+            expected.push_back(item.handle);
+        }
+    }
+    std::sort(expected.begin(), expected.end());
+
+    QVERIFY(!expected.empty());
+    QVERIFY(index.queryRadius(center, radius) == expected);
+}
+
+void TestSpatialIndex::testNearestQuery() {
+    const auto items = randomItems(4000, 4);
+    SpatialIndex index;
+    for (const auto& item : items) {
+        index.insert(item.handle, item.box);
+    }
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> coord(-1500.0, 1500.0);
+    for (int q = 0; q < 50; ++q) {
+        const Point2D point(coord(rng), coord(rng));
+
+        std::vector<std::pair<double, std::string>> ranked;
+        for (const auto& item : items) {
+            const double dx = std::max({item.box.minX() - point.x(), 0.0, point.x() - item.box.maxX()});
+            const double dy = std::max({item.box.minY() - point.y(), 0.0, point.y() - item.box.maxY()});
+            ranked.emplace_back(std::sqrt(dx * dx + dy * dy), item.handle);
+        }
+        std::sort(ranked.begin(), ranked.end());
+
+        const auto nearest = index.queryNearest(point, 7);
+        QCOMPARE(nearest.size(), size_t(7));
+        for (size_t k = 0; k < nearest.size(); ++k) {
+            QVERIFY(nearest[k] == ranked[k].second);
+        }
+    }
+}
+
+void TestSpatialIndex::testNearestQuerySparseGrid() {
+    // A far outlier stretches the grid to its 65536-cell limit; the
+    // clusters occupy a handful of cells at opposite corners
+    std::vector<Item> items;
+    items.push_back({"FAR", BoundingBox::fromPoints(Point2D(1e6, 1e6), Point2D(1e6, 1e6))});
+    for (size_t i = 0; i < 300; ++i) {
+        const double x = static_cast<double>(i % 20) * 0.05;
+        const double y = static_cast<double>(i / 20) * 0.05;
+        items.push_back({"H" + std::to_string(i),
+                         BoundingBox::fromPoints(Point2D(x, y), Point2D(x + 0.001, y + 0.001))});
+    }
+    SpatialIndex index;
+    for (const auto& item : items) {
+        index.insert(item.handle, item.box);
+    }
+    QVERIFY(index.cellSize() > 1.0);
+
+    // More results than handles, from between the clusters and from far outside
+    for (const Point2D& point : {Point2D(5e5, 4e5), Point2D(-3e6, 2e6), Point2D(0.5, 0.5)}) {
+        std::vector<std::pair<double, std::string>> ranked;
+        for (const auto& item : items) {
+            const double dx = std::max({item.box.minX() - point.x(), 0.0, point.x() - item.box.maxX()});
+            const double dy = std::max({item.box.minY() - point.y(), 0.0, point.y() - item.box.maxY()});
+            ranked.emplace_back(std::sqrt(dx * dx + dy * dy), item.handle);
+        }
+        std::sort(ranked.begin(), ranked.end());
+
+        const auto all = index.queryNearest(point, items.size() + 10);
+        QCOMPARE(all.size(), items.size());
+        for (size_t k = 0; k < all.size(); ++k) {
+            QVERIFY(all[k] == ranked[k].second);
+        }
+        const auto few = index.queryNearest(point, 3);
+        QCOMPARE(few.size(), size_t(3));
+        QVERIFY(few[0] == ranked[0].second);
+    }
+
+    // Only oversized entries: no grid to walk
+    SpatialIndex borders;
+    borders.insert("BORDER", BoundingBox::fromPoints(Point2D(-5000, -5000), Point2D(5000, 5000)));
+    borders.insert("TINY", BoundingBox::fromPoints(Point2D(0, 0), Point2D(0, 0)));
+    QCOMPARE(borders.queryNearest(Point2D(1e9, 1e9), 5).size(), size_t(2));
+    QCOMPARE(borders.bounds().maxX(), 5000.0);
+}
+
+void TestSpatialIndex::testUpdateAndRemove() {
+    SpatialIndex index;
+    const BoundingBox boxA = BoundingBox::fromPoints(Point2D(0, 0), Point2D(1, 1));
+    const BoundingBox boxB = BoundingBox::fromPoints(Point2D(100, 100), Point2D(101, 101));
+    index.insert("A", boxA);
+
+    QVERIFY(index.update("A", boxA, boxB));
+    QVERIFY(index.queryWindow(boxA).empty());
+    QCOMPARE(index.queryWindow(boxB).size(), size_t(1));
+
+    QVERIFY(!index.update("MISSING", boxA, boxB));
+    QVERIFY(!index.remove("MISSING", boxA));
+
+    QVERIFY(index.remove("A", boxB));
+    QVERIFY(index.empty());
+    QVERIFY(!index.contains("A"));
+    QVERIFY(index.queryWindow(boxB).empty());
+}
+
+void TestSpatialIndex::testBoundsAfterRemoval() {
+    auto items = randomItems(1000, 6);
+    SpatialIndex index;
+    for (const auto& item : items) {
+        index.insert(item.handle, item.box);
+    }
+
+    // Remove half the items and compare bounds to a full recomputation
+    for (size_t i = 0; i < items.size(); i += 2) {
+        QVERIFY(index.remove(items[i].handle, items[i].box));
+    }
+
+    BoundingBox expected;
+    for (size_t i = 1; i < items.size(); i += 2) {
+        expected = expected.merge(items[i].box);
+    }
+
+    const BoundingBox actual = index.bounds();
+    QCOMPARE(actual.minX(), expected.minX());
+    QCOMPARE(actual.minY(), expected.minY());
+    QCOMPARE(actual.maxX(), expected.maxX());
+    QCOMPARE(actual.maxY(), expected.maxY());
+}
+
+void TestSpatialIndex::testSharedHandles() {
+    // Decomposed polylines keep one handle on every segment
+    SpatialIndex index;
+    const BoundingBox seg1 = BoundingBox::fromPoints(Point2D(0, 0), Point2D(10, 0));
+    const BoundingBox seg2 = BoundingBox::fromPoints(Point2D(10, 0), Point2D(10, 10));
+    QVERIFY(index.insert("POLY", seg1));
+    QVERIFY(index.insert("POLY", seg2));
+    QCOMPARE(index.size(), size_t(2));
+
+    const BoundingBox window = BoundingBox::fromPoints(Point2D(-1, -1), Point2D(11, 11));
+    QCOMPARE(index.queryWindow(window).size(), size_t(1));
+    QCOMPARE(index.queryNearest(Point2D(5, 5), 3).size(), size_t(1));
+
+    // Removing one segment leaves the other indexed
+    QVERIFY(index.remove("POLY", seg2));
+    QVERIFY(index.contains("POLY"));
+    QCOMPARE(index.bounds().maxY(), 0.0);
+}
+
+void TestSpatialIndex::testKeyedEntries() {
+    // Keys tell polyline segments apart: only the segments hit are reported
+    SpatialIndex index;
+    const BoundingBox seg1 = BoundingBox::fromPoints(Point2D(0, 0), Point2D(10, 0));
+    const BoundingBox seg2 = BoundingBox::fromPoints(Point2D(10, 0), Point2D(10, 10));
+    const BoundingBox border = BoundingBox::fromPoints(Point2D(-5000, -5000), Point2D(5000, 5000));
+    QVERIFY(index.insert("POLY", seg1, 7));
+    QVERIFY(index.insert("POLY", seg2, 3));
+    QVERIFY(index.insert("BORDER", border, 12));  // Oversized
+    QVERIFY(index.insert("LOOSE", seg1));         // No key
+    QVERIFY(!index.insert("OTHER", seg2, 3));     // Key in use
+
+    const BoundingBox nearStart = BoundingBox::fromPoints(Point2D(1, -1), Point2D(2, 1));
+    QVERIFY(index.queryWindowKeys(nearStart) == (std::vector<SpatialIndex::Key>{7, 12}));
+    QCOMPARE(index.queryWindow(nearStart).size(), size_t(3));  // POLY, BORDER, LOOSE
+
+    // Same box under one handle: the key picks the entry
+    QVERIFY(index.update(3, seg1));
+    QVERIFY(index.queryWindowKeys(nearStart) == (std::vector<SpatialIndex::Key>{3, 7, 12}));
+    QVERIFY(index.remove(7));
+    QVERIFY(!index.remove(7));
+    QVERIFY(!index.update(7, seg2));
+    QVERIFY(index.queryWindowKeys(nearStart) == (std::vector<SpatialIndex::Key>{3, 12}));
+    QVERIFY(index.contains("POLY"));
+
+    // A freed key can be used again
+    QVERIFY(index.insert("NEW", seg2, 7));
+    QCOMPARE(index.size(), size_t(4));
+}
+
+void TestSpatialIndex::testOversizedEntries() {
+    auto items = randomItems(500, 7);
+    // Sheet border spanning the whole drawing
+    items.push_back({"BORDER", BoundingBox::fromPoints(Point2D(-5000, -5000), Point2D(5000, 5000))});
+
+    SpatialIndex index;
+    for (const auto& item : items) {
+        index.insert(item.handle, item.box);
+    }
+
+    const BoundingBox window = BoundingBox::fromPoints(Point2D(0, 0), Point2D(1, 1));
+    const auto hits = index.queryWindow(window);
+    QVERIFY(std::find(hits.begin(), hits.end(), "BORDER") != hits.end());
+    QVERIFY(hits == linearWindow(items, window));
+}
+
+// =============================================================================
+// DOCUMENT MODEL INTEGRATION
+// =============================================================================
+
+void TestSpatialIndex::testDocumentModelKeepsIndexInSync() {
+    DocumentModel doc;
+
+    auto line = Line2D::create(Point2D(0, 0), Point2D(10, 0));
+    auto arc = Arc2D::create(Point2D(50, 50), 5.0, 0.0, M_PI, true);
+    QVERIFY(line.has_value() && arc.has_value());
+
+    const std::string lineHandle = doc.addLine(*line);
+    const std::string arcHandle = doc.addArc(*arc);
+    const std::string pointHandle = doc.addPoint(Point2D(-20, -20));
+    QVERIFY(!lineHandle.empty() && !arcHandle.empty() && !pointHandle.empty());
+
+    QCOMPARE(doc.spatialIndex().size(), size_t(3));
+    QCOMPARE(doc.spatialIndex().queryWindowKeys(doc.bounds()).size(), size_t(3));
+    QCOMPARE(doc.bounds().minX(), -20.0);
+    QCOMPARE(doc.bounds().maxX(), 55.0);
+
+    auto nearest = doc.spatialIndex().queryNearest(Point2D(1, 1), 1);
+    QCOMPARE(nearest.size(), size_t(1));
+    QVERIFY(nearest[0] == lineHandle);
+
+    // Move the line next to the arc
+    auto moved = Line2D::create(Point2D(60, 60), Point2D(70, 60));
+    QVERIFY(moved.has_value());
+    QVERIFY(doc.updateEntity(lineHandle, *moved));
+    QVERIFY(doc.spatialIndex().queryRadius(Point2D(0, 0), 1.0).empty());
+    QCOMPARE(doc.bounds().maxX(), 70.0);
+
+    // Remove and restore keep the index in step
+    GeometryEntityWithMetadata saved = *doc.findEntityByHandle(pointHandle);
+    QVERIFY(doc.removeEntity(pointHandle));
+    QVERIFY(!doc.spatialIndex().contains(pointHandle));
+    QCOMPARE(doc.bounds().minX(), 45.0);
+
+    QVERIFY(doc.restoreEntityAtIndex(saved, 2));
+    QVERIFY(doc.spatialIndex().contains(pointHandle));
+    QCOMPARE(doc.bounds().minX(), -20.0);
+
+    doc.clear();
+    QVERIFY(doc.spatialIndex().empty());
+    QVERIFY(!doc.bounds().isValid());
+}
+
+void TestSpatialIndex::testDocumentWindowIndices() {
+    DocumentModel doc;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(-500.0, 500.0);
+
+    std::vector<std::string> handles;
+    for (int i = 0; i < 3000; ++i) {
+        const Point2D start(coord(rng), coord(rng));
+        auto line = Line2D::create(start, Point2D(start.x() + 5.0, start.y() + 3.0));
+        QVERIFY(line.has_value());
+        handles.push_back(doc.addLine(*line));
+    }
+    // Removals shift the positions of everything after them
+    for (size_t i = 0; i < handles.size(); i += 7) {
+        QVERIFY(doc.removeEntity(handles[i]));
+    }
+
+    const DocumentSnapshot current = doc.snapshot();
+    std::uniform_real_distribution<double> corner(-550.0, 550.0);
+    for (int q = 0; q < 50; ++q) {
+        const BoundingBox window = BoundingBox::fromPoints(
+            Point2D(corner(rng), corner(rng)), Point2D(corner(rng), corner(rng)));
+
+        std::vector<size_t> expected;
+        size_t index = 0;
+        for (const auto& entity : current) {
+            if (window.intersects(SpatialIndex::boundsOf(entity.entity))) {
+                expected.push_back(index);
+            }
+            ++index;
+        }
+        QVERIFY(doc.queryWindowIndices(window) == expected);
+    }
+}
+
+QTEST_MAIN(TestSpatialIndex)
+#include "test_SpatialIndex.moc"
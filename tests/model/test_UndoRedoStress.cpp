@@ -197,6 +197,35 @@ private slots:
         QCOMPARE(m_model->entities().size(), size_t(0));
     }
 
+    void testHandleLookupAfterRandomOperations() {
+        m_rng.seed(7);
+
+        for (int i = 0; i < 300; ++i) {
+            int action = m_rng() % 10;
+            if (action < 4) {
+                addRandomLine();
+            } else if (action < 6) {
+                deleteRandomEntity();
+            } else if (action < 8) {
+                if (m_history->canUndo()) {
+                    QVERIFY(m_history->undo());
+                }
+            } else {
+                if (m_history->canRedo()) {
+                    QVERIFY(m_history->redo());
+                }
+            }
+
+            // Handle index must match document positions after every step
+            const auto& entities = m_model->entities();
+            for (size_t j = 0; j < entities.size(); ++j) {
+                auto index = m_model->findEntityIndexByHandle(entities[j].handle);
+                QVERIFY(index.has_value());
+                QCOMPARE(*index, j);
+            }
+        }
+    }
+
     void testInterleavedUndoRedo() {
         // Create 10 entities
         for (int i = 0; i < 10; ++i) {
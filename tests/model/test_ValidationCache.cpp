@@ -0,0 +1,268 @@
+#include <QtTest/QtTest>
+#include <QTemporaryDir>
+#include "model/ValidationCache.h"
+#include "model/DocumentModel.h"
+#include "geometry/Line2D.h"
+#include "geometry/Point2D.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+using namespace OwnCAD::Import;
+
+class TestValidationCache : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testContentHashStableAndSensitive();
+    void testRoundTrip();
+    void testDamagedEntryIsMiss();
+    void testIncompleteResultNotStored();
+    void testLeastRecentlyUsedEviction();
+    void testLoadUsesCache();
+
+private:
+    static void addDirtyDrawing(DocumentModel& doc);
+    static void compareResults(const ValidationResult& a, const ValidationResult& b);
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+
+void TestValidationCache::addDirtyDrawing(DocumentModel& doc) {
+    // Plate with a 1 mm square hole, a duplicate line and a crossing
+    ManufacturingRules rules;
+    rules.minHoleDiameter = TYPICAL_MIN_HOLE_DIAMETER;
+    doc.setManufacturingRules(rules);
+    auto square = [&doc](double x, double y, double size) {
+        const Point2D a(x, y), b(x + size, y), c(x + size, y + size), d(x, y + size);
+        doc.addEntities({*Line2D::create(a, b), *Line2D::create(b, c),
+                         *Line2D::create(c, d), *Line2D::create(d, a)});
+    };
+    square(0, 0, 100);
+    square(10, 10, 1);
+    doc.addEntities({*Line2D::create(Point2D(50, 50), Point2D(60, 60)),
+                     *Line2D::create(Point2D(50, 50), Point2D(60, 60)),
+                     *Line2D::create(Point2D(50, 60), Point2D(60, 50))});
+}
+
+void TestValidationCache::compareResults(const ValidationResult& a, const ValidationResult& b) {
+    QCOMPARE(a.isValid, b.isValid);
+    QCOMPARE(a.issueCount(), b.issueCount());
+    for (size_t i = 0; i < a.issueCount(); ++i) {
+        const GeometryIssue& x = a.issues()[i];
+        const GeometryIssue& y = b.issues()[i];
+        QVERIFY(x.type == y.type);
+        QCOMPARE(x.arc, y.arc);
+        QCOMPARE(x.entityIndex, y.entityIndex);
+        QCOMPARE(x.relatedEntityIndex, y.relatedEntityIndex);
+        QCOMPARE(x.value, y.value);
+        QCOMPARE(x.limit, y.limit);
+        QCOMPARE(x.location.has_value(), y.location.has_value());
+        QCOMPARE(a.contourOf(x), b.contourOf(y));
+        QCOMPARE(describe(x), describe(y));
+    }
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestValidationCache::testContentHashStableAndSensitive() {
+    DocumentModel first;
+    DocumentModel second;
+    addDirtyDrawing(first);
+    addDirtyDrawing(second);
+    QVERIFY(first.contentHash() == second.contentHash());
+    QCOMPARE(first.contentHash().toHex().size(), size_t(32));
+
+    // Geometry, handles and rules all count
+    const ContentHash before = first.contentHash();
+    const std::string handle = first.entities()[0].handle;
+    QVERIFY(first.updateEntity(handle, *Line2D::create(Point2D(0, 0), Point2D(100.000000001, 0))));
+    QVERIFY(first.contentHash() != before);
+
+    second.addLine(*Line2D::create(Point2D(0, 0), Point2D(1, 1)));
+    QVERIFY(second.contentHash() != before);
+
+    DocumentModel third;
+    addDirtyDrawing(third);
+    ManufacturingRules rules;
+    rules.kerfWidth = 0.2;
+    third.setManufacturingRules(rules);
+    QVERIFY(third.contentHash() != before);
+
+    // Signed zeros are the same coordinate
+    ContentHasher plus;
+    ContentHasher minus;
+    plus.addDouble(0.0);
+    minus.addDouble(-0.0);
+    QVERIFY(plus.finish() == minus.finish());
+    ContentHasher other;
+    other.addDouble(1e-300);
+    QVERIFY(other.finish() != plus.finish());
+}
+
+void TestValidationCache::testRoundTrip() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    ValidationCache cache(dir.path().toStdString());
+
+    DocumentModel doc;
+    addDirtyDrawing(doc);
+    const ValidationResult result = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    QVERIFY(result.hasIssueType(GeometryIssueType::HoleTooSmall));
+    QVERIFY(result.hasIssueType(GeometryIssueType::DuplicateLine));
+    QVERIFY(result.hasIssueType(GeometryIssueType::SelfIntersection));
+
+    DocumentStatistics stats;
+    stats.totalSegments = 11;
+    stats.invalidEntities = 4;
+    const ContentHash key = doc.contentHash();
+    QVERIFY(!cache.find(key, 11));
+    QVERIFY(cache.store(key, result, stats, 11));
+    QVERIFY(cache.totalBytes() > 0);
+
+    const auto cached = cache.find(key, 11);
+    QVERIFY(cached.has_value());
+    compareResults(cached->result, result);
+    QCOMPARE(cached->statistics.totalSegments, size_t(11));
+    QCOMPARE(cached->statistics.invalidEntities, size_t(4));
+    QVERIFY(cached->result.hasIssueType(GeometryIssueType::HoleTooSmall));  // Type index rebuilt
+
+    cache.clear();
+    QCOMPARE(cache.totalBytes(), uint64_t(0));
+}
+
+void TestValidationCache::testDamagedEntryIsMiss() {
+    QTemporaryDir dir;
+    ValidationCache cache(dir.path().toStdString());
+    DocumentModel doc;
+    addDirtyDrawing(doc);
+    const ValidationResult result = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    const ContentHash key = doc.contentHash();
+
+    QVERIFY(cache.store(key, result, DocumentStatistics(), 11));
+    QVERIFY(!cache.find(key, 12));  // Entity count disagrees
+
+    QVERIFY(cache.store(key, result, DocumentStatistics(), 11));
+    const std::string path = dir.path().toStdString() + "/" + key.toHex() + ValidationCache::FILE_EXTENSION;
+    const auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 3);
+    QVERIFY(!cache.find(key, 11));
+    QVERIFY(!std::filesystem::exists(path));  // Dropped, not read again
+
+    QVERIFY(cache.store(key, result, DocumentStatistics(), 11));
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('\x7f');
+    }
+    QVERIFY(!cache.find(key, 11));
+
+    // Intact file whose related index is out of range (stale entry)
+    ValidationResult stale = result;
+    stale.editIssues()[0].relatedEntityIndex = 11;
+    QVERIFY(cache.store(key, stale, DocumentStatistics(), 11));
+    QVERIFY(!cache.find(key, 11));
+}
+
+void TestValidationCache::testIncompleteResultNotStored() {
+    QTemporaryDir dir;
+    ValidationCache cache(dir.path().toStdString());
+    ValidationResult result;
+    result.isValid = true;
+    result.truncatedRules.push_back(GeometryValidator::RULE_DUPLICATES);
+    QVERIFY(!cache.store(ContentHash(), result, DocumentStatistics(), 1));
+
+    result.truncatedRules.clear();
+    result.cancelled = true;
+    QVERIFY(!cache.store(ContentHash(), result, DocumentStatistics(), 1));
+    QCOMPARE(cache.totalBytes(), uint64_t(0));
+}
+
+void TestValidationCache::testLeastRecentlyUsedEviction() {
+    QTemporaryDir dir;
+    DocumentModel doc;
+    addDirtyDrawing(doc);
+    const ValidationResult result = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+
+    // Size the cap for two entries
+    ValidationCache probe(dir.path().toStdString());
+    QVERIFY(probe.store(ContentHash(), result, DocumentStatistics(), 11));
+    const uint64_t entrySize = probe.totalBytes();
+    probe.clear();
+
+    ValidationCache cache(dir.path().toStdString(), entrySize * 2 + entrySize / 2);
+    ContentHash a, b, c;
+    a.low = 1;
+    b.low = 2;
+    c.low = 3;
+    const auto pause = [] { std::this_thread::sleep_for(std::chrono::milliseconds(20)); };
+    QVERIFY(cache.store(a, result, DocumentStatistics(), 11));
+    pause();
+    QVERIFY(cache.store(b, result, DocumentStatistics(), 11));
+    pause();
+    QVERIFY(cache.find(a, 11).has_value());  // a is now the most recent
+    pause();
+    QVERIFY(cache.store(c, result, DocumentStatistics(), 11));
+
+    QVERIFY(cache.totalBytes() <= cache.maxBytes());
+    QVERIFY(cache.find(a, 11).has_value());
+    QVERIFY(!cache.find(b, 11).has_value());
+    QVERIFY(cache.find(c, 11).has_value());
+}
+
+void TestValidationCache::testLoadUsesCache() {
+    QTemporaryDir dir;
+    const std::string dxf = dir.filePath("part.dxf").toStdString();
+    {
+        DocumentModel source;
+        addDirtyDrawing(source);
+        QVERIFY(source.exportDXFFile(dxf));
+    }
+    auto cache = std::make_shared<ValidationCache>(dir.filePath("cache").toStdString());
+
+    // First open validates and stores
+    DocumentModel first;
+    first.setValidationCache(cache);
+    QVERIFY(first.loadDXFFile(dxf));
+    QVERIFY(!first.isValidationFromCache());
+    QVERIFY(!first.validationResult().passed());
+    QVERIFY(cache->totalBytes() > 0);
+
+    // Second open shows the stored result without validating
+    DocumentModel second;
+    second.setValidationCache(cache);
+    QVERIFY(second.loadDXFFile(dxf, false));
+    QVERIFY(second.isValidationFromCache());
+    compareResults(second.validationResult(), first.validationResult());
+    QCOMPARE(second.statistics().invalidEntities, first.statistics().invalidEntities);
+    QCOMPARE(second.statistics().dxfEntitiesImported, first.statistics().dxfEntitiesImported);
+    const auto& issue = second.validationResult().issues().front();
+    QCOMPARE(second.validationResult().handleOf(issue.entityIndex),
+             first.validationResult().handleOf(issue.entityIndex));
+
+    // Confirmation is a full run, which replaces the cached result
+    QVERIFY(!second.validateIncremental());
+    second.finalizeValidation(DocumentModel::validateSnapshot(second.snapshot(), second.beginValidation()),
+                              second.version());
+    QVERIFY(!second.isValidationFromCache());
+    compareResults(second.validationResult(), first.validationResult());
+
+    // Other limits are other content
+    DocumentModel third;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = 0.5;
+    third.setManufacturingRules(rules);
+    third.setValidationCache(cache);
+    QVERIFY(third.loadDXFFile(dxf, false));
+    QVERIFY(!third.isValidationFromCache());
+}
+
+QTEST_MAIN(TestValidationCache)
+#include "test_ValidationCache.moc"
@@ -0,0 +1,209 @@
+#include <QTest>
+#include <QSignalSpy>
+#include <QThread>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "model/ValidationScheduler.h"
+#include "model/DocumentModel.h"
+#include "geometry/Line2D.h"
+
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+
+/**
+ * @brief Tests for ValidationScheduler
+ *
+ * Covers debouncing, superseded runs, cancellation and delivery thread.
+ */
+class TestValidationScheduler : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    void testBurstCoalescesIntoOneRun();
+    void testEditDuringRunIsNotLost();
+    void testCancelDiscardsResult();
+    void testDocumentChangeWithoutRequestRevalidates();
+    void testSmallEditIsPatchedWithoutWorker();
+    void testDestroyCancelsRun();
+
+private:
+    void addLines(int count);
+    static bool hasDuplicate(const ValidationResult& result);
+
+    DocumentModel* m_model = nullptr;
+    ValidationScheduler* m_scheduler = nullptr;
+};
+
+void TestValidationScheduler::init()
+{
+    m_model = new DocumentModel();
+    m_scheduler = new ValidationScheduler(m_model);
+}
+
+void TestValidationScheduler::cleanup()
+{
+    delete m_scheduler;
+    m_scheduler = nullptr;
+    delete m_model;
+    m_model = nullptr;
+}
+
+void TestValidationScheduler::addLines(int count)
+{
+    for (int i = 0; i < count; ++i) {
+        auto line = Line2D::create(Point2D(0, i * 5.0), Point2D(10, i * 5.0));
+        QVERIFY(line.has_value());
+        m_model->addLine(*line);
+    }
+}
+
+bool TestValidationScheduler::hasDuplicate(const ValidationResult& result)
+{
+    for (const auto& issue : result.issues()) {
+        if (issue.type == GeometryIssueType::DuplicateLine) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// =============================================================================
+// TESTS
+// =============================================================================
+
+void TestValidationScheduler::testBurstCoalescesIntoOneRun()
+{
+    addLines(10);
+    m_scheduler->setDebounceInterval(50);
+    QSignalSpy finished(m_scheduler, &ValidationScheduler::validationFinished);
+
+    // Simulated drag: many edits, each requesting validation
+    QThread* deliveryThread = nullptr;
+    connect(m_scheduler, &ValidationScheduler::validationFinished, this,
+            [&deliveryThread]() { deliveryThread = QThread::currentThread(); });
+    for (int i = 0; i < 30; ++i) {
+        addLines(1);
+        m_scheduler->requestValidation();
+    }
+
+    QVERIFY(finished.wait(5000));
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(m_scheduler->runsStarted(), uint64_t(1));
+    QCOMPARE(finished.at(0).at(0).toULongLong(), m_scheduler->generation());
+    QCOMPARE(deliveryThread, QThread::currentThread());
+    QVERIFY(!m_scheduler->isRunning());
+    QVERIFY(!m_scheduler->isPending());
+}
+
+void TestValidationScheduler::testEditDuringRunIsNotLost()
+{
+    addLines(200);
+    m_scheduler->setDebounceInterval(0);
+    QSignalSpy finished(m_scheduler, &ValidationScheduler::validationFinished);
+
+    m_scheduler->validateNow();
+    QVERIFY(m_scheduler->isRunning());
+
+    // Edit before the first result is delivered: it must be superseded
+    auto duplicate = Line2D::create(Point2D(0, 0), Point2D(10, 0));
+    QVERIFY(duplicate.has_value());
+    m_model->addLine(*duplicate);
+    m_scheduler->requestValidation();
+
+    QVERIFY(finished.wait(5000));
+    QCOMPARE(finished.count(), 1);
+    QCOMPARE(finished.at(0).at(0).toULongLong(), m_scheduler->generation());
+    QCOMPARE(m_scheduler->runsStarted(), uint64_t(2));
+    QVERIFY(hasDuplicate(m_model->validationResult()));
+}
+
+void TestValidationScheduler::testCancelDiscardsResult()
+{
+    addLines(50);
+    QSignalSpy finished(m_scheduler, &ValidationScheduler::validationFinished);
+
+    m_scheduler->validateNow();
+    m_scheduler->cancel();
+
+    QTRY_VERIFY_WITH_TIMEOUT(!m_scheduler->isRunning(), 5000);
+    QTest::qWait(50);
+    QCOMPARE(finished.count(), 0);
+    QCOMPARE(m_scheduler->runsStarted(), uint64_t(1));
+}
+
+void TestValidationScheduler::testDocumentChangeWithoutRequestRevalidates()
+{
+    addLines(20);
+    QSignalSpy finished(m_scheduler, &ValidationScheduler::validationFinished);
+
+    m_scheduler->validateNow();
+
+    // Edit without telling the scheduler: the result no longer matches
+    // the document version, so it is rerun rather than delivered stale
+    auto duplicate = Line2D::create(Point2D(0, 0), Point2D(10, 0));
+    QVERIFY(duplicate.has_value());
+    m_model->addLine(*duplicate);
+
+    QVERIFY(finished.wait(5000));
+    QCOMPARE(m_scheduler->runsStarted(), uint64_t(2));
+    QVERIFY(hasDuplicate(m_model->validationResult()));
+}
+
+void TestValidationScheduler::testSmallEditIsPatchedWithoutWorker()
+{
+    addLines(20);
+    QSignalSpy finished(m_scheduler, &ValidationScheduler::validationFinished);
+
+    m_scheduler->validateNow();
+    QVERIFY(finished.wait(5000));
+
+    // The complete result is the baseline: a one-entity edit is patched
+    // on this thread and delivered before validateNow() returns
+    auto duplicate = Line2D::create(Point2D(0, 0), Point2D(10, 0));
+    QVERIFY(duplicate.has_value());
+    m_model->addLine(*duplicate);
+    m_scheduler->validateNow();
+
+    QCOMPARE(finished.count(), 2);
+    QVERIFY(!m_scheduler->isRunning());
+    QCOMPARE(m_scheduler->runsStarted(), uint64_t(2));
+    QVERIFY(hasDuplicate(m_model->validationResult()));
+}
+
+void TestValidationScheduler::testDestroyCancelsRun()
+{
+    addLines(2000);
+
+    // Hold the worker in its first progress report until the window closes
+    std::atomic<bool> entered{false};
+    std::atomic<bool> closing{false};
+    std::atomic<int> reportsAfterClose{0};
+    m_model->setValidationProgressCallback([&](const ValidationProgress&) {
+        if (closing) {
+            reportsAfterClose++;
+            return;
+        }
+        entered = true;
+        while (!closing) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    m_scheduler->validateNow();
+    QVERIFY(m_scheduler->isRunning());
+    QTRY_VERIFY_WITH_TIMEOUT(entered.load(), 5000);
+
+    // Destruction cancels the run: it stops at its next check instead of
+    // reporting (and waiting for) the rest of the validation
+    closing = true;
+    delete m_scheduler;
+    m_scheduler = nullptr;
+    QCOMPARE(reportsAfterClose.load(), 0);
+}
+
+QTEST_MAIN(TestValidationScheduler)
+#include "test_ValidationScheduler.moc"
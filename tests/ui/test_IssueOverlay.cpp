@@ -0,0 +1,123 @@
+#include <QtTest/QtTest>
+#include "ui/IssueOverlay.h"
+#include "model/DocumentModel.h"
+#include "geometry/Ellipse2D.h"
+#include "geometry/Line2D.h"
+
+using namespace OwnCAD::UI;
+using namespace OwnCAD::Model;
+using namespace OwnCAD::Geometry;
+
+class TestIssueOverlay : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testZoomBucket();
+    void testClustersSplitWhenZoomingIn();
+    void testSeverityAndCenter();
+    void testRebuildOnlyWhenBucketOrMarkersChange();
+    void testMarkersFromResult();
+};
+
+void TestIssueOverlay::testZoomBucket() {
+    QCOMPARE(IssueOverlay::zoomBucket(1.0), 0);
+    QCOMPARE(IssueOverlay::zoomBucket(1.99), 0);
+    QCOMPARE(IssueOverlay::zoomBucket(2.0), 1);
+    QCOMPARE(IssueOverlay::zoomBucket(0.5), -1);
+    QCOMPARE(IssueOverlay::zoomBucket(0.3), -2);
+    QCOMPARE(IssueOverlay::zoomBucket(0.0), 0);
+}
+
+void TestIssueOverlay::testClustersSplitWhenZoomingIn() {
+    // 100 × 10 issues 1 mm apart, every fourth a warning
+    std::vector<IssueMarker> markers;
+    for (int i = 0; i < 1000; ++i) {
+        IssueMarker marker;
+        marker.location = Point2D(0.5 + i % 100, 0.5 + i / 100);
+        marker.severity = (i % 4 == 0) ? IssueSeverity::Warning : IssueSeverity::Error;
+        markers.push_back(marker);
+    }
+    IssueOverlay overlay;
+    overlay.setMarkers(markers);
+
+    const auto far = overlay.clusters(0.01);   // 6144 mm cells
+    QCOMPARE(far.size(), size_t(1));
+    QCOMPARE(far[0].count, size_t(1000));
+    QCOMPARE(far[0].errors, size_t(750));
+
+    const size_t middle = overlay.clusters(4.0).size();   // 12 mm cells
+    QVERIFY(middle > 1 && middle < 100);
+
+    const auto near = overlay.clusters(100.0);  // 0.75 mm cells
+    QCOMPARE(near.size(), size_t(1000));
+    for (const auto& cluster : near) {
+        QVERIFY(cluster.isSingle());
+    }
+}
+
+void TestIssueOverlay::testSeverityAndCenter() {
+    IssueOverlay overlay;
+    overlay.setMarkers({{Point2D(1, 1), IssueSeverity::Warning},
+                        {Point2D(3, 5), IssueSeverity::Error},
+                        {Point2D(-1, -1), IssueSeverity::Warning}});
+    const auto clusters = overlay.clusters(1.0);  // 48 mm cells; (-1, -1) is in the next cell
+    QCOMPARE(clusters.size(), size_t(2));
+    QCOMPARE(clusters[0].count, size_t(2));
+    QVERIFY(clusters[0].severity() == IssueSeverity::Error);
+    QCOMPARE(clusters[0].center.x(), 2.0);
+    QCOMPARE(clusters[0].center.y(), 3.0);
+    QVERIFY(clusters[1].severity() == IssueSeverity::Warning);
+
+    overlay.clear();
+    QVERIFY(overlay.clusters(1.0).empty());
+}
+
+void TestIssueOverlay::testRebuildOnlyWhenBucketOrMarkersChange() {
+    IssueOverlay overlay;
+    overlay.setMarkers({{Point2D(0, 0), IssueSeverity::Error}});
+    overlay.clusters(1.0);
+    overlay.clusters(1.5);
+    overlay.clusters(1.9);
+    QCOMPARE(overlay.rebuildCount(), size_t(1));
+
+    overlay.clusters(2.5);
+    QCOMPARE(overlay.rebuildCount(), size_t(2));
+
+    overlay.setMarkers({{Point2D(5, 5), IssueSeverity::Warning}});
+    overlay.clusters(2.5);
+    overlay.clusters(3.0);
+    QCOMPARE(overlay.rebuildCount(), size_t(3));
+}
+
+void TestIssueOverlay::testMarkersFromResult() {
+    DocumentModel doc;
+    ManufacturingRules rules;
+    rules.minHoleDiameter = 0.0;
+    rules.minEdgeLength = 1.0;
+    doc.setManufacturingRules(rules);
+    doc.addEllipse(*Ellipse2D::create(Point2D(0, 0), Point2D(10, 0), 0.5, 0.0, 6.283185));  // Not validated
+    doc.addEntities({*Line2D::create(Point2D(0, 0), Point2D(10, 10)),
+                     *Line2D::create(Point2D(0, 10), Point2D(10, 0)),
+                     *Line2D::create(Point2D(20, 0), Point2D(20.5, 0))});
+    const ValidationResult result = DocumentModel::validateSnapshot(doc.snapshot(), doc.beginValidation());
+    QCOMPARE(result.issueCount(), size_t(2));
+
+    const auto markers = IssueOverlay::markersFor(result, doc.snapshot());
+    QCOMPARE(markers.size(), size_t(2));
+    for (size_t i = 0; i < markers.size(); ++i) {
+        const auto& issue = result.issues()[i];
+        if (issue.type == GeometryIssueType::SelfIntersection) {
+            QVERIFY(markers[i].severity == IssueSeverity::Error);
+            QVERIFY(markers[i].location.isEqual(Point2D(5, 5), 1e-9));  // Recorded crossing
+        } else {
+            QVERIFY(issue.type == GeometryIssueType::ShortEdge);
+            QVERIFY(markers[i].severity == IssueSeverity::Warning);
+            QVERIFY(markers[i].location.isEqual(Point2D(20.25, 0), 1e-9));  // Entity center
+        }
+    }
+
+    QVERIFY(IssueOverlay::markersFor(ValidationResult(), doc.snapshot()).empty());
+}
+
+QTEST_MAIN(TestIssueOverlay)
+#include "test_IssueOverlay.moc"